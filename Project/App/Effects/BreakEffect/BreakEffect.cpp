@@ -46,8 +46,8 @@ BreakEffect::BreakEffect(Vector3 worldPosition) {
 	flashPlaneMaterial_.textureName = "Circle2.png";
 	flashPlaneMaterial_.baseColor = Color::Blue;
 
-	flashScaleAnimation_ = std::make_unique<SimpleAnimation<float>>(1.0f, 30.0f, EasingType::EaseOutQuart);
-	flashAlphaAnimation_ = std::make_unique<SimpleAnimation<float>>(1.0f, 0.0f, EasingType::EaseInQuart);
+	flashScaleAnimation_ = SimpleAnimation<float>(1.0f, 30.0f, EasingType::EaseOutQuart);
+	flashAlphaAnimation_ = SimpleAnimation<float>(1.0f, 0.0f, EasingType::EaseInQuart);
 
 	//===================================
 	// リングのデータを初期化
@@ -65,11 +65,11 @@ BreakEffect::BreakEffect(Vector3 worldPosition) {
 	ringRotates_[3] = { 0.0f,-1.17f,0.92f };
 
 
-	ringOuterAnimation_[0] = std::make_unique<SimpleAnimation<float>>(1.0f, 3.0f, EasingType::EaseOutQuart);
-	ringInnerAnimation_[0] = std::make_unique<SimpleAnimation<float>>(0.8f, 2.0f, EasingType::EaseOutQuart);
+	ringOuterAnimation_[0] = SimpleAnimation<float>(1.0f, 3.0f, EasingType::EaseOutQuart);
+	ringInnerAnimation_[0] = SimpleAnimation<float>(0.8f, 2.0f, EasingType::EaseOutQuart);
 
-	ringOuterAnimation_[1] = std::make_unique<SimpleAnimation<float>>(1.0f, 5.0f, EasingType::EaseOutQuart);
-	ringInnerAnimation_[1] = std::make_unique<SimpleAnimation<float>>(0.8f, 4.0f, EasingType::EaseOutQuart);
+	ringOuterAnimation_[1] = SimpleAnimation<float>(1.0f, 5.0f, EasingType::EaseOutQuart);
+	ringInnerAnimation_[1] = SimpleAnimation<float>(0.8f, 4.0f, EasingType::EaseOutQuart);
 
 	//===================================
 	// 粒子のデータを初期化
@@ -100,7 +100,7 @@ BreakEffect::BreakEffect(Vector3 worldPosition) {
 	//===================================
 	// ブラー用のデータを初期化
 	//===================================
-	radialBlurScaleAni_ = std::make_unique<SimpleAnimation<float>>(0.0f, 0.01f, EasingType::EaseInOutSine, true, LoopType::PingPong);
+	radialBlurScaleAni_ = SimpleAnimation<float>(0.0f, 0.01f, EasingType::EaseInOutSine, true, LoopType::PingPong);
 }
 
 BreakEffect::~BreakEffect() {
@@ -180,24 +180,24 @@ void BreakEffect::UpdateExplosion() {
 
 	float t = timer_ / explosionTime_;
 
-	radialBlurScale_ = radialBlurScaleAni_->GetValue(t * 2.0f);
+	radialBlurScale_ = radialBlurScaleAni_.GetValue(t * 2.0f);
 
 	MAGISYSTEM::ApplyPostEffectRadialBlur(Vector2(0.5f, 0.5f), radialBlurScale_);
 
 	// リングの処理
 	for (uint32_t i = 0; i < 2; i++) {
-		ringDatas_[i].outerRadius = ringOuterAnimation_[0]->GetValue(t);
-		ringDatas_[i].innerRadius = ringInnerAnimation_[0]->GetValue(t);
+		ringDatas_[i].outerRadius = ringOuterAnimation_[0].GetValue(t);
+		ringDatas_[i].innerRadius = ringInnerAnimation_[0].GetValue(t);
 	}
 	for (uint32_t i = 2; i < 4; i++) {
-		ringDatas_[i].outerRadius = ringOuterAnimation_[1]->GetValue(t);
-		ringDatas_[i].innerRadius = ringInnerAnimation_[1]->GetValue(t);
+		ringDatas_[i].outerRadius = ringOuterAnimation_[1].GetValue(t);
+		ringDatas_[i].innerRadius = ringInnerAnimation_[1].GetValue(t);
 	}
 
-	flashScale_ = flashScaleAnimation_->GetValue(t);
+	flashScale_ = flashScaleAnimation_.GetValue(t);
 
 	// フラッシュの処理
-	flashPlaneMaterial_.baseColor.w = flashAlphaAnimation_->GetValue(t);
+	flashPlaneMaterial_.baseColor.w = flashAlphaAnimation_.GetValue(t);
 
 	ImGui::DragFloat("t", &t);
 	ImGui::DragFloat("Alpha", &flashPlaneMaterial_.baseColor.w);
@@ -79,7 +79,7 @@ private:
 	//====================================
 	// ラジアルブラー用変数
 	//====================================
-	std::unique_ptr<SimpleAnimation<float>> radialBlurScaleAni_;
+	SimpleAnimation<float> radialBlurScaleAni_;
 	float radialBlurScale_ = 0.01f;
 
 	//====================================
@@ -95,8 +95,8 @@ private:
 	std::array<Vector3, 4> ringRotates_;
 
 	// リングのアニメーション
-	std::unique_ptr<SimpleAnimation<float>> ringOuterAnimation_[2];
-	std::unique_ptr<SimpleAnimation<float>> ringInnerAnimation_[2];
+	SimpleAnimation<float> ringOuterAnimation_[2];
+	SimpleAnimation<float> ringInnerAnimation_[2];
 
 	//===================================
 	// フラッシュ用の変数
@@ -105,8 +105,8 @@ private:
 	PlaneData3D flashPlaneData_;
 	MaterialData3D flashPlaneMaterial_;
 
-	std::unique_ptr<SimpleAnimation<float>> flashScaleAnimation_;
-	std::unique_ptr<SimpleAnimation<float>> flashAlphaAnimation_;
+	SimpleAnimation<float> flashScaleAnimation_;
+	SimpleAnimation<float> flashAlphaAnimation_;
 
 	//===================================
 	// 靄用のパーティクル
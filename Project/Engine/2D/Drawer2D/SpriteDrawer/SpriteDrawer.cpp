@@ -23,38 +23,43 @@ SpriteDrawer::SpriteDrawer(
 	DirectXCommand* directXCommand,
 	SRVUAVManager* srvUavManager,
 	GraphicsPipelineManager* graphicsPipelineManager,
-	Camera2DManager* camera2DManager
+	Camera2DManager* camera2DManager,
+	RenderQueue* renderQueue
 ) {
 	SetDXGI(dxgi);
 	SetDirectXCommand(directXCommand);
 	SetSRVUAVManager(srvUavManager);
 	SetGraphicsPipelineManager(graphicsPipelineManager);
 	SetCamera2DManager(camera2DManager);
-
-	for (uint32_t i = 0; i < kBlendModeNum; ++i) {
-		// リソース作成
-
-		// 
-		// Front
-		// 
-		instancingResourceFront_[i] = dxgi_->CreateBufferResource(sizeof(SpriteDataForGPU) * NumMaxInstance);
-		instancingSrvIndexFront_[i] = srvUavManager_->Allocate();
-		srvUavManager_->CreateSrvStructuredBuffer(instancingSrvIndexFront_[i], instancingResourceFront_[i].Get(), NumMaxInstance, sizeof(SpriteDataForGPU));
-		instancingResourceFront_[i]->Map(0, nullptr, reinterpret_cast<void**>(&instancingDataFront_[i]));
-
-		currentIndexFront_[i] = 0;
-		instanceCountFront_[i] = 0;
-
-		// 
-		// Back
-		// 
-		instancingResourceBack_[i] = dxgi_->CreateBufferResource(sizeof(SpriteDataForGPU) * NumMaxInstance);
-		instancingSrvIndexBack_[i] = srvUavManager_->Allocate();
-		srvUavManager_->CreateSrvStructuredBuffer(instancingSrvIndexBack_[i], instancingResourceBack_[i].Get(), NumMaxInstance, sizeof(SpriteDataForGPU));
-		instancingResourceBack_[i]->Map(0, nullptr, reinterpret_cast<void**>(&instancingDataBack_[i]));
-
-		currentIndexBack_[i] = 0;
-		instanceCountBack_[i] = 0;
+	SetRenderQueue(renderQueue);
+
+	// リソースはフレームごとに持ち、GPUが読んでいる間に書き換えないようにする
+	for (uint32_t frame = 0; frame < FrameConst::FrameCount; ++frame) {
+		for (uint32_t i = 0; i < kBlendModeNum; ++i) {
+			// リソース作成
+
+			// 
+			// Front
+			// 
+			instancingResourceFront_[frame][i] = dxgi_->CreateBufferResource(sizeof(SpriteDataForGPU) * NumMaxInstance);
+			instancingSrvIndexFront_[frame][i] = srvUavManager_->Allocate();
+			srvUavManager_->CreateSrvStructuredBuffer(instancingSrvIndexFront_[frame][i], instancingResourceFront_[frame][i].Get(), NumMaxInstance, sizeof(SpriteDataForGPU));
+			instancingResourceFront_[frame][i]->Map(0, nullptr, reinterpret_cast<void**>(&instancingDataFront_[frame][i]));
+
+			currentIndexFront_[i] = 0;
+			instanceCountFront_[i] = 0;
+
+			// 
+			// Back
+			// 
+			instancingResourceBack_[frame][i] = dxgi_->CreateBufferResource(sizeof(SpriteDataForGPU) * NumMaxInstance);
+			instancingSrvIndexBack_[frame][i] = srvUavManager_->Allocate();
+			srvUavManager_->CreateSrvStructuredBuffer(instancingSrvIndexBack_[frame][i], instancingResourceBack_[frame][i].Get(), NumMaxInstance, sizeof(SpriteDataForGPU));
+			instancingResourceBack_[frame][i]->Map(0, nullptr, reinterpret_cast<void**>(&instancingDataBack_[frame][i]));
+
+			currentIndexBack_[i] = 0;
+			instanceCountBack_[i] = 0;
+		}
 	}
 
 	Logger::Log("SpriteDrawer Initialize\n");
@@ -74,6 +79,26 @@ void SpriteDrawer::Update() {
 		instanceCountBack_[i] = currentIndexBack_[i];
 		currentIndexBack_[i] = 0;
 	}
+
+	// スプライトがあるブレンドモードだけ描画キューに積む
+	for (uint32_t i = 0; i < kBlendModeNum; ++i) {
+		const BlendMode mode = static_cast<BlendMode>(i);
+		if (instanceCountBack_[i] > 0) {
+			renderQueue_->Submit(this, RenderPass::BackSprite, mode, static_cast<uint32_t>(GraphicsPipelineStateType::Sprite), 0);
+		}
+		if (instanceCountFront_[i] > 0) {
+			renderQueue_->Submit(this, RenderPass::FrontSprite, mode, static_cast<uint32_t>(GraphicsPipelineStateType::Sprite), 0);
+		}
+	}
+}
+
+void SpriteDrawer::ExecuteRenderItem(const RenderItem& item, [[maybe_unused]] bool isPipelineChanged) {
+	// パスとブレンドモードごとにひとつしか積まないので、パイプラインは毎回設定する
+	if (RenderQueue::GetPass(item.key) == RenderPass::BackSprite) {
+		DrawBack(RenderQueue::GetBlendMode(item.key));
+	} else {
+		DrawFront(RenderQueue::GetBlendMode(item.key));
+	}
 }
 
 void SpriteDrawer::DrawFront(BlendMode blendMode) {
@@ -81,12 +106,13 @@ void SpriteDrawer::DrawFront(BlendMode blendMode) {
 	if (instanceCountFront_[i] == 0) return;
 
 	ID3D12GraphicsCommandList6* commandList = directXCommand_->GetList6();
+	const uint32_t frameIndex = directXCommand_->GetFrameIndex();
 
 	commandList->SetGraphicsRootSignature(graphicsPipelineManager_->GetRootSignature(GraphicsPipelineStateType::Sprite));
 	commandList->SetPipelineState(graphicsPipelineManager_->GetPipelineState(GraphicsPipelineStateType::Sprite, blendMode));
 
 	camera2DManager_->TransferCurrentCamera(0);
-	commandList->SetGraphicsRootDescriptorTable(1, srvUavManager_->GetDescriptorHandleGPU(instancingSrvIndexFront_[i]));
+	commandList->SetGraphicsRootDescriptorTable(1, srvUavManager_->GetDescriptorHandleGPU(instancingSrvIndexFront_[frameIndex][i]));
 	commandList->SetGraphicsRootDescriptorTable(2, srvUavManager_->GetDescriptorHandleGPU(0));
 
 	commandList->DispatchMesh(1, instanceCountFront_[i], 1);
@@ -97,12 +123,13 @@ void SpriteDrawer::DrawBack(BlendMode blendMode) {
 	if (instanceCountBack_[i] == 0) return;
 
 	ID3D12GraphicsCommandList6* commandList = directXCommand_->GetList6();
+	const uint32_t frameIndex = directXCommand_->GetFrameIndex();
 
 	commandList->SetGraphicsRootSignature(graphicsPipelineManager_->GetRootSignature(GraphicsPipelineStateType::Sprite));
 	commandList->SetPipelineState(graphicsPipelineManager_->GetPipelineState(GraphicsPipelineStateType::Sprite, blendMode));
 
 	camera2DManager_->TransferCurrentCamera(0);
-	commandList->SetGraphicsRootDescriptorTable(1, srvUavManager_->GetDescriptorHandleGPU(instancingSrvIndexBack_[i]));
+	commandList->SetGraphicsRootDescriptorTable(1, srvUavManager_->GetDescriptorHandleGPU(instancingSrvIndexBack_[frameIndex][i]));
 	commandList->SetGraphicsRootDescriptorTable(2, srvUavManager_->GetDescriptorHandleGPU(0));
 
 	commandList->DispatchMesh(1, instanceCountBack_[i], 1);
@@ -110,11 +137,13 @@ void SpriteDrawer::DrawBack(BlendMode blendMode) {
 
 void SpriteDrawer::AddSprite(const SpriteData& data, const SpriteMaterialData& material) {
 	const uint32_t blendIndex = static_cast<uint32_t>(material.blendmode);
+	// 今のフレームのリソースへ書き込む
+	const uint32_t frameIndex = directXCommand_->GetFrameIndex();
 	if (data.isBack) {
-		instancingDataBack_[blendIndex][currentIndexBack_[blendIndex]] = ComputeSpriteDataForGPU(data, material);
+		instancingDataBack_[frameIndex][blendIndex][currentIndexBack_[blendIndex]] = ComputeSpriteDataForGPU(data, material);
 		currentIndexBack_[blendIndex]++;
 	} else {
-		instancingDataFront_[blendIndex][currentIndexFront_[blendIndex]] = ComputeSpriteDataForGPU(data, material);
+		instancingDataFront_[frameIndex][blendIndex][currentIndexFront_[blendIndex]] = ComputeSpriteDataForGPU(data, material);
 		currentIndexFront_[blendIndex]++;
 	}
 }
@@ -217,3 +246,8 @@ void SpriteDrawer::SetCamera2DManager(Camera2DManager* camera2DManager) {
 	assert(camera2DManager);
 	camera2DManager_ = camera2DManager;
 }
+
+void SpriteDrawer::SetRenderQueue(RenderQueue* renderQueue) {
+	assert(renderQueue);
+	renderQueue_ = renderQueue;
+}
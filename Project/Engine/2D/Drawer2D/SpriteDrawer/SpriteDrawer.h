@@ -11,6 +11,8 @@
 #include "Structs/ColorStruct.h"
 #include "Structs/SpriteStruct.h"
 #include "Enums/BlendModeEnum.h"
+#include "Const/FrameConst.h"
+#include "RenderQueue/RenderQueue.h"
 
 class DXGI;
 class DirectXCommand;
@@ -21,20 +23,21 @@ class Camera2DManager;
 /// <summary>
 /// スプライト描画クラス
 /// </summary>
-class SpriteDrawer {
+class SpriteDrawer : public RenderQueueSubmitter {
 public:
 	SpriteDrawer(
 		DXGI* dxgi,
 		DirectXCommand* directXCommand,
 		SRVUAVManager* srvUavManager,
 		GraphicsPipelineManager* graphicsPipelineManager,
-		Camera2DManager* camera2DManager
+		Camera2DManager* camera2DManager,
+		RenderQueue* renderQueue
 	);
 	~SpriteDrawer();
 
 	void Update();
-	void DrawFront(BlendMode blendMode);
-	void DrawBack(BlendMode blendMode);
+	// 描画キューから積んだ描画を記録する
+	void ExecuteRenderItem(const RenderItem& item, bool isPipelineChanged) override;
 
 	void AddSprite(
 		const SpriteData& data,
@@ -43,12 +46,17 @@ public:
 
 private:
 	SpriteDataForGPU ComputeSpriteDataForGPU(const SpriteData& data, const SpriteMaterialData& material);
+private:
+	void DrawFront(BlendMode blendMode);
+	void DrawBack(BlendMode blendMode);
+
 private:
 	void SetDXGI(DXGI* dxgi);
 	void SetDirectXCommand(DirectXCommand* directXCommand);
 	void SetSRVUAVManager(SRVUAVManager* srvUavManager);
 	void SetGraphicsPipelineManager(GraphicsPipelineManager* graphicsPipelineManager);
 	void SetCamera2DManager(Camera2DManager* camera2DManager);
+	void SetRenderQueue(RenderQueue* renderQueue);
 
 private:
 	// インスタンス最大数
@@ -59,12 +67,12 @@ private:
 	//===============================
 
 	// instancing描画用のリソース
-	ComPtr<ID3D12Resource> instancingResourceFront_[static_cast<uint32_t>(BlendMode::Num)];
+	ComPtr<ID3D12Resource> instancingResourceFront_[FrameConst::FrameCount][static_cast<uint32_t>(BlendMode::Num)];
 	// instancing描画用のデータ
-	SpriteDataForGPU* instancingDataFront_[static_cast<uint32_t>(BlendMode::Num)];
+	SpriteDataForGPU* instancingDataFront_[FrameConst::FrameCount][static_cast<uint32_t>(BlendMode::Num)];
 
 	// SpriteSrvIndex
-	uint32_t instancingSrvIndexFront_[static_cast<uint32_t>(BlendMode::Num)];
+	uint32_t instancingSrvIndexFront_[FrameConst::FrameCount][static_cast<uint32_t>(BlendMode::Num)];
 
 	// instance描画する際に使う変数
 	uint32_t instanceCountFront_[static_cast<uint32_t>(BlendMode::Num)];
@@ -77,12 +85,12 @@ private:
 	//===============================
 
 	// instancing描画用のリソース
-	ComPtr<ID3D12Resource> instancingResourceBack_[static_cast<uint32_t>(BlendMode::Num)];
+	ComPtr<ID3D12Resource> instancingResourceBack_[FrameConst::FrameCount][static_cast<uint32_t>(BlendMode::Num)];
 	// instancing描画用のデータ
-	SpriteDataForGPU* instancingDataBack_[static_cast<uint32_t>(BlendMode::Num)];
+	SpriteDataForGPU* instancingDataBack_[FrameConst::FrameCount][static_cast<uint32_t>(BlendMode::Num)];
 
 	// SpriteSrvIndex
-	uint32_t instancingSrvIndexBack_[static_cast<uint32_t>(BlendMode::Num)];
+	uint32_t instancingSrvIndexBack_[FrameConst::FrameCount][static_cast<uint32_t>(BlendMode::Num)];
 
 	// instance描画する際に使う変数
 	uint32_t instanceCountBack_[static_cast<uint32_t>(BlendMode::Num)];
@@ -96,4 +104,5 @@ private:
 	SRVUAVManager* srvUavManager_ = nullptr;
 	GraphicsPipelineManager* graphicsPipelineManager_ = nullptr;
 	Camera2DManager* camera2DManager_ = nullptr;
+	RenderQueue* renderQueue_ = nullptr;
 };
\ No newline at end of file
@@ -85,8 +85,6 @@ void Camera3D::UpdateData() {
 		m.m[3][3] - m.m[3][2])); // Far
 
 	ApplyShake();
-
-	UpdateCameraData();
 }
 
 void Camera3D::Shake(float duration, float intensity) {
@@ -174,21 +172,25 @@ void Camera3D::DrawFrustum() {
 }
 
 void Camera3D::TransferCamera(uint32_t rootParameterIndex) {
-	MAGISYSTEM::GetDirectXCommandList()->SetGraphicsRootConstantBufferView(rootParameterIndex, cameraResource_->GetGPUVirtualAddress());
+	MAGISYSTEM::GetDirectXCommandList()->SetGraphicsRootConstantBufferView(rootParameterIndex, cameraResource_[MAGISYSTEM::GetFrameIndex()]->GetGPUVirtualAddress());
 }
 
 void Camera3D::TransferCameraInv(uint32_t rootParameterIndex) {
-	MAGISYSTEM::GetDirectXCommandList()->SetGraphicsRootConstantBufferView(rootParameterIndex, cameraInvResource_->GetGPUVirtualAddress());
+	MAGISYSTEM::GetDirectXCommandList()->SetGraphicsRootConstantBufferView(rootParameterIndex, cameraInvResource_[MAGISYSTEM::GetFrameIndex()]->GetGPUVirtualAddress());
 }
 
 void Camera3D::TransferCameraFrustum(uint32_t rootParameterIndex) {
-	MAGISYSTEM::GetDirectXCommandList()->SetGraphicsRootConstantBufferView(rootParameterIndex, frustumResource_->GetGPUVirtualAddress());
+	MAGISYSTEM::GetDirectXCommandList()->SetGraphicsRootConstantBufferView(rootParameterIndex, frustumResource_[MAGISYSTEM::GetFrameIndex()]->GetGPUVirtualAddress());
 }
 
 Matrix4x4 Camera3D::GetViewProjectionMatrix() const {
 	return viewProjectionMatrix_;
 }
 
+Matrix4x4 Camera3D::GetProjectionMatrix() const {
+	return projectionMatrix_;
+}
+
 float Camera3D::GetFarClipRange() const {
 	return farClipRange_;
 }
@@ -197,6 +199,11 @@ Vector3 Camera3D::GetEye() const {
 	return eye_;
 }
 
+float Camera3D::GetViewDepth(const Vector3& worldPosition) const {
+	// ビュー行列のz列だけを掛ける
+	return worldPosition.x * viewMatrix_.m[0][2] + worldPosition.y * viewMatrix_.m[1][2] + worldPosition.z * viewMatrix_.m[2][2] + viewMatrix_.m[3][2];
+}
+
 float Camera3D::GetYaw() const {
 	return yaw_;
 }
@@ -222,37 +229,46 @@ void Camera3D::SetPitch(float pitch) {
 }
 
 void Camera3D::CreateCameraResource() {
-	cameraResource_ = MAGISYSTEM::CreateBufferResource(sizeof(Camera3DForGPU));
-	cameraInvResource_ = MAGISYSTEM::CreateBufferResource(sizeof(Camera3DInverseForGPU));
-	frustumResource_ = MAGISYSTEM::CreateBufferResource(sizeof(Camera3DFrustumForGPU));
+	for (uint32_t frame = 0; frame < FrameConst::FrameCount; ++frame) {
+		cameraResource_[frame] = MAGISYSTEM::CreateBufferResource(sizeof(Camera3DForGPU));
+		cameraInvResource_[frame] = MAGISYSTEM::CreateBufferResource(sizeof(Camera3DInverseForGPU));
+		frustumResource_[frame] = MAGISYSTEM::CreateBufferResource(sizeof(Camera3DFrustumForGPU));
+	}
 }
 
 void Camera3D::MapCameraData() {
-	cameraData_ = nullptr;
-	cameraResource_->Map(0, nullptr, reinterpret_cast<void**>(&cameraData_));
+	for (uint32_t frame = 0; frame < FrameConst::FrameCount; ++frame) {
+		cameraData_[frame] = nullptr;
+		cameraResource_[frame]->Map(0, nullptr, reinterpret_cast<void**>(&cameraData_[frame]));
+
+		cameraInvData_[frame] = nullptr;
+		cameraInvResource_[frame]->Map(0, nullptr, reinterpret_cast<void**>(&cameraInvData_[frame]));
 
-	cameraInvData_ = nullptr;
-	cameraInvResource_->Map(0, nullptr, reinterpret_cast<void**>(&cameraInvData_));
+		frustumData_[frame] = nullptr;
+		frustumResource_[frame]->Map(0, nullptr, reinterpret_cast<void**>(&frustumData_[frame]));
 
-	frustumData_ = nullptr;
-	frustumResource_->Map(0, nullptr, reinterpret_cast<void**>(&frustumData_));
+		WriteCameraData(frame);
+	}
+}
 
-	UpdateCameraData();
+void Camera3D::WriteFrameData() {
+	// 今のフレームのリソースへ書き込む
+	WriteCameraData(MAGISYSTEM::GetFrameIndex());
 }
 
-void Camera3D::UpdateCameraData() {
-	cameraData_->worldPosition = eye_;
-	cameraData_->viewProjection = viewProjectionMatrix_;
+void Camera3D::WriteCameraData(uint32_t frameIndex) {
+	cameraData_[frameIndex]->worldPosition = eye_;
+	cameraData_[frameIndex]->viewProjection = viewProjectionMatrix_;
 
-	cameraInvData_->invView = Inverse(viewMatrix_);
-	cameraInvData_->invProj = Inverse(projectionMatrix_);
+	cameraInvData_[frameIndex]->invView = Inverse(viewMatrix_);
+	cameraInvData_[frameIndex]->invProj = Inverse(projectionMatrix_);
 
-	frustumData_->left = frustumPlanes_[0];
-	frustumData_->right = frustumPlanes_[1];
-	frustumData_->bottom = frustumPlanes_[2];
-	frustumData_->top = frustumPlanes_[3];
-	frustumData_->nearClip = frustumPlanes_[4];
-	frustumData_->farClip = frustumPlanes_[5];
+	frustumData_[frameIndex]->left = frustumPlanes_[0];
+	frustumData_[frameIndex]->right = frustumPlanes_[1];
+	frustumData_[frameIndex]->bottom = frustumPlanes_[2];
+	frustumData_[frameIndex]->top = frustumPlanes_[3];
+	frustumData_[frameIndex]->nearClip = frustumPlanes_[4];
+	frustumData_[frameIndex]->farClip = frustumPlanes_[5];
 }
 
 void Camera3D::SetIsUseYawPitch(bool isUseYawPitch) {
@@ -10,6 +10,7 @@
 #include "DirectX/ComPtr/ComPtr.h"
 
 #include "Structs/CameraStruct.h"
+#include "Const/FrameConst.h"
 
 /// <summary>
 /// 3D用カメラ
@@ -23,8 +24,10 @@ public:
 	virtual void Initialize();
 	// 更新
 	virtual void Update();
-	// データ更新
+	// データ更新(行列の計算のみ)
 	virtual void UpdateData();
+	// 今のフレームのリソースへカメラのデータを書き込む(描画スレッドが止まっている間に呼ぶ)
+	void WriteFrameData();
 
 	// カメラを揺らす
 	void Shake(float duration, float intensity);
@@ -43,12 +46,18 @@ public:
 	// ビュープロジェクションマトリックスを送る
 	Matrix4x4 GetViewProjectionMatrix()const;
 
+	// プロジェクション行列を送る
+	Matrix4x4 GetProjectionMatrix()const;
+
 	// ファークリップ距離を送る
 	float GetFarClipRange()const;
 
 	// 視点を送る
 	Vector3 GetEye()const;
 
+	// ワールド座標のカメラから見た深度(ビュー空間のz)を送る
+	float GetViewDepth(const Vector3& worldPosition)const;
+
 	float GetYaw()const;
 	float GetPitch()const;
 
@@ -63,8 +72,8 @@ private:
 	void CreateCameraResource();
 	// カメラのデータをマップ
 	void MapCameraData();
-	// カメラのデータを更新
-	void UpdateCameraData();
+	// 指定したフレームのリソースへカメラのデータを書き込む
+	void WriteCameraData(uint32_t frameIndex);
 
 protected:
 	// カメラの初期トランスフォーム
@@ -112,18 +121,18 @@ protected:
 	float shakeIntensity_ = 0.0f;
 	Vector3 shakeStartTranslate_ = { 0.0f,0.0f,0.0f };
 private:
-	// Camera用リソース
-	ComPtr<ID3D12Resource> cameraResource_ = nullptr;
+	// Camera用リソース(GPUが読んでいる間に書き換えないようにフレームごとに持つ)
+	ComPtr<ID3D12Resource> cameraResource_[FrameConst::FrameCount];
 	// Camera用データ
-	Camera3DForGPU* cameraData_ = nullptr;
+	Camera3DForGPU* cameraData_[FrameConst::FrameCount]{};
 
 	// CameraInv用リソース
-	ComPtr<ID3D12Resource> cameraInvResource_ = nullptr;
+	ComPtr<ID3D12Resource> cameraInvResource_[FrameConst::FrameCount];
 	// CameraInv用データ
-	Camera3DInverseForGPU* cameraInvData_ = nullptr;
+	Camera3DInverseForGPU* cameraInvData_[FrameConst::FrameCount]{};
 
 	// CameraFrustum用リソース
-	ComPtr<ID3D12Resource> frustumResource_ = nullptr;
+	ComPtr<ID3D12Resource> frustumResource_[FrameConst::FrameCount];
 	// CameraFrustum用データ
-	Camera3DFrustumForGPU* frustumData_ = nullptr;
+	Camera3DFrustumForGPU* frustumData_[FrameConst::FrameCount]{};
 };
\ No newline at end of file
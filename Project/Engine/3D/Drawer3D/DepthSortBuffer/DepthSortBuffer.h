@@ -0,0 +1,53 @@
+#pragma once
+
+// C++
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+// MyHedder
+#include "RadixSort/RadixSort.h"
+
+/// <summary>
+/// 奥から順に描くインスタンスを貯めておくバッファ
+/// 積んだときはCPU側に置いておき、Flushで深度の大きい順にリソースへ書き込む
+/// </summary>
+template<typename InstanceData, typename MaterialData>
+class DepthSortBuffer {
+public:
+	// インスタンスを積む(depthはカメラから見た深度)
+	void Add(const InstanceData& instance, const MaterialData& material, float depth) {
+		instances_.push_back(instance);
+		materials_.push_back(material);
+		depths_.push_back(depth);
+	}
+
+	// 奥から順に書き込んで書き込んだ数を返す(積んだ分は捨てる)
+	uint32_t Flush(InstanceData* instanceDestination, MaterialData* materialDestination, uint32_t maxCount) {
+		RadixSort::SortBackToFront(depths_, entries_, scratch_);
+		const uint32_t count = (std::min)(static_cast<uint32_t>(entries_.size()), maxCount);
+		// 書き込み先はCPUから読まないので、前から順に書くだけにする
+		for (uint32_t i = 0; i < count; ++i) {
+			instanceDestination[i] = instances_[entries_[i].index];
+			materialDestination[i] = materials_[entries_[i].index];
+		}
+		instances_.clear();
+		materials_.clear();
+		depths_.clear();
+		return count;
+	}
+
+	// 積んだ数
+	uint32_t GetCount()const {
+		return static_cast<uint32_t>(instances_.size());
+	}
+
+private:
+	std::vector<InstanceData> instances_;
+	std::vector<MaterialData> materials_;
+	// カメラから見た深度
+	std::vector<float> depths_;
+	// 並べ替えた順番と作業領域(毎フレーム確保し直さないように持っておく)
+	std::vector<RadixSort::DepthEntry> entries_;
+	std::vector<RadixSort::DepthEntry> scratch_;
+};
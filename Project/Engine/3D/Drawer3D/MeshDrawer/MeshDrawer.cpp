@@ -9,13 +9,17 @@
 #include "Framework/MAGI.h"
 #include "Logger/Logger.h"
 #include "MAGIUitility/MAGIUtility.h"
+#include "ImportCache/ImportCache.h"
+#include "ImportCache/BinaryStream.h"
+#include "Const/ImportCacheConst.h"
+#include "VertexQuantizer/VertexQuantizer.h"
 using namespace MAGIMath;
 using namespace MAGIUtility;
 
 // ─────────────────────────────────────────────
 MeshDrawer::MeshDrawer(const MeshData& meshData) {
 	/*=== 頂点 / インデックス ===================================================*/
-	vertexCount_ = static_cast<uint32_t>(meshData.vertices.size());
+	vertexCount_ = static_cast<uint32_t>(meshData.quantizedVertices.size());
 	const std::string vertexCount = std::to_string(vertexCount_);
 	indexCount_ = static_cast<uint32_t>(meshData.indices.size());
 	assert(vertexCount_ && indexCount_);
@@ -24,220 +28,116 @@ MeshDrawer::MeshDrawer(const MeshData& meshData) {
 	//Meshlet
 	//=========================================================================
 
-	// 
-	// モデルのデータ
-	// 
-
-	// インデックス配列
-	std::vector<uint32_t> indices;
-	// 頂点座標配列
-	std::vector<DirectX::XMFLOAT3> positions;
-
-	// 
-	// モデルデータからメシュレット用のデータを作成
-	// 
-
-	// インデックスをコピー
-	indices.resize(indexCount_);
-	for (uint32_t i = 0; i < indexCount_; i++) {
-		indices[i] = meshData.indices[i];
-	}
-
-	// 頂点データからポジションを取得
-	positions.resize(vertexCount_);
+	// 量子化した頂点からポジションを取得(GPUで復元する座標と揃える)
+	std::vector<DirectX::XMFLOAT3> positions(vertexCount_);
 	for (uint32_t i = 0; i < vertexCount_; i++) {
-		positions[i] = DirectX::XMFLOAT3(
-			meshData.vertices[i].position.x,
-			meshData.vertices[i].position.y,
-			meshData.vertices[i].position.z
-		);
+		const Vector3 position = VertexQuantizer::DecodePosition(meshData.quantizedVertices[i], meshData.quantization);
+		positions[i] = DirectX::XMFLOAT3(position.x, position.y, position.z);
 	}
 
-	// 
-	// 出力用データ
-	// 
-
-	// メシュレット
-	std::vector<DirectX::Meshlet> meshlets;
-	// ユニーク頂点インデックス
-	std::vector<uint8_t> uniqueVertexIB;
-	// 
-	std::vector<DirectX::MeshletTriangle> primitiveIndices;
-
-	// Meshlet計算
-	HRESULT hr = DirectX::ComputeMeshlets(
-		indices.data(), indices.size() / 3,
-		positions.data(), positions.size(),
-		nullptr,
-		meshlets,
-		uniqueVertexIB,
-		primitiveIndices
-	);
-	assert(SUCCEEDED(hr));
-
-	// メシュレットのサイズを取得
-	meshletCount_ = static_cast<uint32_t>(meshlets.size());
-
-	// メシュレットごとのバウンディングスフィア作成
-	cullData_.resize(meshlets.size());
-
-	hr = DirectX::ComputeCullData(positions.data(), positions.size(),
-		meshlets.data(), meshlets.size(),
-		reinterpret_cast<const uint32_t*>(uniqueVertexIB.data()),
-		uniqueVertexIB.size() / sizeof(uint32_t),
-		primitiveIndices.data(), primitiveIndices.size(),
-		cullData_.data());
-
-	assert(SUCCEEDED(hr));
+	// LODごとにメシュレットを作成
+	lods_.push_back(CreateMeshletLOD(meshData.indices, positions));
+	for (const auto& lod : meshData.lods) {
+		lods_.push_back(CreateMeshletLOD(lod.indices, positions));
+	}
 
 	//=========================================================================
 	//リソースの作成
 	//=========================================================================
 
-	// 頂点編
-	vertexBuffer_ = MAGISYSTEM::CreateBufferResource(sizeof(VertexData3D) * vertexCount_);
+	// 頂点編(量子化した頂点を置く)
+	quantization_ = meshData.quantization;
+	// StructuredBufferは切り出した位置を要素の番号で指定するので要素の大きさに揃える
+	vertexBuffer_ = MAGISYSTEM::UploadStaticBuffer(meshData.quantizedVertices.data(), sizeof(QuantizedVertexData3D) * vertexCount_, sizeof(QuantizedVertexData3D));
 	vertexSrvIdx_ = MAGISYSTEM::SrvUavAllocate();
-	MAGISYSTEM::CreateSrvStructuredBuffer(vertexSrvIdx_, vertexBuffer_.Get(), vertexCount_, sizeof(VertexData3D));
-
-	// 頂点データをコピー
-	{
-		void* mappedPtr = nullptr;
-		vertexBuffer_->Map(0, nullptr, &mappedPtr);
-		std::memcpy(mappedPtr, meshData.vertices.data(), sizeof(VertexData3D) * vertexCount_);
-		vertexBuffer_->Unmap(0, nullptr);
-	}
-
-
-	// メシュレット編
-	meshletBuffer_ = MAGISYSTEM::CreateBufferResource(sizeof(DirectX::Meshlet) * static_cast<uint32_t>(meshlets.size()));
-	meshletSrvIdx_ = MAGISYSTEM::SrvUavAllocate();
-	MAGISYSTEM::CreateSrvStructuredBuffer(
-		meshletSrvIdx_,
-		meshletBuffer_.Get(),
-		static_cast<uint32_t>(meshlets.size()),
-		sizeof(DirectX::Meshlet)
-	);
-
-	// バッファにデータ転送
-	{
-		void* mappedPtr = nullptr;
-		meshletBuffer_->Map(0, nullptr, &mappedPtr);
-		std::memcpy(mappedPtr, meshlets.data(), sizeof(DirectX::Meshlet) * meshlets.size());
-		meshletBuffer_->Unmap(0, nullptr);
-	}
-
-	// ユニーク頂点インデックス編
-	meshletUniqueVertIB_ = MAGISYSTEM::CreateBufferResource(static_cast<uint32_t>(uniqueVertexIB.size()));
-	uniqueVertSrvIdx_ = MAGISYSTEM::SrvUavAllocate();
-	MAGISYSTEM::CreateSrvByteAddressBuffer(
-		uniqueVertSrvIdx_,
-		meshletUniqueVertIB_.Get(),
-		static_cast<uint32_t>(uniqueVertexIB.size())
-	);
-
-	// バッファにデータ転送
-	{
-		void* mappedPtr = nullptr;
-		meshletUniqueVertIB_->Map(0, nullptr, &mappedPtr);
-		std::memcpy(mappedPtr, uniqueVertexIB.data(), uniqueVertexIB.size());
-		meshletUniqueVertIB_->Unmap(0, nullptr);
-	}
-
-	// PrimitiveIndices編
-	meshletPrimIB_ = MAGISYSTEM::CreateBufferResource(sizeof(DirectX::MeshletTriangle) * static_cast<uint32_t>(primitiveIndices.size()));
-	primSrvIdx_ = MAGISYSTEM::SrvUavAllocate();
-	MAGISYSTEM::CreateSrvStructuredBuffer(
-		primSrvIdx_,
-		meshletPrimIB_.Get(),
-		static_cast<uint32_t>(primitiveIndices.size()),
-		sizeof(DirectX::MeshletTriangle)
-	);
-
-	// バッファにデータ転送
-	{
-		void* mappedPtr = nullptr;
-		meshletPrimIB_->Map(0, nullptr, &mappedPtr);
-		std::memcpy(mappedPtr, primitiveIndices.data(), sizeof(DirectX::MeshletTriangle) * primitiveIndices.size());
-		meshletPrimIB_->Unmap(0, nullptr);
-	}
-
-	// バウンディングスフィア
-	cullDataBuffer_ = MAGISYSTEM::CreateBufferResource(
-		sizeof(DirectX::CullData) * cullData_.size());
-	cullDataSrvIndex_ = MAGISYSTEM::SrvUavAllocate();
-	MAGISYSTEM::CreateSrvStructuredBuffer(
-		cullDataSrvIndex_, cullDataBuffer_.Get(),
-		static_cast<uint32_t>(cullData_.size()),
-		sizeof(DirectX::CullData)
-	);
-
-	{
-		void* p = nullptr;
-		cullDataBuffer_->Map(0, nullptr, &p);
-		std::memcpy(p, cullData_.data(), sizeof(DirectX::CullData) * cullData_.size());
-		cullDataBuffer_->Unmap(0, nullptr);
-	}
+	MAGISYSTEM::CreateSrvStructuredBuffer(vertexSrvIdx_, vertexBuffer_.resource, vertexCount_, sizeof(QuantizedVertexData3D), vertexBuffer_.allocation.offset / sizeof(QuantizedVertexData3D));
 
 	/*=== マテリアル ===========================================================*/
-	materialBuffer_ = MAGISYSTEM::CreateBufferResource(sizeof(ModelMaterialDataForGPU));
-	materialBuffer_->Map(0, nullptr, reinterpret_cast<void**>(&material_));
+	// 定数バッファは先頭も大きさも256バイトに揃える
+	const uint64_t materialBufferSize = DivRoundUp(sizeof(ModelMaterialDataForGPU), D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT) * D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT;
+	materialBuffer_ = MAGISYSTEM::AllocateUploadBuffer(materialBufferSize, D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT);
+	material_ = reinterpret_cast<ModelMaterialDataForGPU*>(materialBuffer_.mappedData);
 	*material_ = {
 		.textureIndex = MAGISYSTEM::GetTextureIndex(meshData.material.textureFilePath),
 		.baseColor = meshData.material.color,
 		.uvMatrix = MAGIMath::MakeIdentityMatrix4x4(),
 	};
-	materialBuffer_->Unmap(0, nullptr);
 
 }
 
-MeshDrawer::~MeshDrawer() = default;
+MeshDrawer::~MeshDrawer() {
+	// SRVの場所と切り出したバッファを返す
+	MAGISYSTEM::SrvUavFree(vertexSrvIdx_);
+	MAGISYSTEM::FreeStaticBuffer(vertexBuffer_);
+	MAGISYSTEM::FreeUploadBuffer(materialBuffer_);
+	for (const MeshletLOD& lod : lods_) {
+		MAGISYSTEM::SrvUavFree(lod.meshletSrvIdx);
+		MAGISYSTEM::SrvUavFree(lod.uniqueVertSrvIdx);
+		MAGISYSTEM::SrvUavFree(lod.primSrvIdx);
+		MAGISYSTEM::SrvUavFree(lod.cullDataSrvIndex);
+		MAGISYSTEM::FreeStaticBuffer(lod.meshletBuffer);
+		MAGISYSTEM::FreeStaticBuffer(lod.meshletUniqueVertIB);
+		MAGISYSTEM::FreeStaticBuffer(lod.meshletPrimIB);
+		MAGISYSTEM::FreeStaticBuffer(lod.cullDataBuffer);
+	}
+}
 void MeshDrawer::Update() {
 	DrawBoundingSphere();
 }
 
 // -----------------------------------------------------------------------------
-void MeshDrawer::Draw(uint32_t instanceCount) {
+void MeshDrawer::Draw(uint32_t instanceCount, uint32_t lod, uint32_t baseInstance) {
 	if (!instanceCount) return;
+	assert(lod < lods_.size());
+	const MeshletLOD& meshlet = lods_[lod];
 
 	auto* cmd = MAGISYSTEM::GetDirectXCommandList6();
 
-	cmd->SetGraphicsRootConstantBufferView(2, materialBuffer_->GetGPUVirtualAddress());
+	cmd->SetGraphicsRootConstantBufferView(2, materialBuffer_.gpuAddress);
 	cmd->SetGraphicsRootDescriptorTable(4, MAGISYSTEM::GetSrvUavDescriptorHandleGPU(vertexSrvIdx_));
-	cmd->SetGraphicsRootDescriptorTable(5, MAGISYSTEM::GetSrvUavDescriptorHandleGPU(meshletSrvIdx_));
-	cmd->SetGraphicsRootShaderResourceView(6, meshletUniqueVertIB_->GetGPUVirtualAddress());
-	cmd->SetGraphicsRootDescriptorTable(7, MAGISYSTEM::GetSrvUavDescriptorHandleGPU(primSrvIdx_));
-	cmd->SetGraphicsRootDescriptorTable(8, MAGISYSTEM::GetSrvUavDescriptorHandleGPU(cullDataSrvIndex_));
+	cmd->SetGraphicsRootDescriptorTable(5, MAGISYSTEM::GetSrvUavDescriptorHandleGPU(meshlet.meshletSrvIdx));
+	cmd->SetGraphicsRootShaderResourceView(6, meshlet.meshletUniqueVertIB.gpuAddress);
+	cmd->SetGraphicsRootDescriptorTable(7, MAGISYSTEM::GetSrvUavDescriptorHandleGPU(meshlet.primSrvIdx));
+	cmd->SetGraphicsRootDescriptorTable(8, MAGISYSTEM::GetSrvUavDescriptorHandleGPU(meshlet.cullDataSrvIndex));
 	MeshInfo info = {
 		.indexSize = 4,
-		.meshletCount = meshletCount_,
+		.meshletCount = meshlet.meshletCount,
+		.baseInstance = baseInstance,
+		.positionMin = quantization_.positionMin,
+		.positionScale = quantization_.positionScale,
 	};
-	cmd->SetGraphicsRoot32BitConstants(9, 2, &info, 0);
+	cmd->SetGraphicsRoot32BitConstants(9, sizeof(MeshInfo) / sizeof(uint32_t), &info, 0);
 
-	cmd->DispatchMesh(DivRoundUp(meshletCount_, AS_GROUP_SIZE), instanceCount, 1);
+	cmd->DispatchMesh(DivRoundUp(meshlet.meshletCount, AS_GROUP_SIZE), instanceCount, 1);
 }
 
-void MeshDrawer::DrawShadow(uint32_t instanceCount) {
+void MeshDrawer::DrawShadow(uint32_t instanceCount, uint32_t lod, uint32_t baseInstance) {
 	if (!instanceCount) return;
+	assert(lod < lods_.size());
+	const MeshletLOD& meshlet = lods_[lod];
 
 	auto* cmd = MAGISYSTEM::GetDirectXCommandList6();
 
 	cmd->SetGraphicsRootDescriptorTable(2, MAGISYSTEM::GetSrvUavDescriptorHandleGPU(vertexSrvIdx_));
-	cmd->SetGraphicsRootDescriptorTable(3, MAGISYSTEM::GetSrvUavDescriptorHandleGPU(meshletSrvIdx_));
-	cmd->SetGraphicsRootShaderResourceView(4, meshletUniqueVertIB_->GetGPUVirtualAddress());
-	cmd->SetGraphicsRootDescriptorTable(5, MAGISYSTEM::GetSrvUavDescriptorHandleGPU(primSrvIdx_));
-	cmd->SetGraphicsRootDescriptorTable(6, MAGISYSTEM::GetSrvUavDescriptorHandleGPU(cullDataSrvIndex_));
+	cmd->SetGraphicsRootDescriptorTable(3, MAGISYSTEM::GetSrvUavDescriptorHandleGPU(meshlet.meshletSrvIdx));
+	cmd->SetGraphicsRootShaderResourceView(4, meshlet.meshletUniqueVertIB.gpuAddress);
+	cmd->SetGraphicsRootDescriptorTable(5, MAGISYSTEM::GetSrvUavDescriptorHandleGPU(meshlet.primSrvIdx));
+	cmd->SetGraphicsRootDescriptorTable(6, MAGISYSTEM::GetSrvUavDescriptorHandleGPU(meshlet.cullDataSrvIndex));
 
 	MeshInfo info = {
 		.indexSize = 4,
-		.meshletCount = meshletCount_,
+		.meshletCount = meshlet.meshletCount,
+		.baseInstance = baseInstance,
+		.positionMin = quantization_.positionMin,
+		.positionScale = quantization_.positionScale,
 	};
-	cmd->SetGraphicsRoot32BitConstants(7, 2, &info, 0);
+	cmd->SetGraphicsRoot32BitConstants(7, sizeof(MeshInfo) / sizeof(uint32_t), &info, 0);
 
-	cmd->DispatchMesh(DivRoundUp(meshletCount_, AS_GROUP_SIZE), instanceCount, 1);
+	cmd->DispatchMesh(DivRoundUp(meshlet.meshletCount, AS_GROUP_SIZE), instanceCount, 1);
 }
 
 void MeshDrawer::DrawBoundingSphere() {
-	for (const auto& cd : cullData_) {
+	for (const auto& cd : lods_[0].cullData) {
 		const DirectX::XMFLOAT3 bs = cd.BoundingSphere.Center;
 		const Vector3 center = { bs.x, bs.y, bs.z };
 		const float   radius = cd.BoundingSphere.Radius;
@@ -250,3 +150,122 @@ void MeshDrawer::DrawBoundingSphere() {
 		//MAGISYSTEM::DrawSphere3D(world, sphere, PrimitiveMaterialData3D{});
 	}
 }
+
+uint32_t MeshDrawer::GetLODCount() const {
+	return static_cast<uint32_t>(lods_.size());
+}
+
+MeshDrawer::MeshletLOD MeshDrawer::CreateMeshletLOD(const std::vector<uint32_t>& indices, const std::vector<DirectX::XMFLOAT3>& positions) {
+	MeshletLOD result{};
+
+	// 
+	// 出力用データ
+	// 
+
+	// メシュレット
+	std::vector<DirectX::Meshlet> meshlets;
+	// ユニーク頂点インデックス
+	std::vector<uint8_t> uniqueVertexIB;
+	// 
+	std::vector<DirectX::MeshletTriangle> primitiveIndices;
+
+	// 座標とインデックスからキャッシュのキーを作る
+	BinaryWriter source;
+	source.WriteVector(positions);
+	source.WriteVector(indices);
+	const std::string cacheKey = ImportCache::MakeKey(source.GetData(), "Meshlet", ImportCacheConst::MeshletVersion, 0);
+
+	// 生成済みのメシュレットがあればそれを使う
+	bool isCached = false;
+	{
+		std::vector<uint8_t> cacheData;
+		if (MAGISYSTEM::LoadImportCache(cacheKey, cacheData)) {
+			BinaryReader reader(cacheData);
+			isCached =
+				reader.ReadVector(meshlets) &&
+				reader.ReadVector(uniqueVertexIB) &&
+				reader.ReadVector(primitiveIndices) &&
+				reader.ReadVector(result.cullData);
+		}
+	}
+
+	if (!isCached) {
+		// Meshlet計算
+		HRESULT hr = DirectX::ComputeMeshlets(
+			indices.data(), indices.size() / 3,
+			positions.data(), positions.size(),
+			nullptr,
+			meshlets,
+			uniqueVertexIB,
+			primitiveIndices
+		);
+		assert(SUCCEEDED(hr));
+
+		// メシュレットごとのバウンディングスフィア作成
+		result.cullData.resize(meshlets.size());
+
+		hr = DirectX::ComputeCullData(positions.data(), positions.size(),
+			meshlets.data(), meshlets.size(),
+			reinterpret_cast<const uint32_t*>(uniqueVertexIB.data()),
+			uniqueVertexIB.size() / sizeof(uint32_t),
+			primitiveIndices.data(), primitiveIndices.size(),
+			result.cullData.data());
+
+		assert(SUCCEEDED(hr));
+
+		// キャッシュに保存
+		BinaryWriter writer;
+		writer.WriteVector(meshlets);
+		writer.WriteVector(uniqueVertexIB);
+		writer.WriteVector(primitiveIndices);
+		writer.WriteVector(result.cullData);
+		MAGISYSTEM::StoreImportCache(cacheKey, writer.GetData());
+	}
+
+	// メシュレットのサイズを取得
+	result.meshletCount = static_cast<uint32_t>(meshlets.size());
+
+	// メシュレット編
+	result.meshletBuffer = MAGISYSTEM::UploadStaticBuffer(meshlets.data(), sizeof(DirectX::Meshlet) * meshlets.size(), sizeof(DirectX::Meshlet));
+	result.meshletSrvIdx = MAGISYSTEM::SrvUavAllocate();
+	MAGISYSTEM::CreateSrvStructuredBuffer(
+		result.meshletSrvIdx,
+		result.meshletBuffer.resource,
+		static_cast<uint32_t>(meshlets.size()),
+		sizeof(DirectX::Meshlet),
+		result.meshletBuffer.allocation.offset / sizeof(DirectX::Meshlet)
+	);
+
+	// ユニーク頂点インデックス編(ルートSRVでも読むので4バイトに揃える)
+	result.meshletUniqueVertIB = MAGISYSTEM::UploadStaticBuffer(uniqueVertexIB.data(), uniqueVertexIB.size(), sizeof(uint32_t));
+	result.uniqueVertSrvIdx = MAGISYSTEM::SrvUavAllocate();
+	MAGISYSTEM::CreateSrvByteAddressBuffer(
+		result.uniqueVertSrvIdx,
+		result.meshletUniqueVertIB.resource,
+		static_cast<uint32_t>(uniqueVertexIB.size()),
+		result.meshletUniqueVertIB.allocation.offset
+	);
+
+	// PrimitiveIndices編
+	result.meshletPrimIB = MAGISYSTEM::UploadStaticBuffer(primitiveIndices.data(), sizeof(DirectX::MeshletTriangle) * primitiveIndices.size(), sizeof(DirectX::MeshletTriangle));
+	result.primSrvIdx = MAGISYSTEM::SrvUavAllocate();
+	MAGISYSTEM::CreateSrvStructuredBuffer(
+		result.primSrvIdx,
+		result.meshletPrimIB.resource,
+		static_cast<uint32_t>(primitiveIndices.size()),
+		sizeof(DirectX::MeshletTriangle),
+		result.meshletPrimIB.allocation.offset / sizeof(DirectX::MeshletTriangle)
+	);
+
+	// バウンディングスフィア
+	result.cullDataBuffer = MAGISYSTEM::UploadStaticBuffer(result.cullData.data(), sizeof(DirectX::CullData) * result.cullData.size(), sizeof(DirectX::CullData));
+	result.cullDataSrvIndex = MAGISYSTEM::SrvUavAllocate();
+	MAGISYSTEM::CreateSrvStructuredBuffer(
+		result.cullDataSrvIndex, result.cullDataBuffer.resource,
+		static_cast<uint32_t>(result.cullData.size()),
+		sizeof(DirectX::CullData),
+		result.cullDataBuffer.allocation.offset / sizeof(DirectX::CullData)
+	);
+
+	return result;
+}
\ No newline at end of file
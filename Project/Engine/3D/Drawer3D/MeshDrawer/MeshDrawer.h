@@ -7,6 +7,7 @@
 
 // MAGI
 #include "DirectX/ComPtr/ComPtr.h"
+#include "Structs/BufferStruct.h"
 #include "Structs/ModelStruct.h"
 #include "Structs/Primitive3DStruct.h"
 
@@ -17,39 +18,54 @@ public:
 	~MeshDrawer();
 
 	void Update();
-	void Draw(uint32_t instanceCount);
-	void DrawShadow(uint32_t instanceCount);
+	void Draw(uint32_t instanceCount, uint32_t lod, uint32_t baseInstance);
+	void DrawShadow(uint32_t instanceCount, uint32_t lod, uint32_t baseInstance);
 
 	void DrawBoundingSphere();
 
+	// LODの数を取得
+	uint32_t GetLODCount()const;
+
+private:
+	/// <summary>
+	/// LODひとつ分のメシュレット
+	/// </summary>
+	struct MeshletLOD {
+		BufferRegion meshletBuffer;                        // StructuredBuffer<Meshlet>
+		uint32_t meshletCount = 0;
+		uint32_t meshletSrvIdx = 0;
+
+		BufferRegion meshletUniqueVertIB;                  // ByteAddressBuffer
+		uint32_t uniqueVertSrvIdx = 0;
+
+		BufferRegion meshletPrimIB;                        // StructuredBuffer<MeshletTriangle>
+		uint32_t primSrvIdx = 0;
+
+		// メシュレットごとのバウンディングスフィアデータ
+		BufferRegion cullDataBuffer;
+		// メシュレットごとのバウンディングスフィア
+		std::vector<DirectX::CullData> cullData;
+		uint32_t cullDataSrvIndex = 0;
+	};
+
+	// インデックスからメシュレットを作成
+	MeshletLOD CreateMeshletLOD(const std::vector<uint32_t>& indices, const std::vector<DirectX::XMFLOAT3>& positions);
+
 private:
-	// 頂点
-	ComPtr<ID3D12Resource> vertexBuffer_;
-	VertexData3D* vertexData_ = nullptr;
+	// 頂点(形状のバッファは一度だけデフォルトヒープへ転送する)
+	BufferRegion vertexBuffer_;
 	uint32_t vertexCount_ = 0;
 	uint32_t vertexSrvIdx_ = 0;
+	// 量子化した座標の復元パラメータ
+	VertexQuantization quantization_{};
 
 	// インデックスの数
 	uint32_t indexCount_ = 0;
 
-	// メッシュ分割
-	ComPtr<ID3D12Resource> meshletBuffer_;              // StructuredBuffer<Meshlet>
-	uint32_t meshletCount_ = 0;
-	uint32_t meshletSrvIdx_ = 0;
-
-	ComPtr<ID3D12Resource> meshletUniqueVertIB_;        // ByteAddressBuffer
-	uint32_t uniqueVertSrvIdx_ = 0;
-
-	ComPtr<ID3D12Resource> meshletPrimIB_;              // StructuredBuffer<MeshletTriangle>
-	uint32_t primSrvIdx_ = 0;
-
-	// メシュレットごとのバウンディングスフィアデータ
-	ComPtr<ID3D12Resource> cullDataBuffer_;
-	// メシュレットごとのバウンディングスフィア
-	std::vector<DirectX::CullData> cullData_;
-	uint32_t cullDataSrvIndex_ = 0;
+	// メッシュ分割(LOD0が元メッシュ、全LODで頂点を共有)
+	std::vector<MeshletLOD> lods_;
 
-	// マテリアル
-	ComPtr<ID3D12Resource> materialBuffer_;
+	// マテリアル(共有のアップロードバッファから切り出す)
+	BufferRegion materialBuffer_;
 	ModelMaterialDataForGPU* material_ = nullptr;
-};
+};
\ No newline at end of file
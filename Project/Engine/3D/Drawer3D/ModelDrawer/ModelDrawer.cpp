@@ -2,15 +2,27 @@
 
 // C++
 #include <cassert>
+#include <cstring>
+#include <algorithm>
 
 // MyHedder
-#include "Logger/Logger.h"
 #include "Framework/MAGI.h"
 #include "Math/Utility/MathUtility.h"
 
 using namespace MAGIMath;
 
-ModelDrawer::ModelDrawer(const ModelData& modelData) {
+ModelDrawer::ModelDrawer(const ModelData& modelData, RenderQueue* renderQueue, uint32_t materialKey) {
+	assert(renderQueue);
+	renderQueue_ = renderQueue;
+	materialKey_ = materialKey;
+
+	localAABB_ = modelData.localAABB;
+	lodErrors_ = modelData.lodErrors;
+	if (lodErrors_.empty()) {
+		lodErrors_.assign(1, 0.0f);
+	}
+	assert(lodErrors_.size() <= ModelLODConst::MaxLODCount);
+
 	// モデルのメッシュの数を取得
 	const uint32_t meshSize = static_cast<uint32_t>(modelData.meshes.size());
 
@@ -18,34 +30,18 @@ ModelDrawer::ModelDrawer(const ModelData& modelData) {
 	for (uint32_t i = 0; i < meshSize; i++) {
 		std::unique_ptr<MeshDrawer> newMesh = std::make_unique<MeshDrawer>(modelData.meshes[i]);
 		meshes_.push_back(std::move(newMesh));
-	}
-
-	// 描画用のリソースを準備
-	for (uint32_t i = 0; i < kBlendModeNum; i++) {
-		instancingResource_[i] = MAGISYSTEM::CreateBufferResource(sizeof(ModelDataForGPU) * kNumMaxInstance);
-		instancingSrvIndex_[i] = MAGISYSTEM::SrvUavAllocate();
-		MAGISYSTEM::CreateSrvStructuredBuffer(instancingSrvIndex_[i], instancingResource_[i].Get(), kNumMaxInstance, sizeof(ModelDataForGPU));
-		instancingResource_[i]->Map(0, nullptr, reinterpret_cast<void**>(&instancingData_[i]));
 
-		currentIndex_[i] = 0;
-		instanceCount_[i] = 0;
+		// マテリアルが使うテクスチャを覚えておく
+		const std::string& textureFilePath = modelData.meshes[i].material.textureFilePath;
+		if (std::find(textureFilePaths_.begin(), textureFilePaths_.end(), textureFilePath) == textureFilePaths_.end()) {
+			textureFilePaths_.push_back(textureFilePath);
+		}
 	}
-
-}
-
-ModelDrawer::~ModelDrawer() {
-
 }
 
-void ModelDrawer::AddDrawCommand(const Matrix4x4& worldMatrix, const ModelMaterial& material) {
+void ModelDrawer::AddDrawCommand(const Matrix4x4& worldMatrix, const ModelMaterial& material, uint32_t lod, float depth) {
 	const uint32_t blendIndex = static_cast<uint32_t>(material.blendMode);
-
-#if defined(DEBUG) || defined(DEVELOP)
-	if (currentIndex_[blendIndex] >= kNumMaxInstance) {
-		Logger::Log("ModelDrawer3D: Max instance count exceeded!\n");
-		return;
-	}
-#endif // _DEBUG
+	assert(lod < lodErrors_.size());
 
 	ModelDataForGPU newModelData{
 		.worldMatrix = worldMatrix,
@@ -55,16 +51,92 @@ void ModelDrawer::AddDrawCommand(const Matrix4x4& worldMatrix, const ModelMateri
 	};
 
 	// コンテナに挿入
-	instancingData_[blendIndex][currentIndex_[blendIndex]] = newModelData;
-	// インデックスをインクリメント
-	currentIndex_[blendIndex]++;
+	drawCommands_[blendIndex][lod].push_back(newModelData);
+	if (IsDepthSortedBlendMode(material.blendMode)) {
+		drawCommandDepths_[blendIndex].push_back(depth);
+		sortedCommands_[blendIndex].push_back(SortedCommand{ .lod = lod, .index = static_cast<uint32_t>(drawCommands_[blendIndex][lod].size() - 1) });
+	}
+}
+
+void ModelDrawer::AddShadowCommand(const Matrix4x4& worldMatrix, const ModelMaterial& material, uint32_t lod) {
+	assert(lod < lodErrors_.size());
+
+	shadowCommands_[lod].push_back(ModelDataForGPU{
+		.worldMatrix = worldMatrix,
+		.WorldInverseTransepose = MakeInverseTransposeMatrix(worldMatrix),
+		.color = material.color,
+		.isMakeShadow = material.isMakeShadow,
+		});
 }
 
 void ModelDrawer::Update() {
+	// LODごとに積んだインスタンスをこのフレームの領域へ詰める
 	for (uint32_t i = 0; i < kBlendModeNum; i++) {
-		assert(currentIndex_[i] <= kNumMaxInstance);
-		instanceCount_[i] = currentIndex_[i];
-		currentIndex_[i] = 0;
+		drawRanges_[i].clear();
+		const bool isDepthSorted = IsDepthSortedBlendMode(static_cast<BlendMode>(i));
+		uint32_t instanceCount = 0;
+		if (isDepthSorted) {
+			instanceCount = static_cast<uint32_t>(sortedCommands_[i].size());
+		} else {
+			for (uint32_t lod = 0; lod < ModelLODConst::MaxLODCount; lod++) {
+				instanceCount += static_cast<uint32_t>(drawCommands_[i][lod].size());
+			}
+		}
+		// インスタンスがあるブレンドモードだけ描画キューに積む
+		if (instanceCount == 0) {
+			continue;
+		}
+
+		ModelDataForGPU* destination = AllocateInstances(instanceCount, instancingSrvIndex_[i]);
+		if (isDepthSorted) {
+			// LODをまたいで奥から順に並べ、LODが変わるところで描画を分ける
+			RadixSort::SortBackToFront(drawCommandDepths_[i], sortEntries_, sortScratch_);
+			for (uint32_t offset = 0; offset < instanceCount; offset++) {
+				const SortedCommand& command = sortedCommands_[i][sortEntries_[offset].index];
+				destination[offset] = drawCommands_[i][command.lod][command.index];
+				if (drawRanges_[i].empty() || drawRanges_[i].back().lod != command.lod) {
+					drawRanges_[i].push_back(InstanceRange{ .lod = command.lod, .baseInstance = offset });
+				}
+				drawRanges_[i].back().instanceCount++;
+			}
+			drawCommandDepths_[i].clear();
+			sortedCommands_[i].clear();
+		} else {
+			// LODごとにまとめて描く
+			uint32_t offset = 0;
+			for (uint32_t lod = 0; lod < ModelLODConst::MaxLODCount; lod++) {
+				const uint32_t count = static_cast<uint32_t>(drawCommands_[i][lod].size());
+				if (count == 0) continue;
+				std::memcpy(destination + offset, drawCommands_[i][lod].data(), sizeof(ModelDataForGPU) * count);
+				drawRanges_[i].push_back(InstanceRange{ .lod = lod, .baseInstance = offset, .instanceCount = count });
+				offset += count;
+			}
+		}
+		for (uint32_t lod = 0; lod < ModelLODConst::MaxLODCount; lod++) {
+			drawCommands_[i][lod].clear();
+		}
+
+		const BlendMode mode = static_cast<BlendMode>(i);
+		const RenderPass pass = mode == BlendMode::None ? RenderPass::GBuffer : RenderPass::Transparent;
+		renderQueue_->Submit(this, pass, mode, static_cast<uint32_t>(GraphicsPipelineStateType::Model3D), materialKey_);
+	}
+
+	uint32_t shadowInstanceCount = 0;
+	for (uint32_t lod = 0; lod < ModelLODConst::MaxLODCount; lod++) {
+		shadowInstanceCount += static_cast<uint32_t>(shadowCommands_[lod].size());
+	}
+	if (shadowInstanceCount > 0) {
+		ModelDataForGPU* destination = AllocateInstances(shadowInstanceCount, shadowInstancingSrvIndex_);
+		uint32_t shadowOffset = 0;
+		for (uint32_t lod = 0; lod < ModelLODConst::MaxLODCount; lod++) {
+			const uint32_t count = static_cast<uint32_t>(shadowCommands_[lod].size());
+			std::memcpy(destination + shadowOffset, shadowCommands_[lod].data(), sizeof(ModelDataForGPU) * count);
+			shadowLodBaseInstance_[lod] = shadowOffset;
+			shadowLodInstanceCount_[lod] = count;
+			shadowOffset += count;
+			shadowCommands_[lod].clear();
+		}
+		renderQueue_->Submit(this, RenderPass::Shadow, BlendMode::None, static_cast<uint32_t>(ShadowPipelineStateType::Model), materialKey_);
 	}
 
 	// 各メッシュの更新
@@ -73,52 +145,101 @@ void ModelDrawer::Update() {
 	}
 }
 
-void ModelDrawer::Draw(BlendMode mode) {
+void ModelDrawer::ExecuteRenderItem(const RenderItem& item, bool isPipelineChanged) {
+	if (RenderQueue::GetPass(item.key) == RenderPass::Shadow) {
+		DrawShadow(isPipelineChanged);
+	} else {
+		Draw(RenderQueue::GetBlendMode(item.key), isPipelineChanged);
+	}
+}
+
+void ModelDrawer::Draw(BlendMode mode, bool isPipelineChanged) {
 	const uint32_t blendIndex = static_cast<uint32_t>(mode);
-	if (instanceCount_[blendIndex] == 0) return;
 	ID3D12GraphicsCommandList6* commandList = MAGISYSTEM::GetDirectXCommandList6();
 
-	// 
-	// パイプラインの設定
-	// 
-	commandList->SetPipelineState(MAGISYSTEM::GetGraphicsPipelineState(GraphicsPipelineStateType::Model3D, mode));
+	// 直前のモデルと同じパイプラインならカメラとテクスチャ一覧も設定済み
+	if (isPipelineChanged) {
+		// 
+		// パイプラインの設定
+		// 
+		commandList->SetGraphicsRootSignature(MAGISYSTEM::GetGraphicsRootSignature(GraphicsPipelineStateType::Model3D));
+		commandList->SetPipelineState(MAGISYSTEM::GetGraphicsPipelineState(GraphicsPipelineStateType::Model3D, mode));
 
-	// カメラの送信
-	MAGISYSTEM::TransferCamera3D(0);
-	MAGISYSTEM::TransferCurrentCamera3DFrustum(10);
+		// カメラの送信
+		MAGISYSTEM::TransferCamera3D(0);
+		MAGISYSTEM::TransferCurrentCamera3DFrustum(10);
+
+		// テクスチャ一覧 (t1000)
+		commandList->SetGraphicsRootDescriptorTable(3, MAGISYSTEM::GetSrvUavDescriptorHandleGPU(0));
+	}
 
 	// inctancing描画用のデータを送信
 	commandList->SetGraphicsRootDescriptorTable(1, MAGISYSTEM::GetSrvUavDescriptorHandleGPU(instancingSrvIndex_[blendIndex]));
 
-	// テクスチャ一覧 (t1000)
-	commandList->SetGraphicsRootDescriptorTable(3, MAGISYSTEM::GetSrvUavDescriptorHandleGPU(0));
-
-	// 各メッシュの描画
-	for (auto& mesh : meshes_) {
-		mesh->Draw(instanceCount_[blendIndex]);
+	// 範囲ごとに各メッシュの描画(奥から順に描くブレンドモードでは奥の範囲から並んでいる)
+	for (const InstanceRange& range : drawRanges_[blendIndex]) {
+		for (auto& mesh : meshes_) {
+			mesh->Draw(range.instanceCount, range.lod, range.baseInstance);
+		}
 	}
 }
 
-void ModelDrawer::DrawShadow(BlendMode mode) {
-	const uint32_t blendIndex = static_cast<uint32_t>(mode);
-	if (instanceCount_[blendIndex] == 0) return;
+void ModelDrawer::DrawShadow(bool isPipelineChanged) {
 	ID3D12GraphicsCommandList6* commandList = MAGISYSTEM::GetDirectXCommandList6();
 
-	// 
-	// パイプラインの設定
-	// 
-	commandList->SetPipelineState(MAGISYSTEM::GetShadowPipelineState(ShadowPipelineStateType::Model));
-
-	// ライトのVPを転送　(b0)
-	MAGISYSTEM::TransferDirectionalLightCamera(0);
-	// ライトカメラのフラスタムを送信
-	MAGISYSTEM::TransferDirectionalLightFrustum(8);
+	// 直前のモデルと同じパイプラインならライトも設定済み
+	if (isPipelineChanged) {
+		// 
+		// パイプラインの設定
+		// 
+		commandList->SetGraphicsRootSignature(MAGISYSTEM::GetShadowRootSignature(ShadowPipelineStateType::Model));
+		commandList->SetPipelineState(MAGISYSTEM::GetShadowPipelineState(ShadowPipelineStateType::Model));
+
+		// ライトのVPを転送　(b0)
+		MAGISYSTEM::TransferDirectionalLightCamera(0);
+		// ライトカメラのフラスタムを送信
+		MAGISYSTEM::TransferDirectionalLightFrustum(8);
+	}
 
 	// inctancing描画用のデータを送信
-	commandList->SetGraphicsRootDescriptorTable(1, MAGISYSTEM::GetSrvUavDescriptorHandleGPU(instancingSrvIndex_[blendIndex]));
+	commandList->SetGraphicsRootDescriptorTable(1, MAGISYSTEM::GetSrvUavDescriptorHandleGPU(shadowInstancingSrvIndex_));
+
+	// LODごとに各メッシュの描画
+	for (uint32_t lod = 0; lod < ModelLODConst::MaxLODCount; lod++) {
+		if (shadowLodInstanceCount_[lod] == 0) continue;
+		for (auto& mesh : meshes_) {
+			mesh->DrawShadow(shadowLodInstanceCount_[lod], lod, shadowLodBaseInstance_[lod]);
+		}
+	}
+}
 
-	// 各メッシュの描画
-	for (auto& mesh : meshes_) {
-		mesh->DrawShadow(instanceCount_[blendIndex]);
+const AABB& ModelDrawer::GetLocalAABB() const {
+	return localAABB_;
+}
+
+const std::vector<float>& ModelDrawer::GetLODErrors() const {
+	return lodErrors_;
+}
+
+const std::vector<std::string>& ModelDrawer::GetTextureFilePaths() const {
+	return textureFilePaths_;
+}
+
+bool ModelDrawer::MarkUsed(uint64_t frame) {
+	if (lastUsedFrame_ == frame) {
+		return false;
 	}
+	lastUsedFrame_ = frame;
+	return true;
+}
+
+ModelDataForGPU* ModelDrawer::AllocateInstances(uint32_t count, uint32_t& srvIndex) {
+	// StructuredBufferは切り出した位置を要素の番号で指定するので要素の大きさに揃える
+	const BufferRegion region = MAGISYSTEM::AllocateUploadBuffer(sizeof(ModelDataForGPU) * count, sizeof(ModelDataForGPU));
+	// SRVはこのフレームの一時用に作る(描画スレッドが読み終えるまで番号は使い回されない)
+	srvIndex = MAGISYSTEM::SrvUavAllocateTransient(1);
+	MAGISYSTEM::CreateSrvStructuredBuffer(srvIndex, region.resource, count, sizeof(ModelDataForGPU), region.allocation.offset / sizeof(ModelDataForGPU));
+	// 解放してもGPUが読み終えるまで領域は使い回されないので、このフレームの書き込みと描画には使える
+	MAGISYSTEM::FreeUploadBuffer(region);
+	return reinterpret_cast<ModelDataForGPU*>(region.mappedData);
 }
@@ -2,44 +2,109 @@
 
 // C++
 #include <memory>
+#include <string>
 
 // DirectX
 #include <d3d12.h>
 
 // MyHedder
-#include "DirectX/ComPtr/ComPtr.h"
 #include "3D/Drawer3D/MeshDrawer/MeshDrawer.h"
+#include "Const/ModelConst.h"
+#include "RenderQueue/RenderQueue.h"
+#include "RadixSort/RadixSort.h"
 
 /// <summary>
 /// モデル描画用クラス
 /// </summary>
-class ModelDrawer {
+class ModelDrawer : public RenderQueueSubmitter {
 public:
-	ModelDrawer(const ModelData& modelData);
-	~ModelDrawer();
+	// materialKeyは描画キューで同じモデルをまとめるための番号
+	ModelDrawer(const ModelData& modelData, RenderQueue* renderQueue, uint32_t materialKey);
+	~ModelDrawer() = default;
 
-	void AddDrawCommand(const Matrix4x4& worldMatrix, const ModelMaterial& material);
+	// depthはカメラから見た深度(奥から順に描くブレンドモードの並べ替えに使う)
+	void AddDrawCommand(const Matrix4x4& worldMatrix, const ModelMaterial& material, uint32_t lod, float depth);
+	// 影を落とすインスタンスを追加
+	void AddShadowCommand(const Matrix4x4& worldMatrix, const ModelMaterial& material, uint32_t lod);
+	// 積んだインスタンスをリソースへ詰めて描画キューに積む
 	void Update();
-	void Draw(BlendMode mode);
-	void DrawShadow(BlendMode mode);
+	// 描画キューから積んだ描画を記録する
+	void ExecuteRenderItem(const RenderItem& item, bool isPipelineChanged) override;
+
+	// モデル空間の境界ボックスを取得
+	[[nodiscard]] const AABB& GetLocalAABB()const;
+	// LODごとの誤差を取得
+	[[nodiscard]] const std::vector<float>& GetLODErrors()const;
+
+	// マテリアルが使うテクスチャ
+	[[nodiscard]] const std::vector<std::string>& GetTextureFilePaths()const;
+	// このフレームで初めて使われたならtrue
+	bool MarkUsed(uint64_t frame);
 
 private:
-	// インスタンスの最大数
-	static const uint32_t kNumMaxInstance = 65536;
+	void Draw(BlendMode mode, bool isPipelineChanged);
+	void DrawShadow(bool isPipelineChanged);
+	// このフレームのインスタンスの領域を共有のアップロードバッファから切り出し、その範囲を見るSRVを作る
+	ModelDataForGPU* AllocateInstances(uint32_t count, uint32_t& srvIndex);
 
+private:
 	// メッシュ
 	std::vector<std::unique_ptr<MeshDrawer>> meshes_;
 
-	// instancing描画用のリソース
-	ComPtr<ID3D12Resource> instancingResource_[static_cast<uint32_t>(BlendMode::Num)];
-	// instancing描画用のデータ
-	ModelDataForGPU* instancingData_[static_cast<uint32_t>(BlendMode::Num)];
-	// instancingSrvIndex
-	uint32_t instancingSrvIndex_[static_cast<uint32_t>(BlendMode::Num)];
+	// instancingSrvIndex(毎フレーム一時用から確保する)
+	uint32_t instancingSrvIndex_[static_cast<uint32_t>(BlendMode::Num)]{};
+
+	/// <summary>
+	/// 同じLODが続くインスタンスの範囲(ひとつの描画になる)
+	/// </summary>
+	struct InstanceRange {
+		uint32_t lod = 0;
+		uint32_t baseInstance = 0;
+		uint32_t instanceCount = 0;
+	};
+
+	/// <summary>
+	/// 奥から順に描くブレンドモードで積んだインスタンスの場所
+	/// </summary>
+	struct SortedCommand {
+		uint32_t lod = 0;
+		uint32_t index = 0;
+	};
+
+	// LODごとに積んだインスタンス(Updateでリソースへ連続して詰める)
+	std::vector<ModelDataForGPU> drawCommands_[static_cast<uint32_t>(BlendMode::Num)][ModelLODConst::MaxLODCount];
+	// 奥から順に描くブレンドモードで積んだインスタンスの深度と場所(LODをまたいで積んだ順)
+	std::vector<float> drawCommandDepths_[static_cast<uint32_t>(BlendMode::Num)];
+	std::vector<SortedCommand> sortedCommands_[static_cast<uint32_t>(BlendMode::Num)];
+	// 深度で並べ替えた順番と作業領域(毎フレーム確保し直さないように持っておく)
+	std::vector<RadixSort::DepthEntry> sortEntries_;
+	std::vector<RadixSort::DepthEntry> sortScratch_;
+	// 描画するインスタンスの範囲(描く順)
+	std::vector<InstanceRange> drawRanges_[static_cast<uint32_t>(BlendMode::Num)];
+
+	// 影描画用のinstancingSrvIndex(ライトの範囲内の不透明なもののみ、毎フレーム一時用から確保する)
+	uint32_t shadowInstancingSrvIndex_ = 0;
+
+	// 影描画用にLODごとに積んだインスタンス
+	std::vector<ModelDataForGPU> shadowCommands_[ModelLODConst::MaxLODCount];
+	// 影描画用のLODごとのインスタンス開始位置
+	uint32_t shadowLodBaseInstance_[ModelLODConst::MaxLODCount]{};
+	// 影描画用のLODごとのインスタンス数
+	uint32_t shadowLodInstanceCount_[ModelLODConst::MaxLODCount]{};
+
+	// LODごとの誤差
+	std::vector<float> lodErrors_;
+
+	// モデル空間の境界ボックス
+	AABB localAABB_{};
 
+	// マテリアルが使うテクスチャ
+	std::vector<std::string> textureFilePaths_;
+	// 最後に使われたフレーム
+	uint64_t lastUsedFrame_ = UINT64_MAX;
 
-	// instance描画の際に使う変数
-	uint32_t instanceCount_[static_cast<uint32_t>(BlendMode::Num)];
-	// 現在のインデックス
-	uint32_t currentIndex_[static_cast<uint32_t>(BlendMode::Num)];
+	// 描画キュー
+	RenderQueue* renderQueue_ = nullptr;
+	// 描画キューのマテリアル
+	uint32_t materialKey_ = 0;
 };
\ No newline at end of file
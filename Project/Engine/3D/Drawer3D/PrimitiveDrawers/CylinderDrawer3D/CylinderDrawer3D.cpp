@@ -10,12 +10,13 @@
 #include "MAGIUitility/MAGIUtility.h"
 
 #include <cassert>
+#include <algorithm>
 
 #include "Framework/MAGI.h"
 
 using namespace MAGIMath;
 
-CylinderDrawer3D::CylinderDrawer3D(DXGI* dxgi, DirectXCommand* directXCommand, SRVUAVManager* srvUavManager, GraphicsPipelineManager* graphicsPipelineManager, ShadowPipelineManager* shadowPipelineManager, Camera3DManager* camera3DManager, LightManager* lightManager) {
+CylinderDrawer3D::CylinderDrawer3D(DXGI* dxgi, DirectXCommand* directXCommand, SRVUAVManager* srvUavManager, GraphicsPipelineManager* graphicsPipelineManager, ShadowPipelineManager* shadowPipelineManager, Camera3DManager* camera3DManager, LightManager* lightManager, RenderQueue* renderQueue) {
 	SetDXGI(dxgi);
 	SetDirectXCommand(directXCommand);
 	SetSRVUAVManager(srvUavManager);
@@ -23,27 +24,37 @@ CylinderDrawer3D::CylinderDrawer3D(DXGI* dxgi, DirectXCommand* directXCommand, S
 	SetShadowPipelineManager(shadowPipelineManager);
 	SetCamera3DManager(camera3DManager);
 	SetLightManager(lightManager);
-
-	for (uint32_t i = 0; i < kBlendModeNum; ++i) {
-		instancingResource_[i] = dxgi_->CreateBufferResource(sizeof(CylinderData3DForGPU) * PrimitiveCommonConst::NumMaxInstance);
-		instancingSrvIndex_[i] = srvUavManager_->Allocate();
-		srvUavManager_->CreateSrvStructuredBuffer(instancingSrvIndex_[i], instancingResource_[i].Get(), PrimitiveCommonConst::NumMaxInstance, sizeof(CylinderData3DForGPU));
-		instancingResource_[i]->Map(0, nullptr, reinterpret_cast<void**>(&instancingData_[i]));
-
-		materialResource_[i] = dxgi_->CreateBufferResource(sizeof(PrimitiveMaterialData3DForGPU) * PrimitiveCommonConst::NumMaxInstance);
-		materialSrvIndex_[i] = srvUavManager_->Allocate();
-		srvUavManager_->CreateSrvStructuredBuffer(materialSrvIndex_[i], materialResource_[i].Get(), PrimitiveCommonConst::NumMaxInstance, sizeof(PrimitiveMaterialData3DForGPU));
-		materialResource_[i]->Map(0, nullptr, reinterpret_cast<void**>(&materialData_[i]));
-
-		currentIndex_[i] = 0;
-		instanceCount_[i] = 0;
-
-		uint32_t texIndex = MAGISYSTEM::GetTexture()["EngineAssets/Images/uvChecker.png"].srvIndex;
-		for (uint32_t j = 0; j < PrimitiveCommonConst::NumMaxInstance; ++j) {
-			materialData_[i][j].textureIndex = texIndex;
-			materialData_[i][j].baseColor = { 1.0f, 1.0f, 1.0f, 1.0f };
-			materialData_[i][j].uvMatrix = MakeIdentityMatrix4x4();
+	SetRenderQueue(renderQueue);
+
+	// リソースはフレームごとに持ち、GPUが読んでいる間に書き換えないようにする
+	for (uint32_t frame = 0; frame < FrameConst::FrameCount; ++frame) {
+		for (uint32_t i = 0; i < kBlendModeNum; ++i) {
+			instancingResource_[frame][i] = dxgi_->CreateBufferResource(sizeof(CylinderData3DForGPU) * PrimitiveCommonConst::NumMaxInstance);
+			instancingSrvIndex_[frame][i] = srvUavManager_->Allocate();
+			srvUavManager_->CreateSrvStructuredBuffer(instancingSrvIndex_[frame][i], instancingResource_[frame][i].Get(), PrimitiveCommonConst::NumMaxInstance, sizeof(CylinderData3DForGPU));
+			instancingResource_[frame][i]->Map(0, nullptr, reinterpret_cast<void**>(&instancingData_[frame][i]));
+
+			materialResource_[frame][i] = dxgi_->CreateBufferResource(sizeof(PrimitiveMaterialData3DForGPU) * PrimitiveCommonConst::NumMaxInstance);
+			materialSrvIndex_[frame][i] = srvUavManager_->Allocate();
+			srvUavManager_->CreateSrvStructuredBuffer(materialSrvIndex_[frame][i], materialResource_[frame][i].Get(), PrimitiveCommonConst::NumMaxInstance, sizeof(PrimitiveMaterialData3DForGPU));
+			materialResource_[frame][i]->Map(0, nullptr, reinterpret_cast<void**>(&materialData_[frame][i]));
+
+			currentIndex_[i] = 0;
+			instanceCount_[i] = 0;
+
+			uint32_t texIndex = MAGISYSTEM::GetTexture()["EngineAssets/Images/uvChecker.png"].srvIndex;
+			for (uint32_t j = 0; j < PrimitiveCommonConst::NumMaxInstance; ++j) {
+				materialData_[frame][i][j].textureIndex = texIndex;
+				materialData_[frame][i][j].baseColor = { 1.0f, 1.0f, 1.0f, 1.0f };
+				materialData_[frame][i][j].uvMatrix = MakeIdentityMatrix4x4();
+			}
 		}
+
+		// 影描画用のリソース作成
+		shadowInstancingResource_[frame] = dxgi_->CreateBufferResource(sizeof(CylinderData3DForGPU) * PrimitiveCommonConst::NumMaxInstance);
+		shadowInstancingSrvIndex_[frame] = srvUavManager_->Allocate();
+		srvUavManager_->CreateSrvStructuredBuffer(shadowInstancingSrvIndex_[frame], shadowInstancingResource_[frame].Get(), PrimitiveCommonConst::NumMaxInstance, sizeof(CylinderData3DForGPU));
+		shadowInstancingResource_[frame]->Map(0, nullptr, reinterpret_cast<void**>(&shadowInstancingData_[frame]));
 	}
 
 	Logger::Log("CylinderDrawer3D Initialize\n");
@@ -55,11 +66,41 @@ CylinderDrawer3D::~CylinderDrawer3D() {
 }
 
 void CylinderDrawer3D::Update() {
+	// 奥から順に描くブレンドモードを並べ替えて今のフレームのリソースへ書き込む
+	const uint32_t frameIndex = directXCommand_->GetFrameIndex();
+	for (uint32_t i = 0; i < kBlendModeNum; ++i) {
+		if (depthSortBuffers_[i].GetCount() == 0) continue;
+		depthSortBuffers_[i].Flush(instancingData_[frameIndex][i], materialData_[frameIndex][i], PrimitiveCommonConst::NumMaxInstance);
+	}
+
 	for (uint32_t i = 0; i < kBlendModeNum; ++i) {
 		assert(currentIndex_[i] <= PrimitiveCommonConst::NumMaxInstance);
 		instanceCount_[i] = currentIndex_[i];
 		currentIndex_[i] = 0;
 	}
+	assert(shadowCurrentIndex_ <= PrimitiveCommonConst::NumMaxInstance);
+	shadowInstanceCount_ = shadowCurrentIndex_;
+	shadowCurrentIndex_ = 0;
+
+	// インスタンスがあるブレンドモードだけ描画キューに積む
+	for (uint32_t i = 0; i < kBlendModeNum; ++i) {
+		if (instanceCount_[i] == 0) continue;
+		const BlendMode mode = static_cast<BlendMode>(i);
+		const RenderPass pass = mode == BlendMode::None ? RenderPass::GBuffer : RenderPass::Transparent;
+		renderQueue_->Submit(this, pass, mode, static_cast<uint32_t>(GraphicsPipelineStateType::Cylinder3D), 0);
+	}
+	if (shadowInstanceCount_ > 0) {
+		renderQueue_->Submit(this, RenderPass::Shadow, BlendMode::None, static_cast<uint32_t>(ShadowPipelineStateType::Cylinder), 0);
+	}
+}
+
+void CylinderDrawer3D::ExecuteRenderItem(const RenderItem& item, [[maybe_unused]] bool isPipelineChanged) {
+	// パスとブレンドモードごとにひとつしか積まないので、パイプラインは毎回設定する
+	if (RenderQueue::GetPass(item.key) == RenderPass::Shadow) {
+		DrawShadow();
+	} else {
+		Draw(RenderQueue::GetBlendMode(item.key));
+	}
 }
 
 void CylinderDrawer3D::Draw(BlendMode mode) {
@@ -67,13 +108,14 @@ void CylinderDrawer3D::Draw(BlendMode mode) {
 	if (instanceCount_[i] == 0) return;
 
 	ID3D12GraphicsCommandList6* commandList = directXCommand_->GetList6();
+	const uint32_t frameIndex = directXCommand_->GetFrameIndex();
 
 	commandList->SetGraphicsRootSignature(graphicsPipelineManager_->GetRootSignature(GraphicsPipelineStateType::Cylinder3D));
 	commandList->SetPipelineState(graphicsPipelineManager_->GetPipelineState(GraphicsPipelineStateType::Cylinder3D, mode));
 	camera3DManager_->TransferCurrentCamera(0);
 
-	commandList->SetGraphicsRootDescriptorTable(1, srvUavManager_->GetDescriptorHandleGPU(instancingSrvIndex_[i]));
-	commandList->SetGraphicsRootDescriptorTable(2, srvUavManager_->GetDescriptorHandleGPU(materialSrvIndex_[i]));
+	commandList->SetGraphicsRootDescriptorTable(1, srvUavManager_->GetDescriptorHandleGPU(instancingSrvIndex_[frameIndex][i]));
+	commandList->SetGraphicsRootDescriptorTable(2, srvUavManager_->GetDescriptorHandleGPU(materialSrvIndex_[frameIndex][i]));
 	commandList->SetGraphicsRootDescriptorTable(3, srvUavManager_->GetDescriptorHandleGPU(0));
 
 	RootConstants rootConstants{};
@@ -83,28 +125,30 @@ void CylinderDrawer3D::Draw(BlendMode mode) {
 	commandList->DispatchMesh(1, instanceCount_[i], 1);
 }
 
-void CylinderDrawer3D::DrawShadow(BlendMode mode) {
-	const uint32_t i = static_cast<uint32_t>(mode);
-	if (instanceCount_[i] == 0) return;
+void CylinderDrawer3D::DrawShadow() {
+	if (shadowInstanceCount_ == 0) return;
 
 	ID3D12GraphicsCommandList6* commandList = directXCommand_->GetList6();
+	const uint32_t frameIndex = directXCommand_->GetFrameIndex();
 
 	commandList->SetGraphicsRootSignature(shadowPipelineManager_->GetRootSignature(ShadowPipelineStateType::Cylinder));
 	commandList->SetPipelineState(shadowPipelineManager_->GetPipelineState(ShadowPipelineStateType::Cylinder));
 
 	lightManager_->TransferDirectionalLightCamera(0);
 
-	commandList->SetGraphicsRootDescriptorTable(1, srvUavManager_->GetDescriptorHandleGPU(instancingSrvIndex_[i]));
+	commandList->SetGraphicsRootDescriptorTable(1, srvUavManager_->GetDescriptorHandleGPU(shadowInstancingSrvIndex_[frameIndex]));
 
 	RootConstants rootConstants{};
 	rootConstants.baseInstanceIndex = 0;
 	commandList->SetGraphicsRoot32BitConstants(2, 1, &rootConstants, 0);
 
-	commandList->DispatchMesh(1, instanceCount_[i], 1);
+	commandList->DispatchMesh(1, shadowInstanceCount_, 1);
 }
 
 void CylinderDrawer3D::AddCylinder(const Matrix4x4& worldMatrix, const CylinderData3D& data, const MaterialData3D& material) {
 	const uint32_t blendIndex = static_cast<uint32_t>(material.blendMode);
+	// 今のフレームのリソースへ書き込む
+	const uint32_t frameIndex = directXCommand_->GetFrameIndex();
 
 #if defined(DEBUG) || defined(DEVELOP)
 	if (currentIndex_[blendIndex] >= PrimitiveCommonConst::NumMaxInstance) {
@@ -136,9 +180,38 @@ void CylinderDrawer3D::AddCylinder(const Matrix4x4& worldMatrix, const CylinderD
 		.uvMatrix = MakeUVMatrix(material.uvScale, material.uvRotate, material.uvTranslate)
 	};
 
-	instancingData_[blendIndex][currentIndex_[blendIndex]] = newCylinderData;
-	materialData_[blendIndex][currentIndex_[blendIndex]] = newMaterialData;
+	if (IsDepthSortedBlendMode(material.blendMode)) {
+		// 奥から順に描くブレンドモードはUpdateで並べ替えてから書き込む
+		depthSortBuffers_[blendIndex].Add(newCylinderData, newMaterialData, camera3DManager_->GetViewDepth(ExtractionWorldPos(worldMatrix)));
+	} else {
+		instancingData_[frameIndex][blendIndex][currentIndex_[blendIndex]] = newCylinderData;
+		materialData_[frameIndex][blendIndex][currentIndex_[blendIndex]] = newMaterialData;
+	}
 	currentIndex_[blendIndex]++;
+
+	// ライトの範囲内の不透明なものだけ影描画用に積む
+	if (material.blendMode != BlendMode::None || !material.isMakeShadow) {
+		return;
+	}
+	// 形状の境界ボックス(底面が原点、上方向に高さ)
+	const float maxRadius = (std::max)(data.topRadius, data.bottomRadius);
+	const AABB localAABB = {
+		{ -maxRadius, 0.0f, -maxRadius },
+		{ maxRadius, data.height, maxRadius },
+	};
+	if (!lightManager_->IsInDirectionalLightShadowVolume(TransformAABB(localAABB, worldMatrix))) {
+		return;
+	}
+
+#if defined(DEBUG) || defined(DEVELOP)
+	if (shadowCurrentIndex_ >= PrimitiveCommonConst::NumMaxInstance) {
+		Logger::Log("CylinderDrawer3D: Max shadow instance count exceeded!\n");
+		return;
+	}
+#endif // _DEBUG
+
+	shadowInstancingData_[frameIndex][shadowCurrentIndex_] = newCylinderData;
+	shadowCurrentIndex_++;
 }
 
 void CylinderDrawer3D::SetDXGI(DXGI* dxgi) {
@@ -175,3 +248,8 @@ void CylinderDrawer3D::SetLightManager(LightManager* lightManager) {
 	assert(lightManager);
 	lightManager_ = lightManager;
 }
+
+void CylinderDrawer3D::SetRenderQueue(RenderQueue* renderQueue) {
+	assert(renderQueue);
+	renderQueue_ = renderQueue;
+}
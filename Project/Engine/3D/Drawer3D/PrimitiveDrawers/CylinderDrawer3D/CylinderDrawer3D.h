@@ -11,6 +11,9 @@
 #include "Structs/Primitive3DStruct.h"
 #include "Structs/ColorStruct.h"
 #include "Enums/BlendModeEnum.h"
+#include "Const/FrameConst.h"
+#include "RenderQueue/RenderQueue.h"
+#include "3D/Drawer3D/DepthSortBuffer/DepthSortBuffer.h"
 
 class DXGI;
 class DirectXCommand;
@@ -23,7 +26,7 @@ class LightManager;
 /// <summary>
 /// 3Dシリンダー描画クラス
 /// </summary>
-class CylinderDrawer3D {
+class CylinderDrawer3D : public RenderQueueSubmitter {
 public:
 	CylinderDrawer3D(
 		DXGI* dxgi,
@@ -32,13 +35,14 @@ public:
 		GraphicsPipelineManager* graphicsPipelineManager,
 		ShadowPipelineManager* shadowPipelineManager,
 		Camera3DManager* camera3DManager,
-		LightManager* lightManager
+		LightManager* lightManager,
+		RenderQueue* renderQueue
 	);
 	~CylinderDrawer3D();
 
 	void Update();
-	void Draw(BlendMode mode);
-	void DrawShadow(BlendMode mode);
+	// 描画キューから積んだ描画を記録する
+	void ExecuteRenderItem(const RenderItem& item, bool isPipelineChanged) override;
 
 	void AddCylinder(
 		const Matrix4x4& worldMatrix,
@@ -46,6 +50,10 @@ public:
 		const MaterialData3D& material
 	);
 
+private:
+	void Draw(BlendMode mode);
+	void DrawShadow();
+
 private:
 	void SetDXGI(DXGI* dxgi);
 	void SetDirectXCommand(DirectXCommand* directXCommand);
@@ -54,22 +62,23 @@ private:
 	void SetShadowPipelineManager(ShadowPipelineManager* shadowPipelineManager);
 	void SetCamera3DManager(Camera3DManager* camera3DManager);
 	void SetLightManager(LightManager* lightManager);
+	void SetRenderQueue(RenderQueue* renderQueue);
 
 private:
 	// instancing描画用のリソース
-	ComPtr<ID3D12Resource> instancingResource_[static_cast<uint32_t>(BlendMode::Num)];
+	ComPtr<ID3D12Resource> instancingResource_[FrameConst::FrameCount][static_cast<uint32_t>(BlendMode::Num)];
 	// instancing描画用のデータ
-	CylinderData3DForGPU* instancingData_[static_cast<uint32_t>(BlendMode::Num)];
+	CylinderData3DForGPU* instancingData_[FrameConst::FrameCount][static_cast<uint32_t>(BlendMode::Num)];
 
 	// マテリアルのリソース
-	ComPtr<ID3D12Resource> materialResource_[static_cast<uint32_t>(BlendMode::Num)];
+	ComPtr<ID3D12Resource> materialResource_[FrameConst::FrameCount][static_cast<uint32_t>(BlendMode::Num)];
 	// マテリアルデータ
-	PrimitiveMaterialData3DForGPU* materialData_[static_cast<uint32_t>(BlendMode::Num)];
+	PrimitiveMaterialData3DForGPU* materialData_[FrameConst::FrameCount][static_cast<uint32_t>(BlendMode::Num)];
 
 	// Cylinder3DSrvIndex
-	uint32_t instancingSrvIndex_[static_cast<uint32_t>(BlendMode::Num)];
+	uint32_t instancingSrvIndex_[FrameConst::FrameCount][static_cast<uint32_t>(BlendMode::Num)];
 	// MaterialSrvIndex
-	uint32_t materialSrvIndex_[static_cast<uint32_t>(BlendMode::Num)];
+	uint32_t materialSrvIndex_[FrameConst::FrameCount][static_cast<uint32_t>(BlendMode::Num)];
 
 	// instance描画する際に使う変数
 	uint32_t instanceCount_[static_cast<uint32_t>(BlendMode::Num)];
@@ -77,6 +86,20 @@ private:
 	// 現在のインデックス
 	uint32_t currentIndex_[static_cast<uint32_t>(BlendMode::Num)];
 
+	// 奥から順に描くブレンドモードのインスタンス(Updateで並べ替えてからリソースへ書き込む)
+	DepthSortBuffer<CylinderData3DForGPU, PrimitiveMaterialData3DForGPU> depthSortBuffers_[static_cast<uint32_t>(BlendMode::Num)];
+
+	// 影描画用のinstancingリソース(ライトの範囲内の不透明なもののみ)
+	ComPtr<ID3D12Resource> shadowInstancingResource_[FrameConst::FrameCount];
+	// 影描画用のinstancingデータ
+	CylinderData3DForGPU* shadowInstancingData_[FrameConst::FrameCount]{};
+	// 影描画用のSrvIndex
+	uint32_t shadowInstancingSrvIndex_[FrameConst::FrameCount]{};
+	// 影描画するインスタンス数
+	uint32_t shadowInstanceCount_ = 0;
+	// 影描画用の現在のインデックス
+	uint32_t shadowCurrentIndex_ = 0;
+
 private:
 	DXGI* dxgi_ = nullptr;
 	DirectXCommand* directXCommand_ = nullptr;
@@ -85,4 +108,5 @@ private:
 	ShadowPipelineManager* shadowPipelineManager_ = nullptr;
 	Camera3DManager* camera3DManager_ = nullptr;
 	LightManager* lightManager_ = nullptr;
+	RenderQueue* renderQueue_ = nullptr;
 };
\ No newline at end of file
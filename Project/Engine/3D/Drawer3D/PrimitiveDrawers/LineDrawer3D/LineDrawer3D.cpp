@@ -13,21 +13,24 @@
 
 using namespace MAGIUtility;
 
-LineDrawer3D::LineDrawer3D(DXGI* dxgi, DirectXCommand* directXCommand, SRVUAVManager* srvUavManager, GraphicsPipelineManager* graphicsPipelineManager, Camera3DManager* camera3DManager) {
+LineDrawer3D::LineDrawer3D(DXGI* dxgi, DirectXCommand* directXCommand, SRVUAVManager* srvUavManager, GraphicsPipelineManager* graphicsPipelineManager, Camera3DManager* camera3DManager, RenderQueue* renderQueue) {
 	SetDXGI(dxgi);
 	SetDirectXCommand(directXCommand);
 	SetSRVUAVManager(srvUavManager);
 	SetGraphicsPipelineManager(graphicsPipelineManager);
 	SetCamera3DManager(camera3DManager);
+	SetRenderQueue(renderQueue);
 	// Instancingリソースを作る
 	CreateInstancingResource();
 	// Instancingデータを書き込む
 	MapInstancingData();
 
-	// srvのインデックスを割り当て
-	srvIndex_ = srvUavManager_->Allocate();
-	// Srvを作成
-	srvUavManager_->CreateSrvStructuredBuffer(srvIndex_, instancingResource_.Get(), PrimitiveCommonConst::NumMaxInstance, sizeof(LineData3D));
+	for (uint32_t frame = 0; frame < FrameConst::FrameCount; ++frame) {
+		// srvのインデックスを割り当て
+		srvIndex_[frame] = srvUavManager_->Allocate();
+		// Srvを作成
+		srvUavManager_->CreateSrvStructuredBuffer(srvIndex_[frame], instancingResource_[frame].Get(), PrimitiveCommonConst::NumMaxInstance, sizeof(LineData3D));
+	}
 
 	Logger::Log("LineDrawer3D Initialize\n");
 }
@@ -40,6 +43,15 @@ void LineDrawer3D::Update() {
 	assert(currentIndex_ <= PrimitiveCommonConst::NumMaxInstance);
 	instanceCount_ = currentIndex_;
 	currentIndex_ = 0;
+
+	// 線があるときだけ描画キューに積む
+	if (instanceCount_ > 0) {
+		renderQueue_->Submit(this, RenderPass::Line, blendMode_, static_cast<uint32_t>(GraphicsPipelineStateType::Line3D), 0);
+	}
+}
+
+void LineDrawer3D::ExecuteRenderItem([[maybe_unused]] const RenderItem& item, [[maybe_unused]] bool isPipelineChanged) {
+	Draw();
 }
 
 void LineDrawer3D::Draw() {
@@ -59,7 +71,7 @@ void LineDrawer3D::Draw() {
 	// Cameraを転送
 	camera3DManager_->TransferCurrentCamera(0);
 	// StructuredBufferのSRVを設定する
-	commandList->SetGraphicsRootDescriptorTable(1, srvUavManager_->GetDescriptorHandleGPU(srvIndex_));
+	commandList->SetGraphicsRootDescriptorTable(1, srvUavManager_->GetDescriptorHandleGPU(srvIndex_[directXCommand_->GetFrameIndex()]));
 	// 描画
 	commandList->DrawInstanced(2, instanceCount_, 0, 0);
 }
@@ -78,7 +90,8 @@ void LineDrawer3D::AddLine(const Vector3& start, const Vector3& end, const Vecto
 		.end = end,
 		.color = color,
 	};
-	instancingData_[currentIndex_] = newLineData;
+	// 今のフレームのリソースへ書き込む
+	instancingData_[directXCommand_->GetFrameIndex()][currentIndex_] = newLineData;
 	currentIndex_++;
 }
 
@@ -107,16 +120,25 @@ void LineDrawer3D::SetCamera3DManager(Camera3DManager* camera3DManager) {
 	camera3DManager_ = camera3DManager;
 }
 
+void LineDrawer3D::SetRenderQueue(RenderQueue* renderQueue) {
+	assert(renderQueue);
+	renderQueue_ = renderQueue;
+}
+
 void LineDrawer3D::CreateInstancingResource() {
-	// instancing用のリソースを作る
-	instancingResource_ = dxgi_->CreateBufferResource(sizeof(LineData3D) * PrimitiveCommonConst::NumMaxInstance);
+	// instancing用のリソースをフレームごとに作る
+	for (uint32_t frame = 0; frame < FrameConst::FrameCount; ++frame) {
+		instancingResource_[frame] = dxgi_->CreateBufferResource(sizeof(LineData3D) * PrimitiveCommonConst::NumMaxInstance);
+	}
 }
 
 void LineDrawer3D::MapInstancingData() {
-	instancingData_ = nullptr;
-	instancingResource_->Map(0, nullptr, reinterpret_cast<void**>(&instancingData_));
+	for (uint32_t frame = 0; frame < FrameConst::FrameCount; ++frame) {
+		instancingData_[frame] = nullptr;
+		instancingResource_[frame]->Map(0, nullptr, reinterpret_cast<void**>(&instancingData_[frame]));
 
-	for (uint32_t index = 0; index < PrimitiveCommonConst::NumMaxInstance; ++index) {
-		instancingData_[index].color = Vector4(1.0f, 1.0f, 1.0f, 1.0f);
+		for (uint32_t index = 0; index < PrimitiveCommonConst::NumMaxInstance; ++index) {
+			instancingData_[frame][index].color = Vector4(1.0f, 1.0f, 1.0f, 1.0f);
+		}
 	}
 }
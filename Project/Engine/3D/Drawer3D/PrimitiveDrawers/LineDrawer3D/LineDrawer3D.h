@@ -12,6 +12,8 @@
 #include "Structs/ColorStruct.h"
 #include "Enums/BlendModeEnum.h"
 #include "Const/Primitive3DConst.h"
+#include "Const/FrameConst.h"
+#include "RenderQueue/RenderQueue.h"
 
 class DXGI;
 class DirectXCommand;
@@ -22,27 +24,33 @@ class Camera3DManager;
 /// <summary>
 /// 3Dライン描画クラス
 /// </summary>
-class LineDrawer3D {
+class LineDrawer3D : public RenderQueueSubmitter {
 public:
 	LineDrawer3D(
 		DXGI* dxgi,
 		DirectXCommand* directXCommand,
 		SRVUAVManager* srvUavManager,
 		GraphicsPipelineManager* graphicsPipelineManager,
-		Camera3DManager* camera3DManager);
+		Camera3DManager* camera3DManager,
+		RenderQueue* renderQueue);
 	~LineDrawer3D();
 
 	void Update();
-	void Draw();
+	// 描画キューから積んだ描画を記録する
+	void ExecuteRenderItem(const RenderItem& item, bool isPipelineChanged) override;
 
 	void AddLine(const Vector3& start, const Vector3& end, const Vector4& color);
 
+private:
+	void Draw();
+
 private:
 	void SetDXGI(DXGI* dxgi);
 	void SetDirectXCommand(DirectXCommand* directXCommand);
 	void SetSRVUAVManager(SRVUAVManager* srvUavManager);
 	void SetGraphicsPipelineManager(GraphicsPipelineManager* graphicsPipelineManager);
 	void SetCamera3DManager(Camera3DManager* camera3DManager);
+	void SetRenderQueue(RenderQueue* renderQueue);
 private:
 	// instancingリソース作成
 	void CreateInstancingResource();
@@ -52,13 +60,13 @@ private:
 	// ブレンドモード
 	BlendMode blendMode_ = BlendMode::Normal;
 
-	// instancing描画用のリソース
-	ComPtr<ID3D12Resource> instancingResource_ = nullptr;
+	// instancing描画用のリソース(GPUが読んでいる間に書き換えないようにフレームごとに持つ)
+	ComPtr<ID3D12Resource> instancingResource_[FrameConst::FrameCount];
 	// instancing描画用のデータ
-	LineData3D* instancingData_ = nullptr;
+	LineData3D* instancingData_[FrameConst::FrameCount]{};
 
 	// SrvIndex
-	uint32_t srvIndex_ = 0;
+	uint32_t srvIndex_[FrameConst::FrameCount]{};
 	// instance描画する際に使う変数
 	uint32_t instanceCount_ = 0;
 	// 現在のインデックス
@@ -69,5 +77,6 @@ private:
 	SRVUAVManager* srvUavManager_ = nullptr;
 	GraphicsPipelineManager* graphicsPipelineManager_ = nullptr;
 	Camera3DManager* camera3DManager_ = nullptr;
+	RenderQueue* renderQueue_ = nullptr;
 
 };
\ No newline at end of file
@@ -21,28 +21,33 @@ PlaneDrawer3D::PlaneDrawer3D(
 	DirectXCommand* directXCommand,
 	SRVUAVManager* srvUavManager,
 	GraphicsPipelineManager* graphicsPipelineManager,
-	Camera3DManager* camera3DManager
+	Camera3DManager* camera3DManager,
+	RenderQueue* renderQueue
 ) {
 	SetDXGI(dxgi);
 	SetDirectXCommand(directXCommand);
 	SetSRVUAVManager(srvUavManager);
 	SetGraphicsPipelineManager(graphicsPipelineManager);
 	SetCamera3DManager(camera3DManager);
-	for (uint32_t i = 0; i < kBlendModeNum; ++i) {
-		// リソース作成
-		instancingResource_[i] = dxgi_->CreateBufferResource(sizeof(PlaneData3DForGPU) * PrimitiveCommonConst::NumMaxInstance);
-		instancingSrvIndex_[i] = srvUavManager_->Allocate();
-		srvUavManager_->CreateSrvStructuredBuffer(instancingSrvIndex_[i], instancingResource_[i].Get(), PrimitiveCommonConst::NumMaxInstance, sizeof(PlaneData3DForGPU));
-		instancingResource_[i]->Map(0, nullptr, reinterpret_cast<void**>(&instancingData_[i]));
-
-		materialResource_[i] = dxgi_->CreateBufferResource(sizeof(PrimitiveMaterialData3DForGPU) * PrimitiveCommonConst::NumMaxInstance);
-		materialSrvIndex_[i] = srvUavManager_->Allocate();
-		srvUavManager_->CreateSrvStructuredBuffer(materialSrvIndex_[i], materialResource_[i].Get(), PrimitiveCommonConst::NumMaxInstance, sizeof(PrimitiveMaterialData3DForGPU));
-		materialResource_[i]->Map(0, nullptr, reinterpret_cast<void**>(&materialData_[i]));
-
-		currentIndex_[i] = 0;
-		instanceCount_[i] = 0;
+	SetRenderQueue(renderQueue);
+	// リソースはフレームごとに持ち、GPUが読んでいる間に書き換えないようにする
+	for (uint32_t frame = 0; frame < FrameConst::FrameCount; ++frame) {
+		for (uint32_t i = 0; i < kBlendModeNum; ++i) {
+			// リソース作成
+			instancingResource_[frame][i] = dxgi_->CreateBufferResource(sizeof(PlaneData3DForGPU) * PrimitiveCommonConst::NumMaxInstance);
+			instancingSrvIndex_[frame][i] = srvUavManager_->Allocate();
+			srvUavManager_->CreateSrvStructuredBuffer(instancingSrvIndex_[frame][i], instancingResource_[frame][i].Get(), PrimitiveCommonConst::NumMaxInstance, sizeof(PlaneData3DForGPU));
+			instancingResource_[frame][i]->Map(0, nullptr, reinterpret_cast<void**>(&instancingData_[frame][i]));
+
+			materialResource_[frame][i] = dxgi_->CreateBufferResource(sizeof(PrimitiveMaterialData3DForGPU) * PrimitiveCommonConst::NumMaxInstance);
+			materialSrvIndex_[frame][i] = srvUavManager_->Allocate();
+			srvUavManager_->CreateSrvStructuredBuffer(materialSrvIndex_[frame][i], materialResource_[frame][i].Get(), PrimitiveCommonConst::NumMaxInstance, sizeof(PrimitiveMaterialData3DForGPU));
+			materialResource_[frame][i]->Map(0, nullptr, reinterpret_cast<void**>(&materialData_[frame][i]));
+
+			currentIndex_[i] = 0;
+			instanceCount_[i] = 0;
 
+		}
 	}
 
 	Logger::Log("PlaneDrawer3D Initialize\n");
@@ -53,11 +58,31 @@ PlaneDrawer3D::~PlaneDrawer3D() {
 }
 
 void PlaneDrawer3D::Update() {
+	// 奥から順に描くブレンドモードを並べ替えて今のフレームのリソースへ書き込む
+	const uint32_t frameIndex = directXCommand_->GetFrameIndex();
+	for (uint32_t i = 0; i < kBlendModeNum; ++i) {
+		if (depthSortBuffers_[i].GetCount() == 0) continue;
+		depthSortBuffers_[i].Flush(instancingData_[frameIndex][i], materialData_[frameIndex][i], PrimitiveCommonConst::NumMaxInstance);
+	}
+
 	for (uint32_t i = 0; i < kBlendModeNum; ++i) {
 		assert(currentIndex_[i] <= PrimitiveCommonConst::NumMaxInstance);
 		instanceCount_[i] = currentIndex_[i];
 		currentIndex_[i] = 0;
 	}
+
+	// インスタンスがあるブレンドモードだけ描画キューに積む
+	for (uint32_t i = 0; i < kBlendModeNum; ++i) {
+		if (instanceCount_[i] == 0) continue;
+		const BlendMode mode = static_cast<BlendMode>(i);
+		const RenderPass pass = mode == BlendMode::None ? RenderPass::GBuffer : RenderPass::Transparent;
+		renderQueue_->Submit(this, pass, mode, static_cast<uint32_t>(GraphicsPipelineStateType::Plane3D), 0);
+	}
+}
+
+void PlaneDrawer3D::ExecuteRenderItem(const RenderItem& item, [[maybe_unused]] bool isPipelineChanged) {
+	// ブレンドモードごとにひとつしか積まないので、パイプラインは毎回設定する
+	Draw(RenderQueue::GetBlendMode(item.key));
 }
 
 void PlaneDrawer3D::Draw(BlendMode mode) {
@@ -65,14 +90,15 @@ void PlaneDrawer3D::Draw(BlendMode mode) {
 	if (instanceCount_[i] == 0) return;
 
 	ID3D12GraphicsCommandList6* commandList = directXCommand_->GetList6();
+	const uint32_t frameIndex = directXCommand_->GetFrameIndex();
 
 	commandList->SetGraphicsRootSignature(graphicsPipelineManager_->GetRootSignature(GraphicsPipelineStateType::Plane3D));
 	commandList->SetPipelineState(graphicsPipelineManager_->GetPipelineState(GraphicsPipelineStateType::Plane3D, mode));
 
 	camera3DManager_->TransferCurrentCamera(0); // b0
 
-	commandList->SetGraphicsRootDescriptorTable(1, srvUavManager_->GetDescriptorHandleGPU(instancingSrvIndex_[i]));
-	commandList->SetGraphicsRootDescriptorTable(2, srvUavManager_->GetDescriptorHandleGPU(materialSrvIndex_[i]));
+	commandList->SetGraphicsRootDescriptorTable(1, srvUavManager_->GetDescriptorHandleGPU(instancingSrvIndex_[frameIndex][i]));
+	commandList->SetGraphicsRootDescriptorTable(2, srvUavManager_->GetDescriptorHandleGPU(materialSrvIndex_[frameIndex][i]));
 	commandList->SetGraphicsRootDescriptorTable(3, srvUavManager_->GetDescriptorHandleGPU(0)); // t1000
 
 	RootConstants rootConstants{};
@@ -84,6 +110,8 @@ void PlaneDrawer3D::Draw(BlendMode mode) {
 
 void PlaneDrawer3D::AddPlane(const Matrix4x4& worldMatrix, const PlaneData3D& data, const MaterialData3D& material) {
 	const uint32_t blendIndex = static_cast<uint32_t>(material.blendMode);
+	// 今のフレームのリソースへ書き込む
+	const uint32_t frameIndex = directXCommand_->GetFrameIndex();
 
 #if defined(DEBUG) || defined(DEVELOP)
 	if (currentIndex_[blendIndex] >= PrimitiveCommonConst::NumMaxInstance) {
@@ -117,8 +145,13 @@ void PlaneDrawer3D::AddPlane(const Matrix4x4& worldMatrix, const PlaneData3D& da
 		.uvMatrix = MakeUVMatrix(material.uvScale, material.uvRotate, material.uvTranslate),
 	};
 
-	instancingData_[blendIndex][currentIndex_[blendIndex]] = newPlaneData;
-	materialData_[blendIndex][currentIndex_[blendIndex]] = newMaterialData;
+	if (IsDepthSortedBlendMode(material.blendMode)) {
+		// 奥から順に描くブレンドモードはUpdateで並べ替えてから書き込む
+		depthSortBuffers_[blendIndex].Add(newPlaneData, newMaterialData, camera3DManager_->GetViewDepth(ExtractionWorldPos(worldMatrix)));
+	} else {
+		instancingData_[frameIndex][blendIndex][currentIndex_[blendIndex]] = newPlaneData;
+		materialData_[frameIndex][blendIndex][currentIndex_[blendIndex]] = newMaterialData;
+	}
 
 	currentIndex_[blendIndex]++;
 }
@@ -146,4 +179,9 @@ void PlaneDrawer3D::SetGraphicsPipelineManager(GraphicsPipelineManager* graphics
 void PlaneDrawer3D::SetCamera3DManager(Camera3DManager* camera3DManager) {
 	assert(camera3DManager);
 	camera3DManager_ = camera3DManager;
+}
+
+void PlaneDrawer3D::SetRenderQueue(RenderQueue* renderQueue) {
+	assert(renderQueue);
+	renderQueue_ = renderQueue;
 }
\ No newline at end of file
@@ -16,32 +16,36 @@
 
 using namespace MAGIMath;
 
-RingDrawer3D::RingDrawer3D(DXGI* dxgi, DirectXCommand* directXCommand, SRVUAVManager* srvUavManager, GraphicsPipelineManager* graphicsPipelineManager, Camera3DManager* camera3DManager) {
+RingDrawer3D::RingDrawer3D(DXGI* dxgi, DirectXCommand* directXCommand, SRVUAVManager* srvUavManager, GraphicsPipelineManager* graphicsPipelineManager, Camera3DManager* camera3DManager, RenderQueue* renderQueue) {
 	SetDXGI(dxgi);
 	SetDirectXCommand(directXCommand);
 	SetSRVUAVManager(srvUavManager);
 	SetGraphicsPipelineManager(graphicsPipelineManager);
 	SetCamera3DManager(camera3DManager);
-
-	for (uint32_t i = 0; i < kBlendModeNum; ++i) {
-		instancingResource_[i] = dxgi_->CreateBufferResource(sizeof(RingData3DForGPU) * PrimitiveCommonConst::NumMaxInstance);
-		instancingSrvIndex_[i] = srvUavManager_->Allocate();
-		srvUavManager_->CreateSrvStructuredBuffer(instancingSrvIndex_[i], instancingResource_[i].Get(), PrimitiveCommonConst::NumMaxInstance, sizeof(RingData3DForGPU));
-		instancingResource_[i]->Map(0, nullptr, reinterpret_cast<void**>(&instancingData_[i]));
-
-		materialResource_[i] = dxgi_->CreateBufferResource(sizeof(PrimitiveMaterialData3DForGPU) * PrimitiveCommonConst::NumMaxInstance);
-		materialSrvIndex_[i] = srvUavManager_->Allocate();
-		srvUavManager_->CreateSrvStructuredBuffer(materialSrvIndex_[i], materialResource_[i].Get(), PrimitiveCommonConst::NumMaxInstance, sizeof(PrimitiveMaterialData3DForGPU));
-		materialResource_[i]->Map(0, nullptr, reinterpret_cast<void**>(&materialData_[i]));
-
-		currentIndex_[i] = 0;
-		instanceCount_[i] = 0;
-
-		uint32_t texIndex = MAGISYSTEM::GetTexture()["EngineAssets/Images/uvChecker.png"].srvIndex;
-		for (uint32_t j = 0; j < PrimitiveCommonConst::NumMaxInstance; ++j) {
-			materialData_[i][j].textureIndex = texIndex;
-			materialData_[i][j].baseColor = { 1.0f, 1.0f, 1.0f, 1.0f };
-			materialData_[i][j].uvMatrix = MakeIdentityMatrix4x4();
+	SetRenderQueue(renderQueue);
+
+	// リソースはフレームごとに持ち、GPUが読んでいる間に書き換えないようにする
+	for (uint32_t frame = 0; frame < FrameConst::FrameCount; ++frame) {
+		for (uint32_t i = 0; i < kBlendModeNum; ++i) {
+			instancingResource_[frame][i] = dxgi_->CreateBufferResource(sizeof(RingData3DForGPU) * PrimitiveCommonConst::NumMaxInstance);
+			instancingSrvIndex_[frame][i] = srvUavManager_->Allocate();
+			srvUavManager_->CreateSrvStructuredBuffer(instancingSrvIndex_[frame][i], instancingResource_[frame][i].Get(), PrimitiveCommonConst::NumMaxInstance, sizeof(RingData3DForGPU));
+			instancingResource_[frame][i]->Map(0, nullptr, reinterpret_cast<void**>(&instancingData_[frame][i]));
+
+			materialResource_[frame][i] = dxgi_->CreateBufferResource(sizeof(PrimitiveMaterialData3DForGPU) * PrimitiveCommonConst::NumMaxInstance);
+			materialSrvIndex_[frame][i] = srvUavManager_->Allocate();
+			srvUavManager_->CreateSrvStructuredBuffer(materialSrvIndex_[frame][i], materialResource_[frame][i].Get(), PrimitiveCommonConst::NumMaxInstance, sizeof(PrimitiveMaterialData3DForGPU));
+			materialResource_[frame][i]->Map(0, nullptr, reinterpret_cast<void**>(&materialData_[frame][i]));
+
+			currentIndex_[i] = 0;
+			instanceCount_[i] = 0;
+
+			uint32_t texIndex = MAGISYSTEM::GetTexture()["EngineAssets/Images/uvChecker.png"].srvIndex;
+			for (uint32_t j = 0; j < PrimitiveCommonConst::NumMaxInstance; ++j) {
+				materialData_[frame][i][j].textureIndex = texIndex;
+				materialData_[frame][i][j].baseColor = { 1.0f, 1.0f, 1.0f, 1.0f };
+				materialData_[frame][i][j].uvMatrix = MakeIdentityMatrix4x4();
+			}
 		}
 	}
 
@@ -53,11 +57,31 @@ RingDrawer3D::~RingDrawer3D() {
 }
 
 void RingDrawer3D::Update() {
+	// 奥から順に描くブレンドモードを並べ替えて今のフレームのリソースへ書き込む
+	const uint32_t frameIndex = directXCommand_->GetFrameIndex();
+	for (uint32_t i = 0; i < kBlendModeNum; ++i) {
+		if (depthSortBuffers_[i].GetCount() == 0) continue;
+		depthSortBuffers_[i].Flush(instancingData_[frameIndex][i], materialData_[frameIndex][i], PrimitiveCommonConst::NumMaxInstance);
+	}
+
 	for (uint32_t i = 0; i < kBlendModeNum; ++i) {
 		assert(currentIndex_[i] <= PrimitiveCommonConst::NumMaxInstance);
 		instanceCount_[i] = currentIndex_[i];
 		currentIndex_[i] = 0;
 	}
+
+	// インスタンスがあるブレンドモードだけ描画キューに積む
+	for (uint32_t i = 0; i < kBlendModeNum; ++i) {
+		if (instanceCount_[i] == 0) continue;
+		const BlendMode mode = static_cast<BlendMode>(i);
+		const RenderPass pass = mode == BlendMode::None ? RenderPass::GBuffer : RenderPass::Transparent;
+		renderQueue_->Submit(this, pass, mode, static_cast<uint32_t>(GraphicsPipelineStateType::Ring3D), 0);
+	}
+}
+
+void RingDrawer3D::ExecuteRenderItem(const RenderItem& item, [[maybe_unused]] bool isPipelineChanged) {
+	// ブレンドモードごとにひとつしか積まないので、パイプラインは毎回設定する
+	Draw(RenderQueue::GetBlendMode(item.key));
 }
 
 void RingDrawer3D::Draw(BlendMode mode) {
@@ -65,12 +89,13 @@ void RingDrawer3D::Draw(BlendMode mode) {
 	if (instanceCount_[i] == 0) return;
 
 	ID3D12GraphicsCommandList6* commandList = directXCommand_->GetList6();
+	const uint32_t frameIndex = directXCommand_->GetFrameIndex();
 	commandList->SetGraphicsRootSignature(graphicsPipelineManager_->GetRootSignature(GraphicsPipelineStateType::Ring3D));
 	commandList->SetPipelineState(graphicsPipelineManager_->GetPipelineState(GraphicsPipelineStateType::Ring3D, mode));
 	camera3DManager_->TransferCurrentCamera(0);
 
-	commandList->SetGraphicsRootDescriptorTable(1, srvUavManager_->GetDescriptorHandleGPU(instancingSrvIndex_[i]));
-	commandList->SetGraphicsRootDescriptorTable(2, srvUavManager_->GetDescriptorHandleGPU(materialSrvIndex_[i]));
+	commandList->SetGraphicsRootDescriptorTable(1, srvUavManager_->GetDescriptorHandleGPU(instancingSrvIndex_[frameIndex][i]));
+	commandList->SetGraphicsRootDescriptorTable(2, srvUavManager_->GetDescriptorHandleGPU(materialSrvIndex_[frameIndex][i]));
 	commandList->SetGraphicsRootDescriptorTable(3, srvUavManager_->GetDescriptorHandleGPU(0));
 
 	RootConstants rootConstants{};
@@ -82,6 +107,8 @@ void RingDrawer3D::Draw(BlendMode mode) {
 
 void RingDrawer3D::AddRing(const Matrix4x4& worldMatrix, const RingData3D& data, const MaterialData3D& material) {
 	const uint32_t blendIndex = static_cast<uint32_t>(material.blendMode);
+	// 今のフレームのリソースへ書き込む
+	const uint32_t frameIndex = directXCommand_->GetFrameIndex();
 
 #if defined(DEBUG) || defined(DEVELOP)
 	if (currentIndex_[blendIndex] >= PrimitiveCommonConst::NumMaxInstance) {
@@ -113,8 +140,13 @@ void RingDrawer3D::AddRing(const Matrix4x4& worldMatrix, const RingData3D& data,
 		.uvMatrix = MakeUVMatrix(material.uvScale, material.uvRotate, material.uvTranslate)
 	};
 
-	instancingData_[blendIndex][currentIndex_[blendIndex]] = newRingData;
-	materialData_[blendIndex][currentIndex_[blendIndex]] = newMaterialData;
+	if (IsDepthSortedBlendMode(material.blendMode)) {
+		// 奥から順に描くブレンドモードはUpdateで並べ替えてから書き込む
+		depthSortBuffers_[blendIndex].Add(newRingData, newMaterialData, camera3DManager_->GetViewDepth(ExtractionWorldPos(worldMatrix)));
+	} else {
+		instancingData_[frameIndex][blendIndex][currentIndex_[blendIndex]] = newRingData;
+		materialData_[frameIndex][blendIndex][currentIndex_[blendIndex]] = newMaterialData;
+	}
 	currentIndex_[blendIndex]++;
 }
 
@@ -141,4 +173,9 @@ void RingDrawer3D::SetGraphicsPipelineManager(GraphicsPipelineManager* graphicsP
 void RingDrawer3D::SetCamera3DManager(Camera3DManager* camera3DManager) {
 	assert(camera3DManager);
 	camera3DManager_ = camera3DManager;
+}
+
+void RingDrawer3D::SetRenderQueue(RenderQueue* renderQueue) {
+	assert(renderQueue);
+	renderQueue_ = renderQueue;
 }
\ No newline at end of file
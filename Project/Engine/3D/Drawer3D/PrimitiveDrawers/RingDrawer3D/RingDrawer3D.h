@@ -11,6 +11,9 @@
 #include "Structs/Primitive3DStruct.h"
 #include "Structs/ColorStruct.h"
 #include "Enums/BlendModeEnum.h"
+#include "Const/FrameConst.h"
+#include "RenderQueue/RenderQueue.h"
+#include "3D/Drawer3D/DepthSortBuffer/DepthSortBuffer.h"
 
 class DXGI;
 class DirectXCommand;
@@ -21,20 +24,22 @@ class Camera3DManager;
 /// <summary>
 /// 3Dリング描画クラス
 /// </summary>
-class RingDrawer3D {
+class RingDrawer3D : public RenderQueueSubmitter {
 public:
 	RingDrawer3D(
 		DXGI* dxgi,
 		DirectXCommand* directXCommand,
 		SRVUAVManager* srvUavManager,
 		GraphicsPipelineManager* graphicsPipelineManager,
-		Camera3DManager* camera3DManager
+		Camera3DManager* camera3DManager,
+		RenderQueue* renderQueue
 	);
 	~RingDrawer3D();
 
 
 	void Update();
-	void Draw(BlendMode mode);
+	// 描画キューから積んだ描画を記録する
+	void ExecuteRenderItem(const RenderItem& item, bool isPipelineChanged) override;
 
 	void AddRing(
 		const Matrix4x4& worldMatrix,
@@ -42,28 +47,32 @@ public:
 		const MaterialData3D& material
 	);
 
+private:
+	void Draw(BlendMode mode);
+
 private:
 	void SetDXGI(DXGI* dxgi);
 	void SetDirectXCommand(DirectXCommand* directXCommand);
 	void SetSRVUAVManager(SRVUAVManager* srvUavManager);
 	void SetGraphicsPipelineManager(GraphicsPipelineManager* graphicsPipelineManager);
 	void SetCamera3DManager(Camera3DManager* camera3DManager);
+	void SetRenderQueue(RenderQueue* renderQueue);
 
 private:
 	// instancing描画用のリソース
-	ComPtr<ID3D12Resource> instancingResource_[static_cast<uint32_t>(BlendMode::Num)];
+	ComPtr<ID3D12Resource> instancingResource_[FrameConst::FrameCount][static_cast<uint32_t>(BlendMode::Num)];
 	// instancing描画用のデータ
-	RingData3DForGPU* instancingData_[static_cast<uint32_t>(BlendMode::Num)];
+	RingData3DForGPU* instancingData_[FrameConst::FrameCount][static_cast<uint32_t>(BlendMode::Num)];
 
 	// マテリアルのリソース
-	ComPtr<ID3D12Resource> materialResource_[static_cast<uint32_t>(BlendMode::Num)];
+	ComPtr<ID3D12Resource> materialResource_[FrameConst::FrameCount][static_cast<uint32_t>(BlendMode::Num)];
 	// マテリアルデータ
-	PrimitiveMaterialData3DForGPU* materialData_[static_cast<uint32_t>(BlendMode::Num)];
+	PrimitiveMaterialData3DForGPU* materialData_[FrameConst::FrameCount][static_cast<uint32_t>(BlendMode::Num)];
 
 	// Ring3DSrvIndex
-	uint32_t instancingSrvIndex_[static_cast<uint32_t>(BlendMode::Num)];
+	uint32_t instancingSrvIndex_[FrameConst::FrameCount][static_cast<uint32_t>(BlendMode::Num)];
 	// MaterialSrvIndex
-	uint32_t materialSrvIndex_[static_cast<uint32_t>(BlendMode::Num)];
+	uint32_t materialSrvIndex_[FrameConst::FrameCount][static_cast<uint32_t>(BlendMode::Num)];
 
 	// instance描画する際に使う変数
 	uint32_t instanceCount_[static_cast<uint32_t>(BlendMode::Num)];
@@ -71,10 +80,14 @@ private:
 	// 現在のインデックス
 	uint32_t currentIndex_[static_cast<uint32_t>(BlendMode::Num)];
 
+	// 奥から順に描くブレンドモードのインスタンス(Updateで並べ替えてからリソースへ書き込む)
+	DepthSortBuffer<RingData3DForGPU, PrimitiveMaterialData3DForGPU> depthSortBuffers_[static_cast<uint32_t>(BlendMode::Num)];
+
 private:
 	DXGI* dxgi_ = nullptr;
 	DirectXCommand* directXCommand_ = nullptr;
 	SRVUAVManager* srvUavManager_ = nullptr;
 	GraphicsPipelineManager* graphicsPipelineManager_ = nullptr;
 	Camera3DManager* camera3DManager_ = nullptr;
+	RenderQueue* renderQueue_ = nullptr;
 };
\ No newline at end of file
@@ -71,7 +71,8 @@ void SkyBoxDrawer::Update() {
 	Matrix4x4 scaleMat = MakeScaleMatrix(scale);
 	Matrix4x4 translateMat = MakeTranslateMatrix(translate);
 
-	skyBoxData_->worldMatrix = scaleMat * translateMat;
+	// 今のフレームのリソースへ書き込む
+	skyBoxData_[directXCommand_->GetFrameIndex()]->worldMatrix = scaleMat * translateMat;
 }
 
 void SkyBoxDrawer::Draw() {
@@ -91,7 +92,7 @@ void SkyBoxDrawer::Draw() {
 	commandList->IASetIndexBuffer(&indexBufferView_);
 
 	// スカイボックスのデータをセット
-	commandList->SetGraphicsRootConstantBufferView(0, skyBoxResource_->GetGPUVirtualAddress());
+	commandList->SetGraphicsRootConstantBufferView(0, skyBoxResource_[directXCommand_->GetFrameIndex()]->GetGPUVirtualAddress());
 
 	// カメラをセット
 	camera3DManager_->TransferCurrentCamera(1);
@@ -197,13 +198,17 @@ void SkyBoxDrawer::MapIndexData() {
 }
 
 void SkyBoxDrawer::CreateSkyBoxResource() {
-	skyBoxResource_ = dxgi_->CreateBufferResource(sizeof(SkyBoxDataForGPU));
+	for (uint32_t frame = 0; frame < FrameConst::FrameCount; ++frame) {
+		skyBoxResource_[frame] = dxgi_->CreateBufferResource(sizeof(SkyBoxDataForGPU));
+	}
 }
 
 void SkyBoxDrawer::MapSkyBoxData() {
-	skyBoxData_ = nullptr;
-	skyBoxResource_->Map(0, nullptr, reinterpret_cast<void**>(&skyBoxData_));
-	skyBoxData_->worldMatrix = MakeIdentityMatrix4x4();
+	for (uint32_t frame = 0; frame < FrameConst::FrameCount; ++frame) {
+		skyBoxData_[frame] = nullptr;
+		skyBoxResource_[frame]->Map(0, nullptr, reinterpret_cast<void**>(&skyBoxData_[frame]));
+		skyBoxData_[frame]->worldMatrix = MakeIdentityMatrix4x4();
+	}
 }
 
 void SkyBoxDrawer::SetDXGI(DXGI* dxgi) {
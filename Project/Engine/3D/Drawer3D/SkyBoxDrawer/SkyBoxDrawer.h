@@ -9,6 +9,7 @@
 #include "DirectX/ComPtr/ComPtr.h"
 #include "Math/Utility/MathUtility.h"
 #include "Structs/SkyBoxStruct.h"
+#include "Const/FrameConst.h"
 
 class DXGI;
 class DirectXCommand;
@@ -77,10 +78,10 @@ private:
 	// インデックスデータ
 	std::vector<uint32_t> indices_;
 
-	// スカイボックスのリソース
-	ComPtr<ID3D12Resource> skyBoxResource_ = nullptr;
+	// スカイボックスのリソース(フレームごと)
+	ComPtr<ID3D12Resource> skyBoxResource_[FrameConst::FrameCount];
 	// スカイボックスのデータ
-	SkyBoxDataForGPU* skyBoxData_ = nullptr;
+	SkyBoxDataForGPU* skyBoxData_[FrameConst::FrameCount]{};
 
 
 	// テクスチャのインデックス
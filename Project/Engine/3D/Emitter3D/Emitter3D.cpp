@@ -54,7 +54,10 @@ void Emitter3D::EmitAll() {
 		// デフォルト
 	case EmitType::Default:
 		// パーティクルグループの個数分ループ
-		for (auto particleGroup : particleGroups_) {
+		for (const auto& particleGroup : particleGroups_) {
+			// 発生するパーティクルをフレーム単位の一時メモリに積んでからまとめて渡す
+			FrameVector<EmitParamater> emitBatch(FrameArenaAllocator<EmitParamater>(MAGISYSTEM::GetFrameArena()));
+			emitBatch.reserve(emitterSetting_.count);
 			// 発生個数分ループ
 			for (uint32_t i = 0; i < emitterSetting_.count; i++) {
 
@@ -78,13 +81,17 @@ void Emitter3D::EmitAll() {
 				// 生存時間
 				emitParamater.lifeTime = Random::GenerateFloat(emitterSetting_.minLifeTime, emitterSetting_.maxLifeTime);
 
-				particleGroup.second->AddNewParticle(emitParamater);
+				emitBatch.push_back(emitParamater);
 			}
+			particleGroup.second->AddNewParticles(emitBatch);
 		}
 		break;
 	case EmitType::Random:
 		// パーティクルグループの個数分ループ
-		for (auto particleGroup : particleGroups_) {
+		for (const auto& particleGroup : particleGroups_) {
+			// 発生するパーティクルをフレーム単位の一時メモリに積んでからまとめて渡す
+			FrameVector<EmitParamater> emitBatch(FrameArenaAllocator<EmitParamater>(MAGISYSTEM::GetFrameArena()));
+			emitBatch.reserve(emitterSetting_.count);
 			// 発生個数分ループ
 			for (uint32_t i = 0; i < emitterSetting_.count; i++) {
 				// 発生座標
@@ -108,8 +115,9 @@ void Emitter3D::EmitAll() {
 				// 生存時間
 				emitParamater.lifeTime = Random::GenerateFloat(emitterSetting_.minLifeTime, emitterSetting_.maxLifeTime);
 
-				particleGroup.second->AddNewParticle(emitParamater);
+				emitBatch.push_back(emitParamater);
 			}
+			particleGroup.second->AddNewParticles(emitBatch);
 		}
 		break;
 	}
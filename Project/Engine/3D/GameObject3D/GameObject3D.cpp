@@ -58,6 +58,20 @@ void GameObject3D::SetIsActive(bool isActive) {
 	isActive_ = isActive;
 }
 
+void GameObject3D::SetSpatialProxyId(uint32_t proxyId) {
+	spatialProxyId_ = proxyId;
+}
+
+bool GameObject3D::UpdateModelBounds() {
+	bool isUpdated = false;
+	for (const auto& modelRenderer : modelRendererComponents_) {
+		if (auto it = modelRenderer.second.lock()) {
+			isUpdated |= it->UpdateLocalAABB();
+		}
+	}
+	return isUpdated;
+}
+
 const std::string& GameObject3D::GetName()const {
 	return name_;
 }
@@ -84,3 +98,47 @@ std::weak_ptr<ModelRenderer> GameObject3D::GetModelRenderer(const std::string& r
 
 	return {};
 }
+
+
+bool GameObject3D::HasModelRenderer() const {
+	for (const auto& modelRenderer : modelRendererComponents_) {
+		if (!modelRenderer.second.expired()) {
+			return true;
+		}
+	}
+	return false;
+}
+
+AABB GameObject3D::GetWorldAABB() const {
+	AABB result{};
+	bool isFirst = true;
+	for (const auto& modelRenderer : modelRendererComponents_) {
+		if (auto it = modelRenderer.second.lock()) {
+			const AABB aabb = it->GetWorldAABB();
+			result = isFirst ? aabb : MAGIMath::MergeAABB(result, aabb);
+			isFirst = false;
+		}
+	}
+
+	// レンダラーが無い場合は位置だけの箱
+	if (isFirst) {
+		const Vector3 position = MAGIMath::ExtractionWorldPos(transformComponent_->GetWorldMatrix());
+		result = { position, position };
+	}
+	return result;
+}
+
+bool GameObject3D::GetIsWorldAABBChanged() const {
+	for (const auto& modelRenderer : modelRendererComponents_) {
+		if (auto it = modelRenderer.second.lock()) {
+			if (it->GetTransform()->GetIsWorldMatrixUpdated()) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+uint32_t GameObject3D::GetSpatialProxyId() const {
+	return spatialProxyId_;
+}
\ No newline at end of file
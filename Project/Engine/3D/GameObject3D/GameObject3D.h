@@ -4,9 +4,11 @@
 #include <string>
 #include <unordered_map>
 #include <memory>
+#include <cstdint>
 
 #include "Math/Types/Vector3.h"
 #include "Math/Types/Quaternion.h"
+#include "Math/Types/AABB.h"
 
 // 前方宣言
 class Transform3D;
@@ -27,8 +29,12 @@ public:
 
 	void AddModelRenderer(std::shared_ptr<ModelRenderer> modelRenderer);
 
+	// 読み込みが後から終わったモデルの境界ボックスを取り込む(取り込んだらtrue)
+	bool UpdateModelBounds();
+
 	void SetIsAlive(bool isAlive);
 	void SetIsActive(bool isActive);
+	void SetSpatialProxyId(uint32_t proxyId);
 
 	[[nodiscard]] const std::string& GetName()const;
 
@@ -37,6 +43,15 @@ public:
 
 	[[nodiscard]] Transform3D* GetTransform();
 	[[nodiscard]] std::weak_ptr<ModelRenderer> GetModelRenderer(const std::string& rendererName);
+
+	// モデル描画コンポーネントを持っているか
+	[[nodiscard]] bool HasModelRenderer()const;
+	// 全モデル描画コンポーネントを包むワールド空間の境界ボックス
+	[[nodiscard]] AABB GetWorldAABB()const;
+	// 今フレームで境界ボックスが変化したか
+	[[nodiscard]] bool GetIsWorldAABBChanged()const;
+	// 空間インデックスのプロキシID
+	[[nodiscard]] uint32_t GetSpatialProxyId()const;
 private:
 	// 名前
 	std::string name_ = "";
@@ -44,6 +59,8 @@ private:
 	bool isAlive_ = true;
 	// 有効フラグ
 	bool isActive_ = true;
+	// 空間インデックスのプロキシID
+	uint32_t spatialProxyId_ = 0xFFFFFFFF;
 
 	//=======================
 	// コンポーネント
@@ -0,0 +1,209 @@
+#include "LooseOctree.h"
+
+// C++
+#include <cassert>
+#include <cmath>
+#include <algorithm>
+
+LooseOctree::LooseOctree(const AABB& worldBounds, uint32_t maxDepth) {
+	maxDepth_ = maxDepth;
+	Rebuild(worldBounds);
+}
+
+void LooseOctree::Rebuild(const AABB& worldBounds) {
+	worldBounds_ = worldBounds;
+
+	// 立方体のルートを作り直す
+	const Vector3 extent = MAGIMath::ExtentAABB(worldBounds_);
+	const float halfSize = (std::max)({ extent.x, extent.y, extent.z, 1.0f });
+	nodes_.clear();
+	CreateNode(MAGIMath::CenterAABB(worldBounds_), halfSize, 0);
+
+	// 登録済みのプロキシを入れ直す
+	for (uint32_t i = 0; i < static_cast<uint32_t>(proxies_.size()); i++) {
+		if (proxies_[i].isUsed) {
+			LinkProxy(i, FindTargetNode(proxies_[i].bounds));
+		}
+	}
+}
+
+void LooseOctree::Clear() {
+	proxies_.clear();
+	freeProxyIds_.clear();
+	proxyCount_ = 0;
+	Rebuild(worldBounds_);
+}
+
+uint32_t LooseOctree::Insert(const AABB& bounds, GameObject3D* object) {
+	assert(object);
+
+	uint32_t proxyId = 0;
+	if (!freeProxyIds_.empty()) {
+		proxyId = freeProxyIds_.back();
+		freeProxyIds_.pop_back();
+	} else {
+		proxyId = static_cast<uint32_t>(proxies_.size());
+		proxies_.emplace_back();
+	}
+
+	Proxy& proxy = proxies_[proxyId];
+	proxy.bounds = bounds;
+	proxy.object = object;
+	proxy.isUsed = true;
+	proxyCount_++;
+
+	LinkProxy(proxyId, FindTargetNode(bounds));
+	return proxyId;
+}
+
+void LooseOctree::Update(uint32_t proxyId, const AABB& bounds) {
+	assert(proxyId < proxies_.size() && proxies_[proxyId].isUsed);
+
+	Proxy& proxy = proxies_[proxyId];
+	proxy.bounds = bounds;
+
+	// 今のノードのルーズ範囲に収まっていて深さも変わらないならそのまま
+	const Node& current = nodes_[proxy.nodeIndex];
+	const AABB loose = GetLooseBounds(current);
+	const Vector3 center = MAGIMath::CenterAABB(bounds);
+	const bool isInside =
+		center.x >= current.center.x - current.halfSize && center.x <= current.center.x + current.halfSize &&
+		center.y >= current.center.y - current.halfSize && center.y <= current.center.y + current.halfSize &&
+		center.z >= current.center.z - current.halfSize && center.z <= current.center.z + current.halfSize &&
+		bounds.min.x >= loose.min.x && bounds.max.x <= loose.max.x &&
+		bounds.min.y >= loose.min.y && bounds.max.y <= loose.max.y &&
+		bounds.min.z >= loose.min.z && bounds.max.z <= loose.max.z;
+	if (isInside && current.depth == CalculateDepth(bounds)) {
+		return;
+	}
+
+	UnlinkProxy(proxyId);
+	LinkProxy(proxyId, FindTargetNode(bounds));
+}
+
+void LooseOctree::Remove(uint32_t proxyId) {
+	if (proxyId >= proxies_.size() || !proxies_[proxyId].isUsed) {
+		return;
+	}
+
+	UnlinkProxy(proxyId);
+	proxies_[proxyId] = Proxy{};
+	freeProxyIds_.push_back(proxyId);
+	proxyCount_--;
+}
+
+void LooseOctree::QueryAABB(const AABB& bounds, std::vector<GameObject3D*>& result) const {
+	auto test = [&bounds](const AABB& target) {
+		return MAGIMath::IsIntersectAABB(bounds, target);
+		};
+	Query(test, test, result);
+}
+
+void LooseOctree::QuerySphere(const Vector3& center, float radius, std::vector<GameObject3D*>& result) const {
+	auto test = [&center, radius](const AABB& target) {
+		return MAGIMath::IsIntersectAABBSphere(target, center, radius);
+		};
+	Query(test, test, result);
+}
+
+void LooseOctree::QueryFrustum(const Vector4 planes[6], std::vector<GameObject3D*>& result) const {
+	auto test = [planes](const AABB& target) {
+		return MAGIMath::IsAABBInFrustum(target, planes);
+		};
+	Query(test, test, result);
+}
+
+uint32_t LooseOctree::GetProxyCount() const {
+	return proxyCount_;
+}
+
+const AABB& LooseOctree::GetWorldBounds() const {
+	return worldBounds_;
+}
+
+uint32_t LooseOctree::CreateNode(const Vector3& center, float halfSize, uint32_t depth) {
+	Node node{};
+	node.center = center;
+	node.halfSize = halfSize;
+	node.depth = depth;
+	node.children.fill(-1);
+	nodes_.push_back(std::move(node));
+	return static_cast<uint32_t>(nodes_.size() - 1);
+}
+
+uint32_t LooseOctree::FindTargetNode(const AABB& bounds) {
+	const Vector3 center = MAGIMath::CenterAABB(bounds);
+
+	// ルート範囲外に中心があるものはルートで抱える
+	const Node& root = nodes_[0];
+	if (std::abs(center.x - root.center.x) > root.halfSize ||
+		std::abs(center.y - root.center.y) > root.halfSize ||
+		std::abs(center.z - root.center.z) > root.halfSize) {
+		return 0;
+	}
+
+	const uint32_t targetDepth = CalculateDepth(bounds);
+
+	// 中心の位置で子ノードを辿る
+	uint32_t nodeIndex = 0;
+	while (nodes_[nodeIndex].depth < targetDepth) {
+		const Node& node = nodes_[nodeIndex];
+		const uint32_t octant =
+			(center.x >= node.center.x ? 1u : 0u) |
+			(center.y >= node.center.y ? 2u : 0u) |
+			(center.z >= node.center.z ? 4u : 0u);
+
+		int32_t child = node.children[octant];
+		if (child < 0) {
+			const float childHalf = node.halfSize * 0.5f;
+			const Vector3 childCenter = {
+				node.center.x + ((octant & 1u) ? childHalf : -childHalf),
+				node.center.y + ((octant & 2u) ? childHalf : -childHalf),
+				node.center.z + ((octant & 4u) ? childHalf : -childHalf),
+			};
+			const uint32_t depth = node.depth + 1;
+			// CreateNodeでnodes_が再確保されるのでnodeは以降使わない
+			child = static_cast<int32_t>(CreateNode(childCenter, childHalf, depth));
+			nodes_[nodeIndex].children[octant] = child;
+		}
+		nodeIndex = static_cast<uint32_t>(child);
+	}
+	return nodeIndex;
+}
+
+uint32_t LooseOctree::CalculateDepth(const AABB& bounds) const {
+	// ルーズ係数2なら、最大半径がノードの半分の大きさ以下であれば中心がどこでもはみ出さない
+	const Vector3 extent = MAGIMath::ExtentAABB(bounds);
+	const float radius = (std::max)({ extent.x, extent.y, extent.z });
+	if (radius <= 0.0f) {
+		return maxDepth_;
+	}
+	const float ratio = nodes_[0].halfSize * (kLooseness - 1.0f) / radius;
+	if (ratio < 1.0f) {
+		return 0;
+	}
+	const uint32_t depth = static_cast<uint32_t>(std::floor(std::log2(ratio)));
+	return (std::min)(depth, maxDepth_);
+}
+
+AABB LooseOctree::GetLooseBounds(const Node& node) const {
+	const float looseHalf = node.halfSize * kLooseness;
+	return AABB{
+		.min = { node.center.x - looseHalf, node.center.y - looseHalf, node.center.z - looseHalf },
+		.max = { node.center.x + looseHalf, node.center.y + looseHalf, node.center.z + looseHalf },
+	};
+}
+
+void LooseOctree::LinkProxy(uint32_t proxyId, uint32_t nodeIndex) {
+	proxies_[proxyId].nodeIndex = nodeIndex;
+	nodes_[nodeIndex].proxies.push_back(proxyId);
+}
+
+void LooseOctree::UnlinkProxy(uint32_t proxyId) {
+	std::vector<uint32_t>& list = nodes_[proxies_[proxyId].nodeIndex].proxies;
+	auto it = std::find(list.begin(), list.end(), proxyId);
+	if (it != list.end()) {
+		*it = list.back();
+		list.pop_back();
+	}
+}
@@ -0,0 +1,142 @@
+#pragma once
+
+// C++
+#include <vector>
+#include <array>
+#include <cstdint>
+
+// MyHedder
+#include "Math/Utility/MathUtility.h"
+
+// 前方宣言
+class GameObject3D;
+
+/// <summary>
+/// ルーズ八分木による空間インデックス
+/// (ノードの判定範囲を実サイズの2倍に広げ、オブジェクトを大きさに合った深さのノード1つにだけ登録する)
+/// </summary>
+class LooseOctree {
+public:
+	// 無効なプロキシID
+	static constexpr uint32_t kInvalidProxyId = 0xFFFFFFFF;
+
+	LooseOctree(const AABB& worldBounds = kDefaultWorldBounds, uint32_t maxDepth = kDefaultMaxDepth);
+	~LooseOctree() = default;
+
+	// ルートの範囲を作り直して全プロキシを再登録
+	void Rebuild(const AABB& worldBounds);
+	// 全削除
+	void Clear();
+
+	// 登録してプロキシIDを返す
+	uint32_t Insert(const AABB& bounds, GameObject3D* object);
+	// 境界ボックスの更新
+	void Update(uint32_t proxyId, const AABB& bounds);
+	// 登録解除
+	void Remove(uint32_t proxyId);
+
+	// AABBと交差するオブジェクトを取得
+	void QueryAABB(const AABB& bounds, std::vector<GameObject3D*>& result) const;
+	// 球と交差するオブジェクトを取得
+	void QuerySphere(const Vector3& center, float radius, std::vector<GameObject3D*>& result) const;
+	// フラスタムにかかるオブジェクトを取得
+	void QueryFrustum(const Vector4 planes[6], std::vector<GameObject3D*>& result) const;
+
+	// 登録数を取得
+	uint32_t GetProxyCount() const;
+	// ルートの範囲を取得
+	const AABB& GetWorldBounds() const;
+
+private:
+	// ノード
+	struct Node {
+		Vector3 center;
+		float halfSize;
+		uint32_t depth;
+		// 子ノードのインデックス(無ければ-1)
+		std::array<int32_t, 8> children;
+		// このノードに登録されているプロキシ
+		std::vector<uint32_t> proxies;
+	};
+
+	// 登録物
+	struct Proxy {
+		AABB bounds;
+		GameObject3D* object = nullptr;
+		uint32_t nodeIndex = 0;
+		bool isUsed = false;
+	};
+
+private:
+	// ノード作成
+	uint32_t CreateNode(const Vector3& center, float halfSize, uint32_t depth);
+	// 境界ボックスに合ったノードを探す(必要なら子ノードを作成)
+	uint32_t FindTargetNode(const AABB& bounds);
+	// 境界ボックスが収まる深さを計算
+	uint32_t CalculateDepth(const AABB& bounds) const;
+	// ノードのルーズ範囲を取得
+	AABB GetLooseBounds(const Node& node) const;
+	// ノードにプロキシを登録
+	void LinkProxy(uint32_t proxyId, uint32_t nodeIndex);
+	// ノードからプロキシを外す
+	void UnlinkProxy(uint32_t proxyId);
+
+	// 条件を満たすノードを走査してオブジェクトを集める
+	template <typename NodeTest, typename ProxyTest>
+	void Query(NodeTest nodeTest, ProxyTest proxyTest, std::vector<GameObject3D*>& result) const;
+
+private:
+	// デフォルトのワールド範囲
+	static constexpr AABB kDefaultWorldBounds = { { -1024.0f,-1024.0f,-1024.0f }, { 1024.0f,1024.0f,1024.0f } };
+	// デフォルトの最大深さ
+	static constexpr uint32_t kDefaultMaxDepth = 8;
+	// ルーズ係数
+	static constexpr float kLooseness = 2.0f;
+
+	// ルートの範囲
+	AABB worldBounds_{};
+	// 最大深さ
+	uint32_t maxDepth_ = kDefaultMaxDepth;
+
+	// ノード(0番がルート)
+	std::vector<Node> nodes_;
+	// プロキシ
+	std::vector<Proxy> proxies_;
+	// 空きプロキシID
+	std::vector<uint32_t> freeProxyIds_;
+	// 登録数
+	uint32_t proxyCount_ = 0;
+};
+
+template<typename NodeTest, typename ProxyTest>
+inline void LooseOctree::Query(NodeTest nodeTest, ProxyTest proxyTest, std::vector<GameObject3D*>& result) const {
+	if (nodes_.empty()) {
+		return;
+	}
+
+	// 深さ優先で走査
+	std::vector<uint32_t> stack;
+	stack.push_back(0);
+	while (!stack.empty()) {
+		const Node& node = nodes_[stack.back()];
+		stack.pop_back();
+
+		// ルートは範囲外のオブジェクトも抱えているので必ず調べる
+		if (node.depth != 0 && !nodeTest(GetLooseBounds(node))) {
+			continue;
+		}
+
+		for (uint32_t proxyId : node.proxies) {
+			const Proxy& proxy = proxies_[proxyId];
+			if (proxyTest(proxy.bounds)) {
+				result.push_back(proxy.object);
+			}
+		}
+
+		for (int32_t child : node.children) {
+			if (child >= 0) {
+				stack.push_back(static_cast<uint32_t>(child));
+			}
+		}
+	}
+}
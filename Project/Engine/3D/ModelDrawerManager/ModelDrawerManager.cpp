@@ -2,9 +2,12 @@
 
 // C++
 #include <cassert>
+#include <algorithm>
 
 // MyHedder
 #include "Logger/Logger.h"
+#include "Const/ModelConst.h"
+#include "WindowApp/WindowApp.h"
 
 #include "DirectX/DXGI/DXGI.h"
 #include "DirectX/DirectXCommand/DirectXCommand.h"
@@ -12,6 +15,11 @@
 #include "PipelineManagers/GraphicsPipelineManager/GraphicsPipelineManager.h"
 #include "PipelineManagers/ShadowPipelineManager/ShadowPipelineManager.h"
 #include "Camera3DManager/Camera3DManager.h"
+#include "LightManager/LightManager.h"
+#include "OcclusionCuller/OcclusionCuller.h"
+#include "TextureDataContainer/TextureDataContainer.h"
+#include "ResidencyManager/ResidencyManager.h"
+#include "RenderQueue/RenderQueue.h"
 
 ModelDrawerManager::ModelDrawerManager(
 	DXGI* dxgi,
@@ -19,7 +27,12 @@ ModelDrawerManager::ModelDrawerManager(
 	SRVUAVManager* srvUavManager,
 	GraphicsPipelineManager* graphicsPipelineManager,
 	ShadowPipelineManager* shadowPipelineManager,
-	Camera3DManager* camera3DManager
+	Camera3DManager* camera3DManager,
+	LightManager* lightManager,
+	OcclusionCuller* occlusionCuller,
+	TextureDataContainer* textureDataContainer,
+	ResidencyManager* residencyManager,
+	RenderQueue* renderQueue
 ) {
 	SetDXGI(dxgi);
 	SetDirectXCommand(directXCommand);
@@ -27,6 +40,11 @@ ModelDrawerManager::ModelDrawerManager(
 	SetGraphicsPipelineManager(graphicsPipelineManager);
 	SetShadowPipelineManager(shadowPipelineManager);
 	SetCamera3DManager(camera3DManager);
+	SetLightManager(lightManager);
+	SetOcclusionCuller(occlusionCuller);
+	SetTextureDataContainer(textureDataContainer);
+	SetResidencyManager(residencyManager);
+	SetRenderQueue(renderQueue);
 
 	Logger::Log("ModelDrawerManager Initialize\n");
 }
@@ -36,17 +54,44 @@ ModelDrawerManager::~ModelDrawerManager() {
 }
 
 void ModelDrawerManager::CreateModelDrawer(const std::string& modelDrawerName, const ModelData& modelData) {
+	// 作成済みならリソースを作らない
+	if (HasModelDrawer(modelDrawerName)) {
+		return;
+	}
+
 	// 追加する描画クラスを作成
-	std::unique_ptr<ModelDrawer> newModelDrawer = std::make_unique<ModelDrawer>(modelData);
+	std::unique_ptr<ModelDrawer> newModelDrawer = std::make_unique<ModelDrawer>(modelData, renderQueue_, nextMaterialKey_++);
 
 	// ペアを作って挿入
 	modelDrawers_.insert(std::make_pair(modelDrawerName, std::move(newModelDrawer)));
 }
 
+bool ModelDrawerManager::HasModelDrawer(const std::string& modelDrawerName) const {
+	return modelDrawers_.contains(modelDrawerName);
+}
+
 void ModelDrawerManager::DrawModel(const std::string& modelDrawerName, const Matrix4x4& worldMatrix, const ModelMaterial& material) {
 	auto it = modelDrawers_.find(modelDrawerName);
 	if (it != modelDrawers_.end()) {
-		it->second->AddDrawCommand(worldMatrix, material);
+		// フレームで最初の描画のときだけ常駐を確認する
+		if (it->second->MarkUsed(residencyManager_->GetFrame())) {
+			TouchResidency(it->second.get());
+		}
+
+		const AABB worldAABB = MAGIMath::TransformAABB(it->second->GetLocalAABB(), worldMatrix);
+		// カメラから見た大きさでLODを決める(影も同じLODを使う)
+		const uint32_t lod = SelectLOD(it->second->GetLODErrors(), worldAABB, worldMatrix);
+
+		// 遮蔽されていないものだけカメラ用に積む
+		if (occlusionCuller_->IsVisible(worldAABB)) {
+			it->second->AddDrawCommand(worldMatrix, material, lod, camera3DManager_->GetViewDepth(MAGIMath::CenterAABB(worldAABB)));
+		}
+
+		// ライトの範囲内の不透明なものだけ影描画用に積む
+		if (material.blendMode == BlendMode::None && material.isMakeShadow &&
+			lightManager_->IsInDirectionalLightShadowVolume(worldAABB)) {
+			it->second->AddShadowCommand(worldMatrix, material, lod);
+		}
 	}
 }
 
@@ -57,23 +102,42 @@ void ModelDrawerManager::UpdateAll() {
 	}
 }
 
-void ModelDrawerManager::DrawAll(BlendMode mode) {
-	// ルーシグネイチャをセット
-	directXCommand_->GetList()->SetGraphicsRootSignature(graphicsPipelineManager_->GetRootSignature(GraphicsPipelineStateType::Model3D));
-
-	// 描画
-	for (auto& modelDrawer : modelDrawers_) {
-		modelDrawer.second->Draw(mode);
+uint32_t ModelDrawerManager::SelectLOD(const std::vector<float>& lodErrors, const AABB& worldAABB, const Matrix4x4& worldMatrix) {
+	if (lodErrors.size() <= 1) return 0;
+
+	Camera3D* camera = camera3DManager_->GetCurrentCamera();
+	if (!camera) return 0;
+
+	// 境界ボックスを包む球
+	const Vector3 center = MAGIMath::CenterAABB(worldAABB);
+	const float radius = MAGIMath::Length(MAGIMath::ExtentAABB(worldAABB));
+	// 球の表面までの距離(内側にいる場合は最高精度)
+	const float distance = MAGIMath::Length(center - camera->GetEye()) - radius;
+	if (distance <= 0.0f) return 0;
+
+	// モデル空間の誤差をワールドに直すための最大スケール
+	const float scale = (std::max)({
+		MAGIMath::Length(Vector3{ worldMatrix.m[0][0], worldMatrix.m[0][1], worldMatrix.m[0][2] }),
+		MAGIMath::Length(Vector3{ worldMatrix.m[1][0], worldMatrix.m[1][1], worldMatrix.m[1][2] }),
+		MAGIMath::Length(Vector3{ worldMatrix.m[2][0], worldMatrix.m[2][1], worldMatrix.m[2][2] }),
+		});
+
+	// 距離1での1ワールド単位あたりのピクセル数
+	const float pixelsPerUnit = camera->GetProjectionMatrix().m[1][1] * static_cast<float>(WindowApp::kClientHeight) * 0.5f;
+
+	// オブジェクト空間の誤差を画面上のピクセルに直して比べる
+	uint32_t result = 0;
+	for (uint32_t lod = 1; lod < static_cast<uint32_t>(lodErrors.size()); lod++) {
+		const float pixelError = lodErrors[lod] * scale * pixelsPerUnit / distance;
+		if (pixelError > ModelLODConst::PixelErrorThreshold) break;
+		result = lod;
 	}
+	return result;
 }
 
-void ModelDrawerManager::DrawShadowAll(BlendMode mode) {
-	// ルーシグネイチャをセット
-	directXCommand_->GetList()->SetGraphicsRootSignature(shadowPipelineManager_->GetRootSignature(ShadowPipelineStateType::Model));
-
-	// 描画
-	for (auto& modelDrawer : modelDrawers_) {
-		modelDrawer.second->DrawShadow(mode);
+void ModelDrawerManager::TouchResidency(ModelDrawer* modelDrawer) {
+	for (const std::string& textureFilePath : modelDrawer->GetTextureFilePaths()) {
+		textureDataContainer_->Touch(textureFilePath);
 	}
 }
 
@@ -106,3 +170,28 @@ void ModelDrawerManager::SetCamera3DManager(Camera3DManager* camera3DManager) {
 	assert(camera3DManager);
 	camera3DManager_ = camera3DManager;
 }
+
+void ModelDrawerManager::SetLightManager(LightManager* lightManager) {
+	assert(lightManager);
+	lightManager_ = lightManager;
+}
+
+void ModelDrawerManager::SetOcclusionCuller(OcclusionCuller* occlusionCuller) {
+	assert(occlusionCuller);
+	occlusionCuller_ = occlusionCuller;
+}
+
+void ModelDrawerManager::SetTextureDataContainer(TextureDataContainer* textureDataContainer) {
+	assert(textureDataContainer);
+	textureDataContainer_ = textureDataContainer;
+}
+
+void ModelDrawerManager::SetResidencyManager(ResidencyManager* residencyManager) {
+	assert(residencyManager);
+	residencyManager_ = residencyManager;
+}
+
+void ModelDrawerManager::SetRenderQueue(RenderQueue* renderQueue) {
+	assert(renderQueue);
+	renderQueue_ = renderQueue;
+}
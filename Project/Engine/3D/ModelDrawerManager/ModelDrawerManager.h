@@ -18,6 +18,11 @@ class SRVUAVManager;
 class GraphicsPipelineManager;
 class ShadowPipelineManager;
 class Camera3DManager;
+class LightManager;
+class OcclusionCuller;
+class TextureDataContainer;
+class ResidencyManager;
+class RenderQueue;
 
 /// <summary>
 /// モデル描画クラスのマネージャー
@@ -30,16 +35,27 @@ public:
 		SRVUAVManager* srvUavManager,
 		GraphicsPipelineManager* graphicsPipelineManager,
 		ShadowPipelineManager* shadowPipelineManager,
-		Camera3DManager* camera3DManager
+		Camera3DManager* camera3DManager,
+		LightManager* lightManager,
+		OcclusionCuller* occlusionCuller,
+		TextureDataContainer* textureDataContainer,
+		ResidencyManager* residencyManager,
+		RenderQueue* renderQueue
 	);
 	~ModelDrawerManager();
 
 	void CreateModelDrawer(const std::string& modelDrawerName, const ModelData& modelData);
+	// 描画クラスが作られているか
+	bool HasModelDrawer(const std::string& modelDrawerName)const;
 	void DrawModel(const std::string& modelDrawerName, const Matrix4x4& worldMatrix, const ModelMaterial& material);
+	// 全モデル描画クラスを更新して描画キューに積む
 	void UpdateAll();
-	void DrawAll(BlendMode mode);
 
-	void DrawShadowAll(BlendMode mode);
+private:
+	// 投影した誤差が許容ピクセル以下になる最も粗いLODを選ぶ
+	uint32_t SelectLOD(const std::vector<float>& lodErrors, const AABB& worldAABB, const Matrix4x4& worldMatrix);
+	// モデルが使うテクスチャを使ったことにする(追い出されていれば戻す)
+	void TouchResidency(ModelDrawer* modelDrawer);
 
 private:
 	void SetDXGI(DXGI* dxgi);
@@ -48,10 +64,17 @@ private:
 	void SetGraphicsPipelineManager(GraphicsPipelineManager* graphicsPipelineManager);
 	void SetShadowPipelineManager(ShadowPipelineManager* shadowPipelineManager);
 	void SetCamera3DManager(Camera3DManager* camera3DManager);
+	void SetLightManager(LightManager* lightManager);
+	void SetOcclusionCuller(OcclusionCuller* occlusionCuller);
+	void SetTextureDataContainer(TextureDataContainer* textureDataContainer);
+	void SetResidencyManager(ResidencyManager* residencyManager);
+	void SetRenderQueue(RenderQueue* renderQueue);
 
 private:
 	// 描画クラスのコンテナ
 	std::unordered_map<std::string, std::unique_ptr<ModelDrawer>> modelDrawers_;
+	// 次に作る描画クラスの描画キューでのマテリアル
+	uint32_t nextMaterialKey_ = 0;
 
 private:
 	DXGI* dxgi_ = nullptr;
@@ -60,4 +83,9 @@ private:
 	GraphicsPipelineManager* graphicsPipelineManager_ = nullptr;
 	ShadowPipelineManager* shadowPipelineManager_ = nullptr;
 	Camera3DManager* camera3DManager_ = nullptr;
+	LightManager* lightManager_ = nullptr;
+	OcclusionCuller* occlusionCuller_ = nullptr;
+	TextureDataContainer* textureDataContainer_ = nullptr;
+	ResidencyManager* residencyManager_ = nullptr;
+	RenderQueue* renderQueue_ = nullptr;
 };
\ No newline at end of file
@@ -0,0 +1,319 @@
+#include "OcclusionCuller.h"
+
+// C++
+#include <cassert>
+#include <cmath>
+#include <algorithm>
+
+// MyHedder
+#include "Logger/Logger.h"
+#include "ModelDataContainer/ModelDataContainer.h"
+#include "Camera3DManager/Camera3DManager.h"
+#include "FrameArena/FrameArena.h"
+#include "VertexQuantizer/VertexQuantizer.h"
+
+namespace {
+	// 行ベクトル形式で位置を変換
+	Vector4 TransformPosition(const Vector3& p, const Matrix4x4& m) {
+		return Vector4{
+			p.x * m.m[0][0] + p.y * m.m[1][0] + p.z * m.m[2][0] + m.m[3][0],
+			p.x * m.m[0][1] + p.y * m.m[1][1] + p.z * m.m[2][1] + m.m[3][1],
+			p.x * m.m[0][2] + p.y * m.m[1][2] + p.z * m.m[2][2] + m.m[3][2],
+			p.x * m.m[0][3] + p.y * m.m[1][3] + p.z * m.m[2][3] + m.m[3][3],
+		};
+	}
+
+	// クリップ空間の線形補間
+	Vector4 LerpClip(const Vector4& a, const Vector4& b, float t) {
+		return Vector4{
+			a.x + (b.x - a.x) * t,
+			a.y + (b.y - a.y) * t,
+			a.z + (b.z - a.z) * t,
+			a.w + (b.w - a.w) * t,
+		};
+	}
+}
+
+OcclusionCuller::OcclusionCuller(ModelDataContainer* modelDataContainer, Camera3DManager* camera3DManager, FrameArena* frameArena) {
+	SetModelDataContainer(modelDataContainer);
+	SetCamera3DManager(camera3DManager);
+	SetFrameArena(frameArena);
+
+	// 階層深度バッファを確保
+	uint32_t width = kWidth;
+	uint32_t height = kHeight;
+	while (true) {
+		mipWidths_.push_back(width);
+		mipHeights_.push_back(height);
+		minDepthMips_.emplace_back(width * height, 1.0f);
+		maxDepthMips_.emplace_back(width * height, 1.0f);
+		if (width == 1 && height == 1) {
+			break;
+		}
+		width = (std::max)(1u, (width + 1) / 2);
+		height = (std::max)(1u, (height + 1) / 2);
+	}
+
+	Logger::Log("OcclusionCuller Initialize\n");
+}
+
+OcclusionCuller::~OcclusionCuller() {
+	Logger::Log("OcclusionCuller Finalize\n");
+}
+
+void OcclusionCuller::BeginFrame() {
+	hasOccluder_ = false;
+	std::fill(minDepthMips_[0].begin(), minDepthMips_[0].end(), 1.0f);
+
+	if (Camera3D* camera = camera3DManager_->GetCurrentCamera()) {
+		viewProjection_ = camera->GetViewProjectionMatrix();
+	}
+}
+
+void OcclusionCuller::RasterizeOccluder(const std::string& modelName, const Matrix4x4& worldMatrix) {
+	if (!isEnable_) {
+		return;
+	}
+
+	const OccluderMesh* meshPtr = FindOccluderMesh(modelName);
+	// 読み込み前のモデルは遮蔽物にしない
+	if (!meshPtr) {
+		return;
+	}
+	const OccluderMesh& mesh = *meshPtr;
+	const Matrix4x4 worldViewProjection = worldMatrix * viewProjection_;
+
+	// 頂点をクリップ空間へ(遮蔽物ごとに毎フレーム使うのでフレーム単位の一時メモリに置く)
+	FrameVector<Vector4> clipPositions(mesh.positions.size(), FrameArenaAllocator<Vector4>(frameArena_));
+	for (size_t i = 0; i < mesh.positions.size(); i++) {
+		clipPositions[i] = TransformPosition(mesh.positions[i], worldViewProjection);
+	}
+
+	for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
+		RasterizeTriangle(clipPositions[mesh.indices[i]], clipPositions[mesh.indices[i + 1]], clipPositions[mesh.indices[i + 2]]);
+	}
+	hasOccluder_ = true;
+}
+
+void OcclusionCuller::EndFrame() {
+	if (!hasOccluder_) {
+		return;
+	}
+
+	// 最高解像度ではmin/maxは同じ値
+	maxDepthMips_[0] = minDepthMips_[0];
+
+	// 2x2ずつまとめて上のレベルを作る
+	for (size_t level = 1; level < mipWidths_.size(); level++) {
+		const uint32_t srcWidth = mipWidths_[level - 1];
+		const uint32_t srcHeight = mipHeights_[level - 1];
+		const std::vector<float>& srcMin = minDepthMips_[level - 1];
+		const std::vector<float>& srcMax = maxDepthMips_[level - 1];
+
+		for (uint32_t y = 0; y < mipHeights_[level]; y++) {
+			for (uint32_t x = 0; x < mipWidths_[level]; x++) {
+				const uint32_t x0 = x * 2;
+				const uint32_t y0 = y * 2;
+				const uint32_t x1 = (std::min)(x0 + 1, srcWidth - 1);
+				const uint32_t y1 = (std::min)(y0 + 1, srcHeight - 1);
+
+				const uint32_t dst = y * mipWidths_[level] + x;
+				minDepthMips_[level][dst] = (std::min)({
+					srcMin[y0 * srcWidth + x0], srcMin[y0 * srcWidth + x1],
+					srcMin[y1 * srcWidth + x0], srcMin[y1 * srcWidth + x1] });
+				maxDepthMips_[level][dst] = (std::max)({
+					srcMax[y0 * srcWidth + x0], srcMax[y0 * srcWidth + x1],
+					srcMax[y1 * srcWidth + x0], srcMax[y1 * srcWidth + x1] });
+			}
+		}
+	}
+}
+
+bool OcclusionCuller::IsVisible(const AABB& worldAABB) const {
+	if (!isEnable_ || !hasOccluder_) {
+		return true;
+	}
+
+	// 8頂点を投影してスクリーン上の矩形と最も手前の深度を求める
+	float minX = static_cast<float>(kWidth);
+	float minY = static_cast<float>(kHeight);
+	float maxX = 0.0f;
+	float maxY = 0.0f;
+	float nearestDepth = 1.0f;
+	for (uint32_t i = 0; i < 8; i++) {
+		const Vector3 corner = {
+			(i & 1) ? worldAABB.max.x : worldAABB.min.x,
+			(i & 2) ? worldAABB.max.y : worldAABB.min.y,
+			(i & 4) ? worldAABB.max.z : worldAABB.min.z,
+		};
+		const Vector4 clip = TransformPosition(corner, viewProjection_);
+		// ニア面をまたぐものは判定しない
+		if (clip.z < 0.0f || clip.w < kNearClipW) {
+			return true;
+		}
+		const Vector3 screen = ToScreen(clip);
+		minX = (std::min)(minX, screen.x);
+		minY = (std::min)(minY, screen.y);
+		maxX = (std::max)(maxX, screen.x);
+		maxY = (std::max)(maxY, screen.y);
+		nearestDepth = (std::min)(nearestDepth, screen.z);
+	}
+
+	// 画面外の判定は視錐台カリングに任せる
+	if (maxX < 0.0f || maxY < 0.0f || minX >= static_cast<float>(kWidth) || minY >= static_cast<float>(kHeight)) {
+		return true;
+	}
+
+	// 全遮蔽物より手前なら見えている
+	if (nearestDepth <= minDepthMips_.back()[0]) {
+		return true;
+	}
+
+	const int32_t x0 = std::clamp(static_cast<int32_t>(minX), 0, static_cast<int32_t>(kWidth) - 1);
+	const int32_t y0 = std::clamp(static_cast<int32_t>(minY), 0, static_cast<int32_t>(kHeight) - 1);
+	const int32_t x1 = std::clamp(static_cast<int32_t>(maxX), 0, static_cast<int32_t>(kWidth) - 1);
+	const int32_t y1 = std::clamp(static_cast<int32_t>(maxY), 0, static_cast<int32_t>(kHeight) - 1);
+
+	// 矩形が2x2テクセル程度に収まるレベルを選ぶ
+	const int32_t size = (std::max)(x1 - x0, y1 - y0) + 1;
+	uint32_t level = 0;
+	while ((size >> level) > 2 && level + 1 < mipWidths_.size()) {
+		level++;
+	}
+
+	const std::vector<float>& maxDepth = maxDepthMips_[level];
+	const uint32_t mipWidth = mipWidths_[level];
+	for (int32_t y = y0 >> level; y <= (y1 >> level); y++) {
+		for (int32_t x = x0 >> level; x <= (x1 >> level); x++) {
+			// 遮蔽物の最も奥より手前なら見えている可能性がある
+			if (nearestDepth <= maxDepth[y * mipWidth + x]) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+void OcclusionCuller::SetIsEnable(bool isEnable) {
+	isEnable_ = isEnable;
+}
+
+bool OcclusionCuller::GetIsEnable() const {
+	return isEnable_;
+}
+
+const OcclusionCuller::OccluderMesh* OcclusionCuller::FindOccluderMesh(const std::string& modelName) {
+	auto it = occluderMeshes_.find(modelName);
+	if (it != occluderMeshes_.end()) {
+		return &it->second;
+	}
+
+	// 読み込み前は空のメッシュをキャッシュせず、次のフレーム以降で作り直す
+	if (!modelDataContainer_->IsModelLoaded(modelName)) {
+		return nullptr;
+	}
+
+	// 全メッシュを位置だけの1メッシュにまとめる
+	const ModelData modelData = modelDataContainer_->FindModelData(modelName);
+	OccluderMesh newMesh{};
+	for (const MeshData& mesh : modelData.meshes) {
+		const uint32_t baseVertex = static_cast<uint32_t>(newMesh.positions.size());
+		for (const QuantizedVertexData3D& vertex : mesh.quantizedVertices) {
+			newMesh.positions.push_back(VertexQuantizer::DecodePosition(vertex, mesh.quantization));
+		}
+		for (uint32_t index : mesh.indices) {
+			newMesh.indices.push_back(baseVertex + index);
+		}
+	}
+	return &occluderMeshes_.emplace(modelName, std::move(newMesh)).first->second;
+}
+
+void OcclusionCuller::RasterizeTriangle(const Vector4& c0, const Vector4& c1, const Vector4& c2) {
+	// ニア面(z >= 0)でクリップ
+	const Vector4 input[3] = { c0, c1, c2 };
+	Vector4 clipped[4];
+	uint32_t count = 0;
+	for (uint32_t i = 0; i < 3; i++) {
+		const Vector4& a = input[i];
+		const Vector4& b = input[(i + 1) % 3];
+		const bool isInsideA = a.z >= 0.0f;
+		const bool isInsideB = b.z >= 0.0f;
+		if (isInsideA) {
+			clipped[count++] = a;
+		}
+		if (isInsideA != isInsideB) {
+			clipped[count++] = LerpClip(a, b, a.z / (a.z - b.z));
+		}
+	}
+	if (count < 3) {
+		return;
+	}
+
+	// 扇状に分割して描画
+	const Vector3 s0 = ToScreen(clipped[0]);
+	for (uint32_t i = 1; i + 1 < count; i++) {
+		RasterizeScreenTriangle(s0, ToScreen(clipped[i]), ToScreen(clipped[i + 1]));
+	}
+}
+
+void OcclusionCuller::RasterizeScreenTriangle(const Vector3& s0, const Vector3& s1, const Vector3& s2) {
+	const float area = (s1.x - s0.x) * (s2.y - s0.y) - (s1.y - s0.y) * (s2.x - s0.x);
+	if (std::abs(area) < 1.0e-8f) {
+		return;
+	}
+	// 表裏どちらも遮蔽物として扱う
+	const float invArea = 1.0f / area;
+
+	const int32_t minX = (std::max)(0, static_cast<int32_t>(std::floor((std::min)({ s0.x, s1.x, s2.x }))));
+	const int32_t minY = (std::max)(0, static_cast<int32_t>(std::floor((std::min)({ s0.y, s1.y, s2.y }))));
+	const int32_t maxX = (std::min)(static_cast<int32_t>(kWidth) - 1, static_cast<int32_t>(std::ceil((std::max)({ s0.x, s1.x, s2.x }))));
+	const int32_t maxY = (std::min)(static_cast<int32_t>(kHeight) - 1, static_cast<int32_t>(std::ceil((std::max)({ s0.y, s1.y, s2.y }))));
+	if (minX > maxX || minY > maxY) {
+		return;
+	}
+
+	std::vector<float>& depth = minDepthMips_[0];
+	for (int32_t y = minY; y <= maxY; y++) {
+		const float py = static_cast<float>(y) + 0.5f;
+		for (int32_t x = minX; x <= maxX; x++) {
+			const float px = static_cast<float>(x) + 0.5f;
+
+			// 重心座標(面積の符号で正規化するので巻き順に依存しない)
+			const float w0 = ((s1.x - px) * (s2.y - py) - (s1.y - py) * (s2.x - px)) * invArea;
+			const float w1 = ((s2.x - px) * (s0.y - py) - (s2.y - py) * (s0.x - px)) * invArea;
+			const float w2 = 1.0f - w0 - w1;
+			if (w0 < 0.0f || w1 < 0.0f || w2 < 0.0f) {
+				continue;
+			}
+
+			// NDCの深度はスクリーン空間で線形
+			const float z = (std::min)(w0 * s0.z + w1 * s1.z + w2 * s2.z, 1.0f);
+			float& dst = depth[y * kWidth + x];
+			dst = (std::min)(dst, z);
+		}
+	}
+}
+
+Vector3 OcclusionCuller::ToScreen(const Vector4& clip) const {
+	const float invW = 1.0f / clip.w;
+	return Vector3{
+		(clip.x * invW * 0.5f + 0.5f) * static_cast<float>(kWidth),
+		(-clip.y * invW * 0.5f + 0.5f) * static_cast<float>(kHeight),
+		clip.z * invW,
+	};
+}
+
+void OcclusionCuller::SetModelDataContainer(ModelDataContainer* modelDataContainer) {
+	assert(modelDataContainer);
+	modelDataContainer_ = modelDataContainer;
+}
+
+void OcclusionCuller::SetCamera3DManager(Camera3DManager* camera3DManager) {
+	assert(camera3DManager);
+	camera3DManager_ = camera3DManager;
+}
+
+void OcclusionCuller::SetFrameArena(FrameArena* frameArena) {
+	assert(frameArena);
+	frameArena_ = frameArena;
+}
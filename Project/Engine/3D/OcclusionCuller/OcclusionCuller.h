@@ -0,0 +1,88 @@
+#pragma once
+
+// C++
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+// MyHedder
+#include "Math/Utility/MathUtility.h"
+
+// 前方宣言
+class ModelDataContainer;
+class Camera3DManager;
+class FrameArena;
+
+/// <summary>
+/// CPUソフトウェアラスタライザによるオクルージョンカリング
+/// (遮蔽物を低解像度の深度バッファに描き、min/maxの階層深度でインスタンスの可視判定を行う)
+/// </summary>
+class OcclusionCuller {
+public:
+	OcclusionCuller(ModelDataContainer* modelDataContainer, Camera3DManager* camera3DManager, FrameArena* frameArena);
+	~OcclusionCuller();
+
+	// フレーム開始(深度バッファのクリアとカメラ行列の取得)
+	void BeginFrame();
+	// 遮蔽物を深度バッファに描画
+	void RasterizeOccluder(const std::string& modelName, const Matrix4x4& worldMatrix);
+	// フレームの遮蔽物描画終了(階層深度の作成)
+	void EndFrame();
+
+	// ワールド空間の境界ボックスが見えているか
+	[[nodiscard]] bool IsVisible(const AABB& worldAABB) const;
+
+	void SetIsEnable(bool isEnable);
+	[[nodiscard]] bool GetIsEnable()const;
+
+private:
+	// 遮蔽物用のメッシュ(位置のみ)
+	struct OccluderMesh {
+		std::vector<Vector3> positions;
+		std::vector<uint32_t> indices;
+	};
+
+	// 遮蔽物メッシュの取得(初回のみモデルデータから作成、読み込み前はnullptr)
+	const OccluderMesh* FindOccluderMesh(const std::string& modelName);
+	// クリップ空間の三角形をニア面でクリップして描画
+	void RasterizeTriangle(const Vector4& c0, const Vector4& c1, const Vector4& c2);
+	// スクリーン空間の三角形を描画
+	void RasterizeScreenTriangle(const Vector3& s0, const Vector3& s1, const Vector3& s2);
+	// クリップ空間からスクリーン空間へ
+	Vector3 ToScreen(const Vector4& clip) const;
+
+	void SetModelDataContainer(ModelDataContainer* modelDataContainer);
+	void SetCamera3DManager(Camera3DManager* camera3DManager);
+	void SetFrameArena(FrameArena* frameArena);
+
+private:
+	// 深度バッファの解像度
+	static constexpr uint32_t kWidth = 256;
+	static constexpr uint32_t kHeight = 128;
+	// ニア面判定の閾値
+	static constexpr float kNearClipW = 1.0e-4f;
+
+	// 有効フラグ
+	bool isEnable_ = true;
+	// 今フレームに遮蔽物が描かれたか
+	bool hasOccluder_ = false;
+
+	// ビュープロジェクション行列
+	Matrix4x4 viewProjection_{};
+
+	// 遮蔽物メッシュのキャッシュ
+	std::unordered_map<std::string, OccluderMesh> occluderMeshes_;
+
+	// 深度バッファ(0番が最高解像度)
+	std::vector<std::vector<float>> minDepthMips_;
+	std::vector<std::vector<float>> maxDepthMips_;
+	// 各レベルの解像度
+	std::vector<uint32_t> mipWidths_;
+	std::vector<uint32_t> mipHeights_;
+
+private:
+	ModelDataContainer* modelDataContainer_ = nullptr;
+	Camera3DManager* camera3DManager_ = nullptr;
+	FrameArena* frameArena_ = nullptr;
+};
@@ -7,6 +7,8 @@ using namespace MAGIMath;
 BaseParticleGroup3D::BaseParticleGroup3D(const std::string& particleGroupName) {
 	// 名前をセット
 	name = particleGroupName;
+	// パーティクルの配列を確保
+	particles_.reserve(kNumMaxInstance_);
 
 	// Instancingリソースを作る
 	CreateInstancingResource();
@@ -20,11 +22,52 @@ BaseParticleGroup3D::BaseParticleGroup3D(const std::string& particleGroupName) {
 }
 
 void BaseParticleGroup3D::Update() {
-	// instancingデータを更新
-	UpdateInstancingData();
+	for (size_t index = 0; index < particles_.size();) {
+		ParticleData& particle = particles_[index];
+		// 生存時間を過ぎていたら末尾と入れ替えて取り除く
+		if (particle.lifeTime <= particle.currentTime) {
+			particle = particles_.back();
+			particles_.pop_back();
+			continue;
+		}
+
+		// 経過時間を足す
+		particle.currentTime += MAGISYSTEM::GetDeltaTime();
+		// 移動
+		particle.transform.translate += particle.velocity * MAGISYSTEM::GetDeltaTime();
+
+		if (isRotate) {
+			particle.transform.rotate.z += MAGISYSTEM::GetDeltaTime();
+		}
+
+		// 次のパーティクルに進める
+		++index;
+	}
+}
+
+void BaseParticleGroup3D::WriteFrameData() {
+	// instancingデータを書き込む
+	WriteInstancingData();
+
+	// Materialデータを書き込む
+	WriteMaterialData();
+
+	// 描画スレッドが記録している間に変わらないように確定させる
+	renderBlendMode_ = blendMode_;
+}
 
-	// Materialデータ更新
-	UpdateMaterialData();
+void BaseParticleGroup3D::SubmitRenderItem(RenderQueue* renderQueue) {
+	if (instanceCount_ == 0) {
+		return;
+	}
+	renderQueue->Submit(this, RenderPass::Particle, renderBlendMode_, static_cast<uint32_t>(GraphicsPipelineStateType::Particle3D), materialKey_);
+}
+
+void BaseParticleGroup3D::ExecuteRenderItem([[maybe_unused]] const RenderItem& item, bool isPipelineChanged) {
+	// パーティクルグループの描画前設定
+	PrepareForRendering(isPipelineChanged);
+	// 描画
+	Draw();
 }
 
 void BaseParticleGroup3D::AddNewParticle(const EmitParamater& emitSetting) {
@@ -52,6 +95,16 @@ void BaseParticleGroup3D::AddNewParticle(const EmitParamater& emitSetting) {
 	particles_.push_back(particle);
 }
 
+void BaseParticleGroup3D::AddNewParticles(std::span<const EmitParamater> emitSettings) {
+	for (const EmitParamater& emitSetting : emitSettings) {
+		// 最大数を超えたらそれ以上は追加しない
+		if (particles_.size() >= kNumMaxInstance_) {
+			return;
+		}
+		AddNewParticle(emitSetting);
+	}
+}
+
 Renderer3DType BaseParticleGroup3D::GetRendererType()const {
 	return rendererType_.value();
 }
@@ -64,113 +117,127 @@ bool& BaseParticleGroup3D::GetIsShow() {
 	return isShow_;
 }
 
-void BaseParticleGroup3D::PrepareForRendering() {
+void BaseParticleGroup3D::PrepareForRendering(bool isPipelineChanged) {
 	// コマンドリストを取得
 	ID3D12GraphicsCommandList* commandList = MAGISYSTEM::GetDirectXCommandList();
-	// RootSignatureを設定
-	commandList->SetGraphicsRootSignature(MAGISYSTEM::GetGraphicsRootSignature(GraphicsPipelineStateType::Particle3D));
-	// PSOを設定
-	commandList->SetPipelineState(MAGISYSTEM::GetGraphicsPipelineState(GraphicsPipelineStateType::Particle3D, blendMode_));
-	// 形状を設定
-	commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	// 直前のグループと同じパイプラインなら形状とカメラも設定済み
+	if (isPipelineChanged) {
+		// RootSignatureを設定
+		commandList->SetGraphicsRootSignature(MAGISYSTEM::GetGraphicsRootSignature(GraphicsPipelineStateType::Particle3D));
+		// PSOを設定
+		commandList->SetPipelineState(MAGISYSTEM::GetGraphicsPipelineState(GraphicsPipelineStateType::Particle3D, renderBlendMode_));
+		// 形状を設定
+		commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+		// カメラを転送
+		MAGISYSTEM::TransferCamera3D(cameraRootParamaterIndex_);
+	}
+	// 今のフレームのリソースを使う
+	const uint32_t frameIndex = MAGISYSTEM::GetFrameIndex();
 	// マテリアルCBufferの場所を設定
-	commandList->SetGraphicsRootConstantBufferView(0, materialResource_->GetGPUVirtualAddress());
+	commandList->SetGraphicsRootConstantBufferView(0, materialResource_[frameIndex]->GetGPUVirtualAddress());
 	// StructuredBufferのSRVを設定する
 	commandList->SetGraphicsRootDescriptorTable(1, MAGISYSTEM::GetSrvUavDescriptorHandleGPU(srvIndex_));
-	// カメラを転送
-	MAGISYSTEM::TransferCamera3D(cameraRootParamaterIndex_);
 }
 
 void BaseParticleGroup3D::CreateInstancingResource() {
-	// instancing用のリソースを作る
-	instancingResource_ = MAGISYSTEM::CreateBufferResource(sizeof(ParticleForGPU) * kNumMaxInstance_);
-	// srvのインデックスを割り当て
-	srvIndex_ = MAGISYSTEM::SrvUavAllocate();
-	// Srvを作成
-	MAGISYSTEM::CreateSrvStructuredBuffer(srvIndex_, instancingResource_.Get(), kNumMaxInstance_, sizeof(ParticleForGPU));
+	for (uint32_t frame = 0; frame < FrameConst::FrameCount; ++frame) {
+		// instancing用のリソースを作る
+		instancingResource_[frame] = MAGISYSTEM::CreateBufferResource(sizeof(ParticleForGPU) * kNumMaxInstance_);
+	}
 }
 
 void BaseParticleGroup3D::MapInstancingData() {
-	instancingData_ = nullptr;
-	instancingResource_->Map(0, nullptr, reinterpret_cast<void**>(&instancingData_));
+	for (uint32_t frame = 0; frame < FrameConst::FrameCount; ++frame) {
+		instancingData_[frame] = nullptr;
+		instancingResource_[frame]->Map(0, nullptr, reinterpret_cast<void**>(&instancingData_[frame]));
 
-	for (uint32_t index = 0; index < kNumMaxInstance_; ++index) {
-		instancingData_[index].color = Vector4(1.0f, 1.0f, 1.0f, 1.0f);
+		for (uint32_t index = 0; index < kNumMaxInstance_; ++index) {
+			instancingData_[frame][index].color = Vector4(1.0f, 1.0f, 1.0f, 1.0f);
+		}
 	}
 }
 
-void BaseParticleGroup3D::UpdateInstancingData() {
+void BaseParticleGroup3D::WriteInstancingData() {
 	// 描画すべきインスタンス数
 	instanceCount_ = 0;
-
-	for (std::list<ParticleData>::iterator particleIterator = particles_.begin();
-		particleIterator != particles_.end();) {
-		// 生存時間を過ぎていたら更新せず描画対象にしない
-		if ((*particleIterator).lifeTime <= (*particleIterator).currentTime) {
-			particleIterator = particles_.erase(particleIterator);
-			continue;
+	// 今のフレームのリソースへ書き込む
+	ParticleForGPU* instancingData = instancingData_[MAGISYSTEM::GetFrameIndex()];
+
+	// 奥から順に描くブレンドモードは深度で並べ替えた順に書き込む
+	const bool isDepthSorted = IsDepthSortedBlendMode(blendMode_);
+	if (isDepthSorted) {
+		particleDepths_.clear();
+		for (const ParticleData& particle : particles_) {
+			particleDepths_.push_back(MAGISYSTEM::GetCamera3DViewDepth(particle.transform.translate));
 		}
+		RadixSort::SortBackToFront(particleDepths_, sortEntries_, sortScratch_);
+	}
 
-		// 経過時間を足す
-		(*particleIterator).currentTime += MAGISYSTEM::GetDeltaTime();
-		// 移動
-		(*particleIterator).transform.translate += (*particleIterator).velocity * MAGISYSTEM::GetDeltaTime();
-
-		if (isRotate) {
-			(*particleIterator).transform.rotate.z += MAGISYSTEM::GetDeltaTime();
+	for (size_t index = 0; index < particles_.size(); ++index) {
+		if (instanceCount_ >= kNumMaxInstance_) {
+			break;
 		}
+		const ParticleData& particle = isDepthSorted ? particles_[sortEntries_[index].index] : particles_[index];
 
 		// 透明度
-		float alpha = 1.0f - ((*particleIterator).currentTime / (*particleIterator).lifeTime);
-
-		if (instanceCount_ < kNumMaxInstance_) {
-			// Wマトリックスを求める
-			// Scale
-			Matrix4x4 scaleMatrix = MakeScaleMatrix((*particleIterator).transform.scale);
-			// 
-			Matrix4x4 rotateMatrix = MakeRotateXYZMatrix((*particleIterator).transform.rotate);
-
-			// translate
-			Matrix4x4 translateMatrix = MakeTranslateMatrix((*particleIterator).transform.translate);
-
-			// ワールド行列を作成
-			Matrix4x4 worldMatrix = scaleMatrix * rotateMatrix * translateMatrix;
-
-			// ワールド行列
-			instancingData_[instanceCount_].World = worldMatrix;
-			// 色を入力
-			instancingData_[instanceCount_].color.x = (*particleIterator).color.x;
-			instancingData_[instanceCount_].color.y = (*particleIterator).color.y;
-			instancingData_[instanceCount_].color.z = (*particleIterator).color.z;
-			instancingData_[instanceCount_].color.w = alpha;
-
-			// 生きているParticleの数を1つカウントする
-			instanceCount_++;
-		}
-		// 次のイテレーターに進める
-		++particleIterator;
+		float alpha = 1.0f - (particle.currentTime / particle.lifeTime);
+
+		// Wマトリックスを求める
+		// Scale
+		Matrix4x4 scaleMatrix = MakeScaleMatrix(particle.transform.scale);
+		// 
+		Matrix4x4 rotateMatrix = MakeRotateXYZMatrix(particle.transform.rotate);
+
+		// translate
+		Matrix4x4 translateMatrix = MakeTranslateMatrix(particle.transform.translate);
+
+		// ワールド行列を作成
+		Matrix4x4 worldMatrix = scaleMatrix * rotateMatrix * translateMatrix;
+
+		// ワールド行列
+		instancingData[instanceCount_].World = worldMatrix;
+		// 色を入力
+		instancingData[instanceCount_].color.x = particle.color.x;
+		instancingData[instanceCount_].color.y = particle.color.y;
+		instancingData[instanceCount_].color.z = particle.color.z;
+		instancingData[instanceCount_].color.w = alpha;
+
+		// 生きているParticleの数を1つカウントする
+		instanceCount_++;
+	}
+
+	// 書き込んだ範囲だけを見るSRVをこのフレームの一時用に作る
+	if (instanceCount_ > 0) {
+		srvIndex_ = MAGISYSTEM::SrvUavAllocateTransient(1);
+		MAGISYSTEM::CreateSrvStructuredBuffer(srvIndex_, instancingResource_[MAGISYSTEM::GetFrameIndex()].Get(), instanceCount_, sizeof(ParticleForGPU));
 	}
 }
 
 void BaseParticleGroup3D::CreateMaterialResource() {
 	// マテリアル用のリソース作成
-	materialResource_ = MAGISYSTEM::CreateBufferResource(sizeof(Material3DForGPU));
+	for (uint32_t frame = 0; frame < FrameConst::FrameCount; ++frame) {
+		materialResource_[frame] = MAGISYSTEM::CreateBufferResource(sizeof(Material3DForGPU));
+	}
 }
 
 void BaseParticleGroup3D::MapMaterialData() {
-	materialData_ = nullptr;
-	materialResource_->Map(0, nullptr, reinterpret_cast<void**>(&materialData_));
-	materialData_->color = material_.color;
-	materialData_->enableSpecularRef = material_.enableSpecularRef;
-	materialData_->enableLighting = material_.enableLighting;
-	materialData_->shininess = material_.shininess;
-	materialData_->uvTransformMatrix = MakeUVMatrix(material_.uvTransform.scale, material_.uvTransform.rotateZ, material_.uvTransform.translate);
-}
-
-void BaseParticleGroup3D::UpdateMaterialData() {
-	materialData_->color = material_.color;
-	materialData_->enableSpecularRef = material_.enableSpecularRef;
-	materialData_->enableLighting = material_.enableLighting;
-	materialData_->shininess = material_.shininess;
-	materialData_->uvTransformMatrix = MakeUVMatrix(material_.uvTransform.scale, material_.uvTransform.rotateZ, material_.uvTransform.translate);
+	for (uint32_t frame = 0; frame < FrameConst::FrameCount; ++frame) {
+		materialData_[frame] = nullptr;
+		materialResource_[frame]->Map(0, nullptr, reinterpret_cast<void**>(&materialData_[frame]));
+		materialData_[frame]->color = material_.color;
+		materialData_[frame]->enableSpecularRef = material_.enableSpecularRef;
+		materialData_[frame]->enableLighting = material_.enableLighting;
+		materialData_[frame]->shininess = material_.shininess;
+		materialData_[frame]->uvTransformMatrix = MakeUVMatrix(material_.uvTransform.scale, material_.uvTransform.rotateZ, material_.uvTransform.translate);
+	}
+}
+
+void BaseParticleGroup3D::WriteMaterialData() {
+	// 今のフレームのリソースへ書き込む
+	Material3DForGPU* materialData = materialData_[MAGISYSTEM::GetFrameIndex()];
+	materialData->color = material_.color;
+	materialData->enableSpecularRef = material_.enableSpecularRef;
+	materialData->enableLighting = material_.enableLighting;
+	materialData->shininess = material_.shininess;
+	materialData->uvTransformMatrix = MakeUVMatrix(material_.uvTransform.scale, material_.uvTransform.rotateZ, material_.uvTransform.translate);
 }
\ No newline at end of file
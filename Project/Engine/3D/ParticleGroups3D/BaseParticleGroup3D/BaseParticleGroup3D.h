@@ -3,12 +3,16 @@
 // C++
 #include <string>
 #include <cstdint>
-#include <list>
+#include <vector>
+#include <span>
 #include <optional>
 
 #include "Structs/ParticleStruct.h"
 #include "Enums/Renderer3DEnum.h"
 #include "Enums/BlendModeEnum.h"
+#include "Const/FrameConst.h"
+#include "RenderQueue/RenderQueue.h"
+#include "RadixSort/RadixSort.h"
 
 #include "DirectX/ComPtr/ComPtr.h"
 
@@ -17,17 +21,25 @@
 /// <summary>
 /// パーティクルグループ
 /// </summary>
-class BaseParticleGroup3D {
+class BaseParticleGroup3D : public RenderQueueSubmitter {
 public:
 	BaseParticleGroup3D(const std::string& particleGroupName);
 	virtual ~BaseParticleGroup3D() = default;
 
 	virtual void AssignShape() = 0;
+	// パーティクルの移動と寿命の更新(CPUのみ)
 	virtual void Update();
-	virtual void Draw() = 0;
+	// 今のフレームのリソースへ書き込む(描画スレッドが止まっている間に呼ぶ)
+	virtual void WriteFrameData();
+	// 描画するパーティクルがあれば描画キューに積む(書き込みの後に呼ぶ)
+	void SubmitRenderItem(RenderQueue* renderQueue);
+	// 描画キューから積んだ描画を記録する
+	void ExecuteRenderItem(const RenderItem& item, bool isPipelineChanged) override;
 
 	// 新規パーティクルの追加
 	void AddNewParticle(const EmitParamater& emitSetting);
+	// 新規パーティクルをまとめて追加
+	void AddNewParticles(std::span<const EmitParamater> emitSettings);
 
 	// 
 	// アクセッサ
@@ -40,30 +52,32 @@ public:
 	// 描画フラグを取得
 	bool& GetIsShow();
 protected:
-	// 描画前処理
-	void PrepareForRendering();
+	// 描画(パイプラインなどは設定済み)
+	virtual void Draw() = 0;
+	// 描画前処理(直前のグループと同じパイプラインならリソースの設定だけ行う)
+	void PrepareForRendering(bool isPipelineChanged);
 
 private:
 	// instancingリソース作成
 	void CreateInstancingResource();
 	// instancingリソース書き込み
 	void MapInstancingData();
-	// instancingデータ更新
-	void UpdateInstancingData();
+	// instancingデータ書き込み
+	void WriteInstancingData();
 
 	// マテリアルリソースの作成
 	void CreateMaterialResource();
 	// マテリアルデータの書き込み
 	void MapMaterialData();
-	// マテリアルデータの更新
-	void UpdateMaterialData();
+	// マテリアルデータの書き込み
+	void WriteMaterialData();
 
 public:
 	// パーティクルグループの名前
 	std::string name = "";
 protected:
-	// パーティクルのリスト
-	std::list<ParticleData> particles_;
+	// パーティクルの配列(最大数まで先に確保しておき、発生のたびにヒープから確保しない)
+	std::vector<ParticleData> particles_;
 	// パーティクルの最大数
 	const uint32_t kNumMaxInstance_ = 1024;
 	// 描画タイプ
@@ -72,6 +86,10 @@ protected:
 	BlendMode blendMode_ = BlendMode::Add;
 	// instance描画する際に使う変数
 	uint32_t instanceCount_ = 0;
+	// 描画に使うブレンドモード(書き込み時に確定させる)
+	BlendMode renderBlendMode_ = BlendMode::Add;
+	// 描画キューでまとめて描くためのマテリアル
+	uint32_t materialKey_ = 0;
 
 	// 描画フラグ
 	bool isShow_ = true;
@@ -82,17 +100,23 @@ private:
 	// カメラのルートパラメタインデックス番号
 	const uint32_t cameraRootParamaterIndex_ = 4;
 
-	// instancing描画用リソース
-	ComPtr<ID3D12Resource> instancingResource_ = nullptr;
+	// instancing描画用リソース(GPUが読んでいる間に書き換えないようにフレームごとに持つ)
+	ComPtr<ID3D12Resource> instancingResource_[FrameConst::FrameCount];
 	// instancing描画用データ
-	ParticleForGPU* instancingData_ = nullptr;
-	// SrvIndex
+	ParticleForGPU* instancingData_[FrameConst::FrameCount]{};
+	// SrvIndex(毎フレーム一時用から確保する)
 	uint32_t srvIndex_ = 0;
 
 	// マテリアルリソース
-	ComPtr<ID3D12Resource> materialResource_ = nullptr;
+	ComPtr<ID3D12Resource> materialResource_[FrameConst::FrameCount];
 	// マテリアルデータ
-	Material3DForGPU* materialData_ = nullptr;
+	Material3DForGPU* materialData_[FrameConst::FrameCount]{};
 	// マテリアル
 	Material3D material_{};
+
+	// 奥から順に描くブレンドモードのときのパーティクルの深度
+	std::vector<float> particleDepths_;
+	// 深度で並べ替えた順番と作業領域(毎フレーム確保し直さないように持っておく)
+	std::vector<RadixSort::DepthEntry> sortEntries_;
+	std::vector<RadixSort::DepthEntry> sortScratch_;
 };
\ No newline at end of file
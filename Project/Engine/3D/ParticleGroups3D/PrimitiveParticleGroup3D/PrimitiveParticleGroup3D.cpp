@@ -36,19 +36,23 @@ void PrimitiveParticleGroup3D::AssignShape() {
 }
 
 void PrimitiveParticleGroup3D::Update() {
-	// Primitive更新
-	primitive_->Update();
 	// 基底クラスの更新
 	BaseParticleGroup3D::Update();
 }
 
-void PrimitiveParticleGroup3D::Draw() {
-	// パーティクルグループの描画前設定
-	PrepareForRendering();
+void PrimitiveParticleGroup3D::WriteFrameData() {
+	// Primitive更新
+	primitive_->Update();
+	// テクスチャを確定させ、同じテクスチャのグループをまとめて描く
+	textureSrvIndex_ = MAGISYSTEM::GetTexture()[textureName_].srvIndex;
+	materialKey_ = textureSrvIndex_;
+	// 基底クラスの書き込み
+	BaseParticleGroup3D::WriteFrameData();
+}
 
+void PrimitiveParticleGroup3D::Draw() {
 	// Texture用のSRVをセット
-	uint32_t textureSrvIndex = MAGISYSTEM::GetTexture()[textureName_].srvIndex;
-	MAGISYSTEM::GetDirectXCommandList()->SetGraphicsRootDescriptorTable(2, MAGISYSTEM::GetSrvUavDescriptorHandleGPU(textureSrvIndex));
+	MAGISYSTEM::GetDirectXCommandList()->SetGraphicsRootDescriptorTable(2, MAGISYSTEM::GetSrvUavDescriptorHandleGPU(textureSrvIndex_));
 
 	// 描画
 	primitive_->DrawInstanced(instanceCount_);
@@ -18,16 +18,21 @@ public:
 
 	void AssignShape()override;
 	void Update()override;
-	void Draw()override;
+	void WriteFrameData()override;
 
 	// テクスチャを取得
 	std::string& GetTextureName();
 
+protected:
+	void Draw()override;
+
 private:
 	// プリミティブ形状タイプ
 	std::optional<Primitive3DType> primitiveType_ = std::nullopt;
 	// 貼り付けるテクスチャファイル
 	std::string textureName_ = "";
+	// 描画に使うテクスチャのSrvIndex(書き込み時に確定させる)
+	uint32_t textureSrvIndex_ = 0;
 	// 形状
 	std::unique_ptr<BasePrimitiveShape3D> primitive_ = nullptr;
 };
\ No newline at end of file
@@ -18,16 +18,18 @@ void StaticParticleGroup3D::AssignShape() {
 }
 
 void StaticParticleGroup3D::Update() {
-	// モデル更新
-	model_->Update();
 	// 基底クラスの更新
 	BaseParticleGroup3D::Update();
 }
 
-void StaticParticleGroup3D::Draw() {
-	// パーティクルグループの描画前設定
-	PrepareForRendering();
+void StaticParticleGroup3D::WriteFrameData() {
+	// モデル更新
+	model_->Update();
+	// 基底クラスの書き込み
+	BaseParticleGroup3D::WriteFrameData();
+}
 
+void StaticParticleGroup3D::Draw() {
 	// 描画
 	model_->DrawInstancedForParticle(instanceCount_);
 }
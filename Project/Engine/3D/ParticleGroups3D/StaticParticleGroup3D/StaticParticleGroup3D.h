@@ -14,6 +14,9 @@ public:
 
 	void AssignShape()override;
 	void Update()override;
+	void WriteFrameData()override;
+
+protected:
 	void Draw()override;
 
 private:
@@ -7,6 +7,7 @@ ModelRenderer::ModelRenderer(const std::string& name, const std::string& modelNa
 	name_ = name;
 	modelName_ = modelName;
 	material_ = material;
+	UpdateLocalAABB();
 
 	// トランスフォームを作成
 	std::unique_ptr<Transform3D> transform = std::make_unique<Transform3D>();
@@ -24,12 +25,31 @@ void ModelRenderer::Draw() {
 	}
 }
 
+void ModelRenderer::DrawOccluder() {
+	if (isRender_ && isOccluder_) {
+		MAGISYSTEM::RasterizeOccluder(modelName_, transform_->GetWorldMatrix());
+	}
+}
+
 void ModelRenderer::Finalize() {
 	if (transform_) {
 		transform_->SetIsAlive(false);
 	}
 }
 
+bool ModelRenderer::UpdateLocalAABB() {
+	if (isLocalAABBReady_) {
+		return false;
+	}
+	// 読み込み前は原点の点のまま、読み込み後に取り直す
+	if (!MAGISYSTEM::IsModelLoaded(modelName_)) {
+		return false;
+	}
+	localAABB_ = MAGISYSTEM::FindModelLocalAABB(modelName_);
+	isLocalAABBReady_ = true;
+	return true;
+}
+
 void ModelRenderer::SetIsAlive(bool isAlive) {
 	isAlive_ = isAlive;
 }
@@ -42,6 +62,10 @@ void ModelRenderer::SetIsRender(bool isRender) {
 	isRender_ = isRender;
 }
 
+void ModelRenderer::SetIsOccluder(bool isOccluder) {
+	isOccluder_ = isOccluder;
+}
+
 const std::string& ModelRenderer::GetName() const {
 	return name_;
 }
@@ -54,6 +78,21 @@ bool ModelRenderer::GetIsRender() const {
 	return isRender_;
 }
 
+bool ModelRenderer::GetIsOccluder() const {
+	return isOccluder_;
+}
+
 Transform3D* ModelRenderer::GetTransform() {
 	return transform_;
+}
+const std::string& ModelRenderer::GetModelName() const {
+	return modelName_;
+}
+
+const AABB& ModelRenderer::GetLocalAABB() const {
+	return localAABB_;
+}
+
+AABB ModelRenderer::GetWorldAABB() const {
+	return MAGIMath::TransformAABB(localAABB_, transform_->GetWorldMatrix());
 }
\ No newline at end of file
@@ -6,6 +6,7 @@
 
 // MyHedder
 #include "Structs/ModelStruct.h"
+#include "Math/Types/AABB.h"
 
 // 前方宣言
 class Transform3D;
@@ -19,18 +20,29 @@ public:
 	~ModelRenderer();
 
 	void Draw();
+	// 遮蔽物としてオクルージョン用の深度バッファに描画
+	void DrawOccluder();
 
 	void Finalize();
 
+	// 読み込みが後から終わったモデルの境界ボックスを取り込む(取り込んだらtrue)
+	bool UpdateLocalAABB();
+
 	void SetIsAlive(bool isAlive);
 
 	void SetMaterial(const ModelMaterial& material);
 	void SetIsRender(bool isRender);
+	void SetIsOccluder(bool isOccluder);
 
 	[[nodiscard]] const std::string& GetName()const;
 	[[nodiscard]] bool GetIsAlive()const;
 	[[nodiscard]] bool GetIsRender()const;
+	[[nodiscard]] bool GetIsOccluder()const;
 	[[nodiscard]] Transform3D* GetTransform();
+	[[nodiscard]] const std::string& GetModelName()const;
+	[[nodiscard]] const AABB& GetLocalAABB()const;
+	// ワールド空間の境界ボックスを取得
+	[[nodiscard]] AABB GetWorldAABB()const;
 
 private:
 	// 名前
@@ -39,10 +51,16 @@ private:
 	std::string modelName_ = "";
 	// マテリアル
 	ModelMaterial material_{};
+	// モデル空間の境界ボックス
+	AABB localAABB_{};
+	// 境界ボックスをモデルから取得済みか
+	bool isLocalAABBReady_ = false;
 	// トランスフォーム
 	Transform3D* transform_;
 	// 描画フラグ
 	bool isRender_ = true;
+	// 遮蔽物フラグ
+	bool isOccluder_ = false;
 	// 生存フラグ
 	bool isAlive_ = true;
 };
\ No newline at end of file
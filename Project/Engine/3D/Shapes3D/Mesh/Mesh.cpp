@@ -1,10 +1,18 @@
 #include "Mesh.h"
 
 #include "Framework/MAGI.h"
+#include "VertexQuantizer/VertexQuantizer.h"
 
 Mesh::Mesh(const MeshData& meshData) {
 	// メッシュのデータを受けとる
 	meshData_ = meshData;
+	// スキニングしないモデルはフル精度の頂点を持たないので量子化した頂点から復元する
+	if (meshData_.vertices.empty()) {
+		meshData_.vertices.reserve(meshData_.quantizedVertices.size());
+		for (const auto& vertex : meshData_.quantizedVertices) {
+			meshData_.vertices.push_back(VertexQuantizer::Decode(vertex, meshData_.quantization));
+		}
+	}
 }
 
 void Mesh::Initialize() {
@@ -10,6 +10,7 @@
 // MyHedder
 #include "DirectX/ComPtr/ComPtr.h"
 #include "Structs/ModelStruct.h"
+#include "Structs/BufferStruct.h"
 #include "Enums/Primitive3DEnum.h"
 
 /// <summary>
@@ -28,20 +29,6 @@ public:
 	void SetIsNormalMap(bool enableNormalMap);
 
 private:
-	// 頂点リソースの作成
-	void CreateVertexResource();
-	// 頂点バッファービューの作成
-	void CreateVertexBufferView();
-	// 頂点データの書き込み
-	void MapVertexData();
-
-	// インデックスリソースの作成
-	void CreateIndexResource();
-	// インデックスバッファビューの作成
-	void CreateIndexBufferView();
-	// インデックスデータの書き込み
-	void MapIndexData();
-
 	// マテリアルリソースの作成
 	void CreateMaterialResource();
 	// マテリアルデータの書き込み
@@ -50,22 +37,10 @@ private:
 protected:
 	// 形状データ
 	PrimitiveData primitiveData_{};
+	// 形状の頂点とインデックス(形状ごとにデフォルトヒープへ転送したものを共有する)
+	const PrimitiveShapeBuffer* shapeBuffer_ = nullptr;
 private:
 
-	// 頂点リソース
-	ComPtr<ID3D12Resource> vertexResource_ = nullptr;
-	// 頂点データ
-	VertexData3D* vertexData_ = nullptr;
-	// VBV
-	D3D12_VERTEX_BUFFER_VIEW vertexBufferView_{};
-
-	// インデックスリソース
-	ComPtr<ID3D12Resource> indexResource_ = nullptr;
-	// インデックスデータ
-	uint32_t* indexData_ = nullptr;
-	// インデックスバッファビュー
-	D3D12_INDEX_BUFFER_VIEW indexBufferView_{};
-
 	// マテリアルリソース
 	ComPtr<ID3D12Resource> materialResource_ = nullptr;
 	// マテリアルデータ
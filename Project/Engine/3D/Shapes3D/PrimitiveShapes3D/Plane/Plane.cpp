@@ -11,6 +11,7 @@ Plane::Plane()
 
 void Plane::SetShape() {
 	primitiveData_ = MAGISYSTEM::GetPrimitiveShape(Primitive3DType::Plane);
+	shapeBuffer_ = &MAGISYSTEM::GetPrimitiveShapeBuffer(Primitive3DType::Plane);
 }
 
 void Plane::Update() {
@@ -11,6 +11,7 @@ Sphere::Sphere()
 
 void Sphere::SetShape() {
 	primitiveData_ = MAGISYSTEM::GetPrimitiveShape(Primitive3DType::Sphere);
+	shapeBuffer_ = &MAGISYSTEM::GetPrimitiveShapeBuffer(Primitive3DType::Sphere);
 }
 
 void Sphere::Update() {
@@ -49,6 +49,9 @@ void Transform3D::Initialize(const Vector3& translate) {
 }
 
 void Transform3D::Update() {
+	// 今フレームでワールド行列を作り直すかどうかを記録
+	isWorldMatrixUpdated_ = isChanged_;
+
 	if (isChanged_) {
 		// 直接Q回転に変更があった場合はこっち優先
 		if (preRotate_ != rotate_) {
@@ -123,6 +126,10 @@ const bool& Transform3D::GetIsChanged() const {
 	return isChanged_;
 }
 
+bool Transform3D::GetIsWorldMatrixUpdated() const {
+	return isWorldMatrixUpdated_;
+}
+
 const bool& Transform3D::GetisAlive() const {
 	return isAlive_;
 }
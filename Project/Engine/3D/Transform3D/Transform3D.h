@@ -71,6 +71,7 @@ public:
 	[[nodiscard]] Transform3D* GetParent()const;
 
 	[[nodiscard]] const bool& GetIsChanged()const;
+	[[nodiscard]] bool GetIsWorldMatrixUpdated()const;
 	[[nodiscard]] const bool& GetisAlive()const;
 
 	[[nodiscard]] const Vector3& GetScale()const;
@@ -111,6 +112,9 @@ private:
 	// 変更フラグ
 	bool isChanged_ = false;
 
+	// 今フレームにワールド行列が更新されたかどうか
+	bool isWorldMatrixUpdated_ = false;
+
 	// 生存フラグ
 	bool isAlive_ = true;
 
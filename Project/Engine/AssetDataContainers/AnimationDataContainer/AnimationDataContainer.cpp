@@ -2,14 +2,15 @@
 
 #include <iostream>
 #include <cassert>
-#include <filesystem>
 
 #include "Logger/Logger.h"
+#include "AssetPack/AssetPack.h"
+#include "AssetPack/AssetPackIOSystem.h"
 
 using namespace MAGIMath;
 
-AnimationDataContainer::AnimationDataContainer() {
-	Initialize();
+AnimationDataContainer::AnimationDataContainer(AssetPack* assetPack) {
+	Initialize(assetPack);
 	Logger::Log("AnimationDataContainer Initialize\n");
 }
 
@@ -18,20 +19,45 @@ AnimationDataContainer::~AnimationDataContainer() {
 	Logger::Log("AnimationDataContainer Finalize\n");
 }
 
-void AnimationDataContainer::Initialize() {
+void AnimationDataContainer::Initialize(AssetPack* assetPack) {
+	SetAssetPack(assetPack);
 	animationDatas_.clear();
 }
 
 void AnimationDataContainer::Load(const std::string& animationFileName, bool isInSameDirectoryAsModel) {
-	// すでに読み込んだファイルかチェック
-	auto it = std::find(loadedAnimationFileNames_.begin(), loadedAnimationFileNames_.end(), animationFileName);
-	if (it != loadedAnimationFileNames_.end()) {
-		// すでに読み込まれていれば早期リターン
-		return;
-	}
+	// 読み込みを開始して確定まで待つ(読み込み済みなら何もしない)
+	LoadAsync(animationFileName, isInSameDirectoryAsModel);
+	// ほかの読み込みは待たない
+	loadQueue_.Wait(animationFileName, [this](const std::string&, std::vector<AnimationData>& animations) {
+		FinalizeAnimations(animations);
+		return true;
+		});
+}
+
+AssetLoadHandle AnimationDataContainer::LoadAsync(const std::string& animationFileName, bool isInSameDirectoryAsModel) {
+	// assimpの読み込みはワーカースレッドで行う
+	return loadQueue_.Request(animationFileName, [this, animationFileName, isInSameDirectoryAsModel]() {
+		return LoadAnimationFile(animationFileName, isInSameDirectoryAsModel);
+		});
+}
+
+void AnimationDataContainer::UpdateLoads() {
+	loadQueue_.Update([this](const std::string&, std::vector<AnimationData>& animations) {
+		FinalizeAnimations(animations);
+		return true;
+		});
+}
+
+void AnimationDataContainer::WaitLoads() {
+	loadQueue_.Wait([this](const std::string&, std::vector<AnimationData>& animations) {
+		FinalizeAnimations(animations);
+		return true;
+		});
+}
 
-	// アニメーションデータ用意
-	AnimationData animation;
+std::vector<AnimationData> AnimationDataContainer::LoadAnimationFile(const std::string& animationFileName, bool isInSameDirectoryAsModel) {
+	// 読み込んだアニメーション
+	std::vector<AnimationData> result;
 	// 対応する拡張子
 	std::vector<std::string> supportedExtensions = { ".gltf" };
 
@@ -42,18 +68,13 @@ void AnimationDataContainer::Load(const std::string& animationFileName, bool isI
 		? (modelDirectoryPath + animationFileName)
 		: (animationDirectoryPath + animationFileName);
 
-	// ファイル探索
-	std::filesystem::path baseDir(fileDirectoryPath);
+	// 拡張子ごとにパックの目次(無ければディスク)を引く
 	std::string animationFilePath;
-	for (const auto& entry : std::filesystem::directory_iterator(baseDir)) {
-		if (entry.is_regular_file()) {
-			std::string ext = entry.path().extension().string();
-			if (std::find(supportedExtensions.begin(), supportedExtensions.end(), ext) != supportedExtensions.end()) {
-				if (entry.path().stem().string() == animationFileName) {
-					animationFilePath = entry.path().string();
-					break;
-				}
-			}
+	for (const auto& ext : supportedExtensions) {
+		const std::string candidatePath = fileDirectoryPath + "/" + animationFileName + ext;
+		if (assetPack_->Exists(candidatePath)) {
+			animationFilePath = candidatePath;
+			break;
 		}
 	}
 
@@ -64,6 +85,8 @@ void AnimationDataContainer::Load(const std::string& animationFileName, bool isI
 
 	// Assimpで読み込み
 	Assimp::Importer importer;
+	// 参照ファイルもパックから読む(IOSystemの解放はimporterが行う)
+	importer.SetIOHandler(new AssetPackIOSystem(assetPack_));
 	const aiScene* scene = importer.ReadFile(animationFilePath.c_str(), 0);
 
 	// アニメーションが見つからない場合
@@ -125,12 +148,18 @@ void AnimationDataContainer::Load(const std::string& animationFileName, bool isI
 			}
 		}
 
-		// アニメーションをコンテナに格納
-		animationDatas_[animationData.name] = animationData;
+		// アニメーションを結果に格納
+		result.push_back(std::move(animationData));
 	}
 
-	// 読み込み完了したファイル名をリストに追加
-	loadedAnimationFileNames_.push_back(animationFileName);
+	return result;
+}
+
+void AnimationDataContainer::FinalizeAnimations(std::vector<AnimationData>& animations) {
+	// アニメーションをコンテナに格納
+	for (auto& animationData : animations) {
+		animationDatas_[animationData.name] = std::move(animationData);
+	}
 }
 
 AnimationData AnimationDataContainer::FindAnimationData(const std::string& animationName) {
@@ -141,4 +170,9 @@ AnimationData AnimationDataContainer::FindAnimationData(const std::string& anima
 	}
 	assert(false && "Warning: Not Found Animation!!");
 	return AnimationData{};
-}
\ No newline at end of file
+}
+
+void AnimationDataContainer::SetAssetPack(AssetPack* assetPack) {
+	assert(assetPack);
+	assetPack_ = assetPack;
+}
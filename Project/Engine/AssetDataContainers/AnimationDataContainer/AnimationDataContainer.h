@@ -3,7 +3,7 @@
 // C++
 #include <string>
 #include <unordered_map>
-#include <list>
+#include <vector>
 
 // Assimp
 #include <assimp/include/assimp/Importer.hpp>
@@ -12,22 +12,40 @@
 
 // MyHedder
 #include "Structs/AnimationStruct.h"
+#include "AssetLoadQueue/AssetLoadQueue.h"
+
+// 前方宣言
+class AssetPack;
 
 /// <summary>
 /// アニメーションのデータコンテナ
 /// </summary>
 class AnimationDataContainer {
 public:
-	AnimationDataContainer();
+	AnimationDataContainer(AssetPack* assetPack);
 	~AnimationDataContainer();
 
-	void Initialize();
+	void Initialize(AssetPack* assetPack);
 	void Load(const std::string& animationFileName, bool isInSameDirectoryAsModel);
+	// 非同期で読み込む(確定はメインスレッドのUpdateLoads/WaitLoadsで行う)
+	AssetLoadHandle LoadAsync(const std::string& animationFileName, bool isInSameDirectoryAsModel);
+	// 読み込みが終わったアニメーションを確定
+	void UpdateLoads();
+	// すべての非同期読み込みを待って確定
+	void WaitLoads();
 
 	AnimationData FindAnimationData(const std::string& animationName);
 private:
-	// 読み込み済みのファイルコンテナ
-	std::list<std::string> loadedAnimationFileNames_;
+	// アニメーションファイルの読み込み(ワーカースレッドで実行)
+	std::vector<AnimationData> LoadAnimationFile(const std::string& animationFileName, bool isInSameDirectoryAsModel);
+	// 読み込んだアニメーションをコンテナに確定
+	void FinalizeAnimations(std::vector<AnimationData>& animations);
+	void SetAssetPack(AssetPack* assetPack);
+private:
 	// アニメーションデータコンテナ
 	std::unordered_map<std::string, AnimationData> animationDatas_;
+	// 非同期読み込みのキュー(読み込み済みファイルの重複もここで弾く)
+	AssetLoadQueue<std::vector<AnimationData>> loadQueue_;
+private:
+	AssetPack* assetPack_ = nullptr;
 };
\ No newline at end of file
@@ -0,0 +1,176 @@
+#pragma once
+
+// C++
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/// <summary>
+/// 非同期読み込みのハンドル(メインスレッドで確定するとReadyになる)
+/// </summary>
+class AssetLoadHandle {
+public:
+	AssetLoadHandle() = default;
+	explicit AssetLoadHandle(std::shared_ptr<const std::atomic<bool>> isReady)
+		:isReady_(std::move(isReady)) {
+	}
+
+	// 読み込みが確定したか
+	bool IsReady()const {
+		return isReady_ && isReady_->load(std::memory_order_acquire);
+	}
+	// 有効なハンドルか
+	bool IsValid()const {
+		return isReady_ != nullptr;
+	}
+
+private:
+	std::shared_ptr<const std::atomic<bool>> isReady_;
+};
+
+/// <summary>
+/// ワーカースレッドで読み込み、メインスレッドで確定する読み込みキュー
+/// Requestはどのスレッドからでも呼べる。Update/Waitはメインスレッド専用
+/// 確定関数がfalseを返したものは読み込み結果を持ったまま次のUpdateでもう一度確定する
+/// </summary>
+template<typename Result>
+class AssetLoadQueue {
+public:
+	using Loader = std::function<Result()>;
+	// 確定できたらtrueを返す(Waitに渡すものは必ず確定すること)
+	using Finalizer = std::function<bool(const std::string&, Result&)>;
+
+	// 読み込みを開始する(同じキーは一度しか読み込まない)
+	AssetLoadHandle Request(const std::string& key, Loader loader) {
+		std::lock_guard<std::mutex> lock(mutex_);
+		auto it = readyFlags_.find(key);
+		if (it != readyFlags_.end()) {
+			return AssetLoadHandle(it->second);
+		}
+
+		auto readyFlag = std::make_shared<std::atomic<bool>>(false);
+		readyFlags_.emplace(key, readyFlag);
+		pendings_.push_back(Pending{
+			.key = key,
+			.future = std::async(std::launch::async, std::move(loader)),
+			.readyFlag = readyFlag,
+			.result = std::nullopt,
+			});
+		return AssetLoadHandle(readyFlag);
+	}
+
+	// 読み込みが終わったものだけ確定する
+	void Update(const Finalizer& finalizer) {
+		FinalizePendings(finalizer, false);
+	}
+
+	// すべての読み込みが終わるまで待って確定する
+	void Wait(const Finalizer& finalizer) {
+		// 確定中に別の読み込みが積まれることがあるので空になるまで繰り返す
+		while (HasPending()) {
+			FinalizePendings(finalizer, true);
+		}
+	}
+
+	// 指定したキーの読み込みだけを待って確定する(読み込み中でなければ何もしない)
+	void Wait(const std::string& key, const Finalizer& finalizer) {
+		Pending pending;
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			auto it = std::find_if(pendings_.begin(), pendings_.end(), [&key](const Pending& p) { return p.key == key; });
+			if (it == pendings_.end()) {
+				return;
+			}
+			pending = std::move(*it);
+			pendings_.erase(it);
+		}
+
+		if (!pending.result) {
+			pending.result.emplace(pending.future.get());
+		}
+		[[maybe_unused]] const bool isFinalized = finalizer(pending.key, *pending.result);
+		assert(isFinalized && "finalizer passed to Wait must finalize");
+		pending.readyFlag->store(true, std::memory_order_release);
+	}
+
+	// 確定済みのキーを忘れて、次のRequestで読み直せるようにする
+	void Forget(const std::string& key) {
+		std::lock_guard<std::mutex> lock(mutex_);
+		auto it = readyFlags_.find(key);
+		// 読み込み中のものは忘れない
+		if (it == readyFlags_.end() || !it->second->load(std::memory_order_acquire)) {
+			return;
+		}
+		readyFlags_.erase(it);
+	}
+
+	// 読み込み中のものがあるか
+	bool HasPending() {
+		std::lock_guard<std::mutex> lock(mutex_);
+		return !pendings_.empty();
+	}
+
+private:
+	/// <summary>
+	/// 読み込み中のアセット
+	/// </summary>
+	struct Pending {
+		std::string key;
+		std::future<Result> future;
+		std::shared_ptr<std::atomic<bool>> readyFlag;
+		// 受け取った読み込み結果(確定を見送ったときに持っておく)
+		std::optional<Result> result;
+	};
+
+	void FinalizePendings(const Finalizer& finalizer, bool isWait) {
+		// 終わったものをロックの外に取り出す
+		std::vector<Pending> completed;
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			for (auto it = pendings_.begin(); it != pendings_.end();) {
+				if (isWait || it->result || it->future.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+					completed.push_back(std::move(*it));
+					it = pendings_.erase(it);
+				} else {
+					++it;
+				}
+			}
+		}
+
+		// 確定はリクエスト順に行う
+		std::vector<Pending> deferred;
+		for (auto& pending : completed) {
+			if (!pending.result) {
+				pending.result.emplace(pending.future.get());
+			}
+			if (!finalizer(pending.key, *pending.result)) {
+				assert(!isWait && "finalizer passed to Wait must finalize");
+				deferred.push_back(std::move(pending));
+				continue;
+			}
+			pending.readyFlag->store(true, std::memory_order_release);
+		}
+
+		// 見送ったものは順番を保って先頭に戻す
+		if (!deferred.empty()) {
+			std::lock_guard<std::mutex> lock(mutex_);
+			pendings_.insert(pendings_.begin(), std::make_move_iterator(deferred.begin()), std::make_move_iterator(deferred.end()));
+		}
+	}
+
+private:
+	std::mutex mutex_;
+	// 読み込み中のアセット
+	std::vector<Pending> pendings_;
+	// リクエスト済みのキーと確定フラグ
+	std::unordered_map<std::string, std::shared_ptr<std::atomic<bool>>> readyFlags_;
+};
@@ -0,0 +1,157 @@
+#include "AssetPack.h"
+
+// C++
+#include <cassert>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+// MyHedder
+#include "Logger/Logger.h"
+
+// ツール(Tools/AssetPacker)が書き出すレイアウトと一致させる
+static_assert(sizeof(AssetPack::Header) == 32);
+static_assert(sizeof(AssetPack::Entry) == 32);
+
+namespace {
+	// パスの1文字を正規化(区切り文字を'/'に、英字を小文字に)
+	char NormalizePathChar(char c) {
+		if (c == '\\') return '/';
+		if (c >= 'A' && c <= 'Z') return static_cast<char>(c - 'A' + 'a');
+		return c;
+	}
+
+	// 正規化したうえでパスが一致するか
+	bool IsSamePath(const char* packPath, uint32_t packPathLength, const std::string& filePath) {
+		if (packPathLength != filePath.size()) return false;
+		for (uint32_t i = 0; i < packPathLength; i++) {
+			if (NormalizePathChar(packPath[i]) != NormalizePathChar(filePath[i])) return false;
+		}
+		return true;
+	}
+}
+
+AssetPack::AssetPack(const std::string& packFilePath) {
+	Initialize(packFilePath);
+	Logger::Log("AssetPack Initialize\n");
+}
+
+AssetPack::~AssetPack() {
+	Close();
+	Logger::Log("AssetPack Finalize\n");
+}
+
+void AssetPack::Initialize(const std::string& packFilePath) {
+	// パックが無ければディスクから読む
+	if (!std::filesystem::exists(packFilePath)) {
+		Logger::Log("AssetPack: " + packFilePath + " not found. Loading loose files\n");
+		return;
+	}
+
+	const std::wstring packFilePathW = Logger::ConvertString(packFilePath);
+	file_ = CreateFileW(packFilePathW.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	assert(file_ != INVALID_HANDLE_VALUE);
+
+	LARGE_INTEGER fileSize{};
+	GetFileSizeEx(file_, &fileSize);
+	viewSize_ = static_cast<uint64_t>(fileSize.QuadPart);
+	assert(viewSize_ >= sizeof(Header));
+
+	mapping_ = CreateFileMappingW(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	assert(mapping_);
+	view_ = static_cast<const uint8_t*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+	assert(view_);
+
+	// ヘッダーと目次の確認
+	header_ = reinterpret_cast<const Header*>(view_);
+	assert(std::memcmp(header_->magic, kMagic, sizeof(kMagic)) == 0 && "Invalid asset pack");
+	assert(header_->version == kVersion && "Unsupported asset pack version");
+	assert(header_->tableSize > 0 && (header_->tableSize & (header_->tableSize - 1)) == 0);
+	assert(header_->tableOffset + sizeof(Entry) * header_->tableSize <= viewSize_);
+	assert(header_->stringOffset <= viewSize_);
+
+	entries_ = reinterpret_cast<const Entry*>(view_ + header_->tableOffset);
+	strings_ = reinterpret_cast<const char*>(view_ + header_->stringOffset);
+
+	Logger::Log("AssetPack: " + packFilePath + " mapped\n");
+}
+
+bool AssetPack::IsOpen() const {
+	return view_ != nullptr;
+}
+
+std::span<const uint8_t> AssetPack::Find(const std::string& filePath) const {
+	if (!IsOpen()) {
+		return {};
+	}
+
+	const uint64_t hash = HashPath(filePath);
+	const uint32_t mask = header_->tableSize - 1;
+
+	// 線形探査(空きスロットに当たれば無い)
+	for (uint32_t i = 0; i < header_->tableSize; i++) {
+		const Entry& entry = entries_[(static_cast<uint32_t>(hash) + i) & mask];
+		if (entry.nameLength == 0) {
+			break;
+		}
+		if (entry.hash == hash && IsSamePath(strings_ + entry.nameOffset, entry.nameLength, filePath)) {
+			assert(entry.dataOffset + entry.dataSize <= viewSize_);
+			return { view_ + entry.dataOffset, static_cast<size_t>(entry.dataSize) };
+		}
+	}
+	return {};
+}
+
+bool AssetPack::Contains(const std::string& filePath) const {
+	return Find(filePath).data() != nullptr;
+}
+
+bool AssetPack::Exists(const std::string& filePath) const {
+	return Contains(filePath) || std::filesystem::exists(filePath);
+}
+
+std::span<const uint8_t> AssetPack::ReadFile(const std::string& filePath, std::vector<uint8_t>& looseData) const {
+	// パックにあればマップしたメモリをそのまま返す
+	const std::span<const uint8_t> packedData = Find(filePath);
+	if (packedData.data()) {
+		return packedData;
+	}
+
+	// ディスクから丸ごと読む
+	std::ifstream file(filePath, std::ios_base::binary | std::ios_base::ate);
+	if (!file.is_open()) {
+		return {};
+	}
+	looseData.resize(static_cast<size_t>(file.tellg()));
+	file.seekg(0, std::ios_base::beg);
+	file.read(reinterpret_cast<char*>(looseData.data()), looseData.size());
+	return looseData;
+}
+
+uint64_t AssetPack::HashPath(const std::string& filePath) {
+	uint64_t hash = 14695981039346656037ull;
+	for (char c : filePath) {
+		hash ^= static_cast<uint8_t>(NormalizePathChar(c));
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+void AssetPack::Close() {
+	if (view_) {
+		UnmapViewOfFile(view_);
+		view_ = nullptr;
+	}
+	if (mapping_) {
+		CloseHandle(mapping_);
+		mapping_ = nullptr;
+	}
+	if (file_ != INVALID_HANDLE_VALUE) {
+		CloseHandle(file_);
+		file_ = INVALID_HANDLE_VALUE;
+	}
+	header_ = nullptr;
+	entries_ = nullptr;
+	strings_ = nullptr;
+	viewSize_ = 0;
+}
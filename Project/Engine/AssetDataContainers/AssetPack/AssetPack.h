@@ -0,0 +1,84 @@
+#pragma once
+
+// C++
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+// Windows
+#include <Windows.h>
+
+/// <summary>
+/// 1ファイルにまとめたアセットパック(メモリマップで読む)
+/// 目次はパスのハッシュをキーにしたオープンアドレス法のテーブルで、O(1)で引ける
+/// パックが無い、またはパックに無いファイルはディスクから読む
+/// </summary>
+class AssetPack {
+public:
+	AssetPack(const std::string& packFilePath);
+	~AssetPack();
+
+	// 初期化(パックファイルが無ければ開かない)
+	void Initialize(const std::string& packFilePath);
+	// パックを開いているか
+	bool IsOpen()const;
+
+	// パック内のファイルを検索(無ければ空を返す)
+	std::span<const uint8_t> Find(const std::string& filePath)const;
+	// パック内にあるか
+	bool Contains(const std::string& filePath)const;
+	// パック内かディスク上にファイルがあるか
+	bool Exists(const std::string& filePath)const;
+	// ファイルの中身を取得(パックに無ければlooseDataへディスクから読む。どちらにも無ければ空)
+	std::span<const uint8_t> ReadFile(const std::string& filePath, std::vector<uint8_t>& looseData)const;
+
+	// 目次のキーにするハッシュ(区切り文字と大文字小文字を正規化したFNV-1a)
+	static uint64_t HashPath(const std::string& filePath);
+
+public:
+	// パックのヘッダー
+	struct Header {
+		char magic[8];
+		uint32_t version;
+		// 目次のスロット数(2のべき乗)
+		uint32_t tableSize;
+		// 目次の位置
+		uint64_t tableOffset;
+		// パス文字列の位置
+		uint64_t stringOffset;
+	};
+
+	// 目次の1スロット(nameLengthが0なら空き)
+	struct Entry {
+		uint64_t hash;
+		uint64_t dataOffset;
+		uint64_t dataSize;
+		uint32_t nameOffset;
+		uint32_t nameLength;
+	};
+
+	// パックの識別子
+	static constexpr char kMagic[8] = { 'M','A','G','I','P','A','C','K' };
+	// パックのバージョン
+	static constexpr uint32_t kVersion = 1;
+private:
+	// パックを閉じる
+	void Close();
+private:
+	// ファイルハンドル
+	HANDLE file_ = INVALID_HANDLE_VALUE;
+	// ファイルマッピングハンドル
+	HANDLE mapping_ = nullptr;
+	// マップしたパック全体
+	const uint8_t* view_ = nullptr;
+	// パックのサイズ
+	uint64_t viewSize_ = 0;
+
+	// ヘッダー
+	const Header* header_ = nullptr;
+	// 目次
+	const Entry* entries_ = nullptr;
+	// パス文字列
+	const char* strings_ = nullptr;
+};
@@ -0,0 +1,39 @@
+#include "AssetPackIOSystem.h"
+
+// C++
+#include <cassert>
+#include <span>
+
+// assimp
+#include <assimp/include/assimp/MemoryIOWrapper.h>
+
+// MyHedder
+#include "AssetPack/AssetPack.h"
+
+AssetPackIOSystem::AssetPackIOSystem(const AssetPack* assetPack, std::vector<std::string>* openedFiles) {
+	assert(assetPack);
+	assetPack_ = assetPack;
+	openedFiles_ = openedFiles;
+}
+
+bool AssetPackIOSystem::Exists(const char* pFile) const {
+	if (assetPack_->Contains(pFile)) {
+		return true;
+	}
+	return Assimp::DefaultIOSystem::Exists(pFile);
+}
+
+Assimp::IOStream* AssetPackIOSystem::Open(const char* pFile, const char* pMode) {
+	// パックは読み込み専用
+	if (pMode[0] == 'r') {
+		if (openedFiles_) {
+			openedFiles_->push_back(pFile);
+		}
+		const std::span<const uint8_t> data = assetPack_->Find(pFile);
+		if (data.data()) {
+			// マップしたメモリをそのまま読む(所有はしない)
+			return new Assimp::MemoryIOStream(data.data(), data.size(), false);
+		}
+	}
+	return Assimp::DefaultIOSystem::Open(pFile, pMode);
+}
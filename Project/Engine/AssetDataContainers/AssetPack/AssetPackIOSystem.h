@@ -0,0 +1,30 @@
+#pragma once
+
+// C++
+#include <string>
+#include <vector>
+
+// assimp
+#include <assimp/include/assimp/DefaultIOSystem.h>
+
+// 前方宣言
+class AssetPack;
+
+/// <summary>
+/// assimpがアセットパックからファイルを読むためのIOSystem
+/// gltfの.binなど、モデルが参照するファイルもパックから引く
+/// パックに無いファイルは通常のファイル読み込みに任せる
+/// </summary>
+class AssetPackIOSystem :public Assimp::DefaultIOSystem {
+public:
+	// openedFilesを渡すと、読み込みで開いたファイルのパスを記録する
+	AssetPackIOSystem(const AssetPack* assetPack, std::vector<std::string>* openedFiles = nullptr);
+
+	bool Exists(const char* pFile)const override;
+	Assimp::IOStream* Open(const char* pFile, const char* pMode = "rb") override;
+private:
+	// アセットパック
+	const AssetPack* assetPack_ = nullptr;
+	// 開いたファイルの記録先
+	std::vector<std::string>* openedFiles_ = nullptr;
+};
@@ -0,0 +1,95 @@
+#pragma once
+
+// C++
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/// <summary>
+/// キャッシュ用のバイナリ書き込み(メモリ上に積む)
+/// </summary>
+class BinaryWriter {
+public:
+	// 値をそのまま書き込む
+	template<typename T>
+	void Write(const T& value) {
+		static_assert(std::is_trivially_copyable_v<T>);
+		const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+		data_.insert(data_.end(), bytes, bytes + sizeof(T));
+	}
+
+	// 要素数と中身を書き込む
+	template<typename T>
+	void WriteVector(const std::vector<T>& values) {
+		static_assert(std::is_trivially_copyable_v<T>);
+		Write<uint64_t>(values.size());
+		const uint8_t* bytes = reinterpret_cast<const uint8_t*>(values.data());
+		data_.insert(data_.end(), bytes, bytes + sizeof(T) * values.size());
+	}
+
+	// 文字列を書き込む
+	void WriteString(const std::string& value) {
+		Write<uint64_t>(value.size());
+		data_.insert(data_.end(), value.begin(), value.end());
+	}
+
+	// 書き込んだデータ
+	const std::vector<uint8_t>& GetData()const {
+		return data_;
+	}
+
+private:
+	std::vector<uint8_t> data_;
+};
+
+/// <summary>
+/// キャッシュ用のバイナリ読み込み(範囲外を読もうとしたらfalseを返す)
+/// </summary>
+class BinaryReader {
+public:
+	explicit BinaryReader(std::span<const uint8_t> data)
+		:data_(data) {
+	}
+
+	template<typename T>
+	bool Read(T& value) {
+		static_assert(std::is_trivially_copyable_v<T>);
+		if (cursor_ + sizeof(T) > data_.size()) return false;
+		std::memcpy(&value, data_.data() + cursor_, sizeof(T));
+		cursor_ += sizeof(T);
+		return true;
+	}
+
+	template<typename T>
+	bool ReadVector(std::vector<T>& values) {
+		static_assert(std::is_trivially_copyable_v<T>);
+		uint64_t count = 0;
+		if (!Read(count)) return false;
+		if (count > (data_.size() - cursor_) / sizeof(T)) return false;
+		values.resize(static_cast<size_t>(count));
+		std::memcpy(values.data(), data_.data() + cursor_, sizeof(T) * values.size());
+		cursor_ += sizeof(T) * values.size();
+		return true;
+	}
+
+	bool ReadString(std::string& value) {
+		uint64_t length = 0;
+		if (!Read(length)) return false;
+		if (length > data_.size() - cursor_) return false;
+		value.assign(reinterpret_cast<const char*>(data_.data() + cursor_), static_cast<size_t>(length));
+		cursor_ += static_cast<size_t>(length);
+		return true;
+	}
+
+	// 残りのデータ
+	std::span<const uint8_t> GetRemaining()const {
+		return data_.subspan(cursor_);
+	}
+
+private:
+	std::span<const uint8_t> data_;
+	size_t cursor_ = 0;
+};
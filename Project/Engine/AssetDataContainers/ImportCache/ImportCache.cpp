@@ -0,0 +1,130 @@
+#include "ImportCache.h"
+
+// C++
+#include <cassert>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <thread>
+
+// MyHedder
+#include "Logger/Logger.h"
+#include "AssetPack/AssetPack.h"
+#include "ImportCache/BinaryStream.h"
+
+ImportCache::ImportCache(AssetPack* assetPack, const std::string& cacheDirectory) {
+	Initialize(assetPack, cacheDirectory);
+	Logger::Log("ImportCache Initialize\n");
+}
+
+ImportCache::~ImportCache() {
+	Logger::Log("ImportCache Finalize\n");
+}
+
+void ImportCache::Initialize(AssetPack* assetPack, const std::string& cacheDirectory) {
+	SetAssetPack(assetPack);
+	cacheDirectory_ = cacheDirectory;
+
+	// キャッシュディレクトリを作成
+	std::error_code ec;
+	std::filesystem::create_directories(cacheDirectory_, ec);
+}
+
+std::string ImportCache::MakeKey(std::span<const uint8_t> sourceData, const std::string& importerName, uint32_t importerVersion, uint64_t flags) {
+	uint64_t hash = HashBytes(sourceData);
+	hash = HashBytes({ reinterpret_cast<const uint8_t*>(importerName.data()), importerName.size() }, hash);
+	hash = HashBytes({ reinterpret_cast<const uint8_t*>(&importerVersion), sizeof(importerVersion) }, hash);
+	hash = HashBytes({ reinterpret_cast<const uint8_t*>(&flags), sizeof(flags) }, hash);
+	// ハッシュに加えてソースのサイズも名前に入れて衝突を避ける
+	return std::format("{}_{:016x}_{:x}", importerName, hash, sourceData.size());
+}
+
+bool ImportCache::Load(const std::string& key, std::vector<uint8_t>& outData) const {
+	std::ifstream file(MakeCacheFilePath(key), std::ios_base::binary | std::ios_base::ate);
+	if (!file.is_open()) {
+		return false;
+	}
+	std::vector<uint8_t> fileData(static_cast<size_t>(file.tellg()));
+	file.seekg(0, std::ios_base::beg);
+	file.read(reinterpret_cast<char*>(fileData.data()), fileData.size());
+	file.close();
+
+	BinaryReader reader(fileData);
+
+	// ヘッダーの確認
+	char magic[8]{};
+	uint32_t version = 0;
+	if (!reader.Read(magic) || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0) return false;
+	if (!reader.Read(version) || version != kVersion) return false;
+
+	// 依存ファイルの中身が変わっていないか確認
+	uint32_t dependencyCount = 0;
+	if (!reader.Read(dependencyCount)) return false;
+	std::vector<uint8_t> looseData;
+	for (uint32_t i = 0; i < dependencyCount; i++) {
+		std::string path;
+		uint64_t hash = 0;
+		if (!reader.ReadString(path) || !reader.Read(hash)) return false;
+		const std::span<const uint8_t> dependencyData = assetPack_->ReadFile(path, looseData);
+		if (!dependencyData.data() || HashBytes(dependencyData) != hash) return false;
+	}
+
+	// 本体
+	if (!reader.ReadVector(outData)) return false;
+	return true;
+}
+
+void ImportCache::Store(const std::string& key, std::span<const uint8_t> data, const std::vector<std::string>& dependencies) const {
+	BinaryWriter writer;
+	writer.Write(kMagic);
+	writer.Write(kVersion);
+
+	// 依存ファイルとその中身のハッシュ
+	writer.Write(static_cast<uint32_t>(dependencies.size()));
+	std::vector<uint8_t> looseData;
+	for (const auto& path : dependencies) {
+		const std::span<const uint8_t> dependencyData = assetPack_->ReadFile(path, looseData);
+		writer.WriteString(path);
+		writer.Write(HashBytes(dependencyData));
+	}
+
+	// 本体
+	writer.Write<uint64_t>(data.size());
+	const std::vector<uint8_t>& header = writer.GetData();
+
+	// 書きかけのファイルを読まないよう一時ファイルに書いてから置き換える(同じ中身を別スレッドが書くこともあるので名前を分ける)
+	const std::string cacheFilePath = MakeCacheFilePath(key);
+	const std::string tempFilePath = std::format("{}.{:x}.tmp", cacheFilePath, std::hash<std::thread::id>{}(std::this_thread::get_id()));
+	{
+		std::ofstream file(tempFilePath, std::ios_base::binary | std::ios_base::trunc);
+		if (!file.is_open()) {
+			Logger::Log("ImportCache: failed to write " + cacheFilePath + "\n");
+			return;
+		}
+		file.write(reinterpret_cast<const char*>(header.data()), header.size());
+		file.write(reinterpret_cast<const char*>(data.data()), data.size());
+	}
+	std::error_code ec;
+	std::filesystem::rename(tempFilePath, cacheFilePath, ec);
+	if (ec) {
+		std::filesystem::remove(tempFilePath, ec);
+	}
+}
+
+uint64_t ImportCache::HashBytes(std::span<const uint8_t> data, uint64_t hash) {
+	for (uint8_t byte : data) {
+		hash ^= byte;
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+std::string ImportCache::MakeCacheFilePath(const std::string& key) const {
+	return cacheDirectory_ + "/" + key + ".bin";
+}
+
+void ImportCache::SetAssetPack(AssetPack* assetPack) {
+	assert(assetPack);
+	assetPack_ = assetPack;
+}
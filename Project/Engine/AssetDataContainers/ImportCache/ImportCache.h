@@ -0,0 +1,52 @@
+#pragma once
+
+// C++
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+// 前方宣言
+class AssetPack;
+
+/// <summary>
+/// インポート結果のキャッシュ
+/// ソースのバイト列、インポーターのバージョン、フラグのハッシュをファイル名にして保存する
+/// 中身で引くので、変更していないアセットは起動のたびに作り直さなくてよい
+/// </summary>
+class ImportCache {
+public:
+	ImportCache(AssetPack* assetPack, const std::string& cacheDirectory);
+	~ImportCache();
+
+	// 初期化
+	void Initialize(AssetPack* assetPack, const std::string& cacheDirectory);
+
+	// ソースのバイト列とインポート設定からキーを作る
+	static std::string MakeKey(std::span<const uint8_t> sourceData, const std::string& importerName, uint32_t importerVersion, uint64_t flags);
+	// キャッシュを読む(無い、または依存ファイルの中身が変わっていればfalse)
+	bool Load(const std::string& key, std::vector<uint8_t>& outData)const;
+	// キャッシュに書き込む(dependenciesは中身が変わったらキャッシュを無効にする追加のソースファイル)
+	void Store(const std::string& key, std::span<const uint8_t> data, const std::vector<std::string>& dependencies = {})const;
+
+private:
+	// バイト列のハッシュ(FNV-1a)
+	static uint64_t HashBytes(std::span<const uint8_t> data, uint64_t hash = kHashOffset);
+	// キーからキャッシュファイルのパスを作る
+	std::string MakeCacheFilePath(const std::string& key)const;
+	// AssetPackのセット
+	void SetAssetPack(AssetPack* assetPack);
+
+private:
+	// キャッシュファイルの識別子
+	static constexpr char kMagic[8] = { 'M','A','G','I','C','A','C','H' };
+	// キャッシュファイルのバージョン
+	static constexpr uint32_t kVersion = 1;
+	// FNV-1aの初期値
+	static constexpr uint64_t kHashOffset = 14695981039346656037ull;
+
+	// キャッシュを置くディレクトリ
+	std::string cacheDirectory_;
+	// ソースの読み込み元
+	AssetPack* assetPack_ = nullptr;
+};
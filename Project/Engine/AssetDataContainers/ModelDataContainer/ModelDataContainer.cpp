@@ -2,16 +2,63 @@
 
 #include <iostream>
 #include <cassert>
-#include <filesystem>
+#include <algorithm>
+#include <cfloat>
 
 #include "Logger/Logger.h"
+#include "Const/ModelConst.h"
+#include "Const/ImportCacheConst.h"
+#include "MeshSimplifier/MeshSimplifier.h"
+#include "MeshOptimizer/MeshOptimizer.h"
+#include "VertexQuantizer/VertexQuantizer.h"
 
 #include "TextureDataContainer/TextureDataContainer.h"
+#include "AssetPack/AssetPack.h"
+#include "AssetPack/AssetPackIOSystem.h"
+#include "ImportCache/ImportCache.h"
+#include "ImportCache/BinaryStream.h"
 
 using namespace MAGIMath;
 
-ModelDataContainer::ModelDataContainer(TextureDataContainer* textureDataContainer) {
-	Initialize(textureDataContainer);
+namespace {
+	// assimpの読み込みフラグ
+	const uint32_t kImportFlags =
+		aiProcess_FlipWindingOrder |
+		aiProcess_FlipUVs |
+		aiProcess_Triangulate |
+		aiProcess_CalcTangentSpace |
+		aiProcess_JoinIdenticalVertices |  // 重複頂点のマージ（ボーンの影響を統一）
+		aiProcess_LimitBoneWeights |       // 最大4ボーンに制限
+		aiProcess_PopulateArmatureData |   // アーマチュアデータを整理（Assimp 5.3 以降）
+		aiProcess_GenSmoothNormals;
+
+	// ノードを再帰的に書き出す
+	void WriteCachedNode(BinaryWriter& writer, const Node& node) {
+		writer.Write(node.transform);
+		writer.Write(node.localMatrix);
+		writer.WriteString(node.name);
+		writer.Write<uint64_t>(node.children.size());
+		for (const auto& child : node.children) {
+			WriteCachedNode(writer, child);
+		}
+	}
+
+	// ノードを再帰的に読む
+	bool ReadCachedNode(BinaryReader& reader, Node& node) {
+		uint64_t childCount = 0;
+		if (!reader.Read(node.transform) || !reader.Read(node.localMatrix) || !reader.ReadString(node.name) || !reader.Read(childCount)) {
+			return false;
+		}
+		node.children.resize(static_cast<size_t>(childCount));
+		for (auto& child : node.children) {
+			if (!ReadCachedNode(reader, child)) return false;
+		}
+		return true;
+	}
+}
+
+ModelDataContainer::ModelDataContainer(TextureDataContainer* textureDataContainer, AssetPack* assetPack, ImportCache* importCache) {
+	Initialize(textureDataContainer, assetPack, importCache);
 	Logger::Log("ModelDataContainer Initialize\n");
 }
 
@@ -20,8 +67,10 @@ ModelDataContainer::~ModelDataContainer() {
 	Logger::Log("ModelDataContainer Finalize\n");
 }
 
-void ModelDataContainer::Initialize(TextureDataContainer* textureDataContainer) {
+void ModelDataContainer::Initialize(TextureDataContainer* textureDataContainer, AssetPack* assetPack, ImportCache* importCache) {
 	SetTextureDataContainer(textureDataContainer);
+	SetAssetPack(assetPack);
+	SetImportCache(importCache);
 	// コンテナをクリア
 	modelDatas_.clear();
 }
@@ -32,8 +81,45 @@ void ModelDataContainer::Load(const std::string& modelName) {
 		// 読み込み済みなら早期リターン
 		return;
 	}
-	// モデルを読み込みコンテナに挿入
-	modelDatas_.insert(std::make_pair(modelName, LoadModel(modelName)));
+	// 読み込みを開始して確定まで待つ(ほかの読み込みは待たない)
+	LoadAsync(modelName);
+	WaitLoad(modelName);
+}
+
+AssetLoadHandle ModelDataContainer::LoadAsync(const std::string& modelName) {
+	// assimpの読み込みと前処理はワーカースレッドで行う
+	return loadQueue_.Request(modelName, [this, modelName]() {
+		LoadedModel loadedModel;
+		loadedModel.modelData = LoadModel(modelName, loadedModel.textureHandles);
+		return loadedModel;
+		});
+}
+
+void ModelDataContainer::UpdateLoads() {
+	// テクスチャが確定していないモデルは待たずに次のフレームへ回す
+	loadQueue_.Update([this](const std::string& modelName, LoadedModel& loadedModel) {
+		if (!IsTexturesReady(loadedModel)) {
+			return false;
+		}
+		FinalizeModel(modelName, loadedModel);
+		return true;
+		});
+}
+
+void ModelDataContainer::WaitLoads() {
+	loadQueue_.Wait([this](const std::string& modelName, LoadedModel& loadedModel) {
+		WaitTextures(loadedModel);
+		FinalizeModel(modelName, loadedModel);
+		return true;
+		});
+}
+
+void ModelDataContainer::WaitLoad(const std::string& modelName) {
+	loadQueue_.Wait(modelName, [this](const std::string& key, LoadedModel& loadedModel) {
+		WaitTextures(loadedModel);
+		FinalizeModel(key, loadedModel);
+		return true;
+		});
 }
 
 ModelData ModelDataContainer::FindModelData(const std::string& modelName) const {
@@ -48,29 +134,37 @@ ModelData ModelDataContainer::FindModelData(const std::string& modelName) const
 	return ModelData{};
 }
 
-ModelData ModelDataContainer::LoadModel(const std::string& modelName) {
+AABB ModelDataContainer::FindModelLocalAABB(const std::string& modelName) const {
+	// 読み込み済みモデルを検索
+	auto it = modelDatas_.find(modelName);
+	if (it != modelDatas_.end()) {
+		return it->second.localAABB;
+	}
+	// 未読み込みの場合は原点の点として扱う
+	return AABB{};
+}
+
+bool ModelDataContainer::IsModelLoaded(const std::string& modelName) const {
+	return modelDatas_.contains(modelName);
+}
+
+ModelData ModelDataContainer::LoadModel(const std::string& modelName, std::vector<AssetLoadHandle>& textureHandles) {
 	// 対応する拡張子のリスト
 	std::vector<std::string> supportedExtensions = { ".obj", ".gltf" };
 
-	// ディレクトリ内のファイルを検索
+	// モデルが入っているディレクトリ
 	std::string directoryPath = "Assets/Models";
 	// モデルファイルが入っているディレクトリ
 	std::string fileDirectoryPath = directoryPath + "/" + modelName;
-	// filesystem用
-	std::filesystem::path modelDirectoryPath(fileDirectoryPath);
 
 	std::string modelFilePath;
 
-	for (const auto& entry : std::filesystem::directory_iterator(modelDirectoryPath)) {
-		if (entry.is_regular_file()) {
-			std::string ext = entry.path().extension().string();
-			// 対応する拡張子かチェック
-			if (std::find(supportedExtensions.begin(), supportedExtensions.end(), ext) != supportedExtensions.end()) {
-				if (entry.path().stem().string() == modelName) {
-					modelFilePath = entry.path().string();
-					break;
-				}
-			}
+	// 拡張子ごとにパックの目次(無ければディスク)を引く
+	for (const auto& ext : supportedExtensions) {
+		const std::string candidatePath = fileDirectoryPath + "/" + modelName + ext;
+		if (assetPack_->Exists(candidatePath)) {
+			modelFilePath = candidatePath;
+			break;
 		}
 	}
 
@@ -79,6 +173,23 @@ ModelData ModelDataContainer::LoadModel(const std::string& modelName) {
 		std::cerr << "Error: Model file not found or unsupported format." << std::endl;
 	}
 
+	// ソースの中身と読み込み設定でキャッシュを引く
+	std::vector<uint8_t> looseSourceData;
+	const std::span<const uint8_t> sourceData = assetPack_->ReadFile(modelFilePath, looseSourceData);
+	const std::string cacheKey = ImportCache::MakeKey(sourceData, "Model", ImportCacheConst::ModelVersion, kImportFlags);
+	{
+		std::vector<uint8_t> cacheData;
+		if (importCache_->Load(cacheKey, cacheData)) {
+			BinaryReader reader(cacheData);
+			ModelData cachedModelData{};
+			if (DeserializeModel(reader, cachedModelData)) {
+				cachedModelData.name = modelName;
+				RequestTextures(cachedModelData, textureHandles);
+				return cachedModelData;
+			}
+		}
+	}
+
 	// 今回追加するモデルのデータ
 	ModelData newModelData{};
 
@@ -86,17 +197,10 @@ ModelData ModelDataContainer::LoadModel(const std::string& modelName) {
 	newModelData.name = modelName;
 
 	Assimp::Importer importer;
-	const aiScene* scene = importer.ReadFile(
-		modelFilePath.c_str(),
-		aiProcess_FlipWindingOrder |
-		aiProcess_FlipUVs |
-		aiProcess_Triangulate |
-		aiProcess_CalcTangentSpace |
-		aiProcess_JoinIdenticalVertices |  // 重複頂点のマージ（ボーンの影響を統一）
-		aiProcess_LimitBoneWeights |       // 最大4ボーンに制限
-		aiProcess_PopulateArmatureData |   // アーマチュアデータを整理（Assimp 5.3 以降）
-		aiProcess_GenSmoothNormals
-	);
+	// 参照ファイルもパックから読む(IOSystemの解放はimporterが行う)
+	std::vector<std::string> openedFiles;
+	importer.SetIOHandler(new AssetPackIOSystem(assetPack_, &openedFiles));
+	const aiScene* scene = importer.ReadFile(modelFilePath.c_str(), kImportFlags);
 	assert(scene && scene->HasMeshes());
 
 	// ノード読み込み
@@ -117,14 +221,14 @@ ModelData ModelDataContainer::LoadModel(const std::string& modelName) {
 
 			// 通常の Diffuse テクスチャ読み込み
 			materialData.textureFilePath = fileDirectoryPath + "/" + diffuseTexName;
-			textureDataContainer_->Load(materialData.textureFilePath);
+			textureHandles.push_back(textureDataContainer_->LoadAsync(materialData.textureFilePath));
 
 			// normalMapのテクスチャが割り当てられている場合
 			aiString normalMapPath;
 			if (material->GetTexture(aiTextureType_NORMALS, 0, &normalMapPath) == AI_SUCCESS) {
 				// アセットにNormal Mapが設定されているので、こちらを使う
 				materialData.normalMapTextureFilePath = fileDirectoryPath + "/" + normalMapPath.C_Str();
-				textureDataContainer_->LoadNormalMap(materialData.normalMapTextureFilePath);
+				textureHandles.push_back(textureDataContainer_->LoadNormalMapAsync(materialData.normalMapTextureFilePath));
 			} else {
 
 			}
@@ -249,9 +353,144 @@ ModelData ModelDataContainer::LoadModel(const std::string& modelName) {
 		newModelData.meshes.push_back(meshData);
 	}
 
+	// メシュレット化に向けて三角形と頂点を並べ替える
+	OptimizeMeshes(newModelData);
+
+	// モデル空間の境界ボックスを計算
+	newModelData.localAABB = CalculateLocalAABB(newModelData);
+
+	// 簡略化したLODを生成
+	GenerateLODs(newModelData);
+
+	// 描画用に頂点を量子化
+	QuantizeMeshes(newModelData);
+
+	// キャッシュに保存(.binなど本体以外に開いたファイルは依存として記録)
+	std::erase(openedFiles, modelFilePath);
+	std::sort(openedFiles.begin(), openedFiles.end());
+	openedFiles.erase(std::unique(openedFiles.begin(), openedFiles.end()), openedFiles.end());
+	BinaryWriter writer;
+	SerializeModel(writer, newModelData);
+	importCache_->Store(cacheKey, writer.GetData(), openedFiles);
+
 	return newModelData;
 }
 
+void ModelDataContainer::RequestTextures(const ModelData& modelData, std::vector<AssetLoadHandle>& textureHandles) {
+	for (const auto& mesh : modelData.meshes) {
+		if (!mesh.material.textureFilePath.empty()) {
+			textureHandles.push_back(textureDataContainer_->LoadAsync(mesh.material.textureFilePath));
+		}
+		if (!mesh.material.normalMapTextureFilePath.empty()) {
+			textureHandles.push_back(textureDataContainer_->LoadNormalMapAsync(mesh.material.normalMapTextureFilePath));
+		}
+	}
+}
+
+void ModelDataContainer::SerializeModel(BinaryWriter& writer, const ModelData& modelData) {
+	// メッシュ
+	writer.Write<uint64_t>(modelData.meshes.size());
+	for (const auto& mesh : modelData.meshes) {
+		// フル精度の頂点はスキニングするモデルだけが持つ(それ以外は空)
+		writer.WriteVector(mesh.vertices);
+		writer.WriteVector(mesh.indices);
+		writer.WriteString(mesh.material.textureFilePath);
+		writer.WriteString(mesh.material.normalMapTextureFilePath);
+		writer.Write(mesh.material.uvMatrix);
+		writer.Write(mesh.material.color);
+		writer.Write<uint64_t>(mesh.lods.size());
+		for (const auto& lod : mesh.lods) {
+			writer.WriteVector(lod.indices);
+			writer.Write(lod.error);
+		}
+		writer.WriteVector(mesh.quantizedVertices);
+		writer.Write(mesh.quantization);
+	}
+
+	// ノード
+	WriteCachedNode(writer, modelData.rootNode);
+
+	// スキンクラスター
+	writer.Write<uint64_t>(modelData.skinClusterData.size());
+	for (const auto& [jointName, jointWeightData] : modelData.skinClusterData) {
+		writer.WriteString(jointName);
+		writer.Write(jointWeightData.inverseBindPoseMatrix);
+		writer.WriteVector(jointWeightData.jointToVertexWeights);
+	}
+
+	writer.Write(modelData.localAABB);
+	writer.WriteVector(modelData.lodErrors);
+}
+
+bool ModelDataContainer::DeserializeModel(BinaryReader& reader, ModelData& modelData) {
+	// メッシュ
+	uint64_t meshCount = 0;
+	if (!reader.Read(meshCount)) return false;
+	modelData.meshes.resize(static_cast<size_t>(meshCount));
+	for (auto& mesh : modelData.meshes) {
+		uint64_t lodCount = 0;
+		if (!reader.ReadVector(mesh.vertices) ||
+			!reader.ReadVector(mesh.indices) ||
+			!reader.ReadString(mesh.material.textureFilePath) ||
+			!reader.ReadString(mesh.material.normalMapTextureFilePath) ||
+			!reader.Read(mesh.material.uvMatrix) ||
+			!reader.Read(mesh.material.color) ||
+			!reader.Read(lodCount)) {
+			return false;
+		}
+		mesh.lods.resize(static_cast<size_t>(lodCount));
+		for (auto& lod : mesh.lods) {
+			if (!reader.ReadVector(lod.indices) || !reader.Read(lod.error)) return false;
+		}
+		if (!reader.ReadVector(mesh.quantizedVertices) || !reader.Read(mesh.quantization)) return false;
+	}
+
+	// ノード
+	if (!ReadCachedNode(reader, modelData.rootNode)) return false;
+
+	// スキンクラスター
+	uint64_t jointCount = 0;
+	if (!reader.Read(jointCount)) return false;
+	for (uint64_t i = 0; i < jointCount; i++) {
+		std::string jointName;
+		JointWeightData jointWeightData{};
+		if (!reader.ReadString(jointName) ||
+			!reader.Read(jointWeightData.inverseBindPoseMatrix) ||
+			!reader.ReadVector(jointWeightData.jointToVertexWeights)) {
+			return false;
+		}
+		modelData.skinClusterData.emplace(std::move(jointName), std::move(jointWeightData));
+	}
+
+	return reader.Read(modelData.localAABB) && reader.ReadVector(modelData.lodErrors);
+}
+
+bool ModelDataContainer::IsTexturesReady(const LoadedModel& loadedModel) const {
+	for (const auto& handle : loadedModel.textureHandles) {
+		if (!handle.IsReady()) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void ModelDataContainer::WaitTextures(const LoadedModel& loadedModel) {
+	// 描画クラスの作成時にSRVが必要なので、このモデルのテクスチャだけ待つ
+	for (const auto& mesh : loadedModel.modelData.meshes) {
+		if (!mesh.material.textureFilePath.empty()) {
+			textureDataContainer_->WaitLoad(mesh.material.textureFilePath);
+		}
+		if (!mesh.material.normalMapTextureFilePath.empty()) {
+			textureDataContainer_->WaitLoad(mesh.material.normalMapTextureFilePath);
+		}
+	}
+}
+
+void ModelDataContainer::FinalizeModel(const std::string& modelName, LoadedModel& loadedModel) {
+	// コンテナに挿入
+	modelDatas_.insert(std::make_pair(modelName, std::move(loadedModel.modelData)));
+}
+
 Node ModelDataContainer::ReadNode(aiNode* node) {
 	Node result{};
 
@@ -274,7 +513,138 @@ Node ModelDataContainer::ReadNode(aiNode* node) {
 	return result;
 }
 
+AABB ModelDataContainer::CalculateLocalAABB(const ModelData& modelData) {
+	AABB result{};
+	bool isFirst = true;
+	for (const auto& mesh : modelData.meshes) {
+		for (const auto& vertex : mesh.vertices) {
+			const Vector3 position = { vertex.position.x,vertex.position.y,vertex.position.z };
+			if (isFirst) {
+				result = { position,position };
+				isFirst = false;
+			} else {
+				result = MergeAABB(result, { position,position });
+			}
+		}
+	}
+	return result;
+}
+
+void ModelDataContainer::OptimizeMeshes(ModelData& modelData) {
+	for (uint32_t meshIndex = 0; meshIndex < static_cast<uint32_t>(modelData.meshes.size()); meshIndex++) {
+		MeshData& mesh = modelData.meshes[meshIndex];
+
+		// 頂点キャッシュとオーバードローを考慮した三角形の順番
+		MeshOptimizer::OptimizeFaces(mesh.indices, mesh.vertices);
+		// 参照順に頂点を詰める
+		const std::vector<uint32_t> vertexRemap = MeshOptimizer::OptimizeVertexFetch(mesh.indices, mesh.vertices);
+
+		// スキニングのウェイトが指す頂点番号を付け替える
+		for (auto& [jointName, jointWeightData] : modelData.skinClusterData) {
+			auto& weights = jointWeightData.jointToVertexWeights;
+			for (auto& weight : weights) {
+				if (weight.meshIndex == meshIndex) {
+					weight.localVertexIndex = static_cast<int32_t>(vertexRemap[weight.localVertexIndex]);
+				}
+			}
+			// 使われなくなった頂点へのウェイトは取り除く
+			std::erase_if(weights, [&](const JointToVertexWeightData& weight) {
+				return weight.meshIndex == meshIndex && weight.localVertexIndex == static_cast<int32_t>(UINT32_MAX);
+				});
+		}
+	}
+}
+
+void ModelDataContainer::GenerateLODs(ModelData& modelData) {
+	// LOD0は元メッシュ
+	modelData.lodErrors.assign(1, 0.0f);
+
+	// スキニングするモデルはウェイトが頂点に紐づくためLODを作らない
+	if (!modelData.skinClusterData.empty()) {
+		return;
+	}
+
+	// メッシュごとの頂点座標
+	std::vector<std::vector<Vector3>> meshPositions(modelData.meshes.size());
+	for (size_t i = 0; i < modelData.meshes.size(); i++) {
+		meshPositions[i].reserve(modelData.meshes[i].vertices.size());
+		for (const auto& vertex : modelData.meshes[i].vertices) {
+			meshPositions[i].push_back({ vertex.position.x,vertex.position.y,vertex.position.z });
+		}
+	}
+
+	float ratio = 1.0f;
+	for (uint32_t lod = 1; lod < ModelLODConst::MaxLODCount; lod++) {
+		ratio *= ModelLODConst::ReductionRatio;
+
+		std::vector<MeshLODData> newLODs(modelData.meshes.size());
+		size_t sourceIndexCount = 0;
+		size_t resultIndexCount = 0;
+		float lodError = modelData.lodErrors.back();
+
+		for (size_t i = 0; i < modelData.meshes.size(); i++) {
+			const MeshData& mesh = modelData.meshes[i];
+			// ひとつ前のLODから簡略化する
+			const std::vector<uint32_t>& sourceIndices = mesh.lods.empty() ? mesh.indices : mesh.lods.back().indices;
+			const float sourceError = mesh.lods.empty() ? 0.0f : mesh.lods.back().error;
+
+			const size_t targetIndexCount = static_cast<size_t>(static_cast<float>(mesh.indices.size()) * ratio) / 3 * 3;
+			const float error = MeshSimplifier::Simplify(meshPositions[i], sourceIndices, targetIndexCount, FLT_MAX, newLODs[i].indices);
+
+			// 減らしきれなかったメッシュは前のLODを使う
+			if (newLODs[i].indices.empty()) {
+				newLODs[i].indices = sourceIndices;
+			} else {
+				MeshOptimizer::OptimizeFaces(newLODs[i].indices, mesh.vertices);
+			}
+			newLODs[i].error = sourceError + error;
+
+			sourceIndexCount += sourceIndices.size();
+			resultIndexCount += newLODs[i].indices.size();
+			lodError = (std::max)(lodError, newLODs[i].error);
+		}
+
+		// ほとんど減らなかったらこれ以上LODを作らない
+		if (static_cast<float>(resultIndexCount) > static_cast<float>(sourceIndexCount) * ModelLODConst::MinReductionRatio) {
+			break;
+		}
+
+		for (size_t i = 0; i < modelData.meshes.size(); i++) {
+			modelData.meshes[i].lods.push_back(std::move(newLODs[i]));
+		}
+		modelData.lodErrors.push_back(lodError);
+	}
+}
+
+void ModelDataContainer::QuantizeMeshes(ModelData& modelData) {
+	for (auto& mesh : modelData.meshes) {
+		mesh.quantization = VertexQuantizer::CalculateQuantization(mesh.vertices);
+		mesh.quantizedVertices.resize(mesh.vertices.size());
+		for (size_t i = 0; i < mesh.vertices.size(); i++) {
+			mesh.quantizedVertices[i] = VertexQuantizer::Encode(mesh.vertices[i], mesh.quantization);
+		}
+	}
+
+	// フル精度の頂点はスキニング(SkinningMeshの計算シェーダー)だけが使う
+	// それ以外は描画も遮蔽も量子化した頂点で足りるので、メモリにもキャッシュにも残さない
+	if (modelData.skinClusterData.empty()) {
+		for (auto& mesh : modelData.meshes) {
+			std::vector<VertexData3D>().swap(mesh.vertices);
+		}
+	}
+}
+
 void ModelDataContainer::SetTextureDataContainer(TextureDataContainer* textureDataContainer) {
 	assert(textureDataContainer);
 	textureDataContainer_ = textureDataContainer;
 }
+
+void ModelDataContainer::SetAssetPack(AssetPack* assetPack) {
+	assert(assetPack);
+	assetPack_ = assetPack;
+}
+
+void ModelDataContainer::SetImportCache(ImportCache* importCache) {
+	assert(importCache);
+	importCache_ = importCache;
+}
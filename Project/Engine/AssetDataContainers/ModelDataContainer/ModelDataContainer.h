@@ -11,31 +11,84 @@
 
 // MyHedder
 #include "Structs/ModelStruct.h"
+#include "AssetLoadQueue/AssetLoadQueue.h"
 
 // 前方宣言
 class TextureDataContainer;
+class AssetPack;
+class ImportCache;
+class BinaryWriter;
+class BinaryReader;
 
 /// <summary>
 /// モデルデータコンテナ
 /// </summary>
 class ModelDataContainer {
 public:
-	ModelDataContainer(TextureDataContainer* textureDataContainer);
+	ModelDataContainer(TextureDataContainer* textureDataContainer, AssetPack* assetPack, ImportCache* importCache);
 	~ModelDataContainer();
 
-	void Initialize(TextureDataContainer* textureDataContainer);
+	void Initialize(TextureDataContainer* textureDataContainer, AssetPack* assetPack, ImportCache* importCache);
 	void Load(const std::string& modelName);
+	// 非同期で読み込む(確定はメインスレッドのUpdateLoads/WaitLoadsで行う)
+	AssetLoadHandle LoadAsync(const std::string& modelName);
+	// 読み込みが終わったモデルを確定
+	void UpdateLoads();
+	// すべての非同期読み込みを待って確定
+	void WaitLoads();
+	// 指定したモデルの非同期読み込みだけを待って確定
+	void WaitLoad(const std::string& modelName);
 
 	ModelData FindModelData(const std::string& modelName)const;
+	// モデル空間の境界ボックスを取得
+	AABB FindModelLocalAABB(const std::string& modelName)const;
+	// モデルの読み込みが終わっているか
+	bool IsModelLoaded(const std::string& modelName)const;
 private:
-	ModelData LoadModel(const std::string& modelName);
+	/// <summary>
+	/// ワーカースレッドで読み込んだモデル
+	/// </summary>
+	struct LoadedModel {
+		ModelData modelData;
+		// モデルが使うテクスチャの読み込みハンドル
+		std::vector<AssetLoadHandle> textureHandles;
+	};
+
+	// モデル読み込み(ワーカースレッドで実行)
+	ModelData LoadModel(const std::string& modelName, std::vector<AssetLoadHandle>& textureHandles);
+	// モデルが使うテクスチャの読み込みを開始
+	void RequestTextures(const ModelData& modelData, std::vector<AssetLoadHandle>& textureHandles);
+	// 前処理済みのモデルをキャッシュ用に書き出す
+	void SerializeModel(BinaryWriter& writer, const ModelData& modelData);
+	// キャッシュからモデルを復元
+	bool DeserializeModel(BinaryReader& reader, ModelData& modelData);
+	// モデルが使うテクスチャがすべて確定したか
+	bool IsTexturesReady(const LoadedModel& loadedModel)const;
+	// モデルが使うテクスチャの読み込みだけを待つ
+	void WaitTextures(const LoadedModel& loadedModel);
+	// 読み込んだモデルをコンテナに確定
+	void FinalizeModel(const std::string& modelName, LoadedModel& loadedModel);
 	// ノードの読み込み
 	Node ReadNode(aiNode* node);
+	// モデル空間の境界ボックスを計算
+	AABB CalculateLocalAABB(const ModelData& modelData);
+	// 三角形と頂点の並べ替え
+	void OptimizeMeshes(ModelData& modelData);
+	// 簡略化したLODを生成
+	void GenerateLODs(ModelData& modelData);
+	// 描画用に頂点を量子化(スキニングしないモデルはフル精度の頂点を捨てる)
+	void QuantizeMeshes(ModelData& modelData);
 private:
 	void SetTextureDataContainer(TextureDataContainer* textureDataContainer);
+	void SetAssetPack(AssetPack* assetPack);
+	void SetImportCache(ImportCache* importCache);
 private:
 	// モデルデータコンテナ
 	std::unordered_map<std::string, ModelData> modelDatas_;
+	// 非同期読み込みのキュー
+	AssetLoadQueue<LoadedModel> loadQueue_;
 private:
 	TextureDataContainer* textureDataContainer_ = nullptr;
+	AssetPack* assetPack_ = nullptr;
+	ImportCache* importCache_ = nullptr;
 };
\ No newline at end of file
@@ -1,20 +1,43 @@
 #include "PrimitiveShapeDataContainer.h"
 
+#include <cassert>
+
+#include "DirectX/StaticBufferUploader/StaticBufferUploader.h"
+
 using namespace MAGIMath;
 
-PrimitiveShapeDataContainer::PrimitiveShapeDataContainer() {
-	Initialize();
+PrimitiveShapeDataContainer::PrimitiveShapeDataContainer(StaticBufferUploader* staticBufferUploader) {
+	Initialize(staticBufferUploader);
 }
 
-PrimitiveShapeDataContainer::~PrimitiveShapeDataContainer() {}
+PrimitiveShapeDataContainer::~PrimitiveShapeDataContainer() {
+	// 転送したバッファを返す
+	for (const auto& [primitiveType, primitiveBuffer] : primitiveBuffers_) {
+		staticBufferUploader_->Free(primitiveBuffer.vertexBuffer);
+		staticBufferUploader_->Free(primitiveBuffer.indexBuffer);
+	}
+}
 
 PrimitiveData PrimitiveShapeDataContainer::GetPrimitiveShapeData(const Primitive3DType& primitiveType) {
 	return primitiveDatas_[primitiveType];
 }
 
-void PrimitiveShapeDataContainer::Initialize() {
+const PrimitiveShapeBuffer& PrimitiveShapeDataContainer::GetPrimitiveShapeBuffer(const Primitive3DType& primitiveType) const {
+	return primitiveBuffers_.at(primitiveType);
+}
+
+void PrimitiveShapeDataContainer::Initialize(StaticBufferUploader* staticBufferUploader) {
+	SetStaticBufferUploader(staticBufferUploader);
+
 	CreatePlane();
 	CreateSphere();
+
+	// 形状ごとに一度だけ転送する
+	for (const auto& [primitiveType, primitiveData] : primitiveDatas_) {
+		UploadShapeBuffer(primitiveType, primitiveData);
+	}
+	// 起動時に一度だけなのですぐ送る
+	staticBufferUploader_->Flush();
 }
 
 void PrimitiveShapeDataContainer::CreatePlane() {
@@ -93,3 +116,28 @@ void PrimitiveShapeDataContainer::CreateSphere() {
 	// コンテナに挿入
 	primitiveDatas_.insert(std::make_pair(Primitive3DType::Sphere, primitiveData));
 }
+
+void PrimitiveShapeDataContainer::UploadShapeBuffer(Primitive3DType primitiveType, const PrimitiveData& primitiveData) {
+	PrimitiveShapeBuffer primitiveBuffer{};
+
+	// 頂点
+	const uint64_t vertexSize = sizeof(VertexData3D) * primitiveData.vertices.size();
+	primitiveBuffer.vertexBuffer = staticBufferUploader_->Upload(primitiveData.vertices.data(), vertexSize, sizeof(float));
+	primitiveBuffer.vertexBufferView.BufferLocation = primitiveBuffer.vertexBuffer.gpuAddress;
+	primitiveBuffer.vertexBufferView.SizeInBytes = UINT(vertexSize);
+	primitiveBuffer.vertexBufferView.StrideInBytes = sizeof(VertexData3D);
+
+	// インデックス
+	const uint64_t indexSize = sizeof(uint32_t) * primitiveData.indices.size();
+	primitiveBuffer.indexBuffer = staticBufferUploader_->Upload(primitiveData.indices.data(), indexSize, sizeof(uint32_t));
+	primitiveBuffer.indexBufferView.BufferLocation = primitiveBuffer.indexBuffer.gpuAddress;
+	primitiveBuffer.indexBufferView.SizeInBytes = UINT(indexSize);
+	primitiveBuffer.indexBufferView.Format = DXGI_FORMAT_R32_UINT;
+
+	primitiveBuffers_.insert(std::make_pair(primitiveType, primitiveBuffer));
+}
+
+void PrimitiveShapeDataContainer::SetStaticBufferUploader(StaticBufferUploader* staticBufferUploader) {
+	assert(staticBufferUploader);
+	staticBufferUploader_ = staticBufferUploader;
+}
@@ -6,21 +6,39 @@
 // MyHedder
 #include "Enums/Primitive3DEnum.h"
 #include "Structs/ModelStruct.h"
+#include "Structs/BufferStruct.h"
+
+// 前方宣言
+class StaticBufferUploader;
 
 /// <summary>
 /// シンプル形状のデータコンテナクラス
+/// 頂点とインデックスは形状ごとに一度だけデフォルトヒープへ転送して共有する
 /// </summary>
 class PrimitiveShapeDataContainer {
 public:
-	PrimitiveShapeDataContainer();
+	PrimitiveShapeDataContainer(StaticBufferUploader* staticBufferUploader);
 	~PrimitiveShapeDataContainer();
 	PrimitiveData GetPrimitiveShapeData(const Primitive3DType& primitiveType);
+	// 形状の頂点とインデックスのバッファを取得
+	const PrimitiveShapeBuffer& GetPrimitiveShapeBuffer(const Primitive3DType& primitiveType)const;
 private:
-	void Initialize();
+	void Initialize(StaticBufferUploader* staticBufferUploader);
 
 	void CreatePlane();
 	void CreateSphere();
+
+	// 形状の頂点とインデックスをデフォルトヒープへ転送
+	void UploadShapeBuffer(Primitive3DType primitiveType, const PrimitiveData& primitiveData);
+
+	// StaticBufferUploaderのインスタンスをセット
+	void SetStaticBufferUploader(StaticBufferUploader* staticBufferUploader);
 private:
 	// シンプル形状のデータ
 	std::unordered_map<Primitive3DType, PrimitiveData> primitiveDatas_;
+	// シンプル形状のバッファ
+	std::unordered_map<Primitive3DType, PrimitiveShapeBuffer> primitiveBuffers_;
+private:
+	// StaticBufferUploader
+	StaticBufferUploader* staticBufferUploader_ = nullptr;
 };
\ No newline at end of file
@@ -0,0 +1,127 @@
+#include "ResidencyManager.h"
+
+// C++
+#include <cassert>
+#include <format>
+
+// MyHedder
+#include "Logger/Logger.h"
+
+ResidencyManager::ResidencyManager(uint64_t budgetBytes) {
+	SetBudget(budgetBytes);
+	Logger::Log("ResidencyManager Initialize\n");
+}
+
+ResidencyManager::~ResidencyManager() {
+	Logger::Log("ResidencyManager Finalize\n");
+}
+
+ResidencyManager::Handle ResidencyManager::Register(ResidentAssetType type, const std::string& name, uint64_t sizeInBytes, EvictFunction evict) {
+	assert(evict);
+
+	// 解除した場所があれば使い回す
+	Handle handle = kInvalidHandle;
+	if (!freeHandles_.empty()) {
+		handle = freeHandles_.back();
+		freeHandles_.pop_back();
+	} else {
+		handle = static_cast<Handle>(entries_.size());
+		entries_.emplace_back();
+	}
+
+	lru_.push_back(handle);
+	entries_[handle] = Entry{
+		.type = type,
+		.name = name,
+		.sizeInBytes = sizeInBytes,
+		.lastUsedFrame = frame_,
+		.isResident = true,
+		.evict = std::move(evict),
+		.lruIt = std::prev(lru_.end()),
+	};
+	residentBytes_ += sizeInBytes;
+	return handle;
+}
+
+void ResidencyManager::Unregister(Handle handle) {
+	if (handle == kInvalidHandle) {
+		return;
+	}
+	assert(handle < entries_.size());
+	Entry& entry = entries_[handle];
+	if (entry.isResident) {
+		residentBytes_ -= entry.sizeInBytes;
+	}
+	lru_.erase(entry.lruIt);
+	entry = Entry{};
+	freeHandles_.push_back(handle);
+}
+
+bool ResidencyManager::Touch(Handle handle) {
+	assert(handle < entries_.size());
+	Entry& entry = entries_[handle];
+	// 末尾(最新)へ移動
+	entry.lastUsedFrame = frame_;
+	lru_.splice(lru_.end(), lru_, entry.lruIt);
+	return entry.isResident;
+}
+
+void ResidencyManager::MarkResident(Handle handle, uint64_t sizeInBytes) {
+	assert(handle < entries_.size());
+	Entry& entry = entries_[handle];
+	if (entry.isResident) {
+		residentBytes_ -= entry.sizeInBytes;
+	}
+	entry.sizeInBytes = sizeInBytes;
+	entry.isResident = true;
+	residentBytes_ += sizeInBytes;
+}
+
+void ResidencyManager::Update() {
+	// 古い順に、前フレームで使っていないものを予算内に収まるまで追い出す
+	bool isWaited = false;
+	for (auto lruIt = lru_.begin(); lruIt != lru_.end() && residentBytes_ > budgetBytes_; ++lruIt) {
+		Entry& entry = entries_[*lruIt];
+		// ここから先は前フレームで使ったもの
+		if (entry.lastUsedFrame == frame_) {
+			break;
+		}
+		if (!entry.isResident) {
+			continue;
+		}
+		// 描画中のフレームが読んでいるかもしれないので、最初の追い出しの前に一度だけ待つ
+		if (!isWaited && waitGPU_) {
+			waitGPU_();
+			isWaited = true;
+		}
+		entry.isResident = false;
+		residentBytes_ -= entry.sizeInBytes;
+		entry.evict();
+#if defined(DEBUG) || defined(DEVELOP)
+		Logger::Log(std::format("ResidencyManager: evicted {} ({} bytes)\n", entry.name, entry.sizeInBytes));
+#endif // DEBUG
+	}
+
+	// 次のフレームへ
+	frame_++;
+}
+
+void ResidencyManager::SetWaitGPUFunction(WaitGPUFunction waitGPU) {
+	waitGPU_ = std::move(waitGPU);
+}
+
+void ResidencyManager::SetBudget(uint64_t budgetBytes) {
+	budgetBytes_ = budgetBytes;
+}
+
+uint64_t ResidencyManager::GetBudget() const {
+	return budgetBytes_;
+}
+
+uint64_t ResidencyManager::GetResidentBytes() const {
+	return residentBytes_;
+}
+
+uint64_t ResidencyManager::GetFrame() const {
+	return frame_;
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+// C++
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// 常駐管理するアセットの種類
+/// </summary>
+enum class ResidentAssetType {
+	Texture,
+};
+
+/// <summary>
+/// 常駐アセットのメモリ予算管理
+/// 最後に描画したフレームでLRUを作り、予算を超えたら古いものから追い出す
+/// 追い出し(解放や格下げ)は登録時に渡した関数で持ち主が行う
+/// 登録時に返すハンドルで引くので、描画ごとの記録で文字列を作らない
+/// </summary>
+class ResidencyManager {
+public:
+	// 登録したアセットのハンドル
+	using Handle = uint32_t;
+	// 未登録を表すハンドル
+	static constexpr Handle kInvalidHandle = 0xFFFFFFFF;
+	// 追い出し関数
+	using EvictFunction = std::function<void()>;
+	// GPUが使い終わるまで待つ関数
+	using WaitGPUFunction = std::function<void()>;
+
+	ResidencyManager(uint64_t budgetBytes);
+	~ResidencyManager();
+
+	// アセットを登録してハンドルを返す(このフレームで使ったものとして扱う)
+	Handle Register(ResidentAssetType type, const std::string& name, uint64_t sizeInBytes, EvictFunction evict);
+	// 登録を解除
+	void Unregister(Handle handle);
+	// このフレームで使ったことを記録(常駐していなければfalse)
+	bool Touch(Handle handle);
+	// 追い出したアセットが再び常駐した
+	void MarkResident(Handle handle, uint64_t sizeInBytes);
+
+	// フレームの始めに、予算を超えていれば前フレームで使わなかったものを古い順に追い出す
+	// 追い出したリソースはすぐ解放されるので、最初に追い出す前に待機関数でGPUを待つ
+	void Update();
+	// 追い出す前に呼ぶ待機関数を設定
+	void SetWaitGPUFunction(WaitGPUFunction waitGPU);
+
+	// 予算の設定
+	void SetBudget(uint64_t budgetBytes);
+	// 予算の取得
+	uint64_t GetBudget()const;
+	// 常駐しているアセットの合計サイズ
+	uint64_t GetResidentBytes()const;
+	// 現在のフレーム
+	uint64_t GetFrame()const;
+
+private:
+	/// <summary>
+	/// 常駐管理するアセット
+	/// </summary>
+	struct Entry {
+		ResidentAssetType type;
+		std::string name;
+		uint64_t sizeInBytes = 0;
+		// 最後に使ったフレーム
+		uint64_t lastUsedFrame = 0;
+		bool isResident = true;
+		EvictFunction evict;
+		// 使った順のリストでの位置
+		std::list<Handle>::iterator lruIt;
+	};
+
+private:
+	// 予算
+	uint64_t budgetBytes_ = 0;
+	// 常駐しているアセットの合計サイズ
+	uint64_t residentBytes_ = 0;
+	// 現在のフレーム
+	uint64_t frame_ = 0;
+	// 追い出す前に呼ぶ待機関数
+	WaitGPUFunction waitGPU_;
+
+	// 登録したアセット(ハンドルが添字、解除した場所は使い回す)
+	std::vector<Entry> entries_;
+	// 空いているハンドル
+	std::vector<Handle> freeHandles_;
+	// 使った順のリスト(先頭が最も古い)
+	std::list<Handle> lru_;
+};
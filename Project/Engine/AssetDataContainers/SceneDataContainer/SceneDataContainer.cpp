@@ -2,15 +2,71 @@
 
 // C++
 #include <fstream>
+#include <algorithm>
 #include <cassert>
+#include <cstring>
+
+// Windows
+#include <Windows.h>
 
 // Json
 #include <nlohmann/json.hpp>
 
 // MyHedder
+#include "Logger/Logger.h"
 #include "MAGIAssert/MAGIAssert.h"
+#include "AssetPack/AssetPack.h"
+
+// ツール(Tools/BlenderAddon)が書き出すレイアウトと一致させる
+static_assert(sizeof(SceneDataContainer::BinaryHeader) == 32);
+static_assert(sizeof(SceneDataContainer::BinaryStringRef) == 8);
+static_assert(sizeof(SceneDataContainer::BinaryCell) == 16);
+
+namespace {
+	/// <summary>
+	/// 読み込みの間だけファイルをメモリマップする
+	/// </summary>
+	class ScopedFileMapping {
+	public:
+		ScopedFileMapping(const std::string& filePath) {
+			const std::wstring filePathW = Logger::ConvertString(filePath);
+			file_ = CreateFileW(filePathW.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+			if (file_ == INVALID_HANDLE_VALUE) {
+				return;
+			}
+			LARGE_INTEGER fileSize{};
+			GetFileSizeEx(file_, &fileSize);
+			size_ = static_cast<size_t>(fileSize.QuadPart);
+			if (size_ == 0) {
+				return;
+			}
+			mapping_ = CreateFileMappingW(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if (mapping_) {
+				view_ = static_cast<const uint8_t*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+			}
+		}
+		~ScopedFileMapping() {
+			if (view_) UnmapViewOfFile(view_);
+			if (mapping_) CloseHandle(mapping_);
+			if (file_ != INVALID_HANDLE_VALUE) CloseHandle(file_);
+		}
+		ScopedFileMapping(const ScopedFileMapping&) = delete;
+		ScopedFileMapping& operator=(const ScopedFileMapping&) = delete;
+
+		std::span<const uint8_t> GetData()const {
+			return view_ ? std::span<const uint8_t>(view_, size_) : std::span<const uint8_t>{};
+		}
 
-SceneDataContainer::SceneDataContainer() {
+	private:
+		HANDLE file_ = INVALID_HANDLE_VALUE;
+		HANDLE mapping_ = nullptr;
+		const uint8_t* view_ = nullptr;
+		size_t size_ = 0;
+	};
+}
+
+SceneDataContainer::SceneDataContainer(AssetPack* assetPack) {
+	SetAssetPack(assetPack);
 	sceneDatas_.clear();
 	Logger::Log("SceneDataContainer Initialize\n");
 }
@@ -20,6 +76,14 @@ SceneDataContainer::~SceneDataContainer() {
 	Logger::Log("SceneDataContainer Finalize\n");
 }
 
+void SceneDataContainer::Load(const std::string& fileName) {
+	if (assetPack_->Exists(kDirectoryPath_ + fileName + ".scene")) {
+		LoadFromBinary(fileName);
+	} else {
+		LoadFromJson(fileName);
+	}
+}
+
 void SceneDataContainer::LoadFromJson(const std::string& fileName) {
 	// 今回ぶち込むシーンデータ
 	SceneData newSceneData;
@@ -53,6 +117,13 @@ void SceneDataContainer::LoadFromJson(const std::string& fileName) {
 	// 正しいレベルデータファイルかチェック
 	assert(name.compare("scene") == 0);
 
+	// ワールド分割のセルの大きさ
+	if (deserialized.contains("cell_size")) {
+		newSceneData.cellSize = deserialized["cell_size"].get<float>();
+	}
+	// オブジェクトごとのセル
+	std::vector<std::pair<int32_t, int32_t>> objectCells;
+
 	// "objects"の全オブジェクトを走査
 	for (nlohmann::json& object : deserialized["objects"]) {
 		assert(object.contains("type"));
@@ -84,17 +155,154 @@ void SceneDataContainer::LoadFromJson(const std::string& fileName) {
 			newObject.translate.y = static_cast<float>(transform["translate"][1]);
 			newObject.translate.z = static_cast<float>(transform["translate"][2]);
 
+			// オクルージョンカリングの遮蔽物指定
+			if (object.contains("occluder")) {
+				newObject.isOccluder = object["occluder"].get<bool>();
+			}
+
+			// ワールド分割のセル
+			if (object.contains("cell")) {
+				objectCells.emplace_back(object["cell"][0].get<int32_t>(), object["cell"][1].get<int32_t>());
+			} else {
+				objectCells.emplace_back(0, 0);
+			}
+
 			newSceneData.objects.push_back(newObject);
 		}
 
 	}
 
+	// セル順に並べる
+	if (newSceneData.cellSize > 0.0f) {
+		BuildCells(newSceneData, objectCells);
+	}
+
 	// コンテナに登録
 	sceneDatas_.insert_or_assign(newSceneData.name, newSceneData);
 }
 
+void SceneDataContainer::LoadFromBinary(const std::string& fileName) {
+	// フルパス作成
+	const std::string fullPath = kDirectoryPath_ + fileName + ".scene";
+
+	// パックにあればマップ済みの領域を、無ければファイルをマップして読む
+	const std::span<const uint8_t> packedData = assetPack_->Find(fullPath);
+	if (packedData.data()) {
+		ParseBinary(fileName, packedData);
+		return;
+	}
+
+	ScopedFileMapping fileMapping(fullPath);
+	MAGIAssert::Assert(fileMapping.GetData().data() != nullptr, "Binary SceneData not found! FileName: " + fileName);
+	ParseBinary(fileName, fileMapping.GetData());
+}
+
 const SceneData& SceneDataContainer::GetData(const std::string& dataName) {
 	auto it = sceneDatas_.find(dataName);
 	MAGIAssert::Assert(it != sceneDatas_.end(), "SceneData not found! DataName: " + dataName);
 	return it->second;
 }
+
+void SceneDataContainer::ParseBinary(const std::string& fileName, std::span<const uint8_t> data) {
+	// ヘッダーの確認
+	MAGIAssert::Assert(data.size() >= sizeof(BinaryHeader), "Invalid binary SceneData! FileName: " + fileName);
+	BinaryHeader header{};
+	std::memcpy(&header, data.data(), sizeof(BinaryHeader));
+	MAGIAssert::Assert(std::memcmp(header.magic, kBinaryMagic, sizeof(kBinaryMagic)) == 0, "Invalid binary SceneData! FileName: " + fileName);
+	MAGIAssert::Assert(header.version == kBinaryVersion, "Unsupported binary SceneData version! FileName: " + fileName);
+
+	// 各配列の位置
+	const size_t objectCount = header.objectCount;
+	const size_t translateOffset = sizeof(BinaryHeader);
+	const size_t rotateOffset = translateOffset + sizeof(float) * 3 * objectCount;
+	const size_t scaleOffset = rotateOffset + sizeof(float) * 4 * objectCount;
+	const size_t modelIndexOffset = scaleOffset + sizeof(float) * 3 * objectCount;
+	const size_t flagOffset = modelIndexOffset + sizeof(uint32_t) * objectCount;
+	const size_t objectNameOffset = flagOffset + sizeof(uint32_t) * objectCount;
+	const size_t modelNameOffset = objectNameOffset + sizeof(BinaryStringRef) * objectCount;
+	const size_t cellOffset = modelNameOffset + sizeof(BinaryStringRef) * header.modelNameCount;
+	const size_t stringTableOffset = cellOffset + sizeof(BinaryCell) * header.cellCount;
+	MAGIAssert::Assert(data.size() >= stringTableOffset + header.stringTableSize, "Truncated binary SceneData! FileName: " + fileName);
+
+	// 中身の範囲チェック用(壊れたファイルは範囲外を読む前に弾く)
+	const std::string invalidMessage = "Invalid binary SceneData! FileName: " + fileName;
+
+	const uint8_t* base = data.data();
+	const char* stringTable = reinterpret_cast<const char*>(base + stringTableOffset);
+	auto readString = [&](size_t offset) {
+		BinaryStringRef ref{};
+		std::memcpy(&ref, base + offset, sizeof(BinaryStringRef));
+		MAGIAssert::Assert(static_cast<uint64_t>(ref.offset) + ref.length <= header.stringTableSize, invalidMessage);
+		return std::string(stringTable + ref.offset, ref.length);
+		};
+
+	// モデル名は番号で共有されているので先に作る
+	std::vector<std::string> modelNames(header.modelNameCount);
+	for (uint32_t i = 0; i < header.modelNameCount; i++) {
+		modelNames[i] = readString(modelNameOffset + sizeof(BinaryStringRef) * i);
+	}
+
+	// 今回ぶち込むシーンデータ
+	SceneData newSceneData;
+	newSceneData.name = fileName;
+	newSceneData.objects.resize(objectCount);
+
+	for (size_t i = 0; i < objectCount; i++) {
+		SceneObjectData& newObject = newSceneData.objects[i];
+		std::memcpy(&newObject.translate, base + translateOffset + sizeof(float) * 3 * i, sizeof(float) * 3);
+		std::memcpy(&newObject.rotate, base + rotateOffset + sizeof(float) * 4 * i, sizeof(float) * 4);
+		std::memcpy(&newObject.scale, base + scaleOffset + sizeof(float) * 3 * i, sizeof(float) * 3);
+
+		uint32_t modelIndex = 0;
+		uint32_t flags = 0;
+		std::memcpy(&modelIndex, base + modelIndexOffset + sizeof(uint32_t) * i, sizeof(uint32_t));
+		std::memcpy(&flags, base + flagOffset + sizeof(uint32_t) * i, sizeof(uint32_t));
+		MAGIAssert::Assert(modelIndex < modelNames.size(), invalidMessage);
+
+		newObject.objectName = readString(objectNameOffset + sizeof(BinaryStringRef) * i);
+		newObject.modelName = modelNames[modelIndex];
+		newObject.isOccluder = (flags & kBinaryFlagOccluder) != 0;
+	}
+
+	// ワールド分割のセル(ツールがセル順に並べて書き出している)
+	newSceneData.cellSize = header.cellSize;
+	newSceneData.cells.resize(header.cellCount);
+	for (uint32_t i = 0; i < header.cellCount; i++) {
+		BinaryCell cell{};
+		std::memcpy(&cell, base + cellOffset + sizeof(BinaryCell) * i, sizeof(BinaryCell));
+		MAGIAssert::Assert(static_cast<uint64_t>(cell.firstObject) + cell.objectCount <= objectCount, invalidMessage);
+		newSceneData.cells[i] = SceneCellData{ .x = cell.x, .z = cell.z, .firstObject = cell.firstObject, .objectCount = cell.objectCount };
+	}
+
+	// コンテナに登録
+	sceneDatas_.insert_or_assign(newSceneData.name, std::move(newSceneData));
+}
+
+void SceneDataContainer::BuildCells(SceneData& sceneData, const std::vector<std::pair<int32_t, int32_t>>& objectCells) {
+	// セル順の並び(同じセル内は元の順)
+	std::vector<uint32_t> order(sceneData.objects.size());
+	for (uint32_t i = 0; i < order.size(); i++) {
+		order[i] = i;
+	}
+	std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+		return objectCells[a] < objectCells[b];
+		});
+
+	std::vector<SceneObjectData> sortedObjects;
+	sortedObjects.reserve(order.size());
+	sceneData.cells.clear();
+	for (uint32_t index : order) {
+		const auto& [x, z] = objectCells[index];
+		if (sceneData.cells.empty() || sceneData.cells.back().x != x || sceneData.cells.back().z != z) {
+			sceneData.cells.push_back(SceneCellData{ .x = x, .z = z, .firstObject = static_cast<uint32_t>(sortedObjects.size()) });
+		}
+		sceneData.cells.back().objectCount++;
+		sortedObjects.push_back(std::move(sceneData.objects[index]));
+	}
+	sceneData.objects = std::move(sortedObjects);
+}
+
+void SceneDataContainer::SetAssetPack(AssetPack* assetPack) {
+	assert(assetPack);
+	assetPack_ = assetPack;
+}
@@ -1,6 +1,8 @@
 #pragma once
 
 // C++
+#include <cstdint>
+#include <span>
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -9,17 +11,33 @@
 #include "Math/Types/Vector3.h"
 #include "Math/Types/Quaternion.h"
 
+// 前方宣言
+class AssetPack;
+
 struct SceneObjectData {
 	std::string objectName;
 	std::string modelName;
 	Vector3 scale;
 	Quaternion rotate;
 	Vector3 translate;
+	bool isOccluder = false;
+};
+
+// ワールド分割のセル(objectsのfirstObjectからobjectCount個がこのセルに属する)
+struct SceneCellData {
+	int32_t x = 0;
+	int32_t z = 0;
+	uint32_t firstObject = 0;
+	uint32_t objectCount = 0;
 };
 
 struct SceneData {
 	std::string name;
 	std::vector<SceneObjectData> objects;
+	// セルの一辺の長さ(0ならワールド分割なし)
+	float cellSize = 0.0f;
+	// ワールド分割のセル(オブジェクトはセル順に並んでいる)
+	std::vector<SceneCellData> cells;
 };
 
 /// <summary>
@@ -27,18 +45,67 @@ struct SceneData {
 /// </summary>
 class SceneDataContainer {
 public:
-	SceneDataContainer();
+	SceneDataContainer(AssetPack* assetPack);
 	~SceneDataContainer();
 
-	// シーンデータをロード
+	// シーンデータをロード(バイナリがあればそちらを使う)
+	void Load(const std::string& fileName);
+	// シーンデータをJsonからロード
 	void LoadFromJson(const std::string& fileName);
+	// シーンデータをバイナリからロード(メモリマップで読む)
+	void LoadFromBinary(const std::string& fileName);
 
 	// シーンデータを取得
 	const SceneData& GetData(const std::string& dataName);
 
+public:
+	// バイナリシーンのヘッダー
+	// 後ろに translate(float3)、rotate(float4)、scale(float3)、モデル名の番号(uint32)、フラグ(uint32) の配列が
+	// オブジェクト数ずつ並び、その後にオブジェクト名とモデル名の文字列参照、セル、文字列テーブルが続く
+	struct BinaryHeader {
+		char magic[8];
+		uint32_t version;
+		uint32_t objectCount;
+		uint32_t modelNameCount;
+		// 文字列テーブルのバイト数
+		uint32_t stringTableSize;
+		uint32_t cellCount;
+		float cellSize;
+	};
+
+	// ワールド分割のセル
+	struct BinaryCell {
+		int32_t x;
+		int32_t z;
+		uint32_t firstObject;
+		uint32_t objectCount;
+	};
+
+	// 文字列テーブル内の文字列(終端文字なし)
+	struct BinaryStringRef {
+		uint32_t offset;
+		uint32_t length;
+	};
+
+	// バイナリシーンの識別子
+	static constexpr char kBinaryMagic[8] = { 'M','A','G','I','S','C','N','E' };
+	// バイナリシーンのバージョン
+	static constexpr uint32_t kBinaryVersion = 2;
+	// オブジェクトのフラグ: 遮蔽物
+	static constexpr uint32_t kBinaryFlagOccluder = 1u << 0;
+private:
+	// バイナリシーンを解釈する
+	void ParseBinary(const std::string& fileName, std::span<const uint8_t> data);
+	// オブジェクトをセル順に並べてセルを作る
+	static void BuildCells(SceneData& sceneData, const std::vector<std::pair<int32_t, int32_t>>& objectCells);
+	// AssetPack
+	void SetAssetPack(AssetPack* assetPack);
 private:
 	// シーンデータコンテナ
 	std::unordered_map<std::string, SceneData> sceneDatas_;
 
 	const std::string kDirectoryPath_ = "Assets/SceneData/";
+
+	// AssetPack
+	AssetPack* assetPack_ = nullptr;
 };
\ No newline at end of file
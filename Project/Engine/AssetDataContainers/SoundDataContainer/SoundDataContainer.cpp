@@ -3,16 +3,20 @@
 // C++
 #include <cassert>
 #include <unordered_map>
+#include <vector>
+#include <span>
+#include <cstring>
 
 #include "Logger/Logger.h"
+#include "AssetPack/AssetPack.h"
 
 // 通常再生中のVoiceを管理するコンテナ
 std::unordered_map<std::string, std::vector<IXAudio2SourceVoice*>> playingVoices_;
 // ループ再生中のVoiceを管理するコンテナ
 std::unordered_map<std::string, IXAudio2SourceVoice*> loopingVoices_;
 
-SoundDataContainer::SoundDataContainer() {
-	Initialize();
+SoundDataContainer::SoundDataContainer(AssetPack* assetPack) {
+	Initialize(assetPack);
 	Logger::Log("SoundDataContainer Initialize\n");
 }
 
@@ -21,7 +25,8 @@ SoundDataContainer::~SoundDataContainer() {
 	Logger::Log("SoundDataContainer Finalize\n");
 }
 
-void SoundDataContainer::Initialize() {
+void SoundDataContainer::Initialize(AssetPack* assetPack) {
+	SetAssetPack(assetPack);
 	HRESULT result;
 	// XAudioエンジンのインスタンスを生成
 	result = XAudio2Create(&xAudio2, 0, XAUDIO2_DEFAULT_PROCESSOR);
@@ -60,16 +65,24 @@ void SoundDataContainer::LoadWave(const std::string& filename) {
 	const std::string directoryPath = "Assets/Sounds";
 	// 連結してフルパス作成
 	const std::string fullpath = directoryPath + "/" + filename;
-	// ファイル入力ストリームのインスタンス
-	std::ifstream file;
-	// .wavファイルをバイナリモードで開く
-	file.open(fullpath, std::ios_base::binary);
+
+	// パックにあればマップしたメモリを、無ければファイルを丸ごと読んだものを使う
+	std::vector<uint8_t> looseFileData;
+	const std::span<const uint8_t> fileData = assetPack_->ReadFile(fullpath, looseFileData);
 	// ファイルオープン失敗を検出する
-	assert(file.is_open());
+	assert(fileData.data());
+
+	// 読み込み位置
+	size_t cursor = 0;
+	auto read = [&](void* dst, size_t size) {
+		assert(cursor + size <= fileData.size());
+		std::memcpy(dst, fileData.data() + cursor, size);
+		cursor += size;
+	};
 
 	// RIFFヘッダーの読み込み
 	RiffHeader riff;
-	file.read((char*)&riff, sizeof(riff));
+	read(&riff, sizeof(riff));
 	// ファイルがRIFFかチェック
 	if (strncmp(riff.chunk.id, "RIFF", 4) != 0) {
 		assert(0);
@@ -82,31 +95,28 @@ void SoundDataContainer::LoadWave(const std::string& filename) {
 	// Formatチャンクの読み込み
 	FormatChunk format = {};
 	// チャンクヘッダーの確認
-	file.read((char*)&format, sizeof(ChunkHeader));
+	read(&format, sizeof(ChunkHeader));
 	if (strncmp(format.chunk.id, "fmt ", 4) != 0) {
 		assert(0);
 	}
 	// チャンク本体の読み込み
 	assert(format.chunk.size <= sizeof(format.fmt));
-	file.read((char*)&format.fmt, format.chunk.size);
+	read(&format.fmt, format.chunk.size);
 
 	// Dataチャンクを探すループ
 	ChunkHeader data;
 	while (true) {
-		file.read((char*)&data, sizeof(data));
+		read(&data, sizeof(data));
 		if (strncmp(data.id, "data", 4) == 0) {
 			break; // dataチャンク見つかった
 		}
 		// 見つからなければ、そのチャンク分スキップ
-		file.seekg(data.size, std::ios_base::cur);
+		cursor += data.size;
 	}
 
 	// Dataチャンクのデータ部(波形データの読み込み)
 	char* pBuffer = new char[data.size];
-	file.read(pBuffer, data.size);
-
-	// WAVEファイルを閉じる
-	file.close();
+	read(pBuffer, data.size);
 
 	// 音声データ
 	std::unique_ptr<SoundData> soundData = std::make_unique<SoundData>();
@@ -238,4 +248,9 @@ SoundData* SoundDataContainer::FindWave(const std::string& filename) {
 	}
 	// ファイル名一致なし
 	return nullptr;
-}
\ No newline at end of file
+}
+
+void SoundDataContainer::SetAssetPack(AssetPack* assetPack) {
+	assert(assetPack);
+	assetPack_ = assetPack;
+}
@@ -8,9 +8,12 @@
 // MyHedder
 #include "Structs/SoundStruct.h"
 
+// 前方宣言
+class AssetPack;
+
 class SoundDataContainer {
 public:
-	SoundDataContainer();
+	SoundDataContainer(AssetPack* assetPack);
 	~SoundDataContainer();
 	// コンテナをクリア
 	void ClearContainer();
@@ -35,13 +38,17 @@ public:
 	SoundData* FindWave(const std::string& filename);
 private:
 	// 初期化
-	void Initialize();
+	void Initialize(AssetPack* assetPack);
 	// 終了
 	void Finalize();
+	void SetAssetPack(AssetPack* assetPack);
 private:
 	Microsoft::WRL::ComPtr<IXAudio2> xAudio2;
 	IXAudio2MasteringVoice* masterVoice;
 
 	// サウンドデータコンテナ
 	std::map<std::string, std::unique_ptr<SoundData>> sounds_;
+
+	// AssetPack
+	AssetPack* assetPack_ = nullptr;
 };
@@ -8,25 +8,42 @@
 #include "DirectX/DirectXCommand/DirectXCommand.h"
 #include "DirectX/Fence/Fence.h"
 #include "ViewManagers/SRVUAVManager/SRVUAVManager.h"
+#include "AssetPack/AssetPack.h"
+#include "ImportCache/ImportCache.h"
+#include "ResidencyManager/ResidencyManager.h"
+#include "Const/ImportCacheConst.h"
 
-TextureDataContainer::TextureDataContainer(DXGI* dxgi, DirectXCommand* directXCommand, Fence* fence, SRVUAVManager* srvUavManager) {
-	Initialize(dxgi, directXCommand, fence, srvUavManager);
+TextureDataContainer::TextureDataContainer(DXGI* dxgi, DirectXCommand* directXCommand, Fence* fence, SRVUAVManager* srvUavManager, AssetPack* assetPack, ImportCache* importCache, ResidencyManager* residencyManager) {
+	Initialize(dxgi, directXCommand, fence, srvUavManager, assetPack, importCache, residencyManager);
 	Logger::Log("TextureDataContainer Initialize\n");
 }
 
 TextureDataContainer::~TextureDataContainer() {
+	// 追い出し関数が残らないように登録を解除
+	for (const auto& [fileName, texture] : textureDatas_) {
+		residencyManager_->Unregister(texture.residencyHandle);
+	}
 	Logger::Log("TextureDataContainer Finalize\n");
 }
 
-void TextureDataContainer::Initialize(DXGI* dxgi, DirectXCommand* directXCommand, Fence* fence, SRVUAVManager* srvUavManager) {
+void TextureDataContainer::Initialize(DXGI* dxgi, DirectXCommand* directXCommand, Fence* fence, SRVUAVManager* srvUavManager, AssetPack* assetPack, ImportCache* importCache, ResidencyManager* residencyManager) {
 	// 必要なインスタンスのポインタ
 	SetDXGI(dxgi);
 	SetDirectXCommand(directXCommand);
 	SetFence(fence);
 	SetSrvUavManager(srvUavManager);
+	SetAssetPack(assetPack);
+	SetImportCache(importCache);
+	SetResidencyManager(residencyManager);
+
+	// アップロード用リングバッファを作成
+	uploadRingResource_ = dxgi_->CreateBufferResource(kUploadRingSize);
+	uploadBatcher_ = std::make_unique<UploadBatcher>(kUploadRingSize, [this]() {
+		SubmitUploads();
+		});
 
 	// デフォルトのテクスチャをロード
-	defaultTextureIndex_ = Load("EngineAssets/Images/uvChecker.png");
+	defaultTextureIndex_ = Load(defaultTextureName_);
 
 }
 
@@ -38,42 +55,11 @@ uint32_t TextureDataContainer::Load(const std::string& fileName, bool isFullPath
 		return it->second.srvIndex;
 	}
 
-	// 今回ぶち込むテクスチャーの箱
-	Texture& texture = textureDatas_[fileName];
-	DirectX::ScratchImage mipImage;
-
-	if (isFullPath) {
-		mipImage = LoadTexture(fileName);
-	} else {
-		// フルパス作成
-		const std::string textureDirectoryFilePath = "Assets/Images/";
-		mipImage = LoadTexture(textureDirectoryFilePath + fileName);
-	}
-
-	texture.metaData = mipImage.GetMetadata();
-	texture.resource = CreateTextureResource(texture.metaData);
-	ComPtr<ID3D12Resource> intermediateResource = UploadTextureData(texture.resource.Get(), mipImage);
-
-	// コマンドのクローズと実行
-	directXCommand_->KickCommand();
-	fence_->WaitGPU();
-	directXCommand_->ResetCommand();
-
-	// SRVを作成するDescriptorHeapの場所を決める
-	texture.srvIndex = srvUavManager_->Allocate();
+	// 読み込みを開始して確定まで待つ
+	LoadAsync(fileName, isFullPath);
+	WaitLoad(fileName);
 
-	if (texture.metaData.IsCubemap()) {
-		// CubeMap用のsrvの作成
-		srvUavManager_->CreateSrvTextureCubeMap(texture.srvIndex, textureDatas_[fileName].resource.Get(), texture.metaData.format);
-	} else {
-		// 通常テクスチャのsrvの作成
-		srvUavManager_->CreateSrvTexture2d(texture.srvIndex, textureDatas_[fileName].resource.Get(), texture.metaData.format, UINT(texture.metaData.mipLevels));
-	}
-
-	// テクスチャ枚数上限チェック
-	assert(srvUavManager_->IsLowerViewMax());
-
-	return texture.srvIndex;
+	return textureDatas_.at(fileName).srvIndex;
 }
 
 void TextureDataContainer::LoadNormalMap(const std::string& filePath) {
@@ -84,28 +70,81 @@ void TextureDataContainer::LoadNormalMap(const std::string& filePath) {
 		return;
 	}
 
-	// 今回ぶち込むテクスチャーの箱
-	Texture& texture = textureDatas_[filePath];
-	DirectX::ScratchImage mipImage;
+	// 読み込みを開始して確定まで待つ
+	LoadNormalMapAsync(filePath);
+	WaitLoad(filePath);
+}
 
-	mipImage = LoadNormalMapTexture(filePath);
+AssetLoadHandle TextureDataContainer::LoadAsync(const std::string& fileName, bool isFullPath) {
+	// フルパス作成
+	const std::string textureDirectoryFilePath = "Assets/Images/";
+	const std::string filePath = isFullPath ? fileName : textureDirectoryFilePath + fileName;
 
-	texture.metaData = mipImage.GetMetadata();
-	texture.resource = CreateTextureResource(texture.metaData);
-	ComPtr<ID3D12Resource> intermediateResource = UploadTextureData(texture.resource.Get(), mipImage);
+	return RequestLoad(fileName, filePath, false);
+}
 
-	// コマンドのクローズと実行
-	directXCommand_->KickCommand();
-	fence_->WaitGPU();
-	directXCommand_->ResetCommand();
+AssetLoadHandle TextureDataContainer::LoadNormalMapAsync(const std::string& filePath) {
+	return RequestLoad(filePath, filePath, true);
+}
 
-	// SRVを作成するDescriptorHeapの場所を決める
-	texture.srvIndex = srvUavManager_->Allocate();
-	// srvの作成
-	srvUavManager_->CreateSrvTexture2d(texture.srvIndex, textureDatas_[filePath].resource.Get(), texture.metaData.format, UINT(texture.metaData.mipLevels));
+void TextureDataContainer::UpdateLoads() {
+	loadQueue_.Update([this](const std::string& fileName, DirectX::ScratchImage& mipImage) {
+		FinalizeTexture(fileName, mipImage);
+		return true;
+		});
+	// このフレームで確定した分をまとめて転送
+	uploadBatcher_->Flush();
+}
 
-	// テクスチャ枚数上限チェック
-	assert(srvUavManager_->IsLowerViewMax());
+void TextureDataContainer::WaitLoads() {
+	loadQueue_.Wait([this](const std::string& fileName, DirectX::ScratchImage& mipImage) {
+		FinalizeTexture(fileName, mipImage);
+		return true;
+		});
+	// 確定した分をまとめて転送
+	uploadBatcher_->Flush();
+}
+
+void TextureDataContainer::WaitLoad(const std::string& fileName) {
+	// ほかの読み込みは待たない
+	loadQueue_.Wait(fileName, [this](const std::string& key, DirectX::ScratchImage& mipImage) {
+		FinalizeTexture(key, mipImage);
+		return true;
+		});
+	uploadBatcher_->Flush();
+}
+
+void TextureDataContainer::Touch(const std::string& fileName) {
+	// デフォルトテクスチャは追い出したテクスチャの代わりなので常駐させたまま
+	if (fileName == defaultTextureName_) {
+		return;
+	}
+	auto it = textureDatas_.find(fileName);
+	if (it == textureDatas_.end()) {
+		return;
+	}
+
+	// 初めて描画に使われたときに管理対象にする
+	Texture& texture = it->second;
+	if (texture.residencyHandle == ResidencyManager::kInvalidHandle) {
+		texture.residencyHandle = residencyManager_->Register(ResidentAssetType::Texture, fileName, GetTextureBytes(texture), [this, fileName]() {
+			EvictTexture(fileName);
+			});
+		return;
+	}
+	if (residencyManager_->Touch(texture.residencyHandle) || reloadingTextures_.contains(fileName)) {
+		return;
+	}
+
+	// 追い出されていたので読み直す(確定するまではデフォルトテクスチャで描かれる)
+	TextureSource source;
+	{
+		std::lock_guard<std::mutex> lock(textureSourceMutex_);
+		source = textureSources_.at(fileName);
+	}
+	reloadingTextures_.insert(fileName);
+	loadQueue_.Forget(fileName);
+	RequestLoad(fileName, source.filePath, source.isNormalMap);
 }
 
 std::unordered_map<std::string, Texture>& TextureDataContainer::GetTexture() {
@@ -126,22 +165,47 @@ uint32_t TextureDataContainer::GetDefaultTextureIndex() const {
 	return defaultTextureIndex_;
 }
 
+AssetLoadHandle TextureDataContainer::RequestLoad(const std::string& fileName, const std::string& filePath, bool isNormalMap) {
+	{
+		std::lock_guard<std::mutex> lock(textureSourceMutex_);
+		textureSources_.try_emplace(fileName, TextureSource{ .filePath = filePath, .isNormalMap = isNormalMap });
+	}
+
+	// デコードとミップマップ生成はワーカースレッドで行う
+	return loadQueue_.Request(fileName, [this, filePath, isNormalMap]() {
+		return isNormalMap ? LoadNormalMapTexture(filePath) : LoadTexture(filePath);
+		});
+}
+
 DirectX::ScratchImage TextureDataContainer::LoadTexture(const std::string& filePath) {
-	// テクスチャファイルを読んでプログラムで扱えるようにする
-	DirectX::ScratchImage image{};
-	std::wstring filePathW = Logger::ConvertString(filePath);
+	// パックにあればマップしたメモリを、無ければファイルを丸ごと読んだものを使う
+	std::vector<uint8_t> looseData;
+	const std::span<const uint8_t> sourceData = assetPack_->ReadFile(filePath, looseData);
+	assert(sourceData.data() && "Texture file not found");
 
 	HRESULT hr{};
 
-	if (filePathW.ends_with(L".dds")) {
-		hr = DirectX::LoadFromDDSFile(filePathW.c_str(), DirectX::DDS_FLAGS_NONE, nullptr, image);
-	} else {
-		hr = DirectX::LoadFromWICFile(filePathW.c_str(), DirectX::WIC_FLAGS_FORCE_SRGB, nullptr, image);
+	// DDSはそのまま使える形式なのでキャッシュしない
+	if (filePath.ends_with(".dds")) {
+		DirectX::ScratchImage image{};
+		hr = DirectX::LoadFromDDSMemory(sourceData.data(), sourceData.size(), DirectX::DDS_FLAGS_NONE, nullptr, image);
+		assert(SUCCEEDED(hr));
+		return image;
 	}
+
+	// デコードとミップマップ生成済みのものがあればそれを使う
+	const std::string cacheKey = ImportCache::MakeKey(sourceData, "Texture", ImportCacheConst::TextureVersion, DirectX::WIC_FLAGS_FORCE_SRGB);
+	DirectX::ScratchImage mipImages{};
+	if (LoadCachedTexture(cacheKey, mipImages)) {
+		return mipImages;
+	}
+
+	// テクスチャファイルを読んでプログラムで扱えるようにする
+	DirectX::ScratchImage image{};
+	hr = DirectX::LoadFromWICMemory(sourceData.data(), sourceData.size(), DirectX::WIC_FLAGS_FORCE_SRGB, nullptr, image);
 	assert(SUCCEEDED(hr));
 
 	// ミップマップの作成
-	DirectX::ScratchImage mipImages{};
 	if (DirectX::IsCompressed(image.GetMetadata().format)) {
 		mipImages = std::move(image);
 	} else {
@@ -149,16 +213,31 @@ DirectX::ScratchImage TextureDataContainer::LoadTexture(const std::string& fileP
 	}
 	assert(SUCCEEDED(hr));
 
+	// キャッシュに保存
+	StoreCachedTexture(cacheKey, mipImages);
+
 	//ミップマップ付きのデータを返す
 	return mipImages;
 }
 
 DirectX::ScratchImage TextureDataContainer::LoadNormalMapTexture(const std::string& filePath) {
+	// パックにあればマップしたメモリを、無ければファイルを丸ごと読んだものを使う
+	std::vector<uint8_t> looseData;
+	const std::span<const uint8_t> sourceData = assetPack_->ReadFile(filePath, looseData);
+	assert(sourceData.data() && "Normal map file not found");
+
+	// デコードとミップマップ生成済みのものがあればそれを使う
+	const std::string cacheKey = ImportCache::MakeKey(sourceData, "NormalMap", ImportCacheConst::TextureVersion, DirectX::WIC_FLAGS_IGNORE_SRGB);
+	DirectX::ScratchImage mipImages{};
+	if (LoadCachedTexture(cacheKey, mipImages)) {
+		return mipImages;
+	}
+
 	// テクスチャファイルをWICで読む
 	DirectX::ScratchImage image{};
-	std::wstring filePathW = Logger::ConvertString(filePath);
-	HRESULT hr = DirectX::LoadFromWICFile(
-		filePathW.c_str(),
+	HRESULT hr = DirectX::LoadFromWICMemory(
+		sourceData.data(),
+		sourceData.size(),
 		DirectX::WIC_FLAGS_IGNORE_SRGB, // ガンマ補正しない
 		nullptr,
 		image
@@ -166,7 +245,6 @@ DirectX::ScratchImage TextureDataContainer::LoadNormalMapTexture(const std::stri
 	assert(SUCCEEDED(hr));
 
 	// 2) ミップマップを作る
-	DirectX::ScratchImage mipImages{};
 	hr = DirectX::GenerateMipMaps(
 		image.GetImages(),
 		image.GetImageCount(),
@@ -177,9 +255,85 @@ DirectX::ScratchImage TextureDataContainer::LoadNormalMapTexture(const std::stri
 	);
 	assert(SUCCEEDED(hr));
 
+	// キャッシュに保存
+	StoreCachedTexture(cacheKey, mipImages);
+
 	return mipImages;
 }
 
+bool TextureDataContainer::LoadCachedTexture(const std::string& cacheKey, DirectX::ScratchImage& mipImages) {
+	std::vector<uint8_t> cacheData;
+	if (!importCache_->Load(cacheKey, cacheData)) {
+		return false;
+	}
+	// キャッシュはミップマップ付きのDDSで持っている
+	const HRESULT hr = DirectX::LoadFromDDSMemory(cacheData.data(), cacheData.size(), DirectX::DDS_FLAGS_NONE, nullptr, mipImages);
+	return SUCCEEDED(hr);
+}
+
+void TextureDataContainer::StoreCachedTexture(const std::string& cacheKey, const DirectX::ScratchImage& mipImages) {
+	DirectX::Blob blob;
+	const HRESULT hr = DirectX::SaveToDDSMemory(mipImages.GetImages(), mipImages.GetImageCount(), mipImages.GetMetadata(), DirectX::DDS_FLAGS_NONE, blob);
+	if (FAILED(hr)) {
+		return;
+	}
+	importCache_->Store(cacheKey, { static_cast<const uint8_t*>(blob.GetConstBufferPointer()), blob.GetBufferSize() });
+}
+
+void TextureDataContainer::FinalizeTexture(const std::string& fileName, DirectX::ScratchImage& mipImage) {
+	// 追い出した後の読み直しならSRVの場所を使い回す
+	const bool isReload = textureDatas_.contains(fileName);
+	if (isReload) {
+		// 描画中のフレームが同じSRVを読んでいるかもしれないので、書き換える前に待つ
+		fence_->WaitGPU();
+	}
+
+	// 今回ぶち込むテクスチャーの箱
+	Texture& texture = textureDatas_[fileName];
+
+	texture.metaData = mipImage.GetMetadata();
+	texture.resource = CreateTextureResource(texture.metaData);
+	// 転送はコマンドリストに積むだけで、GPUの完了はバッチ単位で待つ
+	UploadTextureData(texture.resource.Get(), mipImage);
+
+	// SRVを作成するDescriptorHeapの場所を決める
+	if (!isReload) {
+		texture.srvIndex = srvUavManager_->Allocate();
+	}
+
+	if (texture.metaData.IsCubemap()) {
+		// CubeMap用のsrvの作成
+		srvUavManager_->CreateSrvTextureCubeMap(texture.srvIndex, texture.resource.Get(), texture.metaData.format);
+	} else {
+		// 通常テクスチャのsrvの作成
+		srvUavManager_->CreateSrvTexture2d(texture.srvIndex, texture.resource.Get(), texture.metaData.format, UINT(texture.metaData.mipLevels));
+	}
+
+	// テクスチャ枚数上限チェック
+	assert(srvUavManager_->IsLowerViewMax());
+
+	// 再び常駐した
+	if (isReload) {
+		reloadingTextures_.erase(fileName);
+		residencyManager_->MarkResident(texture.residencyHandle, GetTextureBytes(texture));
+	}
+}
+
+void TextureDataContainer::EvictTexture(const std::string& fileName) {
+	Texture& texture = textureDatas_.at(fileName);
+	const Texture& defaultTexture = textureDatas_.at(defaultTextureName_);
+
+	// 読み直すまではデフォルトテクスチャで描く
+	srvUavManager_->CreateSrvTexture2d(texture.srvIndex, defaultTexture.resource.Get(), defaultTexture.metaData.format, UINT(defaultTexture.metaData.mipLevels));
+	// 追い出す前にGPUの完了を待っているので解放してよい
+	texture.resource = nullptr;
+}
+
+uint64_t TextureDataContainer::GetTextureBytes(const Texture& texture) const {
+	const D3D12_RESOURCE_DESC desc = texture.resource->GetDesc();
+	return dxgi_->GetDevice()->GetResourceAllocationInfo(0, 1, &desc).SizeInBytes;
+}
+
 ComPtr<ID3D12Resource> TextureDataContainer::CreateTextureResource(const DirectX::TexMetadata& metadata) {
 	// metadataを基にResourceの設定
 	D3D12_RESOURCE_DESC resourceDesc{};
@@ -208,12 +362,23 @@ ComPtr<ID3D12Resource> TextureDataContainer::CreateTextureResource(const DirectX
 	return resource;
 }
 
-ComPtr<ID3D12Resource> TextureDataContainer::UploadTextureData(ID3D12Resource* texture, const DirectX::ScratchImage& mipImages) {
+void TextureDataContainer::UploadTextureData(ID3D12Resource* texture, const DirectX::ScratchImage& mipImages) {
 	std::vector<D3D12_SUBRESOURCE_DATA> subresources;
 	DirectX::PrepareUpload(dxgi_->GetDevice(), mipImages.GetImages(), mipImages.GetImageCount(), mipImages.GetMetadata(), subresources);
 	uint64_t intermediateSize = GetRequiredIntermediateSize(texture, 0, UINT(subresources.size()));
-	ComPtr<ID3D12Resource> intermediateResource = dxgi_->CreateBufferResource(intermediateSize);
-	UpdateSubresources(directXCommand_->GetList(), texture, intermediateResource.Get(), 0, 0, UINT(subresources.size()), subresources.data());
+
+	if (intermediateSize <= uploadBatcher_->GetCapacity()) {
+		// リングの空き領域に書き込む(空きがなければここで一度送信される)
+		const uint64_t offset = uploadBatcher_->Allocate(intermediateSize, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+		UpdateSubresources(directXCommand_->GetList(), texture, uploadRingResource_.Get(), offset, 0, UINT(subresources.size()), subresources.data());
+	} else {
+		// リングに収まらないものは専用の中間リソースを作る
+		ComPtr<ID3D12Resource> intermediateResource = dxgi_->CreateBufferResource(intermediateSize);
+		UpdateSubresources(directXCommand_->GetList(), texture, intermediateResource.Get(), 0, 0, UINT(subresources.size()), subresources.data());
+		externalUploadResources_.push_back(intermediateResource);
+		uploadBatcher_->AddExternalUpload();
+	}
+
 	// Textureへの転送後は利用できるよう、D3D12_RESOURCE_STATE_COPY_DESTからD3D12_RESOURCE_STATE_GENERIC_READへResourceStateを変更する
 	D3D12_RESOURCE_BARRIER barrier{};
 	barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
@@ -223,7 +388,16 @@ ComPtr<ID3D12Resource> TextureDataContainer::UploadTextureData(ID3D12Resource* t
 	barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_COPY_DEST;
 	barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_GENERIC_READ;
 	directXCommand_->GetList()->ResourceBarrier(1, &barrier);
-	return intermediateResource;
+}
+
+void TextureDataContainer::SubmitUploads() {
+	// コマンドのクローズと実行
+	directXCommand_->KickCommand();
+	fence_->WaitGPU();
+	directXCommand_->ResetCommand();
+
+	// GPUが読み終わったので中間リソースを解放
+	externalUploadResources_.clear();
 }
 
 void TextureDataContainer::SetDXGI(DXGI* dxgi) {
@@ -245,3 +419,18 @@ void TextureDataContainer::SetSrvUavManager(SRVUAVManager* srvUavManager) {
 	assert(srvUavManager);
 	srvUavManager_ = srvUavManager;
 }
+
+void TextureDataContainer::SetAssetPack(AssetPack* assetPack) {
+	assert(assetPack);
+	assetPack_ = assetPack;
+}
+
+void TextureDataContainer::SetImportCache(ImportCache* importCache) {
+	assert(importCache);
+	importCache_ = importCache;
+}
+
+void TextureDataContainer::SetResidencyManager(ResidencyManager* residencyManager) {
+	assert(residencyManager);
+	residencyManager_ = residencyManager;
+}
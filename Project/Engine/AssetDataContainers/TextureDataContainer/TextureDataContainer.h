@@ -2,32 +2,52 @@
 
 // C++
 #include <map>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
+#include <unordered_set>
 #include <string>
 #include <vector>
 
 #include "Structs/TextureStruct.h"
+#include "AssetLoadQueue/AssetLoadQueue.h"
+#include "DirectX/UploadBatcher/UploadBatcher.h"
 
 // 前方宣言
 class DXGI;
 class DirectXCommand;
 class Fence;
 class SRVUAVManager;
+class AssetPack;
+class ImportCache;
+class ResidencyManager;
 
 /// <summary>
 /// テクスチャデータのコンテナ
 /// </summary>
 class TextureDataContainer {
 public:
-	TextureDataContainer(DXGI* dxgi, DirectXCommand* command, Fence* fence, SRVUAVManager* srvUavManagerManager);
+	TextureDataContainer(DXGI* dxgi, DirectXCommand* command, Fence* fence, SRVUAVManager* srvUavManagerManager, AssetPack* assetPack, ImportCache* importCache, ResidencyManager* residencyManager);
 	~TextureDataContainer();
 
 	// 初期化
-	void Initialize(DXGI* dxgi, DirectXCommand* command, Fence* fence, SRVUAVManager* srvUavManager);
+	void Initialize(DXGI* dxgi, DirectXCommand* command, Fence* fence, SRVUAVManager* srvUavManager, AssetPack* assetPack, ImportCache* importCache, ResidencyManager* residencyManager);
 	// テクスチャのロード
 	uint32_t Load(const std::string& fileName, bool isFullPath = true);
 	// ノーマルマップテクスチャのロード
 	void LoadNormalMap(const std::string& filePath);
+	// テクスチャの非同期ロード(どのスレッドからでも呼べる)
+	AssetLoadHandle LoadAsync(const std::string& fileName, bool isFullPath = true);
+	// ノーマルマップテクスチャの非同期ロード(どのスレッドからでも呼べる)
+	AssetLoadHandle LoadNormalMapAsync(const std::string& filePath);
+	// 読み込みが終わったテクスチャをGPUに転送して確定
+	void UpdateLoads();
+	// すべての非同期ロードを待って確定
+	void WaitLoads();
+	// 指定したテクスチャの読み込みだけを待って確定
+	void WaitLoad(const std::string& fileName);
+	// 描画に使ったことを記録(追い出されていれば読み直す)
+	void Touch(const std::string& fileName);
 	// Textureを渡す
 	std::unordered_map<std::string, Texture>& GetTexture();
 	// メタデータを渡す
@@ -38,14 +58,36 @@ public:
 	// デフォルトテクスチャのインデックスを渡す
 	uint32_t GetDefaultTextureIndex()const;
 private:
-	// Texture読み込み
+	/// <summary>
+	/// 読み直し用のテクスチャの読み込み元
+	/// </summary>
+	struct TextureSource {
+		std::string filePath;
+		bool isNormalMap = false;
+	};
+
+	// 読み込み元を記録して非同期ロードを開始
+	AssetLoadHandle RequestLoad(const std::string& fileName, const std::string& filePath, bool isNormalMap);
+	// Texture読み込み(ワーカースレッドで実行)
 	DirectX::ScratchImage LoadTexture(const std::string& filePath);
-	// 法線マップ用Texture読み込み
+	// 法線マップ用Texture読み込み(ワーカースレッドで実行)
 	DirectX::ScratchImage LoadNormalMapTexture(const std::string& filePath);
+	// キャッシュからミップマップ付きのテクスチャを読む
+	bool LoadCachedTexture(const std::string& cacheKey, DirectX::ScratchImage& mipImages);
+	// ミップマップ付きのテクスチャをキャッシュに保存
+	void StoreCachedTexture(const std::string& cacheKey, const DirectX::ScratchImage& mipImages);
+	// 読み込んだテクスチャの転送を積んでSRVを作る
+	void FinalizeTexture(const std::string& fileName, DirectX::ScratchImage& mipImage);
+	// 予算超過で追い出す(SRVはデフォルトテクスチャを指すようにする)
+	void EvictTexture(const std::string& fileName);
+	// テクスチャが使っているGPUメモリのサイズ
+	uint64_t GetTextureBytes(const Texture& texture)const;
 	// テクスチャリソースを作る
 	ComPtr<ID3D12Resource> CreateTextureResource(const DirectX::TexMetadata& metadata);
-	// テクスチャデータを送る
-	ComPtr<ID3D12Resource> UploadTextureData(ID3D12Resource* texture, const DirectX::ScratchImage& mipImages);
+	// テクスチャデータの転送をコマンドリストに積む
+	void UploadTextureData(ID3D12Resource* texture, const DirectX::ScratchImage& mipImages);
+	// 積んだ転送を実行してGPUの完了を待つ
+	void SubmitUploads();
 private:
 	// DXGIのインスタンスをセット
 	void SetDXGI(DXGI* dxgi);
@@ -55,9 +97,31 @@ private:
 	void SetFence(Fence* fence);
 	// SrvUavManager
 	void SetSrvUavManager(SRVUAVManager* srvUavManager);
+	// AssetPack
+	void SetAssetPack(AssetPack* assetPack);
+	// ImportCache
+	void SetImportCache(ImportCache* importCache);
+	// ResidencyManager
+	void SetResidencyManager(ResidencyManager* residencyManager);
 private:
 	// テクスチャデータコンテナ
 	std::unordered_map<std::string, Texture> textureDatas_;
+	// 非同期読み込みのキュー
+	AssetLoadQueue<DirectX::ScratchImage> loadQueue_;
+	// テクスチャの読み込み元(どのスレッドからも書かれるのでロックする)
+	std::unordered_map<std::string, TextureSource> textureSources_;
+	std::mutex textureSourceMutex_;
+	// 追い出した後に読み直し中のテクスチャ
+	std::unordered_set<std::string> reloadingTextures_;
+
+	// アップロード用リングバッファのサイズ
+	static const uint64_t kUploadRingSize = 64ull * 1024 * 1024;
+	// アップロード用リングバッファ
+	ComPtr<ID3D12Resource> uploadRingResource_ = nullptr;
+	// リングの領域管理と転送のまとめ送り
+	std::unique_ptr<UploadBatcher> uploadBatcher_ = nullptr;
+	// リングに収まらないテクスチャ用の中間リソース(送信が終わるまで保持)
+	std::vector<ComPtr<ID3D12Resource>> externalUploadResources_;
 private:
 	// DXGI
 	DXGI* dxgi_ = nullptr;
@@ -67,7 +131,15 @@ private:
 	Fence* fence_ = nullptr;
 	// SrvManager
 	SRVUAVManager* srvUavManager_ = nullptr;
+	// AssetPack
+	AssetPack* assetPack_ = nullptr;
+	// ImportCache
+	ImportCache* importCache_ = nullptr;
+	// ResidencyManager
+	ResidencyManager* residencyManager_ = nullptr;
 
+	// エンジンのデフォルトテクスチャの名前
+	const std::string defaultTextureName_ = "EngineAssets/Images/uvChecker.png";
 	// エンジンのデフォルトテクスチャのインデックス
 	uint32_t defaultTextureIndex_ = 0;
 };
\ No newline at end of file
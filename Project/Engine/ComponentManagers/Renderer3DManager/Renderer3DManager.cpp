@@ -26,6 +26,12 @@ void Renderer3DManager::Draw() {
 	}
 }
 
+void Renderer3DManager::DrawOccluders() {
+	for (auto& modelRenderer : modelRenderers_) {
+		modelRenderer->DrawOccluder();
+	}
+}
+
 void Renderer3DManager::DeleteGarbage() {
 	for (auto& modelRenderer : modelRenderers_) {
 		if (modelRenderer && !modelRenderer->GetIsAlive()) {
@@ -17,6 +17,8 @@ public:
 
 	[[nodiscard]] std::weak_ptr<ModelRenderer> Add(std::shared_ptr<ModelRenderer> modelRenderer);
 	void Draw();
+	// 遮蔽物の描画
+	void DrawOccluders();
 	void DeleteGarbage();
 	void Clear();
 
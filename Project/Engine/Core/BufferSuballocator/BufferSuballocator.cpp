@@ -0,0 +1,82 @@
+#include "BufferSuballocator.h"
+
+// C++
+#include <algorithm>
+#include <cassert>
+
+BufferSuballocator::BufferSuballocator(uint64_t blockSize, uint32_t frameLatency, CreateBlockFunction createBlock) {
+	assert(blockSize >= TLSFAllocator::kGranularity);
+	assert(createBlock);
+	blockSize_ = blockSize;
+	createBlock_ = createBlock;
+	// 今のフレームの区間とGPUが読んでいるかもしれないframeLatency個の区間
+	pendingFrees_.resize(frameLatency + 1);
+}
+
+BufferSuballocator::~BufferSuballocator() {
+
+}
+
+BufferSuballocator::Allocation BufferSuballocator::Allocate(uint64_t sizeInBytes, uint64_t alignment) {
+	assert(sizeInBytes > 0);
+
+	// 今あるブロックから切り出す
+	for (uint32_t i = 0; i < blocks_.size(); i++) {
+		const uint64_t offset = blocks_[i]->Allocate(sizeInBytes, alignment);
+		if (offset != TLSFAllocator::kInvalidOffset) {
+			return Allocation{ .blockIndex = i, .offset = offset, .size = sizeInBytes };
+		}
+	}
+
+	// 足りなければブロックを足す(ブロックより大きいものはそれが収まる大きさで作る)
+	const uint32_t blockIndex = static_cast<uint32_t>(blocks_.size());
+	const uint64_t blockSize = (std::max)(blockSize_, TLSFAllocator::GetRequiredSize(sizeInBytes, alignment));
+	blocks_.push_back(std::make_unique<TLSFAllocator>(blockSize));
+	createBlock_(blockIndex, blocks_.back()->GetSize());
+
+	const uint64_t offset = blocks_.back()->Allocate(sizeInBytes, alignment);
+	assert(offset != TLSFAllocator::kInvalidOffset);
+	return Allocation{ .blockIndex = blockIndex, .offset = offset, .size = sizeInBytes };
+}
+
+void BufferSuballocator::Free(const Allocation& allocation) {
+	assert(allocation.blockIndex < blocks_.size());
+	// 描画中のフレームが読んでいるかもしれないので空きに戻すのは遅らせる
+	pendingFrees_[slotIndex_].push_back(allocation);
+}
+
+void BufferSuballocator::BeginFrame() {
+	slotIndex_ = (slotIndex_ + 1) % static_cast<uint32_t>(pendingFrees_.size());
+
+	// この区間を前に使ったフレームはframeLatency + 1フレーム前なのでGPUが読み終えている
+	std::vector<Allocation>& pending = pendingFrees_[slotIndex_];
+	for (const Allocation& allocation : pending) {
+		blocks_[allocation.blockIndex]->Free(allocation.offset);
+	}
+	pending.clear();
+}
+
+uint32_t BufferSuballocator::GetBlockCount()const {
+	return static_cast<uint32_t>(blocks_.size());
+}
+
+uint64_t BufferSuballocator::GetBlockSize(uint32_t blockIndex)const {
+	assert(blockIndex < blocks_.size());
+	return blocks_[blockIndex]->GetSize();
+}
+
+uint64_t BufferSuballocator::GetUsedSize()const {
+	uint64_t usedSize = 0;
+	for (const auto& block : blocks_) {
+		usedSize += block->GetUsedSize();
+	}
+	return usedSize;
+}
+
+uint32_t BufferSuballocator::GetAllocationCount()const {
+	uint32_t count = 0;
+	for (const auto& block : blocks_) {
+		count += block->GetAllocationCount();
+	}
+	return count;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+// C++
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+// MyHedder
+#include "TLSFAllocator/TLSFAllocator.h"
+
+/// <summary>
+/// 大きなバッファ(ブロック)をTLSFで切り分けて小さなバッファの領域を割り当てる
+/// ブロックが足りなければ作成関数で足す(ブロックより大きいものにはその大きさのブロックを作る)
+/// GPUが読み終わるまで領域を使い回さないように、解放はframeLatencyフレーム遅らせる
+/// メインスレッドからのみ呼ぶ。GPUには触らないので作成関数を差し替えれば単体で動かせる
+/// </summary>
+class BufferSuballocator {
+public:
+	// ブロックがないことを表す番号
+	static constexpr uint32_t kInvalidBlock = UINT32_MAX;
+
+	/// <summary>
+	/// 割り当てた領域
+	/// </summary>
+	struct Allocation {
+		// ブロックの番号
+		uint32_t blockIndex = kInvalidBlock;
+		// ブロックの先頭からの位置
+		uint64_t offset = 0;
+		// 大きさ
+		uint64_t size = 0;
+	};
+
+	// ブロックを作る関数(ブロックの番号と大きさを受け取る)
+	using CreateBlockFunction = std::function<void(uint32_t blockIndex, uint64_t sizeInBytes)>;
+
+	// frameLatencyは今のフレームのほかにGPUが読んでいるかもしれないフレームの数
+	BufferSuballocator(uint64_t blockSize, uint32_t frameLatency, CreateBlockFunction createBlock);
+	~BufferSuballocator();
+
+	// 領域を割り当てる
+	[[nodiscard]] Allocation Allocate(uint64_t sizeInBytes, uint64_t alignment);
+	// 領域を解放(GPUが読み終わるまでは使い回さない)
+	void Free(const Allocation& allocation);
+
+	// フレーム開始。GPUが読み終えたフレームで解放した領域を空きに戻す
+	void BeginFrame();
+
+	// ブロックの数
+	[[nodiscard]] uint32_t GetBlockCount()const;
+	// ブロックの大きさ
+	[[nodiscard]] uint64_t GetBlockSize(uint32_t blockIndex)const;
+	// 使用中の大きさ(解放待ちも含む)
+	[[nodiscard]] uint64_t GetUsedSize()const;
+	// 使用中の領域の数(解放待ちも含む)
+	[[nodiscard]] uint32_t GetAllocationCount()const;
+
+private:
+	// 新しく作るブロックの大きさ
+	uint64_t blockSize_ = 0;
+	// ブロックごとの切り分け
+	std::vector<std::unique_ptr<TLSFAllocator>> blocks_;
+	// ブロックを作る関数
+	CreateBlockFunction createBlock_;
+
+	// 今のフレームの区間(解放待ちをframeLatency + 1個で回す)
+	uint32_t slotIndex_ = 0;
+	// 区間ごとの解放待ちの領域
+	std::vector<std::vector<Allocation>> pendingFrees_;
+};
@@ -0,0 +1,86 @@
+#include "DescriptorAllocator.h"
+
+// C++
+#include <cassert>
+
+DescriptorAllocator::DescriptorAllocator(uint32_t persistentCount, uint32_t transientCountPerFrame, uint32_t frameLatency) {
+	assert(persistentCount > 0);
+	persistentCount_ = persistentCount;
+	transientCountPerFrame_ = transientCountPerFrame;
+	frameLatency_ = frameLatency;
+	isAllocated_.resize(persistentCount_, false);
+	// 今のフレームの区間とGPUが読んでいるかもしれないframeLatency個の区間
+	pendingFrees_.resize(frameLatency_ + 1);
+}
+
+DescriptorAllocator::~DescriptorAllocator() {
+
+}
+
+uint32_t DescriptorAllocator::Allocate() {
+	uint32_t index = 0;
+	// 解放された番号から先に使い回す
+	if (!freeList_.empty()) {
+		index = freeList_.back();
+		freeList_.pop_back();
+	} else {
+		assert(persistentTop_ < persistentCount_ && "descriptor heap is full");
+		index = persistentTop_;
+		persistentTop_++;
+	}
+	assert(!isAllocated_[index]);
+	isAllocated_[index] = true;
+	persistentUsedCount_++;
+	return index;
+}
+
+void DescriptorAllocator::Free(uint32_t index) {
+	assert(index < persistentCount_);
+	assert(isAllocated_[index] && "descriptor freed twice");
+	isAllocated_[index] = false;
+	// 描画中のフレームが読んでいるかもしれないので空きに戻すのは遅らせる
+	pendingFrees_[slotIndex_].push_back(index);
+}
+
+uint32_t DescriptorAllocator::AllocateTransient(uint32_t count) {
+	if (transientOffset_ + count > transientCountPerFrame_) {
+		return kInvalidIndex;
+	}
+	// 一時用は常駐用の後ろに区間ごとに並べる
+	const uint32_t index = persistentCount_ + slotIndex_ * transientCountPerFrame_ + transientOffset_;
+	transientOffset_ += count;
+	return index;
+}
+
+void DescriptorAllocator::BeginFrame() {
+	slotIndex_ = (slotIndex_ + 1) % static_cast<uint32_t>(pendingFrees_.size());
+
+	// この区間を前に使ったフレームはframeLatency + 1フレーム前なのでGPUが読み終えている
+	std::vector<uint32_t>& pending = pendingFrees_[slotIndex_];
+	freeList_.insert(freeList_.end(), pending.begin(), pending.end());
+	persistentUsedCount_ -= static_cast<uint32_t>(pending.size());
+	pending.clear();
+
+	// 一時用も同じ理由で巻き戻してよい
+	transientOffset_ = 0;
+}
+
+uint32_t DescriptorAllocator::GetPersistentCount()const {
+	return persistentCount_;
+}
+
+uint32_t DescriptorAllocator::GetPersistentUsedCount()const {
+	return persistentUsedCount_;
+}
+
+bool DescriptorAllocator::HasFreePersistent()const {
+	return !freeList_.empty() || persistentTop_ < persistentCount_;
+}
+
+uint32_t DescriptorAllocator::GetTransientUsedCount()const {
+	return transientOffset_;
+}
+
+uint32_t DescriptorAllocator::GetTotalCount()const {
+	return persistentCount_ + transientCountPerFrame_ * static_cast<uint32_t>(pendingFrees_.size());
+}
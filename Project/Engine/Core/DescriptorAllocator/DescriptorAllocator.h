@@ -0,0 +1,67 @@
+#pragma once
+
+// C++
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// ディスクリプタヒープの番号の割り当て
+/// 先頭は解放できる常駐用(空きリスト)、後ろはフレームごとに巻き戻す一時用(リング)に分ける
+/// GPUが読み終わるまで番号を使い回さないように、解放と一時用の巻き戻しはframeLatencyフレーム遅らせる
+/// メインスレッドからのみ呼ぶ。GPUには触らないので単体で動かせる
+/// </summary>
+class DescriptorAllocator {
+public:
+	// 一時用が確保できなかったときの番号
+	static const uint32_t kInvalidIndex = UINT32_MAX;
+
+	// frameLatencyは今のフレームのほかにGPUが読んでいるかもしれないフレームの数
+	DescriptorAllocator(uint32_t persistentCount, uint32_t transientCountPerFrame, uint32_t frameLatency);
+	~DescriptorAllocator();
+
+	// 常駐用の番号を確保(空きがなければ止める)
+	[[nodiscard]] uint32_t Allocate();
+	// 常駐用の番号を解放(GPUが読み終わるまでは使い回さない)
+	void Free(uint32_t index);
+
+	// 一時用の連続した番号を確保して先頭を返す(このフレームの分が足りなければkInvalidIndex)
+	[[nodiscard]] uint32_t AllocateTransient(uint32_t count);
+
+	// フレーム開始。GPUが読み終えたフレームで解放した番号を空きに戻し、一時用の次の区間を巻き戻す
+	void BeginFrame();
+
+	// 常駐用の番号の数
+	[[nodiscard]] uint32_t GetPersistentCount()const;
+	// 使用中の常駐用の番号の数(解放待ちも含む)
+	[[nodiscard]] uint32_t GetPersistentUsedCount()const;
+	// 常駐用の番号がまだ確保できるか
+	[[nodiscard]] bool HasFreePersistent()const;
+	// このフレームで確保した一時用の番号の数
+	[[nodiscard]] uint32_t GetTransientUsedCount()const;
+	// ヒープ全体の番号の数
+	[[nodiscard]] uint32_t GetTotalCount()const;
+
+private:
+	// 常駐用の番号の数
+	uint32_t persistentCount_ = 0;
+	// 一度も確保していない常駐用の先頭
+	uint32_t persistentTop_ = 0;
+	// 解放されて使い回せる常駐用の番号
+	std::vector<uint32_t> freeList_;
+	// 番号ごとの使用中フラグ(二重解放の検出用)
+	std::vector<bool> isAllocated_;
+	// 使用中の常駐用の番号の数
+	uint32_t persistentUsedCount_ = 0;
+
+	// フレームごとの一時用の番号の数
+	uint32_t transientCountPerFrame_ = 0;
+	// 今のフレームの区間で確保した一時用の番号の数
+	uint32_t transientOffset_ = 0;
+
+	// GPUが読み終わるまでのフレーム数
+	uint32_t frameLatency_ = 0;
+	// 今のフレームの区間(解放待ちと一時用の区間をframeLatency + 1個で回す)
+	uint32_t slotIndex_ = 0;
+	// 区間ごとの解放待ちの番号
+	std::vector<std::vector<uint32_t>> pendingFrees_;
+};
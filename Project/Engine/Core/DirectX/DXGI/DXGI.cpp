@@ -3,6 +3,8 @@
 #include <cassert>
 
 #include "Logger/Logger.h"
+#include "Const/BufferConst.h"
+#include "Const/FrameConst.h"
 
 DXGI::DXGI() {}
 
@@ -151,6 +153,45 @@ bool DXGI::Initialize() {
 	}
 #endif // _DEBUG
 
+	// 共有のアップロードバッファ(足りなくなったらブロックを作って書き込み先を開いたままにする)
+	uploadSuballocator_ = std::make_unique<BufferSuballocator>(BufferConst::BlockSize, FrameConst::FrameCount, [this](uint32_t blockIndex, uint64_t sizeInBytes) {
+		assert(blockIndex == uploadBlocks_.size());
+		ComPtr<ID3D12Resource> block = CreateBufferResource(sizeInBytes);
+		uint8_t* mappedData = nullptr;
+		block->Map(0, nullptr, reinterpret_cast<void**>(&mappedData));
+		uploadBlocks_.push_back(block);
+		uploadBlockMappedData_.push_back(mappedData);
+		});
+
+	// 共有のデフォルトバッファ
+	// COMMONで作っておき、コピーと読み取りはバッファの暗黙の状態遷移に任せる(転送はまとめて送って待つので同じコマンドリストで混ざらない)
+	defaultSuballocator_ = std::make_unique<BufferSuballocator>(BufferConst::BlockSize, FrameConst::FrameCount, [this](uint32_t blockIndex, uint64_t sizeInBytes) {
+		assert(blockIndex == defaultBlocks_.size());
+		D3D12_HEAP_PROPERTIES defaultHeapProperties{};
+		defaultHeapProperties.Type = D3D12_HEAP_TYPE_DEFAULT;
+
+		D3D12_RESOURCE_DESC resourceDesc{};
+		resourceDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+		resourceDesc.Width = sizeInBytes;
+		resourceDesc.Height = 1;
+		resourceDesc.DepthOrArraySize = 1;
+		resourceDesc.MipLevels = 1;
+		resourceDesc.SampleDesc.Count = 1;
+		resourceDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+
+		ComPtr<ID3D12Resource> block = nullptr;
+		hr_ = device_->CreateCommittedResource(
+			&defaultHeapProperties,
+			D3D12_HEAP_FLAG_NONE,
+			&resourceDesc,
+			D3D12_RESOURCE_STATE_COMMON,
+			nullptr,
+			IID_PPV_ARGS(&block)
+		);
+		assert(SUCCEEDED(hr_));
+		defaultBlocks_.push_back(block);
+		});
+
 	// 初期化完了
 	Logger::Log("DXGI Initialize\n");
 
@@ -240,6 +281,47 @@ ComPtr<ID3D12Resource> DXGI::CreateBufferResource(size_t sizeInBytes, bool isfor
 	}
 }
 
+BufferRegion DXGI::AllocateUploadBuffer(uint64_t sizeInBytes, uint64_t alignment) {
+	const BufferSuballocator::Allocation allocation = uploadSuballocator_->Allocate(sizeInBytes, alignment);
+	ID3D12Resource* block = uploadBlocks_[allocation.blockIndex].Get();
+	return BufferRegion{
+		.resource = block,
+		.allocation = allocation,
+		.mappedData = uploadBlockMappedData_[allocation.blockIndex] + allocation.offset,
+		.gpuAddress = block->GetGPUVirtualAddress() + allocation.offset,
+	};
+}
+
+void DXGI::FreeUploadBuffer(const BufferRegion& region) {
+	if (!region.resource) {
+		return;
+	}
+	uploadSuballocator_->Free(region.allocation);
+}
+
+BufferRegion DXGI::AllocateDefaultBuffer(uint64_t sizeInBytes, uint64_t alignment) {
+	const BufferSuballocator::Allocation allocation = defaultSuballocator_->Allocate(sizeInBytes, alignment);
+	ID3D12Resource* block = defaultBlocks_[allocation.blockIndex].Get();
+	return BufferRegion{
+		.resource = block,
+		.allocation = allocation,
+		.mappedData = nullptr,
+		.gpuAddress = block->GetGPUVirtualAddress() + allocation.offset,
+	};
+}
+
+void DXGI::FreeDefaultBuffer(const BufferRegion& region) {
+	if (!region.resource) {
+		return;
+	}
+	defaultSuballocator_->Free(region.allocation);
+}
+
+void DXGI::BeginFrame() {
+	uploadSuballocator_->BeginFrame();
+	defaultSuballocator_->BeginFrame();
+}
+
 ComPtr<ID3D12Resource> DXGI::CreateDepthStencilTextureResource(int32_t width, int32_t height, DXGI_FORMAT format) {
 	// 生成するResourceの設定
 	D3D12_RESOURCE_DESC resourceDesc{};
@@ -2,12 +2,16 @@
 
 // C++
 #include <cstdint>
+#include <memory>
+#include <vector>
 
 // DirectX
 #include <d3d12.h>
 #include <dxgi1_6.h>
 
 #include "DirectX/ComPtr/ComPtr.h"
+#include "BufferSuballocator/BufferSuballocator.h"
+#include "Structs/BufferStruct.h"
 
 class DXGI {
 public:
@@ -22,6 +26,16 @@ public:
 	ComPtr<ID3D12DescriptorHeap> CreateDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE heapType, UINT numDescriptors, bool shaderVisible);
 	// バッファリソースの作成
 	ComPtr<ID3D12Resource> CreateBufferResource(size_t sizeInBytes, bool isforUAV = false);
+	// 共有のアップロードバッファから領域を切り出す(CPUから書き込む小さなバッファ向け)
+	BufferRegion AllocateUploadBuffer(uint64_t sizeInBytes, uint64_t alignment);
+	// 切り出した領域を返す(GPUが読み終わるまでは使い回さない)
+	void FreeUploadBuffer(const BufferRegion& region);
+	// 共有のデフォルトバッファから領域を切り出す(中身はコピーで書き込む)
+	BufferRegion AllocateDefaultBuffer(uint64_t sizeInBytes, uint64_t alignment);
+	// 切り出した領域を返す(GPUが読み終わるまでは使い回さない)
+	void FreeDefaultBuffer(const BufferRegion& region);
+	// フレーム開始。GPUが読み終えた領域を使い回せるようにする
+	void BeginFrame();
 	// デプスステンシルリソースの作成
 	ComPtr<ID3D12Resource> CreateDepthStencilTextureResource(int32_t width, int32_t height, DXGI_FORMAT format);
 	// デプスステンシルリソースの作成
@@ -46,4 +60,16 @@ private:
 	// MeshShader対応Device
 	ComPtr<ID3D12Device10> device10_;
 
+	// 共有のアップロードバッファ(ブロック)
+	std::vector<ComPtr<ID3D12Resource>> uploadBlocks_;
+	// ブロックごとの書き込み先
+	std::vector<uint8_t*> uploadBlockMappedData_;
+	// ブロックの切り分け
+	std::unique_ptr<BufferSuballocator> uploadSuballocator_ = nullptr;
+
+	// 共有のデフォルトバッファ(ブロック)
+	std::vector<ComPtr<ID3D12Resource>> defaultBlocks_;
+	// ブロックの切り分け
+	std::unique_ptr<BufferSuballocator> defaultSuballocator_ = nullptr;
+
 };
\ No newline at end of file
@@ -44,36 +44,8 @@ void DepthStencil::ClearDepthView() {
 	);
 }
 
-void DepthStencil::TransitionToWrite() {
-	if (currentResourceState_ != D3D12_RESOURCE_STATE_DEPTH_WRITE) {
-		D3D12_RESOURCE_BARRIER barrier = {};
-		barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-		barrier.Transition.pResource = resource_.Get();
-		barrier.Transition.StateBefore = currentResourceState_;
-		barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_DEPTH_WRITE;
-		barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-		directXCommand_->GetList()->ResourceBarrier(1, &barrier);
-
-		currentResourceState_ = D3D12_RESOURCE_STATE_DEPTH_WRITE;
-	}
-}
-
-void DepthStencil::TransitionToRead() {
-	// DEPTH_READ | PIXEL_SHADER_RESOURCE の複合ビットへ
-	const auto desired =
-		D3D12_RESOURCE_STATE_DEPTH_READ |
-		D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
-
-	if (currentResourceState_ != desired) {
-		D3D12_RESOURCE_BARRIER barrier = {};
-		barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-		barrier.Transition.pResource = resource_.Get();
-		barrier.Transition.StateBefore = currentResourceState_;
-		barrier.Transition.StateAfter = desired;
-		barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-		directXCommand_->GetList()->ResourceBarrier(1, &barrier);
-		currentResourceState_ = desired;
-	}
+ID3D12Resource* DepthStencil::GetResource() {
+	return resource_.Get();
 }
 
 D3D12_CPU_DESCRIPTOR_HANDLE DepthStencil::GetDepthStencilResorceCPUHandle() {
@@ -20,8 +20,8 @@ public:
 	// デプスをクリア
 	void ClearDepthView();
 
-	void TransitionToWrite();
-	void TransitionToRead();
+	// リソースを取得(状態はレンダーグラフが管理する)
+	ID3D12Resource* GetResource();
 
 	// デプスステンシルリソースのCPUハンドルの取得
 	D3D12_CPU_DESCRIPTOR_HANDLE GetDepthStencilResorceCPUHandle();
@@ -44,7 +44,6 @@ private:
 private:
 	// リソース
 	ComPtr<ID3D12Resource> resource_ = nullptr;
-	D3D12_RESOURCE_STATES currentResourceState_ = D3D12_RESOURCE_STATE_DEPTH_WRITE;
 	// dsvインデックス
 	uint32_t dsvIndex_ = 0;
 	// srvインデックス
@@ -24,12 +24,15 @@ void DirectXCommand::Initialize(DXGI* dxgi, bool isSupportDirectX12Ultimate) {
 		IID_PPV_ARGS(&commandQueue_));
 	assert(SUCCEEDED(hr_));
 
-	// コマンドアロケータを生成する
-	hr_ = dxgi_->GetDevice()->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&commandAllocator_));
-	assert(SUCCEEDED(hr_));
+	// フレームごとのコマンドアロケータを生成する
+	for (uint32_t i = 0; i < FrameConst::FrameCount; i++) {
+		hr_ = dxgi_->GetDevice()->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&commandAllocators_[i]));
+		assert(SUCCEEDED(hr_));
+	}
+	frameIndex_ = 0;
 
 	// コマンドリストを生成する
-	hr_ = dxgi_->GetDevice()->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT, commandAllocator_.Get(), nullptr, IID_PPV_ARGS(&commandList_));
+	hr_ = dxgi_->GetDevice()->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT, commandAllocators_[frameIndex_].Get(), nullptr, IID_PPV_ARGS(&commandList_));
 	assert(SUCCEEDED(hr_));
 
 	// もしサポートされているデバイスなら
@@ -49,20 +52,29 @@ void DirectXCommand::KickCommand() {
 }
 
 void DirectXCommand::ResetCommand() {
-	// アロケータのリセット
-	hr_ = commandAllocator_->Reset();
+	// アロケータのリセット(このスロットを前に使ったフレームの完了は待ってある)
+	hr_ = commandAllocators_[frameIndex_]->Reset();
 	assert(SUCCEEDED(hr_));
 	// コマンドリストのリセット
-	hr_ = commandList_->Reset(commandAllocator_.Get(), nullptr);
+	hr_ = commandList_->Reset(commandAllocators_[frameIndex_].Get(), nullptr);
 	assert(SUCCEEDED(hr_));
 }
 
+void DirectXCommand::SetFrameIndex(uint32_t frameIndex) {
+	assert(frameIndex < FrameConst::FrameCount);
+	frameIndex_ = frameIndex;
+}
+
+uint32_t DirectXCommand::GetFrameIndex() const {
+	return frameIndex_;
+}
+
 ID3D12CommandQueue* DirectXCommand::GetQueue() {
 	return commandQueue_.Get();
 }
 
 ID3D12CommandAllocator* DirectXCommand::GetAllocator() {
-	return commandAllocator_.Get();
+	return commandAllocators_[frameIndex_].Get();
 }
 
 ID3D12GraphicsCommandList* DirectXCommand::GetList() {
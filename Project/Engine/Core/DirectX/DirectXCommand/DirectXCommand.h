@@ -11,6 +11,8 @@
 
 // ComPtr
 #include "DirectX/ComPtr/ComPtr.h"
+// MyHedder
+#include "Const/FrameConst.h"
 
 // 前方宣言
 class DXGI;
@@ -24,8 +26,12 @@ public:
 	void Initialize(DXGI* dxgi, bool isSupportDirectX12Ultimate);
 	// コマンドの実行
 	void KickCommand();
-	// コマンドのリセット
+	// コマンドのリセット(今のフレームのアロケータを使う)
 	void ResetCommand();
+	// 今のフレームのスロット番号を設定
+	void SetFrameIndex(uint32_t frameIndex);
+	// 今のフレームのスロット番号を取得
+	uint32_t GetFrameIndex()const;
 	// キューの取得
 	ID3D12CommandQueue* GetQueue();
 	// アロケータの取得
@@ -44,8 +50,10 @@ private:
 	DXGI* dxgi_ = nullptr;
 	// コマンドキュー
 	ComPtr<ID3D12CommandQueue> commandQueue_ = nullptr;
-	// コマンドアロケータ
-	ComPtr<ID3D12CommandAllocator> commandAllocator_ = nullptr;
+	// コマンドアロケータ(GPUが読んでいる間は使い直せないのでフレームごとに持つ)
+	ComPtr<ID3D12CommandAllocator> commandAllocators_[FrameConst::FrameCount];
+	// 今のフレームのスロット番号
+	uint32_t frameIndex_ = 0;
 	// コマンドリスト
 	ComPtr<ID3D12GraphicsCommandList> commandList_ = nullptr;
 	// MeshShader用コマンドリスト
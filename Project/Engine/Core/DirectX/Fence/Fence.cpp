@@ -11,6 +11,9 @@ Fence::Fence(DXGI* dxgi, DirectXCommand* directXCommand) {
 }
 
 Fence::~Fence() {
+	if (fenceEvent_) {
+		CloseHandle(fenceEvent_);
+	}
 	Logger::Log("Fence Finalize\n");
 }
 
@@ -26,24 +29,39 @@ void Fence::Initialize(DXGI* dxgi, DirectXCommand* directXCommand) {
 }
 
 void Fence::WaitGPU() {
-	// Fenceの値を更新し、GPUGPUがここまでたどり着いたときにFenceの値を指定した値に代入するようにSignalを送る
+	// ここまでに積んだコマンドがすべて終わるまで待つ
+	WaitForValue(Signal());
+}
+
+uint64_t Fence::Signal() {
+	// Fenceの値を更新し、GPUがここまでたどり着いたときにFenceの値を指定した値に代入するようにSignalを送る
 	directXCommand_->GetQueue()->Signal(fence_.Get(), ++fenceValue_);
+	return fenceValue_;
+}
+
+void Fence::WaitForValue(uint64_t fenceValue) {
 	// Fenceの値が指定されたSignal値にたどり着いているか確認する
 	// GetCompletedValueの初期値はFence作成時に渡した初期値
-	if (fence_->GetCompletedValue() < fenceValue_) {
-		// FenceのSignalを待つためのイベントを作成する
-		HANDLE fenceEvent = CreateEvent(NULL, FALSE, FALSE, NULL);
+	if (fence_->GetCompletedValue() < fenceValue) {
 		// 指定したSignalにたどり着いていないので、たどり着くまで待つようにイベントを設定する
-		fence_->SetEventOnCompletion(fenceValue_, fenceEvent);
+		fence_->SetEventOnCompletion(fenceValue, fenceEvent_);
 		// イベントを待つ
-		WaitForSingleObject(fenceEvent, INFINITE);
+		WaitForSingleObject(fenceEvent_, INFINITE);
 	}
 }
 
+uint64_t Fence::GetCompletedValue() const {
+	return fence_->GetCompletedValue();
+}
+
 void Fence::CreateFence() {
 	// 初期値0でフェンスを作る
 	hr_ = dxgi_->GetDevice()->CreateFence(fenceValue_, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&fence_));
 	assert(SUCCEEDED(hr_));
+
+	// FenceのSignalを待つためのイベントを作成する
+	fenceEvent_ = CreateEvent(NULL, FALSE, FALSE, NULL);
+	assert(fenceEvent_ != nullptr);
 }
 
 void Fence::SetDXGI(DXGI* dxgi) {
@@ -22,6 +22,12 @@ public:
 	void Initialize(DXGI* dxgi, DirectXCommand* directXCommand);
 	// GPUを待機
 	void WaitGPU();
+	// キューにシグナルを積み、そのフェンス値を返す
+	uint64_t Signal();
+	// 指定したフェンス値にGPUがたどり着くまで待つ
+	void WaitForValue(uint64_t fenceValue);
+	// GPUがたどり着いたフェンス値
+	uint64_t GetCompletedValue()const;
 private:
 	// フェンス作成
 	void CreateFence();
@@ -35,6 +41,8 @@ private:
 	ComPtr<ID3D12Fence> fence_ = nullptr;
 	// フェンスバリュー
 	UINT64 fenceValue_ = 0;
+	// 待機用のイベント(毎回作らずに使い回す)
+	HANDLE fenceEvent_ = nullptr;
 	// エラー判別君
 	HRESULT hr_ = S_FALSE;
 private:
@@ -0,0 +1,59 @@
+#include "FrameRing.h"
+
+// C++
+#include <cassert>
+
+FrameRing::FrameRing(uint32_t frameCount, SignalFunction signal, WaitFunction wait) {
+	assert(frameCount > 0);
+	assert(signal);
+	assert(wait);
+	fenceValues_.assign(frameCount, 0);
+	signal_ = std::move(signal);
+	wait_ = std::move(wait);
+}
+
+FrameRing::~FrameRing() {
+
+}
+
+void FrameRing::EndFrame() {
+	// このフレームのコマンドが終わったときのフェンス値を覚えておく
+	const uint64_t fenceValue = signal_();
+	assert(fenceValue > lastFenceValue_ && "Fence value must increase");
+	fenceValues_[frameIndex_] = fenceValue;
+	lastFenceValue_ = fenceValue;
+
+	// 次のスロットへ進み、そのスロットを前に使ったフレームの完了だけを待つ
+	frameIndex_ = (frameIndex_ + 1) % static_cast<uint32_t>(fenceValues_.size());
+	Wait(fenceValues_[frameIndex_]);
+}
+
+void FrameRing::WaitIdle() {
+	Wait(lastFenceValue_);
+}
+
+uint32_t FrameRing::GetFrameIndex() const {
+	return frameIndex_;
+}
+
+uint32_t FrameRing::GetFrameCount() const {
+	return static_cast<uint32_t>(fenceValues_.size());
+}
+
+uint64_t FrameRing::GetFenceValue(uint32_t frameIndex) const {
+	assert(frameIndex < fenceValues_.size());
+	return fenceValues_[frameIndex];
+}
+
+uint32_t FrameRing::GetWaitCount() const {
+	return waitCount_;
+}
+
+void FrameRing::Wait(uint64_t fenceValue) {
+	// まだ一度も送っていないスロットは待たない
+	if (fenceValue == 0) {
+		return;
+	}
+	wait_(fenceValue);
+	waitCount_++;
+}
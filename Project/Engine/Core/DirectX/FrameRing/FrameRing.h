@@ -0,0 +1,53 @@
+#pragma once
+
+// C++
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/// <summary>
+/// フレームごとのスロットとフェンス値の管理
+/// 送信したフレームのフェンス値をスロットに覚えておき、そのスロットを使い直す前にだけ待つ
+/// GPUには触らないのでシグナル関数と待機関数を差し替えれば単体で動かせる
+/// </summary>
+class FrameRing {
+public:
+	// キューにシグナルを積み、そのフェンス値を返す関数
+	using SignalFunction = std::function<uint64_t()>;
+	// 指定したフェンス値にGPUがたどり着くまで待つ関数
+	using WaitFunction = std::function<void(uint64_t)>;
+
+	FrameRing(uint32_t frameCount, SignalFunction signal, WaitFunction wait);
+	~FrameRing();
+
+	// フレームのコマンドを送った後に呼ぶ
+	// フェンス値を今のスロットに記録して次のスロットへ進み、そのスロットを前に使ったフレームの完了を待つ
+	void EndFrame();
+	// 送ったフレームがすべて終わるまで待つ(使用中のリソースを解放する前など)
+	void WaitIdle();
+
+	// 今のスロット番号
+	uint32_t GetFrameIndex()const;
+	// スロットの数
+	uint32_t GetFrameCount()const;
+	// スロットを最後に送ったときのフェンス値(まだ送っていなければ0)
+	uint64_t GetFenceValue(uint32_t frameIndex)const;
+	// これまでに待った回数
+	uint32_t GetWaitCount()const;
+private:
+	// 待つ必要があれば待つ
+	void Wait(uint64_t fenceValue);
+private:
+	// スロットごとのフェンス値
+	std::vector<uint64_t> fenceValues_;
+	// 今のスロット番号
+	uint32_t frameIndex_ = 0;
+	// 最後に送ったフェンス値
+	uint64_t lastFenceValue_ = 0;
+	// 待った回数
+	uint32_t waitCount_ = 0;
+	// シグナル関数
+	SignalFunction signal_;
+	// 待機関数
+	WaitFunction wait_;
+};
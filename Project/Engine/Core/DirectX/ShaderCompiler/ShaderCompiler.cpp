@@ -12,7 +12,7 @@ ShaderCompiler::~ShaderCompiler() {
 	Logger::Log("ShaderCompiler Finalize\n");
 }
 
-ComPtr<ID3DBlob> ShaderCompiler::CompileShader(const std::wstring& filePath, const wchar_t* profile) {
+ComPtr<ID3DBlob> ShaderCompiler::CompileShader(const std::wstring& filePath, const wchar_t* profile, const std::vector<std::wstring>& defines) {
 	// ログ出力
 	Logger::Log(Logger::ConvertString(std::format(L"Begin CompileShader, path:{}, profile:{}\n", filePath, profile)));
 
@@ -36,6 +36,10 @@ ComPtr<ID3DBlob> ShaderCompiler::CompileShader(const std::wstring& filePath, con
 		L"-Zpr",                        // 行優先メモリレイアウト
 		L"-D", L"USE_BINDLESS_TEXTURE", // 必要に応じて define 追加
 	};
+	for (const std::wstring& define : defines) {
+		arguments.push_back(L"-D");
+		arguments.push_back(define.c_str());
+	}
 
 	// 実際のコンパイル処理
 	ComPtr<IDxcResult> shaderResult = nullptr;
@@ -17,8 +17,8 @@ public:
 	ShaderCompiler();
 	~ShaderCompiler();
 
-	// シェーダーコンパイル関数
-	ComPtr<ID3DBlob> CompileShader(const std::wstring& filePath, const wchar_t* profile);
+	// シェーダーコンパイル関数(definesでシェーダーの組み合わせを切り替える)
+	ComPtr<ID3DBlob> CompileShader(const std::wstring& filePath, const wchar_t* profile, const std::vector<std::wstring>& defines = {});
 
 private:
 	// DXC初期化
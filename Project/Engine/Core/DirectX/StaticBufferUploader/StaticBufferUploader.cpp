@@ -0,0 +1,100 @@
+#include "StaticBufferUploader.h"
+
+// C++
+#include <cassert>
+#include <cstring>
+
+// MyHedder
+#include "Logger/Logger.h"
+#include "DirectX/DXGI/DXGI.h"
+#include "DirectX/DirectXCommand/DirectXCommand.h"
+#include "DirectX/Fence/Fence.h"
+#include "Const/BufferConst.h"
+
+namespace {
+	// リング内でのコピー元の揃え
+	constexpr uint64_t kStagingAlignment = 16;
+}
+
+StaticBufferUploader::StaticBufferUploader(DXGI* dxgi, DirectXCommand* directXCommand, Fence* fence) {
+	Initialize(dxgi, directXCommand, fence);
+	Logger::Log("StaticBufferUploader Initialize\n");
+}
+
+StaticBufferUploader::~StaticBufferUploader() {
+	// コマンドとフェンスより先に破棄されるので、残った転送はここで送る
+	Flush();
+	Logger::Log("StaticBufferUploader Finalize\n");
+}
+
+void StaticBufferUploader::Initialize(DXGI* dxgi, DirectXCommand* directXCommand, Fence* fence) {
+	// 必要なインスタンスのポインタ
+	SetDXGI(dxgi);
+	SetDirectXCommand(directXCommand);
+	SetFence(fence);
+
+	// アップロード用リングバッファを作成して書き込み先を開いたままにする
+	uploadRingResource_ = dxgi_->CreateBufferResource(BufferConst::StagingRingSize);
+	uploadRingResource_->Map(0, nullptr, reinterpret_cast<void**>(&uploadRingData_));
+	uploadBatcher_ = std::make_unique<UploadBatcher>(BufferConst::StagingRingSize, [this]() {
+		SubmitUploads();
+		});
+}
+
+BufferRegion StaticBufferUploader::Upload(const void* data, uint64_t sizeInBytes, uint64_t alignment) {
+	assert(data && sizeInBytes > 0);
+	BufferRegion region = dxgi_->AllocateDefaultBuffer(sizeInBytes, alignment);
+
+	if (sizeInBytes <= uploadBatcher_->GetCapacity()) {
+		// リングの空き領域に書き込む(空きがなければここで一度送信される)
+		const uint64_t offset = uploadBatcher_->Allocate(sizeInBytes, kStagingAlignment);
+		std::memcpy(uploadRingData_ + offset, data, sizeInBytes);
+		directXCommand_->GetList()->CopyBufferRegion(region.resource, region.allocation.offset, uploadRingResource_.Get(), offset, sizeInBytes);
+	} else {
+		// リングに収まらないものは専用の中間リソースを作る
+		ComPtr<ID3D12Resource> intermediateResource = dxgi_->CreateBufferResource(sizeInBytes);
+		void* mappedData = nullptr;
+		intermediateResource->Map(0, nullptr, &mappedData);
+		std::memcpy(mappedData, data, sizeInBytes);
+		intermediateResource->Unmap(0, nullptr);
+		directXCommand_->GetList()->CopyBufferRegion(region.resource, region.allocation.offset, intermediateResource.Get(), 0, sizeInBytes);
+		externalUploadResources_.push_back(intermediateResource);
+		uploadBatcher_->AddExternalUpload();
+	}
+
+	// デフォルトバッファはCOMMONからの暗黙の遷移で読めるのでバリアは張らない
+	return region;
+}
+
+void StaticBufferUploader::Free(const BufferRegion& region) {
+	dxgi_->FreeDefaultBuffer(region);
+}
+
+void StaticBufferUploader::Flush() {
+	uploadBatcher_->Flush();
+}
+
+void StaticBufferUploader::SubmitUploads() {
+	// コマンドのクローズと実行
+	directXCommand_->KickCommand();
+	fence_->WaitGPU();
+	directXCommand_->ResetCommand();
+
+	// GPUが読み終わったので中間リソースを解放
+	externalUploadResources_.clear();
+}
+
+void StaticBufferUploader::SetDXGI(DXGI* dxgi) {
+	assert(dxgi);
+	dxgi_ = dxgi;
+}
+
+void StaticBufferUploader::SetDirectXCommand(DirectXCommand* directXCommand) {
+	assert(directXCommand);
+	directXCommand_ = directXCommand;
+}
+
+void StaticBufferUploader::SetFence(Fence* fence) {
+	assert(fence);
+	fence_ = fence;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+// C++
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// DirectX
+#include <d3d12.h>
+
+// MyHedder
+#include "DirectX/ComPtr/ComPtr.h"
+#include "DirectX/UploadBatcher/UploadBatcher.h"
+#include "Structs/BufferStruct.h"
+
+// 前方宣言
+class DXGI;
+class DirectXCommand;
+class Fence;
+
+/// <summary>
+/// 作ったあと書き換えないバッファをデフォルトヒープへ一度だけ転送する
+/// 共有のデフォルトバッファから領域を切り出し、アップロード用のリングを経由したコピーを積む
+/// 積んだコピーはFlushでまとめて送る(描画スレッドがコマンドを記録していないときに呼ぶ)
+/// </summary>
+class StaticBufferUploader {
+public:
+	StaticBufferUploader(DXGI* dxgi, DirectXCommand* directXCommand, Fence* fence);
+	~StaticBufferUploader();
+
+	// 初期化
+	void Initialize(DXGI* dxgi, DirectXCommand* directXCommand, Fence* fence);
+	// デフォルトヒープに領域を切り出してデータのコピーを積む
+	BufferRegion Upload(const void* data, uint64_t sizeInBytes, uint64_t alignment);
+	// 切り出した領域を返す(描画中のフレームが読み終わってから使い回す)
+	void Free(const BufferRegion& region);
+	// 積んだコピーがあればまとめて送って完了まで待つ
+	void Flush();
+
+private:
+	// 積んだコピーを送信して待つ
+	void SubmitUploads();
+
+	// DXGIのインスタンスをセット
+	void SetDXGI(DXGI* dxgi);
+	// DirectXCommandのインスタンスをセット
+	void SetDirectXCommand(DirectXCommand* directXCommand);
+	// Fenceのインスタンスをセット
+	void SetFence(Fence* fence);
+
+private:
+	// アップロード用リングバッファ
+	ComPtr<ID3D12Resource> uploadRingResource_ = nullptr;
+	// リングの書き込み先
+	uint8_t* uploadRingData_ = nullptr;
+	// リングの領域管理と転送のまとめ送り
+	std::unique_ptr<UploadBatcher> uploadBatcher_ = nullptr;
+	// リングに収まらないバッファ用の中間リソース(送信が終わるまで保持)
+	std::vector<ComPtr<ID3D12Resource>> externalUploadResources_;
+
+private:
+	// DXGI
+	DXGI* dxgi_ = nullptr;
+	// DirectXCommand
+	DirectXCommand* directXCommand_ = nullptr;
+	// Fence
+	Fence* fence_ = nullptr;
+};
@@ -0,0 +1,59 @@
+#include "UploadBatcher.h"
+
+// C++
+#include <cassert>
+
+UploadBatcher::UploadBatcher(uint64_t capacity, SubmitFunction submit) {
+	assert(capacity > 0);
+	assert(submit);
+	capacity_ = capacity;
+	submit_ = std::move(submit);
+}
+
+UploadBatcher::~UploadBatcher() {
+	// 送信関数が参照するコマンドが先に破棄されることがあるので、ここでは送らない
+	assert(pendingUploadCount_ == 0 && "UploadBatcher destroyed with pending uploads");
+}
+
+uint64_t UploadBatcher::Allocate(uint64_t sizeInBytes, uint64_t alignment) {
+	assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+	assert(sizeInBytes <= capacity_ && "Upload is larger than the ring. Use AddExternalUpload instead");
+
+	uint64_t offset = (head_ + alignment - 1) & ~(alignment - 1);
+	if (offset + sizeInBytes > capacity_) {
+		// 空きが足りないので積んだ分を送って先頭から使い直す
+		Flush();
+		offset = 0;
+	}
+
+	head_ = offset + sizeInBytes;
+	pendingUploadCount_++;
+	return offset;
+}
+
+void UploadBatcher::AddExternalUpload() {
+	pendingUploadCount_++;
+}
+
+void UploadBatcher::Flush() {
+	if (pendingUploadCount_ == 0) {
+		return;
+	}
+	// 積んだ転送をまとめて送り、一度だけ待つ
+	submit_();
+	submitCount_++;
+	pendingUploadCount_ = 0;
+	head_ = 0;
+}
+
+uint64_t UploadBatcher::GetCapacity() const {
+	return capacity_;
+}
+
+uint32_t UploadBatcher::GetPendingUploadCount() const {
+	return pendingUploadCount_;
+}
+
+uint32_t UploadBatcher::GetSubmitCount() const {
+	return submitCount_;
+}
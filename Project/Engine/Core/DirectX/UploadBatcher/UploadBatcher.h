@@ -0,0 +1,45 @@
+#pragma once
+
+// C++
+#include <cstdint>
+#include <functional>
+
+/// <summary>
+/// アップロード用リングバッファの領域管理
+/// 積んだ転送は送信関数(Kick + フェンス待ち + Reset)でまとめてGPUへ送る
+/// GPUには触らないので送信関数を差し替えれば単体で動かせる
+/// </summary>
+class UploadBatcher {
+public:
+	// 積んだ転送をGPUへ送り、完了まで待つ関数
+	using SubmitFunction = std::function<void()>;
+
+	UploadBatcher(uint64_t capacity, SubmitFunction submit);
+	~UploadBatcher();
+
+	// 領域を確保してリング先頭からのオフセットを返す
+	// 空きが足りなければ積んだ分を送信してから先頭に戻る
+	uint64_t Allocate(uint64_t sizeInBytes, uint64_t alignment);
+	// リングを使わない転送(容量を超えるもの)を積んだことを記録する
+	void AddExternalUpload();
+	// 積んだ転送があれば一度だけ送信してリングを空にする
+	void Flush();
+
+	// リングの容量
+	uint64_t GetCapacity()const;
+	// 送信待ちの転送数
+	uint32_t GetPendingUploadCount()const;
+	// これまでに送信した回数
+	uint32_t GetSubmitCount()const;
+private:
+	// リングの容量
+	uint64_t capacity_ = 0;
+	// 次に確保する位置
+	uint64_t head_ = 0;
+	// 送信待ちの転送数
+	uint32_t pendingUploadCount_ = 0;
+	// 送信した回数
+	uint32_t submitCount_ = 0;
+	// 送信関数
+	SubmitFunction submit_;
+};
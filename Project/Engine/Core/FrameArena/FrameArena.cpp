@@ -0,0 +1,87 @@
+#include "FrameArena.h"
+
+// C++
+#include <algorithm>
+
+FrameArena::FrameArena(size_t blockSize, uint32_t bufferCount) {
+	assert(blockSize > 0);
+	assert(bufferCount > 0);
+	blockSize_ = blockSize;
+	buffers_.resize(bufferCount);
+	for (Buffer& buffer : buffers_) {
+		AddBlock(buffer, blockSize_);
+	}
+}
+
+FrameArena::~FrameArena() {
+
+}
+
+void* FrameArena::Allocate(size_t size, size_t alignment) {
+	assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+	Buffer& buffer = buffers_[bufferIndex_];
+
+	while (true) {
+		Block& block = buffer.blocks[buffer.blockIndex];
+		const uintptr_t base = reinterpret_cast<uintptr_t>(block.memory.get());
+		const uintptr_t aligned = (base + buffer.offset + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+		const size_t begin = static_cast<size_t>(aligned - base);
+		if (begin + size <= block.size) {
+			buffer.offset = begin + size;
+			return block.memory.get() + begin;
+		}
+
+		// 入らなければ次のブロックへ(なければ足す)
+		buffer.usedBytes += buffer.offset;
+		buffer.blockIndex++;
+		buffer.offset = 0;
+		if (buffer.blockIndex == buffer.blocks.size()) {
+			AddBlock(buffer, (std::max)(blockSize_, size + alignment));
+		}
+	}
+}
+
+void FrameArena::EndFrame() {
+	bufferIndex_ = (bufferIndex_ + 1) % static_cast<uint32_t>(buffers_.size());
+
+	// 次に使うバッファを読んでいたフレームは終わっているので巻き戻す
+	Buffer& buffer = buffers_[bufferIndex_];
+	if (buffer.blocks.size() > 1) {
+		// 足したブロックはひとつにまとめ、次からは切り替えずに済むようにする
+		size_t totalSize = 0;
+		for (const Block& block : buffer.blocks) {
+			totalSize += block.size;
+		}
+		buffer.blocks.clear();
+		AddBlock(buffer, totalSize);
+	}
+	buffer.blockIndex = 0;
+	buffer.offset = 0;
+	buffer.usedBytes = 0;
+}
+
+size_t FrameArena::GetUsedBytes()const {
+	const Buffer& buffer = buffers_[bufferIndex_];
+	return buffer.usedBytes + buffer.offset;
+}
+
+size_t FrameArena::GetReservedBytes()const {
+	size_t reservedBytes = 0;
+	for (const Buffer& buffer : buffers_) {
+		for (const Block& block : buffer.blocks) {
+			reservedBytes += block.size;
+		}
+	}
+	return reservedBytes;
+}
+
+uint32_t FrameArena::GetBufferIndex()const {
+	return bufferIndex_;
+}
+
+void FrameArena::AddBlock(Buffer& buffer, size_t size) {
+	buffer.blocks.push_back(Block{
+		.memory = std::make_unique<std::byte[]>(size),
+		.size = size,
+		});
+}
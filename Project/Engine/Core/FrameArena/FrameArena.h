@@ -0,0 +1,99 @@
+#pragma once
+
+// C++
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+/// <summary>
+/// フレーム単位の一時メモリ(線形に切り出すだけで個別には解放しない)
+/// EndFrameで次のバッファへ切り替えて巻き戻すので、確保したメモリはバッファの数のフレームだけ使える
+/// メインスレッドからのみ確保する。GPUには触らないので単体で動かせる
+/// </summary>
+class FrameArena {
+public:
+	FrameArena(size_t blockSize, uint32_t bufferCount);
+	~FrameArena();
+
+	// 確保(足りなければブロックを足す)
+	[[nodiscard]] void* Allocate(size_t size, size_t alignment);
+	// フレーム終了。次のバッファへ切り替えて巻き戻す
+	void EndFrame();
+
+	// 今のバッファで切り出したサイズ
+	[[nodiscard]] size_t GetUsedBytes()const;
+	// すべてのバッファで確保しているサイズ
+	[[nodiscard]] size_t GetReservedBytes()const;
+	// 今のバッファ番号
+	[[nodiscard]] uint32_t GetBufferIndex()const;
+
+private:
+	// 確保済みのメモリ
+	struct Block {
+		std::unique_ptr<std::byte[]> memory;
+		size_t size = 0;
+	};
+	// フレームごとのバッファ
+	struct Buffer {
+		std::vector<Block> blocks;
+		// 切り出し中のブロック
+		size_t blockIndex = 0;
+		// ブロック内の位置
+		size_t offset = 0;
+		// 前のブロックまでで切り出したサイズ
+		size_t usedBytes = 0;
+	};
+
+	// ブロックを足す
+	static void AddBlock(Buffer& buffer, size_t size);
+
+private:
+	// ブロックの基本サイズ
+	size_t blockSize_ = 0;
+	// バッファ
+	std::vector<Buffer> buffers_;
+	// 今のバッファ番号
+	uint32_t bufferIndex_ = 0;
+};
+
+/// <summary>
+/// FrameArenaから確保するSTL用のアロケータ(deallocateでは何もしない)
+/// </summary>
+template<typename T>
+class FrameArenaAllocator {
+public:
+	using value_type = T;
+	using propagate_on_container_copy_assignment = std::true_type;
+	using propagate_on_container_move_assignment = std::true_type;
+	using propagate_on_container_swap = std::true_type;
+
+	FrameArenaAllocator() = default;
+	explicit FrameArenaAllocator(FrameArena* arena) : arena_(arena) {}
+	template<typename U>
+	FrameArenaAllocator(const FrameArenaAllocator<U>& other) : arena_(other.GetArena()) {}
+
+	[[nodiscard]] T* allocate(size_t count) {
+		assert(arena_ && "FrameArena is not set");
+		return static_cast<T*>(arena_->Allocate(sizeof(T) * count, alignof(T)));
+	}
+	void deallocate(T*, size_t) {}
+
+	FrameArena* GetArena()const {
+		return arena_;
+	}
+
+	template<typename U>
+	bool operator==(const FrameArenaAllocator<U>& other)const {
+		return arena_ == other.GetArena();
+	}
+
+private:
+	FrameArena* arena_ = nullptr;
+};
+
+// フレーム単位の一時メモリを使う配列
+template<typename T>
+using FrameVector = std::vector<T, FrameArenaAllocator<T>>;
@@ -0,0 +1,76 @@
+#include "RenderThread.h"
+
+// C++
+#include <cassert>
+
+RenderThread::RenderThread() {
+	thread_ = std::thread([this]() { ThreadMain(); });
+}
+
+RenderThread::~RenderThread() {
+	// 実行中の処理を終えてからスレッドを止める
+	Wait();
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		isEndRequest_ = true;
+	}
+	condition_.notify_all();
+	if (thread_.joinable()) {
+		thread_.join();
+	}
+}
+
+void RenderThread::Kick(RenderFunction function) {
+	assert(function);
+	std::unique_lock<std::mutex> lock(mutex_);
+	// 処理は一度にひとつだけ
+	condition_.wait(lock, [this]() { return !isBusy_; });
+	function_ = std::move(function);
+	isBusy_ = true;
+	kickCount_++;
+	lock.unlock();
+	condition_.notify_all();
+}
+
+void RenderThread::Wait() {
+	// 描画スレッドから待つと終わらなくなる
+	if (std::this_thread::get_id() == thread_.get_id()) {
+		return;
+	}
+	std::unique_lock<std::mutex> lock(mutex_);
+	condition_.wait(lock, [this]() { return !isBusy_; });
+}
+
+bool RenderThread::IsBusy() {
+	std::lock_guard<std::mutex> lock(mutex_);
+	return isBusy_;
+}
+
+uint64_t RenderThread::GetKickCount() {
+	std::lock_guard<std::mutex> lock(mutex_);
+	return kickCount_;
+}
+
+void RenderThread::ThreadMain() {
+	while (true) {
+		RenderFunction function;
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			condition_.wait(lock, [this]() { return function_ || isEndRequest_; });
+			if (!function_) {
+				return;
+			}
+			function = std::move(function_);
+			function_ = nullptr;
+		}
+
+		// ロックの外で実行する
+		function();
+
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			isBusy_ = false;
+		}
+		condition_.notify_all();
+	}
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+// C++
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+/// <summary>
+/// 描画コマンドの記録と提出を行うスレッド
+/// Kickで渡した処理を一度にひとつだけ実行する。メインスレッドはその間に次のフレームを更新できる
+/// GPUには触らないので処理を差し替えれば単体で動かせる
+/// </summary>
+class RenderThread {
+public:
+	// 描画スレッドで実行する処理
+	using RenderFunction = std::function<void()>;
+
+	RenderThread();
+	~RenderThread();
+
+	// 処理を渡して実行を始める(前の処理が終わっていなければ終わるまで待つ)
+	void Kick(RenderFunction function);
+	// 渡した処理が終わるまで待つ(描画スレッド自身から呼んだときは待たない)
+	void Wait();
+	// 処理の実行中か
+	[[nodiscard]] bool IsBusy();
+	// これまでに実行した処理の数
+	[[nodiscard]] uint64_t GetKickCount();
+
+private:
+	// スレッドの本体
+	void ThreadMain();
+
+private:
+	std::thread thread_;
+	std::mutex mutex_;
+	// 処理が渡されたときと終わったときに通知する
+	std::condition_variable condition_;
+	// 実行待ちの処理
+	RenderFunction function_;
+	// 処理の実行中か(渡されてから終わるまで)
+	bool isBusy_ = false;
+	// スレッドの終了リクエスト
+	bool isEndRequest_ = false;
+	// 実行した処理の数
+	uint64_t kickCount_ = 0;
+};
@@ -0,0 +1,268 @@
+#include "TLSFAllocator.h"
+
+// C++
+#include <bit>
+#include <cassert>
+#include <numeric>
+
+namespace {
+	// alignmentの倍数に切り上げる
+	uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+		return (value + alignment - 1) / alignment * alignment;
+	}
+
+	// 単位の倍数になるアライメントにする
+	uint64_t ToBlockAlignment(uint64_t alignment) {
+		return std::lcm((std::max)(alignment, uint64_t(1)), TLSFAllocator::kGranularity);
+	}
+}
+
+TLSFAllocator::TLSFAllocator(uint64_t size) {
+	assert(size >= kGranularity);
+	// 端数は使わない
+	size_ = size / kGranularity * kGranularity;
+
+	for (auto& heads : freeHeads_) {
+		heads.fill(kNull);
+	}
+
+	// 最初は全体がひとつの空きブロック
+	InsertFreeBlock(CreateBlock(0, size_));
+}
+
+TLSFAllocator::~TLSFAllocator() {
+
+}
+
+uint64_t TLSFAllocator::Allocate(uint64_t size, uint64_t alignment) {
+	assert(size > 0);
+	const uint64_t blockSize = AlignUp(size, kGranularity);
+	const uint64_t blockAlignment = ToBlockAlignment(alignment);
+
+	// ずれを合わせても足りるブロックを探す
+	const uint32_t blockIndex = FindFreeBlock(blockSize + blockAlignment - kGranularity);
+	if (blockIndex == kNull) {
+		return kInvalidOffset;
+	}
+	RemoveFreeBlock(blockIndex);
+
+	// 前のずれは空きブロックとして切り離す(前は使用中なのでつなげるものはない)
+	const uint64_t alignedOffset = AlignUp(blocks_[blockIndex].offset, blockAlignment);
+	const uint64_t padding = alignedOffset - blocks_[blockIndex].offset;
+	if (padding > 0) {
+		const uint32_t paddingIndex = CreateBlock(blocks_[blockIndex].offset, padding);
+		blocks_[blockIndex].offset = alignedOffset;
+		blocks_[blockIndex].size -= padding;
+		LinkPhysicalBefore(blockIndex, paddingIndex);
+		InsertFreeBlock(paddingIndex);
+	}
+
+	// 後ろの余りも空きブロックとして切り離す
+	assert(blocks_[blockIndex].size >= blockSize);
+	const uint64_t remain = blocks_[blockIndex].size - blockSize;
+	if (remain > 0) {
+		const uint32_t remainIndex = CreateBlock(alignedOffset + blockSize, remain);
+		blocks_[blockIndex].size = blockSize;
+		LinkPhysicalAfter(blockIndex, remainIndex);
+		InsertFreeBlock(remainIndex);
+	}
+
+	blocks_[blockIndex].isFree = false;
+	allocatedBlocks_.emplace(alignedOffset, blockIndex);
+	usedSize_ += blockSize;
+	return alignedOffset;
+}
+
+void TLSFAllocator::Free(uint64_t offset) {
+	auto it = allocatedBlocks_.find(offset);
+	assert(it != allocatedBlocks_.end() && "freed offset was not allocated");
+	uint32_t blockIndex = it->second;
+	allocatedBlocks_.erase(it);
+	usedSize_ -= blocks_[blockIndex].size;
+
+	// 後ろが空いていればつなげる
+	const uint32_t nextIndex = blocks_[blockIndex].nextPhysical;
+	if (nextIndex != kNull && blocks_[nextIndex].isFree) {
+		RemoveFreeBlock(nextIndex);
+		blocks_[blockIndex].size += blocks_[nextIndex].size;
+		UnlinkPhysical(nextIndex);
+		DestroyBlock(nextIndex);
+	}
+
+	// 前が空いていればそちらへつなげる
+	const uint32_t prevIndex = blocks_[blockIndex].prevPhysical;
+	if (prevIndex != kNull && blocks_[prevIndex].isFree) {
+		RemoveFreeBlock(prevIndex);
+		blocks_[prevIndex].size += blocks_[blockIndex].size;
+		UnlinkPhysical(blockIndex);
+		DestroyBlock(blockIndex);
+		blockIndex = prevIndex;
+	}
+
+	InsertFreeBlock(blockIndex);
+}
+
+uint64_t TLSFAllocator::GetRequiredSize(uint64_t size, uint64_t alignment) {
+	// 空きブロックの先頭は単位の倍数なので、ずれは最大でアライメントから単位ひとつ分を引いた分
+	const uint64_t requiredSize = AlignUp(size, kGranularity) + ToBlockAlignment(alignment) - kGranularity;
+	// 探すときと同じく二段目ひとつ分の幅に切り上げる
+	const uint64_t units = requiredSize / kGranularity;
+	if (units < kSecondLevelCount) {
+		return requiredSize;
+	}
+	const uint32_t msb = static_cast<uint32_t>(std::bit_width(units)) - 1;
+	return AlignUp(units, uint64_t(1) << (msb - kSecondLevelBits)) * kGranularity;
+}
+
+uint64_t TLSFAllocator::GetSize()const {
+	return size_;
+}
+
+uint64_t TLSFAllocator::GetUsedSize()const {
+	return usedSize_;
+}
+
+uint32_t TLSFAllocator::GetAllocationCount()const {
+	return static_cast<uint32_t>(allocatedBlocks_.size());
+}
+
+void TLSFAllocator::Mapping(uint64_t size, uint32_t& firstLevel, uint32_t& secondLevel) {
+	const uint64_t units = size / kGranularity;
+	if (units < kSecondLevelCount) {
+		// 小さいものは一段目0に単位数ごとに並べる
+		firstLevel = 0;
+		secondLevel = static_cast<uint32_t>(units);
+		return;
+	}
+	const uint32_t msb = static_cast<uint32_t>(std::bit_width(units)) - 1;
+	firstLevel = msb - kSecondLevelBits + 1;
+	secondLevel = static_cast<uint32_t>(units >> (msb - kSecondLevelBits)) - kSecondLevelCount;
+}
+
+void TLSFAllocator::MappingSearch(uint64_t size, uint32_t& firstLevel, uint32_t& secondLevel) {
+	uint64_t units = size / kGranularity;
+	if (units >= kSecondLevelCount) {
+		// 二段目ひとつ分の幅だけ切り上げると、見つかったリストのブロックはどれも足りる
+		const uint32_t msb = static_cast<uint32_t>(std::bit_width(units)) - 1;
+		units += (uint64_t(1) << (msb - kSecondLevelBits)) - 1;
+	}
+	Mapping(units * kGranularity, firstLevel, secondLevel);
+}
+
+uint32_t TLSFAllocator::FindFreeBlock(uint64_t size)const {
+	uint32_t firstLevel = 0;
+	uint32_t secondLevel = 0;
+	MappingSearch(size, firstLevel, secondLevel);
+	if (firstLevel >= kFirstLevelCount) {
+		return kNull;
+	}
+
+	// 同じ一段目で大きい方の二段目から探す
+	uint32_t secondLevelMap = secondLevelBitmaps_[firstLevel] & (~0u << secondLevel);
+	if (!secondLevelMap) {
+		// 大きい方の一段目から探す
+		const uint64_t firstLevelMap = firstLevel + 1 < 64 ? firstLevelBitmap_ & (~uint64_t(0) << (firstLevel + 1)) : 0;
+		if (!firstLevelMap) {
+			return kNull;
+		}
+		firstLevel = static_cast<uint32_t>(std::countr_zero(firstLevelMap));
+		secondLevelMap = secondLevelBitmaps_[firstLevel];
+	}
+	secondLevel = static_cast<uint32_t>(std::countr_zero(secondLevelMap));
+	return freeHeads_[firstLevel][secondLevel];
+}
+
+void TLSFAllocator::InsertFreeBlock(uint32_t blockIndex) {
+	uint32_t firstLevel = 0;
+	uint32_t secondLevel = 0;
+	Mapping(blocks_[blockIndex].size, firstLevel, secondLevel);
+
+	Block& block = blocks_[blockIndex];
+	block.isFree = true;
+	block.prevFree = kNull;
+	block.nextFree = freeHeads_[firstLevel][secondLevel];
+	if (block.nextFree != kNull) {
+		blocks_[block.nextFree].prevFree = blockIndex;
+	}
+	freeHeads_[firstLevel][secondLevel] = blockIndex;
+	firstLevelBitmap_ |= uint64_t(1) << firstLevel;
+	secondLevelBitmaps_[firstLevel] |= 1u << secondLevel;
+}
+
+void TLSFAllocator::RemoveFreeBlock(uint32_t blockIndex) {
+	uint32_t firstLevel = 0;
+	uint32_t secondLevel = 0;
+	Mapping(blocks_[blockIndex].size, firstLevel, secondLevel);
+
+	Block& block = blocks_[blockIndex];
+	assert(block.isFree);
+	if (block.prevFree != kNull) {
+		blocks_[block.prevFree].nextFree = block.nextFree;
+	} else {
+		freeHeads_[firstLevel][secondLevel] = block.nextFree;
+	}
+	if (block.nextFree != kNull) {
+		blocks_[block.nextFree].prevFree = block.prevFree;
+	}
+	block.prevFree = kNull;
+	block.nextFree = kNull;
+	block.isFree = false;
+
+	// リストが空になったらビットを下ろす
+	if (freeHeads_[firstLevel][secondLevel] == kNull) {
+		secondLevelBitmaps_[firstLevel] &= ~(1u << secondLevel);
+		if (!secondLevelBitmaps_[firstLevel]) {
+			firstLevelBitmap_ &= ~(uint64_t(1) << firstLevel);
+		}
+	}
+}
+
+uint32_t TLSFAllocator::CreateBlock(uint64_t offset, uint64_t size) {
+	uint32_t blockIndex = 0;
+	if (!unusedBlocks_.empty()) {
+		blockIndex = unusedBlocks_.back();
+		unusedBlocks_.pop_back();
+	} else {
+		blockIndex = static_cast<uint32_t>(blocks_.size());
+		blocks_.emplace_back();
+	}
+	blocks_[blockIndex] = Block{
+		.offset = offset,
+		.size = size,
+	};
+	return blockIndex;
+}
+
+void TLSFAllocator::DestroyBlock(uint32_t blockIndex) {
+	unusedBlocks_.push_back(blockIndex);
+}
+
+void TLSFAllocator::LinkPhysicalBefore(uint32_t blockIndex, uint32_t newIndex) {
+	const uint32_t prevIndex = blocks_[blockIndex].prevPhysical;
+	blocks_[newIndex].prevPhysical = prevIndex;
+	blocks_[newIndex].nextPhysical = blockIndex;
+	blocks_[blockIndex].prevPhysical = newIndex;
+	if (prevIndex != kNull) {
+		blocks_[prevIndex].nextPhysical = newIndex;
+	}
+}
+
+void TLSFAllocator::LinkPhysicalAfter(uint32_t blockIndex, uint32_t newIndex) {
+	const uint32_t nextIndex = blocks_[blockIndex].nextPhysical;
+	blocks_[newIndex].prevPhysical = blockIndex;
+	blocks_[newIndex].nextPhysical = nextIndex;
+	blocks_[blockIndex].nextPhysical = newIndex;
+	if (nextIndex != kNull) {
+		blocks_[nextIndex].prevPhysical = newIndex;
+	}
+}
+
+void TLSFAllocator::UnlinkPhysical(uint32_t blockIndex) {
+	const Block& block = blocks_[blockIndex];
+	if (block.prevPhysical != kNull) {
+		blocks_[block.prevPhysical].nextPhysical = block.nextPhysical;
+	}
+	if (block.nextPhysical != kNull) {
+		blocks_[block.nextPhysical].prevPhysical = block.prevPhysical;
+	}
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+// C++
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/// <summary>
+/// ひとつの領域[0, size)をTLSF(二段の空きリスト)で切り分ける
+/// 空きブロックは大きさの2のべき(一段目)とそれを16等分した範囲(二段目)ごとのリストに入れ、ビット演算で定数時間で探す
+/// 解放したブロックは隣の空きブロックとすぐにつなげる
+/// GPUには触らないので単体で動かせる
+/// </summary>
+class TLSFAllocator {
+public:
+	// 確保できなかったときのオフセット
+	static constexpr uint64_t kInvalidOffset = UINT64_MAX;
+	// 切り出す単位(オフセットと大きさは必ずこの倍数になる)
+	static constexpr uint64_t kGranularity = 16;
+
+	explicit TLSFAllocator(uint64_t size);
+	~TLSFAllocator();
+
+	// 領域を確保してオフセットを返す(alignmentは1以上の任意の値、空きがなければkInvalidOffset)
+	[[nodiscard]] uint64_t Allocate(uint64_t size, uint64_t alignment);
+	// Allocateで返したオフセットの領域を解放する
+	void Free(uint64_t offset);
+
+	// 空の領域から確保するのに必要な大きさ(ずれを合わせる分も含む)
+	[[nodiscard]] static uint64_t GetRequiredSize(uint64_t size, uint64_t alignment);
+
+	// 領域全体の大きさ
+	[[nodiscard]] uint64_t GetSize()const;
+	// 使用中の大きさ
+	[[nodiscard]] uint64_t GetUsedSize()const;
+	// 使用中のブロックの数
+	[[nodiscard]] uint32_t GetAllocationCount()const;
+
+private:
+	// 二段目の分割数のビット数
+	static constexpr uint32_t kSecondLevelBits = 4;
+	// 二段目の分割数
+	static constexpr uint32_t kSecondLevelCount = 1u << kSecondLevelBits;
+	// 一段目の数(単位数の最上位ビットから二段目の分を引いた分)
+	static constexpr uint32_t kFirstLevelCount = 64 - kSecondLevelBits;
+	// つながっていないことを表す番号
+	static constexpr uint32_t kNull = UINT32_MAX;
+
+	/// <summary>
+	/// 切り分けたひとつの区間
+	/// </summary>
+	struct Block {
+		uint64_t offset = 0;
+		uint64_t size = 0;
+		// 領域内で前後に並ぶブロック
+		uint32_t prevPhysical = kNull;
+		uint32_t nextPhysical = kNull;
+		// 同じ空きリストの前後
+		uint32_t prevFree = kNull;
+		uint32_t nextFree = kNull;
+		bool isFree = false;
+	};
+
+	// 大きさから入れる空きリストを求める
+	static void Mapping(uint64_t size, uint32_t& firstLevel, uint32_t& secondLevel);
+	// 大きさ以上のブロックだけが入っている空きリストを求める(切り上げてからMapping)
+	static void MappingSearch(uint64_t size, uint32_t& firstLevel, uint32_t& secondLevel);
+
+	// 大きさ以上の空きブロックを探す(なければkNull)
+	uint32_t FindFreeBlock(uint64_t size)const;
+	// 空きリストへ入れる
+	void InsertFreeBlock(uint32_t blockIndex);
+	// 空きリストから外す
+	void RemoveFreeBlock(uint32_t blockIndex);
+
+	// ブロックを作る(使っていない番号を使い回す)
+	uint32_t CreateBlock(uint64_t offset, uint64_t size);
+	// ブロックの番号を使い回せるように返す
+	void DestroyBlock(uint32_t blockIndex);
+	// blockIndexの前にnewIndexをつなげる
+	void LinkPhysicalBefore(uint32_t blockIndex, uint32_t newIndex);
+	// blockIndexの後ろにnewIndexをつなげる
+	void LinkPhysicalAfter(uint32_t blockIndex, uint32_t newIndex);
+	// 領域の並びから外す
+	void UnlinkPhysical(uint32_t blockIndex);
+
+private:
+	// 領域全体の大きさ
+	uint64_t size_ = 0;
+	// 使用中の大きさ
+	uint64_t usedSize_ = 0;
+
+	// ブロック(番号でつなぐ)
+	std::vector<Block> blocks_;
+	// 使っていないブロックの番号
+	std::vector<uint32_t> unusedBlocks_;
+	// 使用中のブロックのオフセットと番号
+	std::unordered_map<uint64_t, uint32_t> allocatedBlocks_;
+
+	// 空きリストがある一段目のビット
+	uint64_t firstLevelBitmap_ = 0;
+	// 一段目ごとの空きリストがある二段目のビット
+	std::array<uint32_t, kFirstLevelCount> secondLevelBitmaps_{};
+	// 空きリストの先頭
+	std::array<std::array<uint32_t, kSecondLevelCount>, kFirstLevelCount> freeHeads_{};
+};
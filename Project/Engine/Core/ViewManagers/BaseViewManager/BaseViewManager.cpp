@@ -4,23 +4,52 @@
 
 #include "DirectX/DXGI/DXGI.h"
 #include "DirectX/DirectXCommand/DirectXCommand.h"
+#include "Const/FrameConst.h"
+#include "MAGIAssert/MAGIAssert.h"
 
 BaseViewManager::BaseViewManager(DXGI* dxgi) {
 	// DXGIのセット
 	SetDXGI(dxgi);
 }
 
-void BaseViewManager::Initialize(const uint32_t& maxViewCount) {
+void BaseViewManager::Initialize(const uint32_t& maxViewCount, uint32_t transientViewCount) {
 	// ディスクリプタヒープ作成
 	CreateDescriptorHeap();
 	// ビューの最大数を設定
 	maxViewCount_ = maxViewCount;
+
+	// 一時用は今のフレームとGPUが読んでいるかもしれないフレームの分だけ後ろに取り、残りを常駐用にする
+	const uint32_t transientTotalCount = transientViewCount * (FrameConst::FrameCount + 1);
+	assert(transientTotalCount < maxViewCount_);
+	allocator_ = std::make_unique<DescriptorAllocator>(maxViewCount_ - transientTotalCount, transientViewCount, FrameConst::FrameCount);
+	assert(allocator_->GetTotalCount() == maxViewCount_);
 }
 
 uint32_t BaseViewManager::Allocate() {
-	uint32_t index = useIndex;
-	useIndex++;
-	return index;
+	return allocator_->Allocate();
+}
+
+void BaseViewManager::Free(uint32_t index) {
+	allocator_->Free(index);
+}
+
+uint32_t BaseViewManager::AllocateTransient(uint32_t count) {
+	const uint32_t index = allocator_->AllocateTransient(count);
+	if (index != DescriptorAllocator::kInvalidIndex) {
+		return index;
+	}
+
+	// 一時用が足りなければ常駐用から借りてすぐ解放する(使い回されるのはGPUが読み終わってから)
+	// 常駐用は連続した番号を確保できないので1つずつのときだけ
+	// リリースでも範囲外のビューを作らないように止める
+	MAGIAssert::Assert(count == 1 && allocator_->HasFreePersistent(), "Transient view count exceeded!");
+	const uint32_t fallbackIndex = allocator_->Allocate();
+	allocator_->Free(fallbackIndex);
+	return fallbackIndex;
+}
+
+void BaseViewManager::BeginFrame() {
+	allocator_->BeginFrame();
 }
 
 D3D12_CPU_DESCRIPTOR_HANDLE BaseViewManager::GetDescriptorHandleCPU(uint32_t index) {
@@ -44,7 +73,7 @@ uint32_t BaseViewManager::GetDescriptorSize() const {
 }
 
 bool BaseViewManager::IsLowerViewMax() const {
-	return useIndex < maxViewCount_;
+	return allocator_->HasFreePersistent();
 }
 
 void BaseViewManager::SetDXGI(DXGI* dxgi) {
@@ -2,12 +2,15 @@
 
 // C++
 #include <cstdint>
+#include <memory>
 
 // DirectX
 #include <d3d12.h>
 
 // ComPtr
 #include "DirectX/ComPtr/ComPtr.h"
+// MyHedder
+#include "DescriptorAllocator/DescriptorAllocator.h"
 
 // 前方宣言
 class DXGI;
@@ -17,10 +20,16 @@ public:
 	BaseViewManager(DXGI* dxgi);
 	virtual ~BaseViewManager() = default;
 
-	// 初期化
-	void Initialize(const uint32_t& maxViewCount);
+	// 初期化(transientViewCountはフレームごとの一時用の数。ヒープの後ろに区間の数だけ取る)
+	void Initialize(const uint32_t& maxViewCount, uint32_t transientViewCount = 0);
 	// 割り当て関数
 	uint32_t Allocate();
+	// 解放関数(描画中のフレームが読み終わってから使い回す)
+	void Free(uint32_t index);
+	// このフレームだけ使う連続したビューを割り当てて先頭を返す(一時用が足りなければ1つずつは常駐用から借りる)
+	uint32_t AllocateTransient(uint32_t count);
+	// フレーム開始(読み終わった解放済みのビューと一時用の区間を使い回せるようにする)
+	void BeginFrame();
 	// CPUの特定のインデックスハンドルを取得
 	D3D12_CPU_DESCRIPTOR_HANDLE GetDescriptorHandleCPU(uint32_t index);
 	// GPUの特定のインデックスハンドルを取得
@@ -42,8 +51,8 @@ protected:
 	ComPtr<ID3D12DescriptorHeap> descriptorHeap_ = nullptr;
 	// Discriptorのサイズ
 	uint32_t descriptorSize_ = 0u;
-	// 使用しているviewのインデックス
-	uint32_t useIndex = 0;
+	// ビューの番号の割り当て
+	std::unique_ptr<DescriptorAllocator> allocator_ = nullptr;
 	// Viewの最大数
 	uint32_t maxViewCount_ = 0;
 protected:
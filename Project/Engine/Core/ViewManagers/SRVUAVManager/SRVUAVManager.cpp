@@ -1,12 +1,14 @@
 #include "SRVUAVManager.h"
 
+#include <cassert>
+
 #include "DirectX/DXGI/DXGI.h"
 
 #include "Logger/Logger.h"
 
 SRVUAVManager::SRVUAVManager(DXGI* dxgi) :BaseViewManager(dxgi) {
 	// 基底クラスの初期化処理
-	BaseViewManager::Initialize(kMaxViewCount_);
+	BaseViewManager::Initialize(kMaxViewCount_, kTransientViewCount_);
 	Logger::Log("SRVUAVManager Initialize\n");
 }
 
@@ -42,24 +44,25 @@ void SRVUAVManager::CreateSrvTextureCubeMap(uint32_t viewIndex, ID3D12Resource*
 	dxgi_->GetDevice()->CreateShaderResourceView(pResource, &srvDesc, GetDescriptorHandleCPU(viewIndex));
 }
 
-void SRVUAVManager::CreateSrvStructuredBuffer(uint32_t viewIndex, ID3D12Resource* pResource, uint32_t numElements, UINT structureByteStride) {
+void SRVUAVManager::CreateSrvStructuredBuffer(uint32_t viewIndex, ID3D12Resource* pResource, uint32_t numElements, UINT structureByteStride, uint64_t firstElement) {
 	D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc{};
 	srvDesc.Format = DXGI_FORMAT_UNKNOWN;
 	srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
 	srvDesc.ViewDimension = D3D12_SRV_DIMENSION_BUFFER;
-	srvDesc.Buffer.FirstElement = 0;
+	srvDesc.Buffer.FirstElement = firstElement;
 	srvDesc.Buffer.Flags = D3D12_BUFFER_SRV_FLAG_NONE;
 	srvDesc.Buffer.NumElements = numElements;
 	srvDesc.Buffer.StructureByteStride = structureByteStride;
 	dxgi_->GetDevice()->CreateShaderResourceView(pResource, &srvDesc, GetDescriptorHandleCPU(viewIndex));
 }
 
-void SRVUAVManager::CreateSrvByteAddressBuffer(uint32_t viewIndex, ID3D12Resource* pResource, uint32_t byteSize) {
+void SRVUAVManager::CreateSrvByteAddressBuffer(uint32_t viewIndex, ID3D12Resource* pResource, uint32_t byteSize, uint64_t byteOffset) {
+	assert(byteOffset % 4 == 0);
 	D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc{};
 	srvDesc.Format = DXGI_FORMAT_R32_TYPELESS;
 	srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
 	srvDesc.ViewDimension = D3D12_SRV_DIMENSION_BUFFER;
-	srvDesc.Buffer.FirstElement = 0;
+	srvDesc.Buffer.FirstElement = byteOffset / 4;
 	srvDesc.Buffer.NumElements = byteSize / 4;
 	srvDesc.Buffer.Flags = D3D12_BUFFER_SRV_FLAG_RAW;
 	srvDesc.Buffer.StructureByteStride = 0;
@@ -10,10 +10,10 @@ public:
 	void CreateSrvTexture2d(uint32_t viewIndex, ID3D12Resource* pResource, DXGI_FORMAT format, UINT mipLevels);
 	// SRV生成(キューブマップ用)
 	void CreateSrvTextureCubeMap(uint32_t viewIndex, ID3D12Resource* pResource, DXGI_FORMAT format);
-	// SRV生成(StructuredBuffer用)
-	void CreateSrvStructuredBuffer(uint32_t viewIndex, ID3D12Resource* pResource, uint32_t numElements, UINT structureByteStride);
-	// SRV作成(RAWBuffer用)
-	void CreateSrvByteAddressBuffer(uint32_t viewIndex, ID3D12Resource* pResource, uint32_t byteSize);
+	// SRV生成(StructuredBuffer用、firstElementは共有バッファから切り出したときの先頭の要素)
+	void CreateSrvStructuredBuffer(uint32_t viewIndex, ID3D12Resource* pResource, uint32_t numElements, UINT structureByteStride, uint64_t firstElement = 0);
+	// SRV作成(RAWBuffer用、byteOffsetは4の倍数)
+	void CreateSrvByteAddressBuffer(uint32_t viewIndex, ID3D12Resource* pResource, uint32_t byteSize, uint64_t byteOffset = 0);
 	// UAV作成
 	void CreateUavStructuredBuffer(uint32_t viewIndex, ID3D12Resource* pResource, uint32_t numElements, UINT structureByteStride);
 private:
@@ -22,4 +22,6 @@ private:
 private:
 	// 最大SRV数
 	const uint32_t kMaxViewCount_ = 65536;
+	// フレームごとの一時用のSRV数(モデル描画クラスごとにブレンドモード数+影の1つ、パーティクルグループごとに1つ使う。超えた分は常駐用から借りる)
+	const uint32_t kTransientViewCount_ = 1024;
 };
\ No newline at end of file
@@ -3,6 +3,9 @@
 #include "Logger/Logger.h"
 
 #include "MAGIUitility/MAGIUtility.h"
+#include "Const/ResidencyConst.h"
+#include "Const/FrameConst.h"
+#include "Const/FrameArenaConst.h"
 
 using namespace MAGIUtility;
 
@@ -16,6 +19,7 @@ std::unique_ptr<D3DResourceLeakChecker> MAGISYSTEM::leakCheck_ = nullptr;
 // 
 std::unique_ptr<WindowApp> MAGISYSTEM::windowApp_ = nullptr;
 std::unique_ptr<DeltaTimer> MAGISYSTEM::deltaTimer_ = nullptr;
+std::unique_ptr<FrameArena> MAGISYSTEM::frameArena_ = nullptr;
 std::unique_ptr<MAGIDirectInput> MAGISYSTEM::directInput_ = nullptr;
 std::unique_ptr<MAGIXInput> MAGISYSTEM::xInput_ = nullptr;
 
@@ -25,6 +29,10 @@ std::unique_ptr<MAGIXInput> MAGISYSTEM::xInput_ = nullptr;
 std::unique_ptr<DXGI> MAGISYSTEM::dxgi_ = nullptr;
 std::unique_ptr<DirectXCommand> MAGISYSTEM::directXCommand_ = nullptr;
 std::unique_ptr<Fence> MAGISYSTEM::fence_ = nullptr;
+std::unique_ptr<FrameRing> MAGISYSTEM::frameRing_ = nullptr;
+std::unique_ptr<StaticBufferUploader> MAGISYSTEM::staticBufferUploader_ = nullptr;
+std::unique_ptr<RenderThread> MAGISYSTEM::renderThread_ = nullptr;
+std::unique_ptr<RenderQueue> MAGISYSTEM::renderQueue_ = nullptr;
 std::unique_ptr<ShaderCompiler> MAGISYSTEM::shaderCompiler_ = nullptr;
 
 // 
@@ -54,6 +62,9 @@ std::unique_ptr<ShadowPipelineManager> MAGISYSTEM::shadowPipelineManager_ = null
 // 
 // AssetContainer
 // 
+std::unique_ptr<AssetPack> MAGISYSTEM::assetPack_ = nullptr;
+std::unique_ptr<ImportCache> MAGISYSTEM::importCache_ = nullptr;
+std::unique_ptr<ResidencyManager> MAGISYSTEM::residencyManager_ = nullptr;
 std::unique_ptr<TextureDataContainer> MAGISYSTEM::textureDataCantainer_ = nullptr;
 std::unique_ptr<PrimitiveShapeDataContainer> MAGISYSTEM::primitiveDataContainer_ = nullptr;
 std::unique_ptr<ModelDataContainer> MAGISYSTEM::modelDataContainer_ = nullptr;
@@ -90,6 +101,7 @@ std::unique_ptr<SphereDrawer3D> MAGISYSTEM::sphereDrawer3D_ = nullptr;
 std::unique_ptr<RingDrawer3D> MAGISYSTEM::ringDrawer3D_ = nullptr;
 std::unique_ptr<CylinderDrawer3D> MAGISYSTEM::cylinderDrawer3D_ = nullptr;
 
+std::unique_ptr<OcclusionCuller> MAGISYSTEM::occlusionCuller_ = nullptr;
 std::unique_ptr<ModelDrawerManager> MAGISYSTEM::modelDrawerManager_ = nullptr;
 
 std::unique_ptr<SkyBoxDrawer> MAGISYSTEM::skyBoxDrawer_ = nullptr;
@@ -129,6 +141,8 @@ void MAGISYSTEM::Initialize() {
 	windowApp_ = std::make_unique<WindowApp>();
 	// DeltaTimer
 	deltaTimer_ = std::make_unique<DeltaTimer>();
+	// FrameArena
+	frameArena_ = std::make_unique<FrameArena>(FrameArenaConst::BlockSize, FrameArenaConst::BufferCount);
 	// DirectInput
 	directInput_ = std::make_unique<MAGIDirectInput>(windowApp_.get());
 	// XInput
@@ -143,6 +157,16 @@ void MAGISYSTEM::Initialize() {
 	directXCommand_ = std::make_unique<DirectXCommand>(dxgi_.get(), isSupportDX12Ultimate_);
 	// Fence
 	fence_ = std::make_unique<Fence>(dxgi_.get(), directXCommand_.get());
+	// FrameRing
+	frameRing_ = std::make_unique<FrameRing>(FrameConst::FrameCount,
+		[]() { return fence_->Signal(); },
+		[](uint64_t fenceValue) { fence_->WaitForValue(fenceValue); });
+	// StaticBufferUploader
+	staticBufferUploader_ = std::make_unique<StaticBufferUploader>(dxgi_.get(), directXCommand_.get(), fence_.get());
+	// RenderThread
+	renderThread_ = std::make_unique<RenderThread>();
+	// RenderQueue
+	renderQueue_ = std::make_unique<RenderQueue>(frameArena_.get());
 	// ShaderCompiler
 	shaderCompiler_ = std::make_unique<ShaderCompiler>();
 
@@ -162,18 +186,26 @@ void MAGISYSTEM::Initialize() {
 	// SwapChain
 	swapChain_ = std::make_unique<SwapChain>(windowApp_.get(), dxgi_.get(), viewport_.get(), scissorRect_.get(), directXCommand_.get(), rtvManager_.get());
 
+	// AssetPack
+	assetPack_ = std::make_unique<AssetPack>("Assets.pack");
+	// ImportCache
+	importCache_ = std::make_unique<ImportCache>(assetPack_.get(), "ImportCache");
+	// ResidencyManager
+	residencyManager_ = std::make_unique<ResidencyManager>(ResidencyConst::DefaultBudgetBytes);
+	// 追い出すリソースは前のフレームが読んでいるかもしれないので、追い出す前にGPUを待つ
+	residencyManager_->SetWaitGPUFunction([]() { frameRing_->WaitIdle(); });
 	// TextureDataContainer
-	textureDataCantainer_ = std::make_unique<TextureDataContainer>(dxgi_.get(), directXCommand_.get(), fence_.get(), srvuavManager_.get());
+	textureDataCantainer_ = std::make_unique<TextureDataContainer>(dxgi_.get(), directXCommand_.get(), fence_.get(), srvuavManager_.get(), assetPack_.get(), importCache_.get(), residencyManager_.get());
 	// PrimitiveDataContainer
-	primitiveDataContainer_ = std::make_unique<PrimitiveShapeDataContainer>();
+	primitiveDataContainer_ = std::make_unique<PrimitiveShapeDataContainer>(staticBufferUploader_.get());
 	// ModelDataContainer
-	modelDataContainer_ = std::make_unique<ModelDataContainer>(textureDataCantainer_.get());
+	modelDataContainer_ = std::make_unique<ModelDataContainer>(textureDataCantainer_.get(), assetPack_.get(), importCache_.get());
 	// AnimationDataContainer
-	animationDataContainer_ = std::make_unique<AnimationDataContainer>();
+	animationDataContainer_ = std::make_unique<AnimationDataContainer>(assetPack_.get());
 	// SoundDataContainer
-	soundDataContainer_ = std::make_unique<SoundDataContainer>();
+	soundDataContainer_ = std::make_unique<SoundDataContainer>(assetPack_.get());
 	// SceneDataContainer
-	sceneDataContainer_ = std::make_unique<SceneDataContainer>();
+	sceneDataContainer_ = std::make_unique<SceneDataContainer>(assetPack_.get());
 
 	// TransformManager
 	transformManager_ = std::make_unique<TransformManager>();
@@ -192,7 +224,7 @@ void MAGISYSTEM::Initialize() {
 	// Emitter3DManager
 	emitter3DManager_ = std::make_unique<Emitter3DManager>();
 	// ParticleGroup3DManager
-	particleGroup3DManager_ = std::make_unique<ParticleGroup3DManager>();
+	particleGroup3DManager_ = std::make_unique<ParticleGroup3DManager>(renderQueue_.get());
 	// LightManager
 	lightManager_ = std::make_unique<LightManager>(dxgi_.get(), directXCommand_.get());
 
@@ -210,24 +242,27 @@ void MAGISYSTEM::Initialize() {
 
 
 	// SpriteDrawer
-	spriteDrawer_ = std::make_unique<SpriteDrawer>(dxgi_.get(), directXCommand_.get(), srvuavManager_.get(), graphicsPipelineManager_.get(), camera2DManager_.get());
+	spriteDrawer_ = std::make_unique<SpriteDrawer>(dxgi_.get(), directXCommand_.get(), srvuavManager_.get(), graphicsPipelineManager_.get(), camera2DManager_.get(), renderQueue_.get());
 	// LineDrawer3D
-	lineDrawer3D_ = std::make_unique<LineDrawer3D>(dxgi_.get(), directXCommand_.get(), srvuavManager_.get(), graphicsPipelineManager_.get(), camera3DManager_.get());
+	lineDrawer3D_ = std::make_unique<LineDrawer3D>(dxgi_.get(), directXCommand_.get(), srvuavManager_.get(), graphicsPipelineManager_.get(), camera3DManager_.get(), renderQueue_.get());
 	// TriangleDrawer3D
-	triangleDrawer3D_ = std::make_unique<TriangleDrawer3D>(dxgi_.get(), directXCommand_.get(), srvuavManager_.get(), graphicsPipelineManager_.get(), camera3DManager_.get());
+	triangleDrawer3D_ = std::make_unique<TriangleDrawer3D>(dxgi_.get(), directXCommand_.get(), srvuavManager_.get(), graphicsPipelineManager_.get(), camera3DManager_.get(), renderQueue_.get());
 	// PlaneDrawer3D
-	planeDrawer3D_ = std::make_unique<PlaneDrawer3D>(dxgi_.get(), directXCommand_.get(), srvuavManager_.get(), graphicsPipelineManager_.get(), camera3DManager_.get());
+	planeDrawer3D_ = std::make_unique<PlaneDrawer3D>(dxgi_.get(), directXCommand_.get(), srvuavManager_.get(), graphicsPipelineManager_.get(), camera3DManager_.get(), renderQueue_.get());
 	// BoxDrawer3D
-	boxDrawer3D_ = std::make_unique<BoxDrawer3D>(dxgi_.get(), directXCommand_.get(), srvuavManager_.get(), graphicsPipelineManager_.get(), shadowPipelineManager_.get(), camera3DManager_.get(), lightManager_.get());
+	boxDrawer3D_ = std::make_unique<BoxDrawer3D>(dxgi_.get(), directXCommand_.get(), srvuavManager_.get(), graphicsPipelineManager_.get(), shadowPipelineManager_.get(), camera3DManager_.get(), lightManager_.get(), renderQueue_.get());
 	// SphereDrawer3D
-	sphereDrawer3D_ = std::make_unique<SphereDrawer3D>(dxgi_.get(), directXCommand_.get(), srvuavManager_.get(), graphicsPipelineManager_.get(), shadowPipelineManager_.get(), camera3DManager_.get(), lightManager_.get());
+	sphereDrawer3D_ = std::make_unique<SphereDrawer3D>(dxgi_.get(), directXCommand_.get(), srvuavManager_.get(), graphicsPipelineManager_.get(), shadowPipelineManager_.get(), camera3DManager_.get(), lightManager_.get(), renderQueue_.get());
 	// RingDrawer3D
-	ringDrawer3D_ = std::make_unique<RingDrawer3D>(dxgi_.get(), directXCommand_.get(), srvuavManager_.get(), graphicsPipelineManager_.get(), camera3DManager_.get());
+	ringDrawer3D_ = std::make_unique<RingDrawer3D>(dxgi_.get(), directXCommand_.get(), srvuavManager_.get(), graphicsPipelineManager_.get(), camera3DManager_.get(), renderQueue_.get());
 	// CylinderDrawer3D
-	cylinderDrawer3D_ = std::make_unique<CylinderDrawer3D>(dxgi_.get(), directXCommand_.get(), srvuavManager_.get(), graphicsPipelineManager_.get(), shadowPipelineManager_.get(), camera3DManager_.get(), lightManager_.get());
+	cylinderDrawer3D_ = std::make_unique<CylinderDrawer3D>(dxgi_.get(), directXCommand_.get(), srvuavManager_.get(), graphicsPipelineManager_.get(), shadowPipelineManager_.get(), camera3DManager_.get(), lightManager_.get(), renderQueue_.get());
+
+	// OcclusionCuller
+	occlusionCuller_ = std::make_unique<OcclusionCuller>(modelDataContainer_.get(), camera3DManager_.get(), frameArena_.get());
 
 	// ModelDrawerManager
-	modelDrawerManager_ = std::make_unique<ModelDrawerManager>(dxgi_.get(), directXCommand_.get(), srvuavManager_.get(), graphicsPipelineManager_.get(), shadowPipelineManager_.get(), camera3DManager_.get());
+	modelDrawerManager_ = std::make_unique<ModelDrawerManager>(dxgi_.get(), directXCommand_.get(), srvuavManager_.get(), graphicsPipelineManager_.get(), shadowPipelineManager_.get(), camera3DManager_.get(), lightManager_.get(), occlusionCuller_.get(), textureDataCantainer_.get(), residencyManager_.get(), renderQueue_.get());
 
 	// SkyBoxDrawer
 	skyBoxDrawer_ = std::make_unique<SkyBoxDrawer>(dxgi_.get(), directXCommand_.get(), srvuavManager_.get(), graphicsPipelineManager_.get(), camera3DManager_.get());
@@ -237,7 +272,7 @@ void MAGISYSTEM::Initialize() {
 		dxgi_.get(), directXCommand_.get(), depthStencil_.get(), viewport_.get(), scissorRect_.get(),
 		rtvManager_.get(), srvuavManager_.get(), defferedRenderringPipelineManager_.get(), postEffectPipelineManager_.get(), shadowPipelineManager_.get(),
 		camera3DManager_.get(), lightManager_.get(),
-		skyBoxDrawer_.get()
+		skyBoxDrawer_.get(), frameArena_.get()
 	);
 
 	// SceneManager
@@ -246,7 +281,7 @@ void MAGISYSTEM::Initialize() {
 	// GrobalDataManager
 	grobalDataManager_ = std::make_unique<GrobalDataManager>();
 	// SceneDataImporter
-	sceneDataImporter_ = std::make_unique<SceneDataImporter>(sceneDataContainer_.get(), gameObject3DManager_.get(), renderer3DManager_.get(), transformManager_.get());
+	sceneDataImporter_ = std::make_unique<SceneDataImporter>(sceneDataContainer_.get(), gameObject3DManager_.get(), renderer3DManager_.get(), transformManager_.get(), modelDataContainer_.get(), modelDrawerManager_.get(), camera3DManager_.get());
 
 	// ImGuiController
 	imguiController_ = std::make_unique<ImGuiController>(windowApp_.get(), dxgi_.get(), directXCommand_.get(), srvuavManager_.get());
@@ -259,6 +294,16 @@ void MAGISYSTEM::Initialize() {
 
 void MAGISYSTEM::Finalize() {
 
+	// 記録中のフレームを提出し終えてから描画スレッドを止める
+	if (renderThread_) {
+		renderThread_.reset();
+	}
+
+	// 描画中のフレームが終わってから解放する
+	if (fence_) {
+		fence_->WaitGPU();
+	}
+
 	// GUI
 	if (gui_) {
 		gui_.reset();
@@ -299,6 +344,11 @@ void MAGISYSTEM::Finalize() {
 		modelDrawerManager_.reset();
 	}
 
+	// OcclusionCuller
+	if (occlusionCuller_) {
+		occlusionCuller_.reset();
+	}
+
 	// CylinderDrawer3D
 	if (cylinderDrawer3D_) {
 		cylinderDrawer3D_.reset();
@@ -434,6 +484,21 @@ void MAGISYSTEM::Finalize() {
 		textureDataCantainer_.reset();
 	}
 
+	// ResidencyManager
+	if (residencyManager_) {
+		residencyManager_.reset();
+	}
+
+	// ImportCache
+	if (importCache_) {
+		importCache_.reset();
+	}
+
+	// AssetPack
+	if (assetPack_) {
+		assetPack_.reset();
+	}
+
 	// SwapChain
 	if (swapChain_) {
 		swapChain_.reset();
@@ -474,6 +539,21 @@ void MAGISYSTEM::Finalize() {
 		shaderCompiler_.reset();
 	}
 
+	// RenderQueue
+	if (renderQueue_) {
+		renderQueue_.reset();
+	}
+
+	// StaticBufferUploader
+	if (staticBufferUploader_) {
+		staticBufferUploader_.reset();
+	}
+
+	// FrameRing
+	if (frameRing_) {
+		frameRing_.reset();
+	}
+
 	// Fence
 	if (fence_) {
 		fence_.reset();
@@ -499,6 +579,11 @@ void MAGISYSTEM::Finalize() {
 		directInput_.reset();
 	}
 
+	// FrameArena
+	if (frameArena_) {
+		frameArena_.reset();
+	}
+
 	// DeltaTimer
 	if (deltaTimer_) {
 		deltaTimer_.reset();
@@ -561,6 +646,9 @@ void MAGISYSTEM::Update() {
 	// トランスフォームコンポーネントの更新
 	transformManager_->Update();
 
+	// 空間インデックスの更新
+	gameObject3DManager_->UpdateSpatialIndex();
+
 	// 2Dカメラマネージャの更新処理
 	camera2DManager_->Update();
 
@@ -583,23 +671,47 @@ void MAGISYSTEM::Update() {
 
 }
 
+void MAGISYSTEM::UpdateAssets() {
+	// 予算を超えていれば使っていないアセットを追い出す(追い出す前にGPUを待つ)
+	residencyManager_->Update();
+
+	// ワーカースレッドで読み込みが終わったアセットを確定
+	modelDataContainer_->UpdateLoads();
+	textureDataCantainer_->UpdateLoads();
+	animationDataContainer_->UpdateLoads();
+	// シーンの非同期インポートを時間の許す分だけ進める
+	sceneDataImporter_->Update();
+	// 確定したアセットのバッファの転送をまとめて送る
+	staticBufferUploader_->Flush();
+}
+
 void MAGISYSTEM::Draw() {
 
-	// 
-	// DirectX描画前処理
-	// 
+	// 前のフレームの描画キューを捨てる
+	renderQueue_->Begin();
 
-	// コマンドリスト取得
-	ID3D12GraphicsCommandList* commandList = directXCommand_->GetList();
+	//==============================================
+	// 今のフレームのリソースへ書き込み
+	//==============================================
 
-	// SRVUAVのディスクリプタヒープを設定
-	ComPtr<ID3D12DescriptorHeap> descriptorHeaps[] = { srvuavManager_->GetDescriptorHeap() };
-	commandList->SetDescriptorHeaps(1, descriptorHeaps->GetAddressOf());
+	// カメラ
+	camera3DManager_->WriteFrameData();
+	// ライト
+	lightManager_->WriteFrameData();
+	// パーティクル
+	particleGroup3DManager_->WriteFrameData();
 
 	// 
 	// 描画処理
 	// 
 
+	//
+	// オクルージョンカリング用に遮蔽物を描画
+	//
+	occlusionCuller_->BeginFrame();
+	renderer3DManager_->DrawOccluders();
+	occlusionCuller_->EndFrame();
+
 	//
 	// シーンの描画処理
 	//
@@ -636,138 +748,113 @@ void MAGISYSTEM::Draw() {
 	// 背景ボックス描画クラスの更新
 	skyBoxDrawer_->Update();
 
+	// 積まれたポストエフェクトを確定
+	renderController_->FlushPostEffect();
 
-	//==============================================
-	// ShadowMap用のDepthのみの描画
-	//==============================================
-
-	// シャドウマップ用の描画をするための前準備
-	renderController_->PreShadowRender();
+	// ImGuiの描画データを確定
+	imguiController_->BuildDrawData();
 
-	// シャドウ用にオブジェクトの描画
-	boxDrawer3D_->DrawShadow(BlendMode::None);
-	sphereDrawer3D_->DrawShadow(BlendMode::None);
-	cylinderDrawer3D_->DrawShadow(BlendMode::None);
-	modelDrawerManager_->DrawShadowAll(BlendMode::None);
+	// 積まれた描画をキーの順に並べ替える
+	renderQueue_->Sort();
 
-	// シャドウマップ用の描画後処理
-	renderController_->PostShadowRender();
+	// このフレームのレンダーグラフを組み立てる
+	BuildRenderGraph();
 
 
 	//==============================================
-	// GBufferにシーンを描画
+	// コマンドの記録と提出は描画スレッドで行う
 	//==============================================
 
-	// シーン描画用のレンダーテクスチャを準備
-	renderController_->PreRenderForGBuffers();
-
-	// オブジェクトの描画(透過なし)
-	BlendMode noneMode = BlendMode::None;
-
-	triangleDrawer3D_->Draw(noneMode);
-	planeDrawer3D_->Draw(noneMode);
-	boxDrawer3D_->Draw(noneMode);
-	sphereDrawer3D_->Draw(noneMode);
-	ringDrawer3D_->Draw(noneMode);
-	cylinderDrawer3D_->Draw(noneMode);
-
-	modelDrawerManager_->DrawAll(noneMode);
-
-	// シーンの描画後処理
-	renderController_->PostRenderForGBuffers();
+	renderThread_->Kick([]() { RenderFrame(); });
+}
 
+void MAGISYSTEM::BuildRenderGraph() {
+	renderController_->BeginRenderGraph();
 
 	//==============================================
-	// シーン用のレンダーテクスチャに描画
+	// ShadowMap用のDepthのみの描画
 	//==============================================
 
-	// シーン用のレンダーテクスチャに描画する前の処理
-	renderController_->PreSceneRender();
-
-	// ライトの適用
-	renderController_->LightingPass();
-
-	// 背景ボックスを描画
-	skyBoxDrawer_->Draw();
-
-	// ポストエフェクトの影響を受ける背景スプライトを描画
-	for (uint32_t i = static_cast<uint32_t>(BlendMode::None); i < kBlendModeNum; ++i) {
-		BlendMode mode = static_cast<BlendMode>(i);
-		spriteDrawer_->DrawBack(mode);
-	}
-
-	// LineDrawer3Dの描画処理
-	lineDrawer3D_->Draw();
-
-	// BlendModeごとに描画(透過ありを順番に描画)
-	for (uint32_t i = static_cast<uint32_t>(BlendMode::Normal); i < kBlendModeNum; ++i) {
-		BlendMode mode = static_cast<BlendMode>(i);
-		modelDrawerManager_->DrawAll(mode);
-		triangleDrawer3D_->Draw(mode);
-		planeDrawer3D_->Draw(mode);
-		boxDrawer3D_->Draw(mode);
-		sphereDrawer3D_->Draw(mode);
-		ringDrawer3D_->Draw(mode);
-		cylinderDrawer3D_->Draw(mode);
-	}
-
-	// パーティクルの描画処理
-	particleGroup3DManager_->Draw();
-
-	// ポストエフェクトの影響を受けるスプライトを描画
-	for (uint32_t i = static_cast<uint32_t>(BlendMode::None); i < kBlendModeNum; ++i) {
-		BlendMode mode = static_cast<BlendMode>(i);
-		spriteDrawer_->DrawFront(mode);
-	}
+	// シャドウ用にオブジェクトの描画
+	renderController_->AddShadowPass([]() {
+		renderQueue_->Execute(RenderPass::Shadow);
+		});
 
-	// シーン用のレンダーテクスチャ描画後処理
-	renderController_->PostSceneRender();
+	//==============================================
+	// GBufferにシーンを描画
+	//==============================================
 
+	// オブジェクトの描画(透過なし)
+	renderController_->AddGBufferPass([]() {
+		renderQueue_->Execute(RenderPass::GBuffer);
+		});
 
 	//==============================================
-	// ポストプロセス
+	// シーン用のレンダーテクスチャに描画
 	//==============================================
 
-	// ポストエフェクトをかける処理
-	renderController_->ApplyPostEffect();
-
+	// ライトの適用後に重ねて描画する
+	renderController_->AddScenePass([]() {
+		// 背景ボックスを描画
+		skyBoxDrawer_->Draw();
+		// ポストエフェクトの影響を受ける背景スプライトを描画
+		renderQueue_->Execute(RenderPass::BackSprite);
+		// 3Dラインの描画
+		renderQueue_->Execute(RenderPass::Line);
+		// 透過ありのオブジェクトをブレンドモードの順に描画
+		renderQueue_->Execute(RenderPass::Transparent);
+		// パーティクルの描画
+		renderQueue_->Execute(RenderPass::Particle);
+		// ポストエフェクトの影響を受けるスプライトを描画
+		renderQueue_->Execute(RenderPass::FrontSprite);
+		});
 
 	//==============================================
-	// SwapChainに投げる前の最終描画
+	// ポストプロセス
 	//==============================================
 
-	// スワップチェーン前最終描画
-	renderController_->RenderToFinalRenderTexture();
-
+	// 続けてかけられるポストエフェクトはまとめてかける
+	renderController_->AddPostEffectPasses();
 
 	//==============================================
 	// SwapChainに描画
 	//==============================================
 
-	// スワップチェーン描画前処理
-	swapChain_->PreRender();
+	renderController_->AddSwapChainPass([]() {
+		// スワップチェーン描画前処理
+		swapChain_->PreRender();
+		// スワップチェーンにポストエフェクトをかけ終えたレンダーテクスチャを描画
+		renderController_->RenderToSwapChain();
+		// ImGui内部コマンド生成
+		imguiController_->SetAllCommand();
+		// スワップチェーンをプレゼント状態に遷移
+		swapChain_->TransitionToPresent();
+		});
 
-	// スワップチェーンに最終描画用レンダーテクスチャを描画
-	renderController_->RenderToSwapChain();
+	// 使われないパスの間引き、一時リソースの割り当て、バリアを求める
+	renderController_->CompileRenderGraph();
+}
 
-	// ImGui内部コマンド生成
-	imguiController_->SetAllCommand();
+void MAGISYSTEM::RenderFrame() {
 
+	// 
+	// DirectX描画前処理
+	// 
 
-	//==============================================
-	// 描画
-	//==============================================
+	// コマンドリスト取得
+	ID3D12GraphicsCommandList* commandList = directXCommand_->GetList();
 
-	// スワップチェーンをプレゼント状態に遷移	
-	swapChain_->TransitionToPresent();
+	// SRVUAVのディスクリプタヒープを設定
+	ComPtr<ID3D12DescriptorHeap> descriptorHeaps[] = { srvuavManager_->GetDescriptorHeap() };
+	commandList->SetDescriptorHeaps(1, descriptorHeaps->GetAddressOf());
 
 
 	//==============================================
-	// 次のフレームのための後処理
+	// レンダーグラフのパスを順に記録する
 	//==============================================
 
-	// レンダーコントローラのフレーム終了処理
-	renderController_->EndFrame();
+	// バリアはグラフが求めたものをパスの前に張る
+	renderController_->ExecuteRenderGraph();
 
 
 	//==============================================
@@ -778,12 +865,19 @@ void MAGISYSTEM::Draw() {
 	directXCommand_->KickCommand();
 	// GPUとOSに画面の交換を行うように通知
 	swapChain_->Present();
-	// Fenceによる待機
-	fence_->WaitGPU();
+	// このフレームのフェンス値を記録し、次に使うスロットを前に使ったフレームの完了だけを待つ
+	frameRing_->EndFrame();
+	directXCommand_->SetFrameIndex(frameRing_->GetFrameIndex());
 	// 次のフレーム用にコマンドをリセット
 	directXCommand_->ResetCommand();
 }
 
+void MAGISYSTEM::WaitRenderThread() {
+	if (renderThread_) {
+		renderThread_->Wait();
+	}
+}
+
 void MAGISYSTEM::DeleteGarbages() {
 
 	//
@@ -796,6 +890,9 @@ void MAGISYSTEM::DeleteGarbages() {
 
 	transformManager_->DeleteGarbage();
 
+	// フレーム単位の一時メモリを次のバッファへ切り替える(描画スレッドが読んでいるバッファは残る)
+	frameArena_->EndFrame();
+
 }
 
 void MAGISYSTEM::Run() {
@@ -803,14 +900,25 @@ void MAGISYSTEM::Run() {
 	Initialize();
 	// メインループ
 	while (true) {
-		// 更新
+		// 更新(描画スレッドが前のフレームを記録している間に行う)
 		Update();
 
+		// 前のフレームの記録と提出が終わるのを待つ
+		renderThread_->Wait();
+
 		// 終了リクエストがあったらループを抜ける;
 		if (IsEndRequest()) {
 			break;
 		}
 
+		// 描画中のフレームが読み終えたディスクリプタとバッファの領域を使い回せるようにする
+		srvuavManager_->BeginFrame();
+		rtvManager_->BeginFrame();
+		dxgi_->BeginFrame();
+
+		// GPUに触るアセットの確定
+		UpdateAssets();
+
 		// 描画
 		Draw();
 
@@ -955,6 +1063,14 @@ ComPtr<ID3D12Resource> MAGISYSTEM::CreateBufferResource(size_t sizeInBytes, bool
 	return dxgi_->CreateBufferResource(sizeInBytes, isUav);
 }
 
+BufferRegion MAGISYSTEM::AllocateUploadBuffer(uint64_t sizeInBytes, uint64_t alignment) {
+	return dxgi_->AllocateUploadBuffer(sizeInBytes, alignment);
+}
+
+void MAGISYSTEM::FreeUploadBuffer(const BufferRegion& region) {
+	dxgi_->FreeUploadBuffer(region);
+}
+
 ComPtr<ID3D12Resource> MAGISYSTEM::CreateDepthStencilTextureResource(int32_t width, int32_t height, DXGI_FORMAT format) {
 	return dxgi_->CreateDepthStencilTextureResource(width, height, format);
 }
@@ -968,17 +1084,36 @@ ID3D12GraphicsCommandList6* MAGISYSTEM::GetDirectXCommandList6() {
 }
 
 void MAGISYSTEM::KickCommand() {
+	WaitRenderThread();
 	directXCommand_->KickCommand();
 }
 
 void MAGISYSTEM::ResetCommand() {
+	WaitRenderThread();
 	directXCommand_->ResetCommand();
 }
 
+uint32_t MAGISYSTEM::GetFrameIndex() {
+	return directXCommand_->GetFrameIndex();
+}
+
 void MAGISYSTEM::WaitGPU() {
+	WaitRenderThread();
 	fence_->WaitGPU();
 }
 
+BufferRegion MAGISYSTEM::UploadStaticBuffer(const void* data, uint64_t sizeInBytes, uint64_t alignment) {
+	return staticBufferUploader_->Upload(data, sizeInBytes, alignment);
+}
+
+void MAGISYSTEM::FreeStaticBuffer(const BufferRegion& region) {
+	staticBufferUploader_->Free(region);
+}
+
+FrameArena* MAGISYSTEM::GetFrameArena() {
+	return frameArena_.get();
+}
+
 ID3D12DescriptorHeap* MAGISYSTEM::GetRTVDescriptorHeap() {
 	return rtvManager_->GetDescriptorHeap();
 }
@@ -995,6 +1130,10 @@ uint32_t MAGISYSTEM::RTVAllocate() {
 	return rtvManager_->Allocate();
 }
 
+void MAGISYSTEM::RTVFree(uint32_t index) {
+	rtvManager_->Free(index);
+}
+
 void MAGISYSTEM::CreateRTVTexture2d(uint32_t rtvIndex, ID3D12Resource* pResource, DXGI_FORMAT format) {
 	rtvManager_->CreateRTVTexture2d(rtvIndex, pResource, format);
 }
@@ -1035,16 +1174,24 @@ uint32_t MAGISYSTEM::SrvUavAllocate() {
 	return srvuavManager_->Allocate();
 }
 
-void MAGISYSTEM::CreateSrvStructuredBuffer(uint32_t viewIndex, ID3D12Resource* pResource, uint32_t numElements, UINT structureByteStride) {
-	srvuavManager_->CreateSrvStructuredBuffer(viewIndex, pResource, numElements, structureByteStride);
+void MAGISYSTEM::SrvUavFree(uint32_t index) {
+	srvuavManager_->Free(index);
+}
+
+uint32_t MAGISYSTEM::SrvUavAllocateTransient(uint32_t count) {
+	return srvuavManager_->AllocateTransient(count);
+}
+
+void MAGISYSTEM::CreateSrvStructuredBuffer(uint32_t viewIndex, ID3D12Resource* pResource, uint32_t numElements, UINT structureByteStride, uint64_t firstElement) {
+	srvuavManager_->CreateSrvStructuredBuffer(viewIndex, pResource, numElements, structureByteStride, firstElement);
 }
 
 void MAGISYSTEM::CreateSrvTexture2D(uint32_t srvIndex, ID3D12Resource* pResource, DXGI_FORMAT format, UINT mipLevels) {
 	srvuavManager_->CreateSrvTexture2d(srvIndex, pResource, format, mipLevels);
 }
 
-void MAGISYSTEM::CreateSrvByteAddressBuffer(uint32_t viewIndex, ID3D12Resource* pResource, uint32_t byteSize) {
-	srvuavManager_->CreateSrvByteAddressBuffer(viewIndex, pResource, byteSize);
+void MAGISYSTEM::CreateSrvByteAddressBuffer(uint32_t viewIndex, ID3D12Resource* pResource, uint32_t byteSize, uint64_t byteOffset) {
+	srvuavManager_->CreateSrvByteAddressBuffer(viewIndex, pResource, byteSize, byteOffset);
 }
 
 void MAGISYSTEM::CreateUavStructuredBuffer(uint32_t viewIndex, ID3D12Resource* pResource, uint32_t numElements, UINT structureByteStride) {
@@ -1153,14 +1300,42 @@ void MAGISYSTEM::ApplyPostEffectRadialBlur(Vector2 center, float blurWidth) {
 	renderController_->AddPostEffect(command);
 }
 
+bool MAGISYSTEM::LoadImportCache(const std::string& key, std::vector<uint8_t>& outData) {
+	return importCache_->Load(key, outData);
+}
+
+void MAGISYSTEM::StoreImportCache(const std::string& key, std::span<const uint8_t> data) {
+	importCache_->Store(key, data);
+}
+
+void MAGISYSTEM::SetResidencyBudget(uint64_t budgetBytes) {
+	residencyManager_->SetBudget(budgetBytes);
+}
+
+uint64_t MAGISYSTEM::GetResidentBytes() {
+	return residencyManager_->GetResidentBytes();
+}
+
 uint32_t MAGISYSTEM::LoadTexture(const std::string& fileName, bool isFullPath) {
+	// 描画スレッドがコマンドを記録している間は触らない
+	WaitRenderThread();
 	return textureDataCantainer_->Load(fileName, isFullPath);
 }
 
 void MAGISYSTEM::LoadNormalMapTexture(const std::string& filePath) {
+	// 描画スレッドがコマンドを記録している間は触らない
+	WaitRenderThread();
 	textureDataCantainer_->LoadNormalMap(filePath);
 }
 
+AssetLoadHandle MAGISYSTEM::LoadTextureAsync(const std::string& fileName, bool isFullPath) {
+	return textureDataCantainer_->LoadAsync(fileName, isFullPath);
+}
+
+AssetLoadHandle MAGISYSTEM::LoadNormalMapTextureAsync(const std::string& filePath) {
+	return textureDataCantainer_->LoadNormalMapAsync(filePath);
+}
+
 std::unordered_map<std::string, Texture>& MAGISYSTEM::GetTexture() {
 	return textureDataCantainer_->GetTexture();
 }
@@ -1188,18 +1363,49 @@ PrimitiveData MAGISYSTEM::GetPrimitiveShape(const Primitive3DType& primitive3dTy
 	return primitiveDataContainer_->GetPrimitiveShapeData(primitive3dType);
 }
 
+const PrimitiveShapeBuffer& MAGISYSTEM::GetPrimitiveShapeBuffer(const Primitive3DType& primitive3dType) {
+	return primitiveDataContainer_->GetPrimitiveShapeBuffer(primitive3dType);
+}
+
 void MAGISYSTEM::LoadModel(const std::string& modelName) {
+	// 描画スレッドがコマンドを記録している間は触らない
+	WaitRenderThread();
 	modelDataContainer_->Load(modelName);
 }
 
+AssetLoadHandle MAGISYSTEM::LoadModelAsync(const std::string& modelName) {
+	return modelDataContainer_->LoadAsync(modelName);
+}
+
 ModelData MAGISYSTEM::FindModel(const std::string& modelName) {
 	return modelDataContainer_->FindModelData(modelName);
 }
 
+AABB MAGISYSTEM::FindModelLocalAABB(const std::string& modelName) {
+	return modelDataContainer_->FindModelLocalAABB(modelName);
+}
+
+bool MAGISYSTEM::IsModelLoaded(const std::string& modelName) {
+	return modelDataContainer_->IsModelLoaded(modelName);
+}
+
 void MAGISYSTEM::LoadAnimation(const std::string& animationFileName, bool isInSameDirectoryAsModel) {
 	animationDataContainer_->Load(animationFileName, isInSameDirectoryAsModel);
 }
 
+AssetLoadHandle MAGISYSTEM::LoadAnimationAsync(const std::string& animationFileName, bool isInSameDirectoryAsModel) {
+	return animationDataContainer_->LoadAsync(animationFileName, isInSameDirectoryAsModel);
+}
+
+void MAGISYSTEM::WaitAssetLoads() {
+	// 描画スレッドがコマンドを記録している間は触らない
+	WaitRenderThread();
+	// モデルの確定中にテクスチャが積まれるのでモデルから待つ
+	modelDataContainer_->WaitLoads();
+	textureDataCantainer_->WaitLoads();
+	animationDataContainer_->WaitLoads();
+}
+
 AnimationData MAGISYSTEM::FindAnimation(const std::string& animationName) {
 	return animationDataContainer_->FindAnimationData(animationName);
 }
@@ -1225,10 +1431,18 @@ void MAGISYSTEM::StopLoopWaveSound(const std::string& fileName) {
 	soundDataContainer_->StopWaveLoop(fileName);
 }
 
+void MAGISYSTEM::LoadSceneData(const std::string& fileName) {
+	sceneDataContainer_->Load(fileName);
+}
+
 void MAGISYSTEM::LoadSceneDataFromJson(const std::string& fileName) {
 	sceneDataContainer_->LoadFromJson(fileName);
 }
 
+void MAGISYSTEM::LoadSceneDataFromBinary(const std::string& fileName) {
+	sceneDataContainer_->LoadFromBinary(fileName);
+}
+
 Transform3D* MAGISYSTEM::AddTransform3D(std::unique_ptr<Transform3D> transform) {
 	return transformManager_->Add(std::move(transform));
 }
@@ -1241,6 +1455,18 @@ std::weak_ptr<GameObject3D> MAGISYSTEM::AddGameObject3D(std::shared_ptr<GameObje
 	return gameObject3DManager_->Add(std::move(gameObjec3D), insertMap);
 }
 
+void MAGISYSTEM::QueryGameObject3DInAABB(const AABB& bounds, std::vector<GameObject3D*>& result) {
+	gameObject3DManager_->QueryAABB(bounds, result);
+}
+
+void MAGISYSTEM::QueryGameObject3DInSphere(const Vector3& center, float radius, std::vector<GameObject3D*>& result) {
+	gameObject3DManager_->QuerySphere(center, radius, result);
+}
+
+void MAGISYSTEM::QueryGameObject3DInFrustum(const Vector4 planes[6], std::vector<GameObject3D*>& result) {
+	gameObject3DManager_->QueryFrustum(planes, result);
+}
+
 void MAGISYSTEM::TransferCamera3D(uint32_t rootParameterIndex) {
 	camera3DManager_->TransferCurrentCamera(rootParameterIndex);
 }
@@ -1253,7 +1479,14 @@ void MAGISYSTEM::ShakeCurrentCamera3D(float duration, float intensity) {
 	camera3DManager_->ShakeCurrentCamera(duration, intensity);
 }
 
+float MAGISYSTEM::GetCamera3DViewDepth(const Vector3& worldPosition) {
+	return camera3DManager_->GetViewDepth(worldPosition);
+}
+
 void MAGISYSTEM::ClearCamera3D() {
+	// カメラのバッファを読んでいるフレームが終わってから消す
+	WaitRenderThread();
+	fence_->WaitGPU();
 	camera3DManager_->Clear();
 }
 
@@ -1274,10 +1507,14 @@ void MAGISYSTEM::ClearEmitter3D() {
 }
 
 std::string MAGISYSTEM::CreatePrimitiveParticleGroup3D(const std::string& particleGroupName, const Primitive3DType& primitiveType, const std::string& textureName) {
+	// 描画スレッドがコマンドを記録している間は触らない
+	WaitRenderThread();
 	return particleGroup3DManager_->CreatePrimitiveParticleGroup(particleGroupName, primitiveType, textureName);
 }
 
 std::string MAGISYSTEM::CreateStaticParticleGroup3D(const std::string& particleGroupName, const std::string& modelName) {
+	// 描画スレッドがコマンドを記録している間は触らない
+	WaitRenderThread();
 	return particleGroup3DManager_->CreateStaticParticleGroup(particleGroupName, modelName);
 }
 
@@ -1319,6 +1556,8 @@ Camera2D* MAGISYSTEM::FindCamera2D(const std::string& cameraName) {
 }
 
 void MAGISYSTEM::SetCurrentCamera2D(const std::string& cameraName) {
+	// 描画スレッドがコマンドを記録している間は触らない
+	WaitRenderThread();
 	camera2DManager_->SetCurrentCamera(cameraName);
 }
 
@@ -1327,6 +1566,9 @@ void MAGISYSTEM::TransferCamera2D(uint32_t rootParameterIndex) {
 }
 
 void MAGISYSTEM::ClearCamera2D() {
+	// カメラのバッファを読んでいるフレームが終わってから消す
+	WaitRenderThread();
+	fence_->WaitGPU();
 	camera2DManager_->Clear();
 }
 
@@ -1335,6 +1577,9 @@ void MAGISYSTEM::AddCamera3D(const std::string& name, std::unique_ptr<Camera3D>
 }
 
 void MAGISYSTEM::RemoveCamera3D(const std::string& cameraName) {
+	// カメラのバッファを読んでいるフレームが終わってから消す
+	WaitRenderThread();
+	fence_->WaitGPU();
 	camera3DManager_->Remove(cameraName);
 }
 
@@ -1375,6 +1620,8 @@ void MAGISYSTEM::DrawCylinder3D(const Matrix4x4& worldMatrix, const CylinderData
 }
 
 void MAGISYSTEM::CreateModelDrawer(const std::string& name, const ModelData& modelData) {
+	// 描画スレッドがコマンドを記録している間は触らない
+	WaitRenderThread();
 	modelDrawerManager_->CreateModelDrawer(name, modelData);
 }
 
@@ -1382,7 +1629,17 @@ void MAGISYSTEM::DrawModel(const std::string& name, const Matrix4x4& worldMatrix
 	modelDrawerManager_->DrawModel(name, worldMatrix, material);
 }
 
+void MAGISYSTEM::RasterizeOccluder(const std::string& modelName, const Matrix4x4& worldMatrix) {
+	occlusionCuller_->RasterizeOccluder(modelName, worldMatrix);
+}
+
+void MAGISYSTEM::SetIsOcclusionCullingEnable(bool isEnable) {
+	occlusionCuller_->SetIsEnable(isEnable);
+}
+
 void MAGISYSTEM::SetSkyBoxTextureIndex(uint32_t skyBoxTextureIndex) {
+	// 描画スレッドがコマンドを記録している間は触らない
+	WaitRenderThread();
 	skyBoxDrawer_->SetTextureIndex(skyBoxTextureIndex);
 }
 
@@ -1439,5 +1696,23 @@ bool MAGISYSTEM::GetGrobalDataValueBool(const std::string& groupName, const std:
 }
 
 void MAGISYSTEM::ImportSceneData(const std::string& sceneDataName, bool isSceneClear) {
+	// 描画スレッドがコマンドを記録している間は触らない
+	WaitRenderThread();
 	sceneDataImporter_->Import(sceneDataName, isSceneClear);
 }
+
+SceneImportHandle MAGISYSTEM::ImportSceneDataAsync(const std::string& sceneDataName, bool isSceneClear) {
+	return sceneDataImporter_->ImportAsync(sceneDataName, isSceneClear);
+}
+
+void MAGISYSTEM::BeginSceneStreaming(const std::string& sceneDataName, bool isSceneClear) {
+	sceneDataImporter_->BeginStreaming(sceneDataName, isSceneClear);
+}
+
+void MAGISYSTEM::EndSceneStreaming() {
+	sceneDataImporter_->EndStreaming();
+}
+
+void MAGISYSTEM::SetSceneStreamingDistance(float loadDistance, float unloadDistance) {
+	sceneDataImporter_->SetStreamingDistance(loadDistance, unloadDistance);
+}
@@ -12,6 +12,7 @@
 // 
 #include "WindowApp/WindowApp.h"
 #include "DeltaTimer/DeltaTimer.h"    
+#include "FrameArena/FrameArena.h"
 #include "Input/MAGIDirectInput/MAGIDirectInput.h"
 #include "Input/MAGIXInput/MAGIXInput.h"
 
@@ -21,7 +22,11 @@
 #include "DirectX/DXGI/DXGI.h"
 #include "DirectX/DirectXCommand/DirectXCommand.h"
 #include "DirectX/Fence/Fence.h"
+#include "DirectX/FrameRing/FrameRing.h"
+#include "DirectX/StaticBufferUploader/StaticBufferUploader.h"
 #include "DirectX/ShaderCompiler/ShaderCompiler.h"
+#include "RenderThread/RenderThread.h"
+#include "RenderQueue/RenderQueue.h"
 
 // 
 // ViewManagers
@@ -42,6 +47,9 @@
 // 
 // AssetContainer
 // 
+#include "AssetPack/AssetPack.h"
+#include "ImportCache/ImportCache.h"
+#include "ResidencyManager/ResidencyManager.h"
 #include "TextureDataContainer/TextureDataContainer.h"
 #include "PrimitiveShapeDataContainer/PrimitiveShapeDataContainer.h"
 #include "SceneDataContainer/SceneDataContainer.h"
@@ -87,6 +95,7 @@
 #include "3D/Drawer3D/PrimitiveDrawers/RingDrawer3D/RingDrawer3D.h"
 #include "3D/Drawer3D/PrimitiveDrawers/CylinderDrawer3D/CylinderDrawer3D.h"
 
+#include "3D/OcclusionCuller/OcclusionCuller.h"
 #include "3D/ModelDrawerManager/ModelDrawerManager.h"
 
 #include "3D/Drawer3D/SkyBoxDrawer/SkyBoxDrawer.h"
@@ -124,9 +133,11 @@ public:
 	virtual void Initialize();
 	// 終了
 	void Finalize();
-	// 更新
+	// 更新(描画スレッドが前のフレームを記録している間に行う)
 	void Update();
-	// 描画
+	// GPUに触るアセットの確定(描画スレッドが止まっている間に行う)
+	void UpdateAssets();
+	// 描画(描画するものを確定させて描画スレッドに渡す)
 	void Draw();
 
 	// 削除フラグの立っているオブジェクトを削除
@@ -228,6 +239,10 @@ public: // エンジンの機能
 	static ID3D12Device* GetDirectXDevice();
 	// バッファリソースを作成
 	static ComPtr<ID3D12Resource> CreateBufferResource(size_t sizeInBytes, bool isUav = false);
+	// 共有のアップロードバッファから領域を切り出す
+	static BufferRegion AllocateUploadBuffer(uint64_t sizeInBytes, uint64_t alignment);
+	// 切り出した領域を返す(描画中のフレームが読み終わってから使い回す)
+	static void FreeUploadBuffer(const BufferRegion& region);
 	// DepthStencilTexリソースの作成
 	static ComPtr<ID3D12Resource> CreateDepthStencilTextureResource(int32_t width, int32_t height, DXGI_FORMAT format);
 
@@ -242,6 +257,8 @@ public: // エンジンの機能
 	static void KickCommand();
 	// コマンドのリセット
 	static void ResetCommand();
+	// 今のフレームのスロット番号(フレームごとに持つバッファの添字)
+	static uint32_t GetFrameIndex();
 #pragma endregion
 
 #pragma region Fenceの機能
@@ -249,6 +266,18 @@ public: // エンジンの機能
 	static void WaitGPU();
 #pragma endregion
 
+#pragma region StaticBufferUploaderの機能
+	// 書き換えないバッファをデフォルトヒープへ転送する(転送はアセットの確定後にまとめて送る)
+	static BufferRegion UploadStaticBuffer(const void* data, uint64_t sizeInBytes, uint64_t alignment);
+	// 転送したバッファを返す(描画中のフレームが読み終わってから使い回す)
+	static void FreeStaticBuffer(const BufferRegion& region);
+#pragma endregion
+
+#pragma region FrameArenaの機能
+	// フレーム単位の一時メモリを取得(確保したメモリは次のフレームの終わりまで使える)
+	static FrameArena* GetFrameArena();
+#pragma endregion
+
 #pragma region RTVManagerの機能
 	// RTVのディスクリプタヒープを取得
 	static ID3D12DescriptorHeap* GetRTVDescriptorHeap();
@@ -258,6 +287,8 @@ public: // エンジンの機能
 	static D3D12_GPU_DESCRIPTOR_HANDLE GetRTVDescriptorHandleGPU(uint32_t index);
 	// RTVIndex割り当て関数
 	static uint32_t RTVAllocate();
+	// RTVIndex解放関数
+	static void RTVFree(uint32_t index);
 	// Texture2D用のRTVの作成
 	static void CreateRTVTexture2d(uint32_t rtvIndex, ID3D12Resource* pResource, DXGI_FORMAT format);
 #pragma endregion
@@ -286,12 +317,16 @@ public: // エンジンの機能
 	static D3D12_GPU_DESCRIPTOR_HANDLE GetSrvUavDescriptorHandleGPU(uint32_t index);
 	// Allocate
 	static uint32_t SrvUavAllocate();
+	// Free(描画中のフレームが読み終わってから使い回す)
+	static void SrvUavFree(uint32_t index);
+	// このフレームだけ使う連続したSRVを割り当てて先頭を返す
+	static uint32_t SrvUavAllocateTransient(uint32_t count);
 	// StructuredBuffer用のsrv作成
-	static void CreateSrvStructuredBuffer(uint32_t viewIndex, ID3D12Resource* pResource, uint32_t numElements, UINT structureByteStride);
+	static void CreateSrvStructuredBuffer(uint32_t viewIndex, ID3D12Resource* pResource, uint32_t numElements, UINT structureByteStride, uint64_t firstElement = 0);
 	// Texure2D用のSrv作成
 	static void CreateSrvTexture2D(uint32_t srvIndex, ID3D12Resource* pResource, DXGI_FORMAT format, UINT mipLevels);
 	// RawBuffer用のsrv作成
-	static void CreateSrvByteAddressBuffer(uint32_t viewIndex, ID3D12Resource* pResource, uint32_t byteSize);
+	static void CreateSrvByteAddressBuffer(uint32_t viewIndex, ID3D12Resource* pResource, uint32_t byteSize, uint64_t byteOffset = 0);
 	// StructuredBuffer用のUAV作成
 	static void CreateUavStructuredBuffer(uint32_t viewIndex, ID3D12Resource* pResource, uint32_t numElements, UINT structureByteStride);
 #pragma endregion
@@ -338,6 +373,20 @@ public: // エンジンの機能
 	static void ApplyPostEffectRadialBlur(Vector2 center, float blurWidth);
 #pragma endregion
 
+#pragma region ImportCache
+	// インポートキャッシュを読む(無ければfalse)
+	static bool LoadImportCache(const std::string& key, std::vector<uint8_t>& outData);
+	// インポートキャッシュに書き込む
+	static void StoreImportCache(const std::string& key, std::span<const uint8_t> data);
+#pragma endregion
+
+#pragma region ResidencyManager
+	// 常駐アセットの予算を設定
+	static void SetResidencyBudget(uint64_t budgetBytes);
+	// 常駐しているアセットの合計サイズを取得
+	static uint64_t GetResidentBytes();
+#pragma endregion
+
 #pragma region TextureDataContainer
 	/// <summary>
 	/// 画像読み込み関数
@@ -348,6 +397,10 @@ public: // エンジンの機能
 	static uint32_t LoadTexture(const std::string& fileName, bool isFullPath = false);
 	// 法線マップ画像の読み込み
 	static void LoadNormalMapTexture(const std::string& filePath);
+	// 画像をワーカースレッドで読み込む(SRVの作成は後のフレームで行う)
+	static AssetLoadHandle LoadTextureAsync(const std::string& fileName, bool isFullPath = false);
+	// 法線マップ画像をワーカースレッドで読み込む
+	static AssetLoadHandle LoadNormalMapTextureAsync(const std::string& filePath);
 	// テクスチャの取得
 	static std::unordered_map<std::string, Texture>& GetTexture();
 	// メタデータ取得
@@ -364,18 +417,30 @@ public: // エンジンの機能
 #pragma region PrimitiveShapeDataContainer
 	// 形状の取得
 	static PrimitiveData GetPrimitiveShape(const Primitive3DType& primitive3dType);
+	// 形状の頂点とインデックスのバッファの取得
+	static const PrimitiveShapeBuffer& GetPrimitiveShapeBuffer(const Primitive3DType& primitive3dType);
 #pragma endregion
 
 #pragma region ModelDataContainer
 	// モデルの読み込み
 	static void LoadModel(const std::string& modelName);
+	// モデルをワーカースレッドで読み込む
+	static AssetLoadHandle LoadModelAsync(const std::string& modelName);
 	// 読み込み済みモデル検索
 	static ModelData FindModel(const std::string& modelName);
+	// モデル空間の境界ボックスを取得
+	static AABB FindModelLocalAABB(const std::string& modelName);
+	// モデルの読み込みが終わっているか
+	static bool IsModelLoaded(const std::string& modelName);
 #pragma endregion
 
 #pragma region AnimationDataContainer
 	// アニメーションの読み込み
 	static void LoadAnimation(const std::string& animationFileName, bool isInSameDirectoryAsModel = true);
+	// アニメーションをワーカースレッドで読み込む
+	static AssetLoadHandle LoadAnimationAsync(const std::string& animationFileName, bool isInSameDirectoryAsModel = true);
+	// 非同期で読み込み中のアセットがすべて使えるようになるまで待つ
+	static void WaitAssetLoads();
 	// 読み込み済みアニメーションの検索
 	static AnimationData FindAnimation(const std::string& animationName);
 #pragma endregion
@@ -394,8 +459,12 @@ public: // エンジンの機能
 #pragma endregion
 
 #pragma region SceneDataContainer
-	// シーンデータの読み込み
+	// シーンデータの読み込み(バイナリがあればそちらを使う)
+	static void LoadSceneData(const std::string& fileName);
+	// シーンデータの読み込み(Json)
 	static void LoadSceneDataFromJson(const std::string& fileName);
+	// シーンデータの読み込み(バイナリ)
+	static void LoadSceneDataFromBinary(const std::string& fileName);
 #pragma endregion
 
 
@@ -413,6 +482,12 @@ public: // エンジンの機能
 #pragma region GameObject3DManager
 	// ゲームオブジェクト3Dを追加
 	static std::weak_ptr<GameObject3D> AddGameObject3D(std::shared_ptr<GameObject3D> gameObjec3D, bool insertMap = true);
+	// AABBと交差するゲームオブジェクト3Dを取得
+	static void QueryGameObject3DInAABB(const AABB& bounds, std::vector<GameObject3D*>& result);
+	// 球と交差するゲームオブジェクト3Dを取得
+	static void QueryGameObject3DInSphere(const Vector3& center, float radius, std::vector<GameObject3D*>& result);
+	// フラスタムにかかるゲームオブジェクト3Dを取得
+	static void QueryGameObject3DInFrustum(const Vector4 planes[6], std::vector<GameObject3D*>& result);
 
 #pragma endregion
 
@@ -444,6 +519,8 @@ public: // エンジンの機能
 	static void TransferCurrentCamera3DFrustum(uint32_t rootParameterIndex);
 	// カメラシェイク
 	static void ShakeCurrentCamera3D(float duration, float intensity);
+	// 使用中の3Dカメラから見た深度
+	static float GetCamera3DViewDepth(const Vector3& worldPosition);
 	// 3Dカメラ全削除
 	static void ClearCamera3D();
 #pragma endregion
@@ -562,6 +639,13 @@ public: // エンジンの機能
 	);
 #pragma endregion
 
+#pragma region OcclusionCuller
+	// 遮蔽物をオクルージョン用の深度バッファに描画
+	static void RasterizeOccluder(const std::string& modelName, const Matrix4x4& worldMatrix);
+	// オクルージョンカリングの有効化
+	static void SetIsOcclusionCullingEnable(bool isEnable);
+#pragma endregion
+
 #pragma region SkyBoxDrawer
 	// スカイボックスのテクスチャインデックスをセット
 	static void SetSkyBoxTextureIndex(uint32_t skyBoxTextureIndex);
@@ -603,6 +687,14 @@ public: // エンジンの機能
 #pragma region SceneDataImporter
 	// シーンデータをインポート
 	static void ImportSceneData(const std::string& sceneDataName, bool isSceneClear = true);
+	// シーンデータを数フレームに分けてインポート
+	static SceneImportHandle ImportSceneDataAsync(const std::string& sceneDataName, bool isSceneClear = true);
+	// ワールド分割されたシーンをカメラの周りだけ読み込む
+	static void BeginSceneStreaming(const std::string& sceneDataName, bool isSceneClear = true);
+	// シーンのストリーミングを終了
+	static void EndSceneStreaming();
+	// セルを読み込む距離と破棄する距離を設定
+	static void SetSceneStreamingDistance(float loadDistance, float unloadDistance);
 
 #pragma endregion
 
@@ -612,6 +704,14 @@ public: // エンジンの機能
 
 #pragma endregion
 
+private:
+	// 描画スレッドで行うコマンドの記録と提出
+	static void RenderFrame();
+	// フレームのレンダーグラフを組み立てる(描画スレッドが止まっている間に呼ぶ)
+	static void BuildRenderGraph();
+	// 描画スレッドが記録中ならその終了を待つ
+	static void WaitRenderThread();
+
 private: // メンバ変数
 	// 終了リクエスト
 	bool endRequest_ = false;
@@ -628,6 +728,7 @@ protected:
 	// 
 	static std::unique_ptr<WindowApp> windowApp_;
 	static std::unique_ptr<DeltaTimer> deltaTimer_;
+	static std::unique_ptr<FrameArena> frameArena_;
 	static std::unique_ptr<MAGIDirectInput> directInput_;
 	static std::unique_ptr<MAGIXInput> xInput_;
 
@@ -637,6 +738,10 @@ protected:
 	static std::unique_ptr<DXGI> dxgi_;
 	static std::unique_ptr<DirectXCommand> directXCommand_;
 	static std::unique_ptr<Fence> fence_;
+	static std::unique_ptr<FrameRing> frameRing_;
+	static std::unique_ptr<StaticBufferUploader> staticBufferUploader_;
+	static std::unique_ptr<RenderThread> renderThread_;
+	static std::unique_ptr<RenderQueue> renderQueue_;
 	static std::unique_ptr<ShaderCompiler> shaderCompiler_;
 
 	// 
@@ -666,6 +771,9 @@ protected:
 	// 
 	// AssetContainer
 	// 
+	static std::unique_ptr<AssetPack> assetPack_;
+	static std::unique_ptr<ImportCache> importCache_;
+	static std::unique_ptr<ResidencyManager> residencyManager_;
 	static std::unique_ptr<TextureDataContainer> textureDataCantainer_;
 	static std::unique_ptr<PrimitiveShapeDataContainer> primitiveDataContainer_;
 	static std::unique_ptr<ModelDataContainer> modelDataContainer_;
@@ -702,6 +810,7 @@ protected:
 	static std::unique_ptr<RingDrawer3D> ringDrawer3D_;
 	static std::unique_ptr<CylinderDrawer3D> cylinderDrawer3D_;
 
+	static std::unique_ptr<OcclusionCuller> occlusionCuller_;
 	static std::unique_ptr<ModelDrawerManager> modelDrawerManager_;
 
 	static std::unique_ptr<SkyBoxDrawer> skyBoxDrawer_;
@@ -6,6 +6,7 @@
 #include "DirectX/DXGI/DXGI.h"
 #include "DirectX/DirectXCommand/DirectXCommand.h"
 #include "ViewManagers/SRVUAVManager/SRVUAVManager.h"
+#include "Const/FrameConst.h"
 
 ImGuiController::ImGuiController(WindowApp* windowApp, DXGI* dxgi, DirectXCommand* command, SRVUAVManager* srvUavManager) {
 	Initialize(windowApp, dxgi, command, srvUavManager);
@@ -33,7 +34,7 @@ void ImGuiController::Initialize(WindowApp* windowApp, DXGI* dxgi, DirectXComman
 	ImGui::StyleColorsDark();
 	ImGui_ImplWin32_Init(windowApp_->GetHwnd());
 	ImGui_ImplDX12_Init(dxgi_->GetDevice(),
-		2,
+		FrameConst::FrameCount,
 		DXGI_FORMAT_R8G8B8A8_UNORM_SRGB,
 		srvUavManager_->GetDescriptorHeap(),
 		srvUavManager_->GetDescriptorHandleCPU(srvIndex),
@@ -48,14 +49,35 @@ void ImGuiController::BeginFrame() {
 	ImGui::NewFrame();
 }
 
-void ImGuiController::SetAllCommand() {
+void ImGuiController::BuildDrawData() {
 	// ImGui内部コマンドの生成
 	ImGui::Render();
+
+	// 次のNewFrameで書き換えられるのでコマンドリストごと複製する
+	ClearDrawData();
+	const ImDrawData* source = ImGui::GetDrawData();
+	drawData_.Valid = source->Valid;
+	drawData_.DisplayPos = source->DisplayPos;
+	drawData_.DisplaySize = source->DisplaySize;
+	drawData_.FramebufferScale = source->FramebufferScale;
+	for (int i = 0; i < source->CmdListsCount; i++) {
+		drawData_.CmdLists.push_back(source->CmdLists[i]->CloneOutput());
+	}
+	drawData_.CmdListsCount = source->CmdListsCount;
+	drawData_.TotalVtxCount = source->TotalVtxCount;
+	drawData_.TotalIdxCount = source->TotalIdxCount;
+}
+
+void ImGuiController::SetAllCommand() {
+	if (!drawData_.Valid) {
+		return;
+	}
 	// 実際のCommandListのImGuiの描画コマンドを積む
-	ImGui_ImplDX12_RenderDrawData(ImGui::GetDrawData(), command_->GetList());
+	ImGui_ImplDX12_RenderDrawData(&drawData_, command_->GetList());
 }
 
 void ImGuiController::Finalize() {
+	ClearDrawData();
 	ImGui_ImplDX12_Shutdown();
 	ImGui_ImplWin32_Shutdown();
 	ImGui::DestroyContext();
@@ -80,3 +102,10 @@ void ImGuiController::SetSrvUavManager(SRVUAVManager* srvUavManager) {
 	assert(srvUavManager);
 	srvUavManager_ = srvUavManager;
 }
+
+void ImGuiController::ClearDrawData() {
+	for (ImDrawList* cmdList : drawData_.CmdLists) {
+		IM_DELETE(cmdList);
+	}
+	drawData_.Clear();
+}
@@ -32,7 +32,10 @@ public:
 	// 更新処理の先頭に呼び出す処理
 	void BeginFrame();
 
-	// 更新処理の最後に呼び出す処理
+	// 更新処理の最後に呼び出す処理(描画データを描画スレッド用に複製する)
+	void BuildDrawData();
+
+	// 複製した描画データのコマンドを積む(描画スレッドから呼ぶ)
 	void SetAllCommand();
 
 	// ImGuiの終了処理
@@ -43,6 +46,8 @@ private:
 	void SetDXGI(DXGI* dxgi);
 	void SetDirectXCommand(DirectXCommand* command);
 	void SetSrvUavManager(SRVUAVManager* srvManager);
+	// 複製した描画データを解放
+	void ClearDrawData();
 private: // インスタンスを受け取る変数
 	// WinAPP
 	WindowApp* windowApp_ = nullptr;
@@ -52,4 +57,7 @@ private: // インスタンスを受け取る変数
 	DirectXCommand* command_ = nullptr;
 	// SrvManager
 	SRVUAVManager* srvUavManager_ = nullptr;
+private:
+	// 描画スレッドに渡す描画データ(次のフレームの更新中も残るように複製して持つ)
+	ImDrawData drawData_{};
 };
\ No newline at end of file
@@ -0,0 +1,147 @@
+#include "PostEffectPlanner.h"
+
+// C++
+#include <cassert>
+
+namespace {
+	// 色をまとめてかけるパスのパラメータの位置(FusedColor.hlsliのFusedColorDataと合わせる)
+	// param0.xy 集中ぼかしの中心 param0.z 集中ぼかしの幅
+	constexpr uint32_t kRadialBlurCenterOffset = 0;
+	constexpr uint32_t kRadialBlurWidthOffset = 2;
+	// param1.xy ビネットの強さと減衰
+	constexpr uint32_t kVignetteOffset = 4;
+}
+
+PostEffectPlanner::PostEffectPlanner() {
+
+}
+
+PostEffectPlanner::~PostEffectPlanner() {
+
+}
+
+void PostEffectPlanner::Plan(std::span<const PostEffectCommand> commands) {
+	passes_.clear();
+
+	uint32_t i = 0;
+	while (i < commands.size()) {
+		const PostEffectType type = commands[i].postEffectType;
+
+		// コピーは何もしないので消す
+		if (type == PostEffectType::Copy) {
+			i++;
+			continue;
+		}
+
+		if (IsColorOp(type)) {
+			i = PlanColorPass(commands, i);
+			continue;
+		}
+
+		// X軸に続くY軸のガウスぼかしは半分の解像度で行う(オフセットはUVなので見た目の範囲は変わらない)
+		if (type == PostEffectType::GaussianX &&
+			i + 1 < commands.size() &&
+			commands[i + 1].postEffectType == PostEffectType::GaussianY) {
+			passes_.push_back(PostEffectPass{
+				.passType = PostEffectPassType::GaussianX,
+				.colorOps = PostEffectColorOp::None,
+				.param = commands[i].param,
+				.isHalfResolution = true,
+				.commandCount = 1,
+				});
+			passes_.push_back(PostEffectPass{
+				.passType = PostEffectPassType::GaussianY,
+				.colorOps = PostEffectColorOp::None,
+				.param = commands[i + 1].param,
+				.isHalfResolution = true,
+				.commandCount = 1,
+				});
+			i += 2;
+			continue;
+		}
+
+		// 片方だけのガウスぼかしはそのままの解像度で行う
+		assert(type == PostEffectType::GaussianX || type == PostEffectType::GaussianY);
+		passes_.push_back(PostEffectPass{
+			.passType = type == PostEffectType::GaussianX ? PostEffectPassType::GaussianX : PostEffectPassType::GaussianY,
+			.colorOps = PostEffectColorOp::None,
+			.param = commands[i].param,
+			.isHalfResolution = false,
+			.commandCount = 1,
+			});
+		i++;
+	}
+}
+
+std::span<const PostEffectPass> PostEffectPlanner::GetPasses()const {
+	return passes_;
+}
+
+bool PostEffectPlanner::IsColorOp(PostEffectType type) {
+	return ToColorOp(type) != PostEffectColorOp::None;
+}
+
+PostEffectColorOp PostEffectPlanner::ToColorOp(PostEffectType type) {
+	switch (type) {
+	case PostEffectType::RadialBlur:
+		return PostEffectColorOp::RadialBlur;
+	case PostEffectType::Grayscale:
+		return PostEffectColorOp::Grayscale;
+	case PostEffectType::Vignette:
+		return PostEffectColorOp::Vignette;
+	default:
+		return PostEffectColorOp::None;
+	}
+}
+
+uint32_t PostEffectPlanner::PlanColorPass(std::span<const PostEffectCommand> commands, uint32_t begin) {
+	PostEffectPass pass{
+		.passType = PostEffectPassType::Color,
+		.colorOps = PostEffectColorOp::None,
+		.param = {},
+		.isHalfResolution = false,
+		.commandCount = 0,
+	};
+
+	// グレースケールとビネットは画素ごとに色へ係数をかけるだけなので順番を入れ替えても結果は同じ
+	// シェーダーは 集中ぼかし→グレースケール→ビネット の順に行う
+	uint32_t i = begin;
+	for (; i < commands.size(); i++) {
+		const PostEffectCommand& command = commands[i];
+		if (command.postEffectType == PostEffectType::Copy) {
+			pass.commandCount++;
+			continue;
+		}
+		if (!IsColorOp(command.postEffectType)) {
+			break;
+		}
+		const PostEffectColorOp op = ToColorOp(command.postEffectType);
+		// 同じ処理はひとつのパスに一度だけ
+		if ((pass.colorOps & op) != PostEffectColorOp::None) {
+			break;
+		}
+		// 集中ぼかしは前の処理の結果の周りを読むので先頭でしか行えない
+		if (op == PostEffectColorOp::RadialBlur && pass.colorOps != PostEffectColorOp::None) {
+			break;
+		}
+
+		switch (op) {
+		case PostEffectColorOp::RadialBlur:
+			pass.param.param[kRadialBlurCenterOffset + 0] = command.param.param[0];
+			pass.param.param[kRadialBlurCenterOffset + 1] = command.param.param[1];
+			pass.param.param[kRadialBlurWidthOffset] = command.param.param[4];
+			break;
+		case PostEffectColorOp::Vignette:
+			pass.param.param[kVignetteOffset + 0] = command.param.param[0];
+			pass.param.param[kVignetteOffset + 1] = command.param.param[1];
+			break;
+		default:
+			break;
+		}
+		pass.colorOps = pass.colorOps | op;
+		pass.commandCount++;
+	}
+
+	passes_.push_back(pass);
+	return i;
+}
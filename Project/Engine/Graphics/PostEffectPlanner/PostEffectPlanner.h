@@ -0,0 +1,40 @@
+#pragma once
+
+// C++
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// MyHedder
+#include "Structs/PostEffectStruct.h"
+
+/// <summary>
+/// 積まれたポストエフェクトのコマンドを続けてかけられるものごとにパスへまとめる
+/// ・集中ぼかし、グレースケール、ビネットはひとつのピクセルシェーダーの組み合わせにまとめる
+/// ・X軸に続くY軸のガウスぼかしは半分の解像度で行う
+/// GPUには触らないので単体で動かせる
+/// </summary>
+class PostEffectPlanner {
+public:
+	PostEffectPlanner();
+	~PostEffectPlanner();
+
+	// コマンドの列からパスの列を組み立てる(前の結果は捨てる)
+	void Plan(std::span<const PostEffectCommand> commands);
+
+	// 組み立てたパス
+	[[nodiscard]] std::span<const PostEffectPass> GetPasses()const;
+
+	// 色をまとめてかけるパスで行える処理か
+	[[nodiscard]] static bool IsColorOp(PostEffectType type);
+	// 色をまとめてかけるパスでの処理のビット
+	[[nodiscard]] static PostEffectColorOp ToColorOp(PostEffectType type);
+
+private:
+	// 続くコマンドを色をまとめてかけるパスにできるだけ詰める
+	uint32_t PlanColorPass(std::span<const PostEffectCommand> commands, uint32_t begin);
+
+private:
+	// 組み立てたパス(毎フレーム確保し直さないように持っておく)
+	std::vector<PostEffectPass> passes_;
+};
@@ -0,0 +1,344 @@
+#include "RenderGraph.h"
+
+// C++
+#include <cassert>
+
+RenderGraph::RenderGraph() {
+
+}
+
+RenderGraph::~RenderGraph() {
+
+}
+
+uint32_t RenderGraph::RegisterExternal(RenderGraphAccess initialState) {
+	physicals_.push_back(Physical{
+		.isTransient = false,
+		.state = initialState,
+		});
+	return static_cast<uint32_t>(physicals_.size() - 1);
+}
+
+void RenderGraph::Begin() {
+	// 配列の容量は残して毎フレーム確保し直さない
+	passes_.clear();
+	uses_.clear();
+	resources_.clear();
+	barriers_.clear();
+	isCompiled_ = false;
+}
+
+RenderGraph::ResourceHandle RenderGraph::Import(uint32_t physicalIndex) {
+	assert(physicalIndex < physicals_.size() && !physicals_[physicalIndex].isTransient);
+	resources_.push_back(Resource{
+		.isImported = true,
+		.physicalIndex = physicalIndex,
+		});
+	return static_cast<ResourceHandle>(resources_.size() - 1);
+}
+
+RenderGraph::ResourceHandle RenderGraph::CreateTexture(const TextureDesc& desc) {
+	resources_.push_back(Resource{
+		.desc = desc,
+		.isImported = false,
+		});
+	return static_cast<ResourceHandle>(resources_.size() - 1);
+}
+
+uint32_t RenderGraph::AddPass(const char* name, ExecuteFunction function) {
+	assert(function);
+	assert(!isCompiled_ && "RenderGraph is already compiled");
+	passes_.push_back(Pass{
+		.name = name,
+		.function = std::move(function),
+		.useBegin = static_cast<uint32_t>(uses_.size()),
+		});
+	return static_cast<uint32_t>(passes_.size() - 1);
+}
+
+void RenderGraph::Read(uint32_t pass, ResourceHandle resource, RenderGraphAccess access) {
+	assert(!IsWriteAccess(access));
+	AddUse(pass, resource, access);
+}
+
+void RenderGraph::Write(uint32_t pass, ResourceHandle resource, RenderGraphAccess access) {
+	assert(IsWriteAccess(access));
+	AddUse(pass, resource, access);
+}
+
+void RenderGraph::SetSideEffect(uint32_t pass) {
+	assert(pass < passes_.size());
+	passes_[pass].hasSideEffect = true;
+}
+
+void RenderGraph::MarkOutput(ResourceHandle resource) {
+	assert(resource < resources_.size());
+	resources_[resource].isOutput = true;
+}
+
+void RenderGraph::Compile() {
+	assert(!isCompiled_ && "RenderGraph is already compiled");
+	CullPasses();
+	ComputeLifetimes();
+	AssignPhysicals();
+	BuildBarriers();
+	isCompiled_ = true;
+}
+
+void RenderGraph::Execute(const BarrierFunction& barrierFunction)const {
+	assert(isCompiled_ && "RenderGraph::Compile must be called before Execute");
+	for (uint32_t i = 0; i < passes_.size(); ++i) {
+		const Pass& pass = passes_[i];
+		if (pass.isCulled) {
+			continue;
+		}
+		if (pass.barrierCount > 0) {
+			barrierFunction(GetBarriers(i));
+		}
+		pass.function();
+	}
+}
+
+uint32_t RenderGraph::GetPhysicalIndex(ResourceHandle resource)const {
+	assert(resource < resources_.size());
+	assert(resources_[resource].physicalIndex != UINT32_MAX && "RenderGraph resource is not used by any pass");
+	return resources_[resource].physicalIndex;
+}
+
+uint32_t RenderGraph::GetPhysicalCount()const {
+	return static_cast<uint32_t>(physicals_.size());
+}
+
+bool RenderGraph::IsTransientPhysical(uint32_t physicalIndex)const {
+	assert(physicalIndex < physicals_.size());
+	return physicals_[physicalIndex].isTransient;
+}
+
+const RenderGraph::TextureDesc& RenderGraph::GetPhysicalDesc(uint32_t physicalIndex)const {
+	assert(physicalIndex < physicals_.size());
+	return physicals_[physicalIndex].desc;
+}
+
+RenderGraphAccess RenderGraph::GetPhysicalState(uint32_t physicalIndex)const {
+	assert(physicalIndex < physicals_.size());
+	return physicals_[physicalIndex].state;
+}
+
+bool RenderGraph::IsCulled(uint32_t pass)const {
+	assert(isCompiled_);
+	assert(pass < passes_.size());
+	return passes_[pass].isCulled;
+}
+
+uint32_t RenderGraph::GetExecutedPassCount()const {
+	assert(isCompiled_);
+	uint32_t count = 0;
+	for (const Pass& pass : passes_) {
+		if (!pass.isCulled) {
+			count++;
+		}
+	}
+	return count;
+}
+
+std::span<const RenderGraph::Barrier> RenderGraph::GetBarriers(uint32_t pass)const {
+	assert(isCompiled_);
+	assert(pass < passes_.size());
+	return std::span<const Barrier>(barriers_.data() + passes_[pass].barrierBegin, passes_[pass].barrierCount);
+}
+
+uint32_t RenderGraph::GetBarrierCount()const {
+	return static_cast<uint32_t>(barriers_.size());
+}
+
+void RenderGraph::AddUse(uint32_t pass, ResourceHandle resource, RenderGraphAccess access) {
+	assert(!isCompiled_ && "RenderGraph is already compiled");
+	assert(resource < resources_.size());
+	// 読み書きは追加した直後のパスにだけ宣言できる(usesを連続させるため)
+	assert(pass + 1 == passes_.size() && "RenderGraph uses must be declared right after AddPass");
+	Pass& target = passes_[pass];
+
+	// 同じリソースを別の使い方でも使うならまとめる
+	for (uint32_t i = target.useBegin; i < target.useBegin + target.useCount; ++i) {
+		if (uses_[i].resource == resource) {
+			uses_[i].access = uses_[i].access | access;
+			// 書き込みはほかの使い方と同時にできない
+			assert(!IsWriteAccess(uses_[i].access) || uses_[i].access == access);
+			return;
+		}
+	}
+	uses_.push_back(ResourceUse{ .resource = resource, .access = access });
+	target.useCount++;
+}
+
+void RenderGraph::CullPasses() {
+	// パスは書き込み先の数、リソースは読むパスの数で参照を数える
+	for (Pass& pass : passes_) {
+		pass.refCount = 0;
+		pass.isCulled = false;
+		for (uint32_t i = pass.useBegin; i < pass.useBegin + pass.useCount; ++i) {
+			if (IsWriteAccess(uses_[i].access)) {
+				pass.refCount++;
+			} else {
+				resources_[uses_[i].resource].refCount++;
+			}
+		}
+	}
+	for (Resource& resource : resources_) {
+		// グラフの後で使うものは読まれているものとして扱う
+		if (resource.isOutput) {
+			resource.refCount++;
+		}
+	}
+
+	// 読まれないリソースと、書き込み先がないパスから間引きを始める
+	unreferenced_.clear();
+	for (uint32_t i = 0; i < resources_.size(); ++i) {
+		if (resources_[i].refCount == 0) {
+			unreferenced_.push_back(i);
+		}
+	}
+	for (uint32_t i = 0; i < passes_.size(); ++i) {
+		if (passes_[i].refCount == 0 && !passes_[i].hasSideEffect) {
+			CullPass(i, unreferenced_);
+		}
+	}
+
+	// 読まれないリソースに書き込むパスの参照を減らし、なくなったら間引く
+	while (!unreferenced_.empty()) {
+		const ResourceHandle resource = unreferenced_.back();
+		unreferenced_.pop_back();
+		for (uint32_t i = 0; i < passes_.size(); ++i) {
+			Pass& pass = passes_[i];
+			if (pass.isCulled) {
+				continue;
+			}
+			for (uint32_t use = pass.useBegin; use < pass.useBegin + pass.useCount; ++use) {
+				if (uses_[use].resource != resource || !IsWriteAccess(uses_[use].access)) {
+					continue;
+				}
+				assert(pass.refCount > 0);
+				pass.refCount--;
+				if (pass.refCount == 0 && !pass.hasSideEffect) {
+					CullPass(i, unreferenced_);
+				}
+			}
+		}
+	}
+}
+
+void RenderGraph::CullPass(uint32_t pass, std::vector<ResourceHandle>& unreferenced) {
+	Pass& target = passes_[pass];
+	target.isCulled = true;
+	for (uint32_t i = target.useBegin; i < target.useBegin + target.useCount; ++i) {
+		if (IsWriteAccess(uses_[i].access)) {
+			continue;
+		}
+		Resource& resource = resources_[uses_[i].resource];
+		assert(resource.refCount > 0);
+		resource.refCount--;
+		if (resource.refCount == 0) {
+			unreferenced.push_back(uses_[i].resource);
+		}
+	}
+}
+
+void RenderGraph::ComputeLifetimes() {
+	for (uint32_t i = 0; i < passes_.size(); ++i) {
+		const Pass& pass = passes_[i];
+		if (pass.isCulled) {
+			continue;
+		}
+		for (uint32_t use = pass.useBegin; use < pass.useBegin + pass.useCount; ++use) {
+			Resource& resource = resources_[uses_[use].resource];
+			if (resource.firstPass == UINT32_MAX) {
+				resource.firstPass = i;
+			}
+			resource.lastPass = i;
+		}
+	}
+	for (Resource& resource : resources_) {
+		// グラフの後で使うものは最後まで生かす
+		if (resource.isOutput && resource.firstPass != UINT32_MAX) {
+			resource.lastPass = static_cast<uint32_t>(passes_.size());
+		}
+	}
+}
+
+void RenderGraph::AssignPhysicals() {
+	for (Physical& physical : physicals_) {
+		physical.isAssigned = false;
+	}
+
+	// パスの順に、最初に使うパスで実体を割り当てる
+	for (uint32_t i = 0; i < passes_.size(); ++i) {
+		const Pass& pass = passes_[i];
+		if (pass.isCulled) {
+			continue;
+		}
+		for (uint32_t use = pass.useBegin; use < pass.useBegin + pass.useCount; ++use) {
+			Resource& resource = resources_[uses_[use].resource];
+			if (resource.isImported || resource.firstPass != i) {
+				continue;
+			}
+			// 一時リソースは中身が決まっていないので、最初は書き込みでなければならない
+			assert(IsWriteAccess(uses_[use].access) && "RenderGraph transient resource is read before written");
+
+			// 設定が同じで、このパスより前に使い終わった実体を使い回す
+			uint32_t physicalIndex = UINT32_MAX;
+			for (uint32_t p = 0; p < physicals_.size(); ++p) {
+				const Physical& physical = physicals_[p];
+				if (physical.isTransient && physical.desc == resource.desc &&
+					(!physical.isAssigned || physical.lastPass < i)) {
+					physicalIndex = p;
+					break;
+				}
+			}
+			// なければ新しく作る
+			if (physicalIndex == UINT32_MAX) {
+				physicals_.push_back(Physical{
+					.desc = resource.desc,
+					.isTransient = true,
+					.state = kTransientInitialState,
+					});
+				physicalIndex = static_cast<uint32_t>(physicals_.size() - 1);
+			}
+
+			Physical& physical = physicals_[physicalIndex];
+			physical.isAssigned = true;
+			physical.lastPass = resource.lastPass;
+			resource.physicalIndex = physicalIndex;
+		}
+	}
+}
+
+void RenderGraph::BuildBarriers() {
+	for (Pass& pass : passes_) {
+		pass.barrierBegin = static_cast<uint32_t>(barriers_.size());
+		pass.barrierCount = 0;
+		if (pass.isCulled) {
+			continue;
+		}
+		for (uint32_t use = pass.useBegin; use < pass.useBegin + pass.useCount; ++use) {
+			const uint32_t physicalIndex = resources_[uses_[use].resource].physicalIndex;
+			Physical& physical = physicals_[physicalIndex];
+			const RenderGraphAccess after = uses_[use].access;
+
+			// 読むだけなら、今の読み取り状態に含まれていればそのまま読める
+			const bool isSameState = physical.state == after;
+			const bool isIncludedRead = !IsWriteAccess(physical.state) && !IsWriteAccess(after) &&
+				(physical.state & after) == after;
+			if (isSameState || isIncludedRead) {
+				continue;
+			}
+
+			barriers_.push_back(Barrier{
+				.physicalIndex = physicalIndex,
+				.before = physical.state,
+				.after = after,
+				});
+			pass.barrierCount++;
+			physical.state = after;
+		}
+	}
+}
@@ -0,0 +1,170 @@
+#pragma once
+
+// C++
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+
+// MyHedder
+#include "Enums/RenderGraphEnum.h"
+
+/// <summary>
+/// レンダーグラフ
+/// 毎フレーム、パスと各パスが読み書きするリソースを宣言してからCompileすると、
+/// 結果が使われないパスを間引き、寿命の重ならない一時リソースに同じ実体を割り当て、各パスの前に張るバリアを求める
+/// GPUには触らないので単体で動かせる(実体の作成とバリアの発行は使う側が行う)
+/// </summary>
+class RenderGraph {
+public:
+	// フレーム内のリソースの番号
+	using ResourceHandle = uint32_t;
+	// パスの処理
+	using ExecuteFunction = std::function<void()>;
+
+	// 一時リソースの設定(同じ設定のものだけ実体を共有する)
+	struct TextureDesc {
+		uint32_t width = 0;
+		uint32_t height = 0;
+		// DXGI_FORMATの値
+		uint32_t format = 0;
+
+		bool operator==(const TextureDesc&)const = default;
+	};
+
+	// パスの前に張るバリア
+	struct Barrier {
+		// 実体の番号
+		uint32_t physicalIndex = 0;
+		RenderGraphAccess before = RenderGraphAccess::None;
+		RenderGraphAccess after = RenderGraphAccess::None;
+	};
+	// バリアを発行する処理
+	using BarrierFunction = std::function<void(std::span<const Barrier>)>;
+
+	// 一時リソースの実体を作ったときの状態(レンダーターゲットとして作る)
+	static constexpr RenderGraphAccess kTransientInitialState = RenderGraphAccess::RenderTarget;
+
+	RenderGraph();
+	~RenderGraph();
+
+	// グラフの外で作ったリソースの実体を登録して番号を返す(状態はフレームをまたいで追い続ける)
+	uint32_t RegisterExternal(RenderGraphAccess initialState);
+
+	// フレームの開始。前のフレームで宣言したパスとリソースを捨てる(実体と状態は残す)
+	void Begin();
+	// 登録した実体をこのフレームで使う
+	ResourceHandle Import(uint32_t physicalIndex);
+	// 一時リソースを宣言する(実体はCompileで割り当てる)
+	ResourceHandle CreateTexture(const TextureDesc& desc);
+	// パスを追加して番号を返す(読み書きは追加した直後に宣言する)
+	uint32_t AddPass(const char* name, ExecuteFunction function);
+	// パスでリソースを読む
+	void Read(uint32_t pass, ResourceHandle resource, RenderGraphAccess access);
+	// パスでリソースに書き込む
+	void Write(uint32_t pass, ResourceHandle resource, RenderGraphAccess access);
+	// 読むパスがなくても間引かないパスにする(スワップチェーンへの描画など)
+	void SetSideEffect(uint32_t pass);
+	// グラフの後で使うリソースにする(書き込むパスを間引かない)
+	void MarkOutput(ResourceHandle resource);
+
+	// 間引きと実体の割り当てとバリアを求め、実体の状態を最後のパスの後へ進める
+	void Compile();
+	// 残ったパスを順に実行する(バリアがあればパスの前にbarrierFunctionへ渡す)
+	void Execute(const BarrierFunction& barrierFunction)const;
+
+	// リソースに割り当てた実体の番号
+	[[nodiscard]] uint32_t GetPhysicalIndex(ResourceHandle resource)const;
+	// 実体の数(登録したものと一時リソースの合計)
+	[[nodiscard]] uint32_t GetPhysicalCount()const;
+	// 一時リソースの実体か
+	[[nodiscard]] bool IsTransientPhysical(uint32_t physicalIndex)const;
+	// 一時リソースの実体の設定
+	[[nodiscard]] const TextureDesc& GetPhysicalDesc(uint32_t physicalIndex)const;
+	// 実体の状態
+	[[nodiscard]] RenderGraphAccess GetPhysicalState(uint32_t physicalIndex)const;
+	// パスが間引かれたか
+	[[nodiscard]] bool IsCulled(uint32_t pass)const;
+	// 間引かれなかったパスの数
+	[[nodiscard]] uint32_t GetExecutedPassCount()const;
+	// パスの前に張るバリア
+	[[nodiscard]] std::span<const Barrier> GetBarriers(uint32_t pass)const;
+	// バリアの総数
+	[[nodiscard]] uint32_t GetBarrierCount()const;
+
+private:
+	// パスが使うリソース
+	struct ResourceUse {
+		ResourceHandle resource = 0;
+		RenderGraphAccess access = RenderGraphAccess::None;
+	};
+
+	// パス
+	struct Pass {
+		const char* name = nullptr;
+		ExecuteFunction function;
+		// uses_の範囲
+		uint32_t useBegin = 0;
+		uint32_t useCount = 0;
+		// barriers_の範囲
+		uint32_t barrierBegin = 0;
+		uint32_t barrierCount = 0;
+		// 書き込み先のうち、まだ読まれる可能性があるものの数
+		uint32_t refCount = 0;
+		bool hasSideEffect = false;
+		bool isCulled = false;
+	};
+
+	// フレーム内のリソース
+	struct Resource {
+		TextureDesc desc{};
+		// 外部のリソースか
+		bool isImported = false;
+		// グラフの後で使うか
+		bool isOutput = false;
+		// 割り当てた実体
+		uint32_t physicalIndex = UINT32_MAX;
+		// 読むパスのうち残っているものの数
+		uint32_t refCount = 0;
+		// 最初と最後に使うパス
+		uint32_t firstPass = UINT32_MAX;
+		uint32_t lastPass = 0;
+	};
+
+	// 実体
+	struct Physical {
+		TextureDesc desc{};
+		bool isTransient = false;
+		// 今の状態
+		RenderGraphAccess state = RenderGraphAccess::None;
+		// このフレームで割り当て済みか
+		bool isAssigned = false;
+		// 割り当てたリソースを使い終わるパス
+		uint32_t lastPass = 0;
+	};
+
+private:
+	// 読み書きを追加する(同じパスで同じリソースを使うときはまとめる)
+	void AddUse(uint32_t pass, ResourceHandle resource, RenderGraphAccess access);
+	// 結果が使われないパスを間引く
+	void CullPasses();
+	// パスを間引いて、読んでいたリソースの参照を減らす
+	void CullPass(uint32_t pass, std::vector<ResourceHandle>& unreferenced);
+	// 残ったパスからリソースの寿命を求める
+	void ComputeLifetimes();
+	// 寿命の重ならない一時リソースに同じ実体を割り当てる
+	void AssignPhysicals();
+	// 実体の状態を追ってパスの前のバリアを求める
+	void BuildBarriers();
+
+private:
+	std::vector<Pass> passes_;
+	std::vector<ResourceUse> uses_;
+	std::vector<Resource> resources_;
+	std::vector<Physical> physicals_;
+	std::vector<Barrier> barriers_;
+	// 間引きの作業領域
+	std::vector<ResourceHandle> unreferenced_;
+	// Compile済みか
+	bool isCompiled_ = false;
+};
@@ -16,9 +16,30 @@
 #include "Camera3DManager/Camera3DManager.h"
 #include "LightManager/LightManager.h"
 #include "3D/Drawer3D/SkyBoxDrawer/SkyBoxDrawer.h"
+#include "WindowApp/WindowApp.h"
 
 #include "Logger/Logger.h"
 
+namespace {
+	// レンダーグラフの使い方をリソースの状態にする
+	D3D12_RESOURCE_STATES ToResourceState(RenderGraphAccess access) {
+		D3D12_RESOURCE_STATES state = D3D12_RESOURCE_STATE_COMMON;
+		if ((access & RenderGraphAccess::RenderTarget) != RenderGraphAccess::None) {
+			state |= D3D12_RESOURCE_STATE_RENDER_TARGET;
+		}
+		if ((access & RenderGraphAccess::DepthWrite) != RenderGraphAccess::None) {
+			state |= D3D12_RESOURCE_STATE_DEPTH_WRITE;
+		}
+		if ((access & RenderGraphAccess::DepthRead) != RenderGraphAccess::None) {
+			state |= D3D12_RESOURCE_STATE_DEPTH_READ;
+		}
+		if ((access & RenderGraphAccess::ShaderRead) != RenderGraphAccess::None) {
+			state |= D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
+		}
+		return state;
+	}
+}
+
 RenderController::RenderController(
 	DXGI* dxgi,
 	DirectXCommand* directXCommand,
@@ -32,7 +53,8 @@ RenderController::RenderController(
 	ShadowPipelineManager* shadowPipelineManager,
 	Camera3DManager* camera3DManager,
 	LightManager* lightManager,
-	SkyBoxDrawer* skyBoxDrawer
+	SkyBoxDrawer* skyBoxDrawer,
+	FrameArena* frameArena
 ) {
 	// インスタンスを受け取る
 	SetDXGI(dxgi);
@@ -48,24 +70,11 @@ RenderController::RenderController(
 	SetCamera3DManager(camera3DManager);
 	SetLightManager(lightManager);
 	SetSkyBoxDrawer(skyBoxDrawer);
+	SetFrameArena(frameArena);
 
 	// パラメータ用のリソースを作成
 	CreatePostEffectParamaterResource();
 
-	// シーン描画用のレンダーテクスチャ
-	sceneRenderTexture_ = std::make_unique<ColorRenderTexture>();
-	sceneRenderTexture_->Initialize();
-
-	// 最終描画用のレンダーテクスチャ
-	finalRenderTexture_ = std::make_unique<ColorRenderTexture>();
-	finalRenderTexture_->Initialize();
-
-	// カラーポストエフェクト用のレンダーテクスチャ
-	for (uint32_t i = 0; i < 2; i++) {
-		colorPostEffectRenderTexture_[i] = std::make_unique<ColorRenderTexture>();
-		colorPostEffectRenderTexture_[i]->Initialize();
-	}
-
 	// GBuffr用のレンダーテクスチャ
 	// アルベド
 	gBufferAlbedoRenderTexture_ = std::make_unique<GBufferAlbedoRenderTexture>();
@@ -78,16 +87,127 @@ RenderController::RenderController(
 	// Shadow用の深度テクスチャ
 	shadowDepthTexture_ = std::make_unique<ShadowDepthTexture>();
 
-	// コマンドの最大数をあらかじめ決めておく
-	postEffectCommand_.resize(kMaxPostEffectNum_);
+	// コマンドはフレーム単位の一時メモリに積む
+	postEffectCommand_ = FrameVector<PostEffectCommand>(FrameArenaAllocator<PostEffectCommand>(frameArena_));
+	pendingPostEffectCommand_ = FrameVector<PostEffectCommand>(FrameArenaAllocator<PostEffectCommand>(frameArena_));
+
+	// ポストエフェクトをまとめる
+	postEffectPlanner_ = std::make_unique<PostEffectPlanner>();
+
+	// レンダーグラフ
+	renderGraph_ = std::make_unique<RenderGraph>();
+
+	// フレームをまたいで使うリソースを作った時の状態で登録する
+	shadowDepthPhysicalIndex_ = RegisterExternalResource(shadowDepthTexture_->GetResource(), RenderGraphAccess::DepthWrite);
+	depthStencilPhysicalIndex_ = RegisterExternalResource(depthStencil_->GetResource(), RenderGraphAccess::DepthWrite);
+	gBufferAlbedoPhysicalIndex_ = RegisterExternalResource(gBufferAlbedoRenderTexture_->GetResource(), RenderGraphAccess::RenderTarget);
+	gBufferNormalPhysicalIndex_ = RegisterExternalResource(gBufferNormalRenderTexture_->GetResource(), RenderGraphAccess::RenderTarget);
+
+	// シーン、ポストエフェクトのカラーはフレームの中だけで使う一時リソースにする
+	colorTextureDesc_ = RenderGraph::TextureDesc{
+		.width = static_cast<uint32_t>(WindowApp::kClientWidth),
+		.height = static_cast<uint32_t>(WindowApp::kClientHeight),
+		.format = static_cast<uint32_t>(DXGI_FORMAT_R8G8B8A8_UNORM_SRGB),
+	};
+	halfColorTextureDesc_ = RenderGraph::TextureDesc{
+		.width = colorTextureDesc_.width / 2,
+		.height = colorTextureDesc_.height / 2,
+		.format = colorTextureDesc_.format,
+	};
 }
 
 RenderController::~RenderController() {}
 
-void RenderController::PreShadowRender() {
-	// まずリソース状態を「書き込み可能」に遷移
-	shadowDepthTexture_->TransitionToWrite();
+void RenderController::BeginRenderGraph() {
+	renderGraph_->Begin();
+	shadowDepthHandle_ = renderGraph_->Import(shadowDepthPhysicalIndex_);
+	depthStencilHandle_ = renderGraph_->Import(depthStencilPhysicalIndex_);
+	gBufferAlbedoHandle_ = renderGraph_->Import(gBufferAlbedoPhysicalIndex_);
+	gBufferNormalHandle_ = renderGraph_->Import(gBufferNormalPhysicalIndex_);
+}
+
+void RenderController::AddShadowPass(RenderGraph::ExecuteFunction draw) {
+	const uint32_t pass = renderGraph_->AddPass("Shadow", [this, draw = std::move(draw)]() {
+		PreShadowRender();
+		draw();
+		});
+	renderGraph_->Write(pass, shadowDepthHandle_, RenderGraphAccess::DepthWrite);
+}
 
+void RenderController::AddGBufferPass(RenderGraph::ExecuteFunction draw) {
+	const uint32_t pass = renderGraph_->AddPass("GBuffer", [this, draw = std::move(draw)]() {
+		PreRenderForGBuffers();
+		draw();
+		});
+	renderGraph_->Write(pass, gBufferAlbedoHandle_, RenderGraphAccess::RenderTarget);
+	renderGraph_->Write(pass, gBufferNormalHandle_, RenderGraphAccess::RenderTarget);
+	renderGraph_->Write(pass, depthStencilHandle_, RenderGraphAccess::DepthWrite);
+}
+
+void RenderController::AddScenePass(RenderGraph::ExecuteFunction draw) {
+	const RenderGraph::ResourceHandle sceneColor = renderGraph_->CreateTexture(colorTextureDesc_);
+	const uint32_t pass = renderGraph_->AddPass("Scene", [this, sceneColor, draw = std::move(draw)]() {
+		PreSceneRender(GetTransientRenderTexture(sceneColor));
+		LightingPass();
+		draw();
+		});
+	renderGraph_->Read(pass, gBufferAlbedoHandle_, RenderGraphAccess::ShaderRead);
+	renderGraph_->Read(pass, gBufferNormalHandle_, RenderGraphAccess::ShaderRead);
+	// 深度はライティングで読みつつ、重ねて描くものの深度テストに使う
+	renderGraph_->Read(pass, depthStencilHandle_, RenderGraphAccess::DepthRead | RenderGraphAccess::ShaderRead);
+	renderGraph_->Read(pass, shadowDepthHandle_, RenderGraphAccess::ShaderRead);
+	renderGraph_->Write(pass, sceneColor, RenderGraphAccess::RenderTarget);
+	currentColorHandle_ = sceneColor;
+}
+
+void RenderController::AddPostEffectPasses() {
+	// 続けてかけられるコマンドをひとつのパスにまとめる
+	postEffectPlanner_->Plan(postEffectCommand_);
+	const std::span<const PostEffectPass> passes = postEffectPlanner_->GetPasses();
+
+	// ひとつ前の結果を読んで新しい一時リソースに書く(寿命が重ならないので同じ大きさの実体は2枚を使い回す)
+	for (uint32_t i = 0; i < static_cast<uint32_t>(passes.size()); i++) {
+		const RenderGraph::ResourceHandle input = currentColorHandle_;
+		const RenderGraph::ResourceHandle output = renderGraph_->CreateTexture(passes[i].isHalfResolution ? halfColorTextureDesc_ : colorTextureDesc_);
+		const uint32_t pass = renderGraph_->AddPass("PostEffect", [this, passes, i, input, output]() {
+			ApplyPostEffect(passes[i], i, GetTransientRenderTexture(input), GetTransientRenderTexture(output));
+			});
+		renderGraph_->Read(pass, input, RenderGraphAccess::ShaderRead);
+		renderGraph_->Write(pass, output, RenderGraphAccess::RenderTarget);
+		currentColorHandle_ = output;
+	}
+}
+
+void RenderController::AddSwapChainPass(RenderGraph::ExecuteFunction draw) {
+	finalColorHandle_ = currentColorHandle_;
+	const uint32_t pass = renderGraph_->AddPass("SwapChain", std::move(draw));
+	renderGraph_->Read(pass, finalColorHandle_, RenderGraphAccess::ShaderRead);
+	// スワップチェーンはグラフの外なので間引かない
+	renderGraph_->SetSideEffect(pass);
+}
+
+void RenderController::CompileRenderGraph() {
+	renderGraph_->Compile();
+
+	// 増えた実体の一時レンダーテクスチャを作る(描画スレッドが止まっている間にディスクリプタを確保する)
+	for (uint32_t i = static_cast<uint32_t>(physicalResources_.size()); i < renderGraph_->GetPhysicalCount(); i++) {
+		assert(renderGraph_->IsTransientPhysical(i));
+		const RenderGraph::TextureDesc& desc = renderGraph_->GetPhysicalDesc(i);
+		assert(desc.format == colorTextureDesc_.format);
+		std::unique_ptr<ColorRenderTexture> renderTexture = std::make_unique<ColorRenderTexture>();
+		renderTexture->Initialize(desc.width, desc.height);
+		physicalResources_.push_back(renderTexture->GetResource());
+		transientRenderTextures_.push_back(std::move(renderTexture));
+	}
+}
+
+void RenderController::ExecuteRenderGraph() {
+	renderGraph_->Execute([this](std::span<const RenderGraph::Barrier> barriers) {
+		ResourceBarrier(barriers);
+		});
+}
+
+void RenderController::PreShadowRender() {
 	// シャドウマップをクリア
 	shadowDepthTexture_->Clear();
 
@@ -99,10 +219,6 @@ void RenderController::PreShadowRender() {
 	scissorRect_->SettingScissorRect(ShadowDepthTexture::kShadowMapWidth, ShadowDepthTexture::kShadowMapHeight);
 }
 
-void RenderController::PostShadowRender() {
-	shadowDepthTexture_->TransitionToRead();
-}
-
 void RenderController::PreRenderForGBuffers() {
 	// Gバッファ2枚＋深度バッファをセットする
 	std::array<D3D12_CPU_DESCRIPTOR_HANDLE, 2> rtvs = {
@@ -123,19 +239,10 @@ void RenderController::PreRenderForGBuffers() {
 	scissorRect_->SettingScissorRect();
 }
 
-void RenderController::PostRenderForGBuffers() {
-	// ライティング前に、GバッファをSRV用に遷移
-	gBufferAlbedoRenderTexture_->TransitionToRead();
-	gBufferNormalRenderTexture_->TransitionToRead();
-
-	// 深度バッファをSRV用に遷移
-	depthStencil_->TransitionToRead();
-}
-
-void RenderController::PreSceneRender() {
+void RenderController::PreSceneRender(ColorRenderTexture* sceneRenderTexture) {
 	// SceneRenderTextureに書き込む
-	sceneRenderTexture_->SetAsRenderTarget(depthStencil_->GetDepthStencilResorceCPUHandle());
-	sceneRenderTexture_->ClearRenderTarget();
+	sceneRenderTexture->SetAsRenderTarget(depthStencil_->GetDepthStencilResorceCPUHandle());
+	sceneRenderTexture->ClearRenderTarget();
 
 	// ビューポートとシザー設定
 	viewport_->SettingViewport();
@@ -178,74 +285,46 @@ void RenderController::LightingPass() {
 	commandList->DrawInstanced(3, 1, 0, 0);
 }
 
-void RenderController::PostSceneRender() {
-	// シーン描画用のレンダーターゲットを読み取り状態に
-	sceneRenderTexture_->TransitionToRead();
-	// 現在のテクスチャをシーン描画結果に
-	currentRenderTexture_ = sceneRenderTexture_.get();
-}
-
-void RenderController::ApplyPostEffect() {
-	// 今回積まれているポストエフェクトの数を取得
-	const uint32_t currentFramePostEffectNum = currentCommandIndex_;
-	if (currentFramePostEffectNum == 0) {
-		return; // 何もなければリターン
-	}
-
+void RenderController::ApplyPostEffect(const PostEffectPass& pass, uint32_t paramIndex, ColorRenderTexture* input, ColorRenderTexture* output) {
 	// コマンドリスト取得
 	ID3D12GraphicsCommandList* commandList = directXCommand_->GetList();
 
-	for (uint32_t i = 0; i < currentFramePostEffectNum; i++) {
-		auto& command = postEffectCommand_[i];
-
-		switch (command.postEffectType) {
-		case PostEffectType::Copy:
-		case PostEffectType::Grayscale:
-			DrawRenderTextureNoParamater(commandList, command.postEffectType);
-			break;
-		case PostEffectType::Vignette:
-		case PostEffectType::GaussianX:
-		case PostEffectType::GaussianY:
-		case PostEffectType::RadialBlur:
-			DrawRenderTextureWithParamater(commandList, command);
-			break;
-		}
-
+	// レンダーターゲットを設定(全画面の三角形ですべての画素を上書きするのでクリアしない)
+	output->SetAsRenderTarget();
+
+	// ビューポート、シザーは書き込むテクスチャの大きさに合わせる
+	viewport_->SettingViewport(output->GetWidth(), output->GetHeight());
+	scissorRect_->SettingScissorRect(output->GetWidth(), output->GetHeight());
+
+	// パスに対応するパイプラインを設定
+	switch (pass.passType) {
+	case PostEffectPassType::Color:
+		// 有効にする処理の組み合わせでシェーダーを選ぶ
+		commandList->SetGraphicsRootSignature(postEffectPipelineManager_->GetFusedColorRootSignature(pass.colorOps));
+		commandList->SetPipelineState(postEffectPipelineManager_->GetFusedColorPipelineState(pass.colorOps, BlendMode::None));
+		break;
+	case PostEffectPassType::GaussianX:
+		commandList->SetGraphicsRootSignature(postEffectPipelineManager_->GetRootSignature(PostEffectType::GaussianX));
+		commandList->SetPipelineState(postEffectPipelineManager_->GetPipelineState(PostEffectType::GaussianX, BlendMode::None));
+		break;
+	case PostEffectPassType::GaussianY:
+		commandList->SetGraphicsRootSignature(postEffectPipelineManager_->GetRootSignature(PostEffectType::GaussianY));
+		commandList->SetPipelineState(postEffectPipelineManager_->GetPipelineState(PostEffectType::GaussianY, BlendMode::None));
+		break;
 	}
-
-	// 最後の結果がcurrentRenderTexture_に入っている
-	currentRenderTarget_ = nullptr; // 使い終わったのでnullに
-	currentCommandIndex_ = 0; // コマンドバッファをリセット
-}
-
-void RenderController::RenderToFinalRenderTexture() {
-	// コマンドリスト取得
-	ID3D12GraphicsCommandList* commandList = directXCommand_->GetList();
-
-	// レンダーターゲットを最終描画用のレンダーテクスチャに指定
-	finalRenderTexture_->SetAsRenderTarget();
-	finalRenderTexture_->ClearRenderTarget();
-	// ビューポートの設定
-	viewport_->SettingViewport();
-	// シザー矩形の設定
-	scissorRect_->SettingScissorRect();
-
-	// 最終レンダーテクスチャに描画
-	// ルートシグネイチャを設定
-	commandList->SetGraphicsRootSignature(postEffectPipelineManager_->GetRootSignature(PostEffectType::Copy));
-	// PSOを設定
-	commandList->SetPipelineState(postEffectPipelineManager_->GetPipelineState(PostEffectType::Copy, BlendMode::None));
-	// 形状を設定
 	commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
-	// ディスクリプタハンドルを指定
-	commandList->SetGraphicsRootDescriptorTable(0, srvUavManager_->GetDescriptorHandleGPU(currentRenderTexture_->GetSrvIndex()));
+	// 入力するテクスチャはひとつ前に描画したレンダーテクスチャ(縮小バッファならバイリニアで拡大して読む)
+	commandList->SetGraphicsRootDescriptorTable(0, srvUavManager_->GetDescriptorHandleGPU(input->GetSrvIndex()));
+
+	// パラメータを更新して送信
+	assert(paramIndex < kMaxPostEffectNum_);
+	const uint32_t frameIndex = directXCommand_->GetFrameIndex();
+	std::memcpy(postEffectParamData_[frameIndex][paramIndex], &pass.param, sizeof(PostEffectParamater));
+	commandList->SetGraphicsRootConstantBufferView(1, postEffectParamResource_[frameIndex][paramIndex]->GetGPUVirtualAddress());
 
 	// 描画
 	commandList->DrawInstanced(3, 1, 0, 0);
-
-	// 最終レンダーテクスチャを読み取り可能状態にする
-	finalRenderTexture_->TransitionToRead();
 }
 
 void RenderController::RenderToSwapChain() {
@@ -260,122 +339,57 @@ void RenderController::RenderToSwapChain() {
 	commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
 	// ディスクリプタハンドルを指定
-	commandList->SetGraphicsRootDescriptorTable(0, srvUavManager_->GetDescriptorHandleGPU(finalRenderTexture_->GetSrvIndex()));
+	commandList->SetGraphicsRootDescriptorTable(0, srvUavManager_->GetDescriptorHandleGPU(GetTransientRenderTexture(finalColorHandle_)->GetSrvIndex()));
 
 	// 描画
 	commandList->DrawInstanced(3, 1, 0, 0);
 }
 
-void RenderController::EndFrame() {
-	// レンダーテクスチャをnullptrに
-	currentRenderTarget_ = nullptr;
-	currentRenderTexture_ = nullptr;
-
-	// 次のフレーム用に書き込み可能状態にする
-	gBufferAlbedoRenderTexture_->TransitionToWrite();
-	gBufferNormalRenderTexture_->TransitionToWrite();
-
-	depthStencil_->TransitionToWrite();
-
-	sceneRenderTexture_->TransitionToWrite();
-	finalRenderTexture_->TransitionToWrite();
-
-	for (uint32_t i = 0; i < 2; i++) {
-		colorPostEffectRenderTexture_[i]->TransitionToWrite();
-	}
-
-}
-
 void RenderController::AddPostEffect(const PostEffectCommand& command) {
+	const uint32_t commandIndex = static_cast<uint32_t>(pendingPostEffectCommand_.size());
+	assert(commandIndex < kMaxPostEffectNum_);
 	// コマンドを追加
-	postEffectCommand_[currentCommandIndex_] = command;
-	// インデックスを登録
-	postEffectCommand_[currentCommandIndex_].index = currentCommandIndex_;
-	// コマンドインデックスをインクリメント
-	currentCommandIndex_++;
-}
-
-void RenderController::SwitchColorRenderTextureIndex() {
-	if (currentColorPostEffectRenderTextureIndex_ == 0) {
-		currentColorPostEffectRenderTextureIndex_ = 1;
-	} else {
-		currentColorPostEffectRenderTextureIndex_ = 0;
-	}
+	pendingPostEffectCommand_.push_back(command);
+	// インデックスを登録(パラメータ用リソースの番号)
+	pendingPostEffectCommand_.back().index = commandIndex;
 }
 
-void RenderController::DrawRenderTextureNoParamater(ID3D12GraphicsCommandList* commandList, const PostEffectType& type) {
-	// 現在の書き込み先のレンダーテクスチャを切り替え
-	currentRenderTarget_ = colorPostEffectRenderTexture_[currentColorPostEffectRenderTextureIndex_].get();
-	// 書き込み可能状態にする
-	currentRenderTarget_->TransitionToWrite();
-	// 次のポストエフェクト用にレンダーテクスチャを切り替え
-	SwitchColorRenderTextureIndex();
-
-	// レンダーターゲットを設定
-	currentRenderTarget_->SetAsRenderTarget();
-	currentRenderTarget_->ClearRenderTarget();
-
-	// ビューポート、シザー設定
-	viewport_->SettingViewport();
-	scissorRect_->SettingScissorRect();
-
-	// ポストエフェクトに対応するパイプラインを設定
-	commandList->SetGraphicsRootSignature(postEffectPipelineManager_->GetRootSignature(type));
-	commandList->SetPipelineState(postEffectPipelineManager_->GetPipelineState(type, BlendMode::None));
-	commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-
-	// 入力するテクスチャはひとつ前に描画したレンダーテクスチャ
-	commandList->SetGraphicsRootDescriptorTable(0, srvUavManager_->GetDescriptorHandleGPU(currentRenderTexture_->GetSrvIndex()));
-
-	// 描画
-	commandList->DrawInstanced(3, 1, 0, 0);
-
-	// 出力結果を次の入力にする
-	currentRenderTexture_ = currentRenderTarget_;
-
-	// 描画した対象を読み取り可能状態にする
-	currentRenderTexture_->TransitionToRead();
+void RenderController::FlushPostEffect() {
+	// 描画スレッドは前のフレームを記録し終えているので差し替えてよい
+	// 積んだメモリは描画スレッドが読み終わるまで一時メモリに残る
+	postEffectCommand_ = std::move(pendingPostEffectCommand_);
+	pendingPostEffectCommand_ = FrameVector<PostEffectCommand>(FrameArenaAllocator<PostEffectCommand>(frameArena_));
 }
 
-void RenderController::DrawRenderTextureWithParamater(ID3D12GraphicsCommandList* commandList, const PostEffectCommand& command) {
-	// 現在の書き込み先のレンダーテクスチャを切り替え
-	currentRenderTarget_ = colorPostEffectRenderTexture_[currentColorPostEffectRenderTextureIndex_].get();
-	// 書き込み可能状態にする
-	currentRenderTarget_->TransitionToWrite();
-	// 次のポストエフェクト用にレンダーテクスチャを切り替え
-	SwitchColorRenderTextureIndex();
-
-	// レンダーターゲットを設定
-	currentRenderTarget_->SetAsRenderTarget();
-	currentRenderTarget_->ClearRenderTarget();
-
-	// ビューポート、シザー設定
-	viewport_->SettingViewport();
-	scissorRect_->SettingScissorRect();
-
-	// パラメータを更新
-	std::memcpy(postEffectParamData_[command.index], &command.param, sizeof(PostEffectParamater));
-
-	// ポストエフェクトに対応するパイプラインを設定
-	commandList->SetGraphicsRootSignature(postEffectPipelineManager_->GetRootSignature(command.postEffectType));
-	commandList->SetPipelineState(postEffectPipelineManager_->GetPipelineState(command.postEffectType, BlendMode::None));
-	commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-
-	// 入力するテクスチャはひとつ前に描画したレンダーテクスチャ
-	commandList->SetGraphicsRootDescriptorTable(0, srvUavManager_->GetDescriptorHandleGPU(currentRenderTexture_->GetSrvIndex()));
-
-	// パラメータを送信
-	commandList->SetGraphicsRootConstantBufferView(1, postEffectParamResource_[command.index]->GetGPUVirtualAddress());
-
-	// 描画
-	commandList->DrawInstanced(3, 1, 0, 0);
-
-	// 出力結果を次の入力にする
-	currentRenderTexture_ = currentRenderTarget_;
+uint32_t RenderController::RegisterExternalResource(ID3D12Resource* resource, RenderGraphAccess initialState) {
+	assert(resource);
+	const uint32_t physicalIndex = renderGraph_->RegisterExternal(initialState);
+	// 実体の番号と配列の位置をそろえる
+	assert(physicalIndex == physicalResources_.size());
+	physicalResources_.push_back(resource);
+	transientRenderTextures_.push_back(nullptr);
+	return physicalIndex;
+}
 
-	// 描画した対象を読み取り可能状態にする
-	currentRenderTexture_->TransitionToRead();
+ColorRenderTexture* RenderController::GetTransientRenderTexture(RenderGraph::ResourceHandle resource)const {
+	ColorRenderTexture* renderTexture = transientRenderTextures_[renderGraph_->GetPhysicalIndex(resource)].get();
+	assert(renderTexture);
+	return renderTexture;
+}
 
+void RenderController::ResourceBarrier(std::span<const RenderGraph::Barrier> barriers) {
+	assert(barriers.size() <= kMaxBarrierNum_);
+	// パスの前のバリアは一度にまとめて張る
+	std::array<D3D12_RESOURCE_BARRIER, kMaxBarrierNum_> resourceBarriers{};
+	for (size_t i = 0; i < barriers.size(); i++) {
+		D3D12_RESOURCE_BARRIER& barrier = resourceBarriers[i];
+		barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+		barrier.Transition.pResource = physicalResources_[barriers[i].physicalIndex];
+		barrier.Transition.StateBefore = ToResourceState(barriers[i].before);
+		barrier.Transition.StateAfter = ToResourceState(barriers[i].after);
+		barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+	}
+	directXCommand_->GetList()->ResourceBarrier(static_cast<UINT>(barriers.size()), resourceBarriers.data());
 }
 
 void RenderController::SetRenderTargets(const std::array<D3D12_CPU_DESCRIPTOR_HANDLE, 2>& rtvs, D3D12_CPU_DESCRIPTOR_HANDLE dsv) {
@@ -383,10 +397,12 @@ void RenderController::SetRenderTargets(const std::array<D3D12_CPU_DESCRIPTOR_HA
 }
 
 void RenderController::CreatePostEffectParamaterResource() {
-	for (uint32_t i = 0; i < kMaxPostEffectNum_; i++) {
-		postEffectParamResource_[i] = dxgi_->CreateBufferResource(sizeof(PostEffectParamater));
-		HRESULT hr = postEffectParamResource_[i]->Map(0, nullptr, reinterpret_cast<void**>(&postEffectParamData_[i]));
-		assert(SUCCEEDED(hr));
+	for (uint32_t frame = 0; frame < FrameConst::FrameCount; ++frame) {
+		for (uint32_t i = 0; i < kMaxPostEffectNum_; i++) {
+			postEffectParamResource_[frame][i] = dxgi_->CreateBufferResource(sizeof(PostEffectParamater));
+			HRESULT hr = postEffectParamResource_[frame][i]->Map(0, nullptr, reinterpret_cast<void**>(&postEffectParamData_[frame][i]));
+			assert(SUCCEEDED(hr));
+		}
 	}
 }
 
@@ -454,3 +470,8 @@ void RenderController::SetSkyBoxDrawer(SkyBoxDrawer* skyBoxDrawer) {
 	assert(skyBoxDrawer);
 	skyBoxDrawer_ = skyBoxDrawer;
 }
+
+void RenderController::SetFrameArena(FrameArena* frameArena) {
+	assert(frameArena);
+	frameArena_ = frameArena;
+}
@@ -2,9 +2,14 @@
 
 #include <vector>
 #include <memory>
+#include <span>
 
 #include "DirectX/ComPtr/ComPtr.h"
 #include "Structs/PostEffectStruct.h"
+#include "Const/FrameConst.h"
+#include "FrameArena/FrameArena.h"
+#include "RenderGraph/RenderGraph.h"
+#include "PostEffectPlanner/PostEffectPlanner.h"
 
 // シーンカラー用のレンダーテクスチャ
 #include "ResourceTextures/RenderTextures/ColorRenderTexture/ColorRenderTexture.h"
@@ -50,52 +55,68 @@ public:
 		ShadowPipelineManager* shadowPipelineManager,
 		Camera3DManager* camera3DManager,
 		LightManager* lightManager,
-		SkyBoxDrawer* skyBoxDrawer
+		SkyBoxDrawer* skyBoxDrawer,
+		FrameArena* frameArena
 	);
 	~RenderController();
 
-	// シャドウマップ用の深度描画前準備
-	void PreShadowRender();
+	// フレームのレンダーグラフを組み始める(描画スレッドが止まっている間に呼ぶ)
+	void BeginRenderGraph();
 
-	// シャドウマップ用の深度描画後処理
-	void PostShadowRender();
+	// シャドウマップに描画するパスを追加(drawで影を落とすオブジェクトを描画する)
+	void AddShadowPass(RenderGraph::ExecuteFunction draw);
 
-	// シーンを描画するための前準備
-	void PreRenderForGBuffers();
+	// GBufferに描画するパスを追加(drawで不透明なオブジェクトを描画する)
+	void AddGBufferPass(RenderGraph::ExecuteFunction draw);
 
-	// シーン描画後の処理
-	void PostRenderForGBuffers();
+	// ライトを適用してシーン用のレンダーテクスチャに描画するパスを追加(drawでライト適用後に重ねて描画する)
+	void AddScenePass(RenderGraph::ExecuteFunction draw);
 
-	// シーン用のレンダーテクスチャに描画する前の処理
-	void PreSceneRender();
-
-	// ライト適用
-	void LightingPass();
+	// 積まれたポストエフェクトを続けてかけられるものごとにまとめてパスとして追加
+	void AddPostEffectPasses();
 
-	// ライト適用後の処理
-	void PostSceneRender();
+	// スワップチェーンに描画するパスを追加(drawの中でRenderToSwapChainを呼ぶ)
+	// これまでのパスの結果をそのまま読むので最終描画用のコピーは行わない
+	void AddSwapChainPass(RenderGraph::ExecuteFunction draw);
 
-	// ポストエフェクトをpingPong方式でかけていく
-	void ApplyPostEffect();
+	// 間引きと一時リソースの割り当てとバリアを求める(一時リソースが足りなければここで作る)
+	void CompileRenderGraph();
 
-	// 最終描画用のテクスチャに描画
-	void RenderToFinalRenderTexture();
+	// レンダーグラフのパスを順に記録する(描画スレッドから呼ぶ)
+	void ExecuteRenderGraph();
 
-	// スワップチェーンに最終描画用のレンダーテクスチャを描画
+	// スワップチェーンに最後のパスの結果を描画(縮小バッファならここで拡大される)
 	void RenderToSwapChain();
 
-	// フレーム終了処理
-	void EndFrame();
-
 	// ポストエフェクト追加
 	void AddPostEffect(const PostEffectCommand& command);
+
+	// 積んだポストエフェクトを描画用に確定させる(描画スレッドが止まっている間に呼ぶ)
+	void FlushPostEffect();
 private:
-	// カラーレンダーテクスチャのインデックス切り替え
-	void SwitchColorRenderTextureIndex();
+	// シャドウマップ用の深度描画前準備
+	void PreShadowRender();
+
+	// シーンを描画するための前準備
+	void PreRenderForGBuffers();
+
+	// シーン用のレンダーテクスチャに描画する前の処理
+	void PreSceneRender(ColorRenderTexture* sceneRenderTexture);
+
+	// ライト適用
+	void LightingPass();
+
+	// まとめたポストエフェクトのパスをひとつかける(paramIndexはパラメータ用リソースの番号)
+	void ApplyPostEffect(const PostEffectPass& pass, uint32_t paramIndex, ColorRenderTexture* input, ColorRenderTexture* output);
 
-	// レンダーテクスチャを描画
-	void DrawRenderTextureNoParamater(ID3D12GraphicsCommandList* commandList, const PostEffectType& type);
-	void DrawRenderTextureWithParamater(ID3D12GraphicsCommandList* commandList, const PostEffectCommand& command);
+	// 外部のリソースをレンダーグラフに登録する
+	uint32_t RegisterExternalResource(ID3D12Resource* resource, RenderGraphAccess initialState);
+
+	// リソースに割り当てた一時レンダーテクスチャを取得
+	ColorRenderTexture* GetTransientRenderTexture(RenderGraph::ResourceHandle resource)const;
+
+	// レンダーグラフのバリアをまとめて張る
+	void ResourceBarrier(std::span<const RenderGraph::Barrier> barriers);
 
 	// 複数のレンダーターゲットを追加
 	void SetRenderTargets(const std::array<D3D12_CPU_DESCRIPTOR_HANDLE, 2>& rtvs, D3D12_CPU_DESCRIPTOR_HANDLE dsv);
@@ -117,6 +138,7 @@ private:
 	void SetCamera3DManager(Camera3DManager* camera3DManager);
 	void SetLightManager(LightManager* lightManager);
 	void SetSkyBoxDrawer(SkyBoxDrawer* skyBoxDrawer);
+	void SetFrameArena(FrameArena* frameArena);
 
 private:
 	// 各インスタンスを受け取るクラス
@@ -133,39 +155,63 @@ private:
 	Camera3DManager* camera3DManager_ = nullptr;
 	LightManager* lightManager_ = nullptr;
 	SkyBoxDrawer* skyBoxDrawer_ = nullptr;
+	FrameArena* frameArena_ = nullptr;
 
 private:
 	// コマンド最大数
 	static const uint32_t kMaxPostEffectNum_ = 64;
+	// 一度に張るバリアの最大数
+	static const uint32_t kMaxBarrierNum_ = 16;
 
-	// 現在のレンダーターゲット
-	BaseRenderTexture* currentRenderTarget_ = nullptr;
-	// これから描画するレンダーテクスチャ
-	BaseRenderTexture* currentRenderTexture_ = nullptr;
+	//================================================
+	// RenderGraph用
+	//================================================
 
-	// シーンを描画するレンダーテクスチャ
-	std::unique_ptr<ColorRenderTexture> sceneRenderTexture_ = nullptr;
-	// 最終描画用のレンダーテクスチャ
-	std::unique_ptr<ColorRenderTexture> finalRenderTexture_ = nullptr;
+	// レンダーグラフ
+	std::unique_ptr<RenderGraph> renderGraph_ = nullptr;
+
+	// 実体の番号ごとのリソース(外部のものと一時レンダーテクスチャ)
+	std::vector<ID3D12Resource*> physicalResources_;
+	// 実体の番号ごとの一時レンダーテクスチャ(外部のものはnullptr)
+	std::vector<std::unique_ptr<ColorRenderTexture>> transientRenderTextures_;
+	// シーンカラー用の一時レンダーテクスチャの設定
+	RenderGraph::TextureDesc colorTextureDesc_{};
+	// 半分の解像度でかけるポストエフェクト用の一時レンダーテクスチャの設定
+	RenderGraph::TextureDesc halfColorTextureDesc_{};
+
+	// 外部のリソースの実体の番号
+	uint32_t shadowDepthPhysicalIndex_ = 0;
+	uint32_t depthStencilPhysicalIndex_ = 0;
+	uint32_t gBufferAlbedoPhysicalIndex_ = 0;
+	uint32_t gBufferNormalPhysicalIndex_ = 0;
+
+	// このフレームのリソース
+	RenderGraph::ResourceHandle shadowDepthHandle_ = 0;
+	RenderGraph::ResourceHandle depthStencilHandle_ = 0;
+	RenderGraph::ResourceHandle gBufferAlbedoHandle_ = 0;
+	RenderGraph::ResourceHandle gBufferNormalHandle_ = 0;
+	// これまでのパスの結果が入っているカラー
+	RenderGraph::ResourceHandle currentColorHandle_ = 0;
+	// スワップチェーンに描画するカラー
+	RenderGraph::ResourceHandle finalColorHandle_ = 0;
 
 	//================================================
 	// PostEffect用
 	//================================================ 
 
-	// カラーポストエフェクト用のレンダーテクスチャ
-	std::unique_ptr<ColorRenderTexture> colorPostEffectRenderTexture_[2] = { nullptr,nullptr };
-	// 現在使用中のカラーポストエフェクト用のレンダーテクスチャインデックス
-	uint32_t currentColorPostEffectRenderTextureIndex_ = 0;
-
-	// ポストエフェクトのパラメータ用リソース
-	ComPtr<ID3D12Resource> postEffectParamResource_[kMaxPostEffectNum_];
+	// ポストエフェクトのパラメータ用リソース(GPUが読んでいる間に上書きしないようフレームごとに持つ)
+	ComPtr<ID3D12Resource> postEffectParamResource_[FrameConst::FrameCount][kMaxPostEffectNum_];
 	// ポストエフェクトのパラメータ用データ
-	PostEffectParamater* postEffectParamData_[kMaxPostEffectNum_];
+	PostEffectParamater* postEffectParamData_[FrameConst::FrameCount][kMaxPostEffectNum_]{};
+
+	// ポストエフェクトをかけるためのコマンド(描画スレッドが読む)
+	FrameVector<PostEffectCommand> postEffectCommand_{};
+
+	// 更新中に積まれたコマンド(FlushPostEffectで描画用へ移す)
+	FrameVector<PostEffectCommand> pendingPostEffectCommand_{};
 
-	// ポストエフェクトをかけるためのコマンド
-	std::vector<PostEffectCommand> postEffectCommand_{};
-	// 現在のコマンドインデックス
-	uint32_t currentCommandIndex_ = 0;
+	// コマンドをパスにまとめる(組み立てたパスは描画スレッドが読み終わるまで次のPlanを呼ばない)
+	std::unique_ptr<PostEffectPlanner> postEffectPlanner_ = nullptr;
 
 
 	//================================================
@@ -0,0 +1,100 @@
+#include "RenderQueue.h"
+
+// C++
+#include <cassert>
+
+// MyHedder
+#include "RadixSort/RadixSort.h"
+
+RenderQueue::RenderQueue(FrameArena* frameArena) {
+	SetFrameArena(frameArena);
+	Begin();
+}
+
+RenderQueue::~RenderQueue() {
+
+}
+
+void RenderQueue::Begin() {
+	// 前のフレームの分は一時メモリごと捨てる
+	items_ = FrameVector<RenderItem>(FrameArenaAllocator<RenderItem>(frameArena_));
+	passBegin_.fill(0);
+	isSorted_ = false;
+}
+
+void RenderQueue::Submit(RenderQueueSubmitter* submitter, RenderPass pass, BlendMode blendMode, uint32_t pipeline, uint32_t material, uint32_t order, uint32_t argument) {
+	assert(submitter);
+	assert(!isSorted_ && "RenderQueue is already sorted");
+	items_.push_back(RenderItem{
+		.key = MakeKey(pass, blendMode, pipeline, material, order),
+		.submitter = submitter,
+		.argument = argument,
+		});
+}
+
+void RenderQueue::Sort() {
+	// 基数ソートの作業領域
+	FrameVector<RenderItem> scratch(items_.size(), FrameArenaAllocator<RenderItem>(frameArena_));
+	RadixSort::Sort(std::span<RenderItem>(items_), std::span<RenderItem>(scratch), [](const RenderItem& item) {
+		return item.key;
+		});
+
+	// パスごとの数を数えて開始位置にする
+	passBegin_.fill(0);
+	for (const RenderItem& item : items_) {
+		passBegin_[static_cast<uint32_t>(GetPass(item.key)) + 1]++;
+	}
+	for (uint32_t i = 0; i < kRenderPassNum; ++i) {
+		passBegin_[i + 1] += passBegin_[i];
+	}
+	isSorted_ = true;
+}
+
+void RenderQueue::Execute(RenderPass pass)const {
+	assert(isSorted_ && "RenderQueue::Sort must be called before Execute");
+	const uint32_t passIndex = static_cast<uint32_t>(pass);
+
+	// パスの最初の描画は必ず設定する(パスの間で別のパイプラインが使われている)
+	uint64_t currentState = UINT64_MAX;
+	for (uint32_t i = passBegin_[passIndex]; i < passBegin_[passIndex + 1]; ++i) {
+		const RenderItem& item = items_[i];
+		// パス、ブレンドモード、パイプラインが同じならPSOも同じ
+		const uint64_t state = item.key >> kPipelineShift;
+		item.submitter->ExecuteRenderItem(item, state != currentState);
+		currentState = state;
+	}
+}
+
+uint64_t RenderQueue::MakeKey(RenderPass pass, BlendMode blendMode, uint32_t pipeline, uint32_t material, uint32_t order) {
+	assert(static_cast<uint32_t>(pass) < kRenderPassNum);
+	assert(static_cast<uint32_t>(blendMode) < 0x10);
+	assert(pipeline < 0x100);
+	// マテリアルはまとめて描くためだけに使うので、重なっても順番が変わるだけ
+	return (static_cast<uint64_t>(pass) << kPassShift) |
+		(static_cast<uint64_t>(blendMode) << kBlendModeShift) |
+		(static_cast<uint64_t>(pipeline) << kPipelineShift) |
+		(static_cast<uint64_t>(material & 0xFFFF) << kMaterialShift) |
+		static_cast<uint64_t>(order);
+}
+
+RenderPass RenderQueue::GetPass(uint64_t key) {
+	return static_cast<RenderPass>(key >> kPassShift);
+}
+
+BlendMode RenderQueue::GetBlendMode(uint64_t key) {
+	return static_cast<BlendMode>((key >> kBlendModeShift) & 0xF);
+}
+
+uint32_t RenderQueue::GetItemCount() const {
+	return static_cast<uint32_t>(items_.size());
+}
+
+uint32_t RenderQueue::GetItemCount(RenderPass pass) const {
+	const uint32_t passIndex = static_cast<uint32_t>(pass);
+	return passBegin_[passIndex + 1] - passBegin_[passIndex];
+}
+
+void RenderQueue::SetFrameArena(FrameArena* frameArena) {
+	assert(frameArena);
+	frameArena_ = frameArena;
+}
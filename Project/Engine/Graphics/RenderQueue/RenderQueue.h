@@ -0,0 +1,85 @@
+#pragma once
+
+// C++
+#include <array>
+#include <cstdint>
+
+// MyHedder
+#include "FrameArena/FrameArena.h"
+#include "Enums/BlendModeEnum.h"
+#include "Enums/RenderPassEnum.h"
+
+class RenderQueueSubmitter;
+
+/// <summary>
+/// 描画キューに積む描画
+/// </summary>
+struct RenderItem {
+	// ソートキー(上位からパス4bit|ブレンドモード4bit|パイプライン8bit|マテリアル16bit|順番32bit)
+	uint64_t key = 0;
+	// 描画を記録するクラス
+	RenderQueueSubmitter* submitter = nullptr;
+	// 描画クラスが自由に使う値
+	uint32_t argument = 0;
+};
+
+/// <summary>
+/// 描画キューから呼ばれて描画を記録するクラス
+/// </summary>
+class RenderQueueSubmitter {
+public:
+	virtual ~RenderQueueSubmitter() = default;
+	// 描画を記録する(isPipelineChangedがfalseなら直前の描画と同じルートシグネイチャとPSOが設定されている)
+	virtual void ExecuteRenderItem(const RenderItem& item, bool isPipelineChanged) = 0;
+};
+
+/// <summary>
+/// 描画キュー
+/// 描画クラスが積んだ描画をフレームに一度キーで基数ソートし、パスごとにキーの順で記録する
+/// GPUには触らないので単体で動かせる
+/// </summary>
+class RenderQueue {
+public:
+	RenderQueue(FrameArena* frameArena);
+	~RenderQueue();
+
+	// フレームの開始。前のフレームで積んだ描画を捨てる(描画スレッドが止まっている間に呼ぶ)
+	void Begin();
+	// 描画を積む(インスタンスがあるときだけ積む)
+	void Submit(RenderQueueSubmitter* submitter, RenderPass pass, BlendMode blendMode, uint32_t pipeline, uint32_t material, uint32_t order = 0, uint32_t argument = 0);
+	// キーの順に並べ替えてパスごとの範囲を確定する
+	void Sort();
+	// パスの描画をキーの順に記録する(描画スレッドから呼ぶ)
+	void Execute(RenderPass pass)const;
+
+	// キーを作る(マテリアルは下位16bitだけ使う)
+	[[nodiscard]] static uint64_t MakeKey(RenderPass pass, BlendMode blendMode, uint32_t pipeline, uint32_t material, uint32_t order);
+	// キーからパスを取り出す
+	[[nodiscard]] static RenderPass GetPass(uint64_t key);
+	// キーからブレンドモードを取り出す
+	[[nodiscard]] static BlendMode GetBlendMode(uint64_t key);
+
+	// 積んだ描画の数
+	[[nodiscard]] uint32_t GetItemCount()const;
+	// パスに積んだ描画の数
+	[[nodiscard]] uint32_t GetItemCount(RenderPass pass)const;
+
+private:
+	void SetFrameArena(FrameArena* frameArena);
+
+private:
+	// キーの各フィールドの位置
+	static constexpr uint32_t kPassShift = 60;
+	static constexpr uint32_t kBlendModeShift = 56;
+	static constexpr uint32_t kPipelineShift = 48;
+	static constexpr uint32_t kMaterialShift = 32;
+
+	FrameArena* frameArena_ = nullptr;
+
+	// 積んだ描画(フレーム単位の一時メモリから確保する)
+	FrameVector<RenderItem> items_{};
+	// パスごとの開始位置(末尾に全体の数)
+	std::array<uint32_t, kRenderPassNum + 1> passBegin_{};
+	// 並べ替え済みか
+	bool isSorted_ = false;
+};
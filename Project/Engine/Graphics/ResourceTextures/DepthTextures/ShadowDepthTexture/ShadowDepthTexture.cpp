@@ -27,8 +27,6 @@ void ShadowDepthTexture::CreateResource() {
 
 	MAGISYSTEM::CreateDSVTexture2d(dsvIndex_, resource_.Get(), DXGI_FORMAT_D32_FLOAT);
 	MAGISYSTEM::CreateSrvTexture2D(srvIndex_, resource_.Get(), DXGI_FORMAT_R32_FLOAT, 1);
-
-	currentResourceState_ = D3D12_RESOURCE_STATE_DEPTH_WRITE;
 }
 
 void ShadowDepthTexture::Clear() {
@@ -47,32 +45,8 @@ void ShadowDepthTexture::SetAsRenderTarget() {
 	MAGISYSTEM::GetDirectXCommandList()->OMSetRenderTargets(0, nullptr, FALSE, &dsvHandle);
 }
 
-void ShadowDepthTexture::TransitionToWrite() {
-	if (currentResourceState_ != D3D12_RESOURCE_STATE_DEPTH_WRITE) {
-		D3D12_RESOURCE_BARRIER barrier = {};
-		barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-		barrier.Transition.pResource = resource_.Get();
-		barrier.Transition.StateBefore = currentResourceState_;
-		barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_DEPTH_WRITE;
-		barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-		MAGISYSTEM::GetDirectXCommandList()->ResourceBarrier(1, &barrier);
-
-		currentResourceState_ = D3D12_RESOURCE_STATE_DEPTH_WRITE;
-	}
-}
-
-void ShadowDepthTexture::TransitionToRead() {
-	if (currentResourceState_ != D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE) {
-		D3D12_RESOURCE_BARRIER barrier = {};
-		barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-		barrier.Transition.pResource = resource_.Get();
-		barrier.Transition.StateBefore = currentResourceState_;
-		barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
-		barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-		MAGISYSTEM::GetDirectXCommandList()->ResourceBarrier(1, &barrier);
-
-		currentResourceState_ = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
-	}
+ID3D12Resource* ShadowDepthTexture::GetResource() {
+	return resource_.Get();
 }
 
 uint32_t ShadowDepthTexture::GetDsvIndex() const {
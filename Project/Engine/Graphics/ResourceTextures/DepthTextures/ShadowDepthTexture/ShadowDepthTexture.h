@@ -17,8 +17,9 @@ public:
 
 	void Clear();
 	void SetAsRenderTarget();
-	void TransitionToWrite();
-	void TransitionToRead();
+
+	// リソースを取得(状態はレンダーグラフが管理する)
+	ID3D12Resource* GetResource();
 
 	uint32_t GetDsvIndex()const;
 	uint32_t GetSrvIndex()const;
@@ -32,7 +33,6 @@ private:
 
 private:
 	ComPtr<ID3D12Resource> resource_;
-	D3D12_RESOURCE_STATES currentResourceState_ = D3D12_RESOURCE_STATE_DEPTH_WRITE;
 
 	uint32_t dsvIndex_ = 0;
 	uint32_t srvIndex_ = 0;
@@ -10,13 +10,19 @@ BaseRenderTexture::BaseRenderTexture() {
 }
 
 BaseRenderTexture::~BaseRenderTexture() {
-
+	// 作成したビューの場所を返す
+	if (resource_) {
+		MAGISYSTEM::RTVFree(rtvIndex_);
+		MAGISYSTEM::SrvUavFree(srvIndex_);
+	}
 }
 
-void BaseRenderTexture::Create(DXGI_FORMAT format, D3D12_RESOURCE_FLAGS resourceFlags, Vector4 clearColor) {
+void BaseRenderTexture::Create(DXGI_FORMAT format, D3D12_RESOURCE_FLAGS resourceFlags, Vector4 clearColor, uint32_t width, uint32_t height) {
 	format_ = format;
 	resourceFlags_ = resourceFlags;
 	clearColor_ = clearColor;
+	width_ = width;
+	height_ = height;
 	// リソースを作成
 	CreateResource();
 	// RTVを作成
@@ -33,41 +39,16 @@ uint32_t BaseRenderTexture::GetSrvIndex() const {
 	return srvIndex_;
 }
 
-
-ID3D12Resource* BaseRenderTexture::GetResource() {
-	return resource_.Get();
+uint32_t BaseRenderTexture::GetWidth() const {
+	return width_;
 }
 
-void BaseRenderTexture::TransitionToWrite() {
-	// 現在の状態を確認
-	if (currentResourceState_ != D3D12_RESOURCE_STATE_RENDER_TARGET) {
-		D3D12_RESOURCE_BARRIER barrier = {};
-		barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-		barrier.Transition.pResource = resource_.Get();
-		barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
-		barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_RENDER_TARGET;
-		barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-		MAGISYSTEM::GetDirectXCommandList()->ResourceBarrier(1, &barrier);
-
-		// 状態を更新
-		currentResourceState_ = D3D12_RESOURCE_STATE_RENDER_TARGET;
-	}
+uint32_t BaseRenderTexture::GetHeight() const {
+	return height_;
 }
 
-void BaseRenderTexture::TransitionToRead() {
-	// 現在の状態を確認
-	if (currentResourceState_ != D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE) {
-		D3D12_RESOURCE_BARRIER barrier = {};
-		barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-		barrier.Transition.pResource = resource_.Get();
-		barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_RENDER_TARGET;
-		barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
-		barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-		MAGISYSTEM::GetDirectXCommandList()->ResourceBarrier(1, &barrier);
-
-		// 状態を更新
-		currentResourceState_ = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
-	}
+ID3D12Resource* BaseRenderTexture::GetResource() {
+	return resource_.Get();
 }
 
 void BaseRenderTexture::SetAsRenderTarget(D3D12_CPU_DESCRIPTOR_HANDLE dsv) {
@@ -87,8 +68,8 @@ void BaseRenderTexture::ClearRenderTarget() {
 void BaseRenderTexture::CreateResource() {
 	// リソースの設定
 	D3D12_RESOURCE_DESC resourceDesc{};
-	resourceDesc.Width = UINT(WindowApp::kClientWidth);					// Textureの幅
-	resourceDesc.Height = UINT(WindowApp::kClientHeight);				// Textureの高さ
+	resourceDesc.Width = UINT(width_);									// Textureの幅
+	resourceDesc.Height = UINT(height_);								// Textureの高さ
 	resourceDesc.Format = format_;										// TextureのFormat
 	resourceDesc.SampleDesc.Count = 1;									// サンプリングカウント。1固定
 	resourceDesc.Flags = resourceFlags_;								// renderTargetとして利用可能にする
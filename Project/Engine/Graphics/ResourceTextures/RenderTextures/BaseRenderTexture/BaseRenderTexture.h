@@ -13,6 +13,7 @@
 #include "Enums/BlendModeEnum.h"
 #include "Structs/ColorStruct.h"
 #include "Math/Types/Vector4.h"
+#include "WindowApp/WindowApp.h"
 
 /// <summary>
 /// レンダーテクスチャの基底クラス
@@ -34,18 +35,21 @@ public:
 	// リソースを取得
 	ID3D12Resource* GetResource();
 
-	// バリアの状態を設定
-	void TransitionToWrite();
-	void TransitionToRead();
-
 	// 自身をレンダーターゲットにする
 	void SetAsRenderTarget(D3D12_CPU_DESCRIPTOR_HANDLE dsv = {});
 	// クリア
 	void ClearRenderTarget();
+
+	// 幅を取得
+	uint32_t GetWidth()const;
+	// 高さを取得
+	uint32_t GetHeight()const;
 protected:
 	void Create(DXGI_FORMAT format = DXGI_FORMAT_R8G8B8A8_UNORM_SRGB,
 		D3D12_RESOURCE_FLAGS resourceFlags = D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET,
-		Vector4 clearColor = Vector4(0.0f, 0.0f, 0.0f, 1.0f));
+		Vector4 clearColor = Vector4(0.0f, 0.0f, 0.0f, 1.0f),
+		uint32_t width = WindowApp::kClientWidth,
+		uint32_t height = WindowApp::kClientHeight);
 
 private:
 	// レンダーテクスチャのリソースを作成
@@ -59,15 +63,16 @@ protected:
 	// レンダーテクスチャ用のリソース
 	ComPtr<ID3D12Resource> resource_ = nullptr;
 
-	// 現在のリソースの状態
-	D3D12_RESOURCE_STATES currentResourceState_ = D3D12_RESOURCE_STATE_RENDER_TARGET;
-
 	// フォーマット
 	DXGI_FORMAT format_{};
 	// リソースフラグ
 	D3D12_RESOURCE_FLAGS resourceFlags_{};
 	// クリアカラー
 	Vector4 clearColor_{};
+	// 幅
+	uint32_t width_ = 0;
+	// 高さ
+	uint32_t height_ = 0;
 
 	// RTVリソースのインデックス
 	uint32_t rtvIndex_ = 0;
@@ -14,3 +14,13 @@ void ColorRenderTexture::Initialize() {
 		Vector4(0.0f, 0.0f, 0.0f, 1.0f)
 	);
 }
+
+void ColorRenderTexture::Initialize(uint32_t width, uint32_t height) {
+	BaseRenderTexture::Create(
+		DXGI_FORMAT_R8G8B8A8_UNORM_SRGB,
+		D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET,
+		Vector4(0.0f, 0.0f, 0.0f, 1.0f),
+		width,
+		height
+	);
+}
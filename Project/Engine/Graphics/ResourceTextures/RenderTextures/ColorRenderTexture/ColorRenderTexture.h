@@ -9,6 +9,8 @@ public:
 	~ColorRenderTexture()override;
 
 	void Initialize();
+	// 大きさを指定して初期化(縮小バッファ用)
+	void Initialize(uint32_t width, uint32_t height);
 
 private:
 
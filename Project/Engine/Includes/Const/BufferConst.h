@@ -0,0 +1,12 @@
+#pragma once
+
+// C++
+#include <cstdint>
+
+/// <summary>
+/// 共有バッファからの切り出しで使う定数
+/// </summary>
+namespace BufferConst {
+	inline constexpr uint64_t BlockSize = 64ull * 1024 * 1024;								// 一度に作る共有バッファの大きさ(バイト)
+	inline constexpr uint64_t StagingRingSize = 32ull * 1024 * 1024;						// デフォルトヒープへ転送するときのアップロード用リングの大きさ(バイト)
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+// C++
+#include <cstdint>
+
+/// <summary>
+/// フレーム単位の一時メモリで使う定数
+/// </summary>
+namespace FrameArenaConst {
+	inline constexpr size_t BlockSize = 1024 * 1024;										// 一度に確保するブロックのサイズ(バイト)
+	inline constexpr uint32_t BufferCount = 2;												// バッファの数(更新中のフレームと描画スレッドが記録中のフレーム)
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+// C++
+#include <cstdint>
+
+/// <summary>
+/// フレームの多重化で使う定数
+/// </summary>
+namespace FrameConst {
+	inline constexpr uint32_t FrameCount = 2;												// 同時に処理するフレーム数(スワップチェーンのバッファ数)
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+// C++
+#include <cstdint>
+
+/// <summary>
+/// インポートキャッシュのバージョン(処理内容を変えたら上げて古いキャッシュを無効にする)
+/// </summary>
+namespace ImportCacheConst {
+	inline constexpr uint32_t ModelVersion = 3;												// モデルの読み込みと前処理(最適化、LOD、量子化)
+	inline constexpr uint32_t MeshletVersion = 1;											// メシュレットとカリングデータの生成
+	inline constexpr uint32_t TextureVersion = 1;											// テクスチャのデコードとミップマップ生成
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+// C++
+#include <cstdint>
+
+/// <summary>
+/// モデルのLODで使う定数
+/// </summary>
+namespace ModelLODConst {
+	inline constexpr uint32_t MaxLODCount = 4;												// 元メッシュを含むLODの最大数
+	inline constexpr float ReductionRatio = 0.5f;											// 1段階ごとの三角形数の削減率
+	inline constexpr float MinReductionRatio = 0.9f;										// これ以上減らせないLODは作らない
+	inline constexpr float PixelErrorThreshold = 1.0f;										// LODで許容する画面上の誤差(ピクセル)
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+// C++
+#include <cstdint>
+
+/// <summary>
+/// 常駐アセットの予算で使う定数
+/// </summary>
+namespace ResidencyConst {
+	inline constexpr uint64_t DefaultBudgetBytes = 1536ull * 1024 * 1024;					// 常駐させるアセットの予算(バイト)
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+/// <summary>
+/// シーンの非同期インポートで使う定数
+/// </summary>
+namespace SceneImportConst {
+	inline constexpr double FrameBudgetMilliseconds = 2.0;									// 1フレームでインポートに使う時間(ミリ秒)
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+/// <summary>
+/// ワールド分割のストリーミングで使う定数
+/// </summary>
+namespace WorldPartitionConst {
+	inline constexpr float LoadDistance = 96.0f;											// カメラからこの距離以内のセルを読み込む
+	inline constexpr float UnloadDistance = 128.0f;											// カメラからこの距離より離れたセルを破棄する(読み込みより遠くして境界で繰り返さない)
+}
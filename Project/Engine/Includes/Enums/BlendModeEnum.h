@@ -18,4 +18,10 @@ enum class BlendMode {
 };
 
 // ブレンドモードの種類の数
-inline constexpr uint32_t kBlendModeNum = static_cast<uint32_t>(BlendMode::Num);
\ No newline at end of file
+inline constexpr uint32_t kBlendModeNum = static_cast<uint32_t>(BlendMode::Num);
+
+// 描く順番で結果が変わるブレンドモードか(奥から順に描く必要がある)
+inline constexpr bool IsDepthSortedBlendMode(BlendMode mode) {
+	// 加算、減算、乗算、スクリーンは順番を入れ替えても結果が同じ
+	return mode == BlendMode::Normal;
+}
\ No newline at end of file
@@ -19,3 +19,33 @@ enum class PostEffectType {
 
 // パイプラインの種類の数 
 inline constexpr uint32_t kPostEffectPipelineStateNum = static_cast<uint32_t>(PostEffectType::Num);
+
+/// <summary>
+/// 色をまとめてかけるパスで有効にする処理(ビットの組み合わせでピクセルシェーダーを切り替える)
+/// </summary>
+enum class PostEffectColorOp : uint32_t {
+	None = 0, // 何もしない(コピー)
+	RadialBlur = 1 << 0, // 集中ぼかし(周りを読むのでパスの先頭でしか行えない)
+	Grayscale = 1 << 1, // グレースケール
+	Vignette = 1 << 2, // ビネット
+};
+
+inline constexpr PostEffectColorOp operator|(PostEffectColorOp a, PostEffectColorOp b) {
+	return static_cast<PostEffectColorOp>(static_cast<uint32_t>(a) | static_cast<uint32_t>(b));
+}
+
+inline constexpr PostEffectColorOp operator&(PostEffectColorOp a, PostEffectColorOp b) {
+	return static_cast<PostEffectColorOp>(static_cast<uint32_t>(a) & static_cast<uint32_t>(b));
+}
+
+// 色をまとめてかけるパスのシェーダーの組み合わせの数
+inline constexpr uint32_t kPostEffectColorPermutationNum = 1 << 3;
+
+/// <summary>
+/// まとめたあとのポストエフェクトのパスの種類
+/// </summary>
+enum class PostEffectPassType {
+	Color, // 色をまとめてかける
+	GaussianX, // X軸ガウスぼかし
+	GaussianY, // Y軸ガウスぼかし
+};
@@ -0,0 +1,33 @@
+#pragma once
+
+// C++
+#include <cstdint>
+
+/// <summary>
+/// レンダーグラフのパスがリソースをどう使うか(ひとつのパスで組み合わせられるようにビットで持つ)
+/// リソースの状態もこの組み合わせで表す
+/// </summary>
+enum class RenderGraphAccess : uint32_t {
+	None = 0,
+	// レンダーターゲットとして書き込む
+	RenderTarget = 1 << 0,
+	// 深度を書き込む
+	DepthWrite = 1 << 1,
+	// 深度テストだけ行う
+	DepthRead = 1 << 2,
+	// ピクセルシェーダーから読む
+	ShaderRead = 1 << 3,
+};
+
+inline constexpr RenderGraphAccess operator|(RenderGraphAccess a, RenderGraphAccess b) {
+	return static_cast<RenderGraphAccess>(static_cast<uint32_t>(a) | static_cast<uint32_t>(b));
+}
+
+inline constexpr RenderGraphAccess operator&(RenderGraphAccess a, RenderGraphAccess b) {
+	return static_cast<RenderGraphAccess>(static_cast<uint32_t>(a) & static_cast<uint32_t>(b));
+}
+
+// 書き込みを含むか(書き込みはほかの使い方と組み合わせられない)
+inline constexpr bool IsWriteAccess(RenderGraphAccess access) {
+	return (access & (RenderGraphAccess::RenderTarget | RenderGraphAccess::DepthWrite)) != RenderGraphAccess::None;
+}
\ No newline at end of file
@@ -0,0 +1,22 @@
+#pragma once
+
+// C++
+#include <cstdint>
+
+/// <summary>
+/// 描画キューのパス(並びが記録する順番)
+/// </summary>
+enum class RenderPass {
+	Shadow,
+	GBuffer,
+	BackSprite,
+	Line,
+	Transparent,
+	Particle,
+	FrontSprite,
+
+	Num,
+};
+
+// パスの数
+inline constexpr uint32_t kRenderPassNum = static_cast<uint32_t>(RenderPass::Num);
\ No newline at end of file
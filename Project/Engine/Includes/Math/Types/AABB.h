@@ -0,0 +1,11 @@
+#pragma once
+
+#include "Math/Types/Vector3.h"
+
+/// <summary>
+/// 軸並行境界ボックス
+/// </summary>
+struct AABB {
+	Vector3 min;
+	Vector3 max;
+};
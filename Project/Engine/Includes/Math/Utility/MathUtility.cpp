@@ -1122,3 +1122,68 @@ Quaternion MAGIMath::Slerp(Quaternion q1, Quaternion q2, float t) {
 	};
 	return Normalize(result);
 }
+
+AABB MAGIMath::TransformAABB(const AABB& aabb, const Matrix4x4& m) {
+	// 中心と半径に分解して、行列の絶対値で半径を広げる (行ベクトル形式)
+	const Vector3 center = CenterAABB(aabb);
+	const Vector3 extent = ExtentAABB(aabb);
+
+	Vector3 worldCenter = {
+		center.x * m.m[0][0] + center.y * m.m[1][0] + center.z * m.m[2][0] + m.m[3][0],
+		center.x * m.m[0][1] + center.y * m.m[1][1] + center.z * m.m[2][1] + m.m[3][1],
+		center.x * m.m[0][2] + center.y * m.m[1][2] + center.z * m.m[2][2] + m.m[3][2],
+	};
+	Vector3 worldExtent = {
+		extent.x * std::abs(m.m[0][0]) + extent.y * std::abs(m.m[1][0]) + extent.z * std::abs(m.m[2][0]),
+		extent.x * std::abs(m.m[0][1]) + extent.y * std::abs(m.m[1][1]) + extent.z * std::abs(m.m[2][1]),
+		extent.x * std::abs(m.m[0][2]) + extent.y * std::abs(m.m[1][2]) + extent.z * std::abs(m.m[2][2]),
+	};
+
+	return AABB{ worldCenter - worldExtent, worldCenter + worldExtent };
+}
+
+AABB MAGIMath::MergeAABB(const AABB& a, const AABB& b) {
+	return AABB{
+		.min = { std::min(a.min.x, b.min.x), std::min(a.min.y, b.min.y), std::min(a.min.z, b.min.z) },
+		.max = { std::max(a.max.x, b.max.x), std::max(a.max.y, b.max.y), std::max(a.max.z, b.max.z) },
+	};
+}
+
+Vector3 MAGIMath::CenterAABB(const AABB& aabb) {
+	return (aabb.min + aabb.max) * 0.5f;
+}
+
+Vector3 MAGIMath::ExtentAABB(const AABB& aabb) {
+	return (aabb.max - aabb.min) * 0.5f;
+}
+
+bool MAGIMath::IsIntersectAABB(const AABB& a, const AABB& b) {
+	return (a.min.x <= b.max.x && a.max.x >= b.min.x) &&
+		(a.min.y <= b.max.y && a.max.y >= b.min.y) &&
+		(a.min.z <= b.max.z && a.max.z >= b.min.z);
+}
+
+bool MAGIMath::IsIntersectAABBSphere(const AABB& aabb, const Vector3& center, float radius) {
+	// 球の中心に最も近いAABB上の点
+	const Vector3 closest = {
+		std::clamp(center.x, aabb.min.x, aabb.max.x),
+		std::clamp(center.y, aabb.min.y, aabb.max.y),
+		std::clamp(center.z, aabb.min.z, aabb.max.z),
+	};
+	return LengthSquared(closest - center) <= radius * radius;
+}
+
+bool MAGIMath::IsAABBInFrustum(const AABB& aabb, const Vector4 planes[6]) {
+	const Vector3 center = CenterAABB(aabb);
+	const Vector3 extent = ExtentAABB(aabb);
+	for (int i = 0; i < 6; ++i) {
+		const Vector4& p = planes[i];
+		// 平面法線方向へのAABBの投影半径
+		const float r = extent.x * std::abs(p.x) + extent.y * std::abs(p.y) + extent.z * std::abs(p.z);
+		const float d = center.x * p.x + center.y * p.y + center.z * p.z + p.w;
+		if (d < -r) {
+			return false;
+		}
+	}
+	return true;
+}
@@ -17,6 +17,8 @@
 
 #include "Math/Types/Quaternion.h"
 
+#include "Math/Types/AABB.h"
+
 ///
 /// Vector2
 ///
@@ -284,4 +286,19 @@ namespace MAGIMath {
 
 	// 球面線形補完
 	Quaternion Slerp(Quaternion q1, Quaternion q2, float t);
+
+	// AABBを行列で変換して包み込むAABBを返す
+	AABB TransformAABB(const AABB& aabb, const Matrix4x4& m);
+	// 二つのAABBを包み込むAABBを返す
+	AABB MergeAABB(const AABB& a, const AABB& b);
+	// AABBの中心
+	Vector3 CenterAABB(const AABB& aabb);
+	// AABBの半分の大きさ
+	Vector3 ExtentAABB(const AABB& aabb);
+	// AABB同士の交差判定
+	bool IsIntersectAABB(const AABB& a, const AABB& b);
+	// AABBと球の交差判定
+	bool IsIntersectAABBSphere(const AABB& aabb, const Vector3& center, float radius);
+	// AABBがフラスタム平面(内向き法線)の内側にかかっているか
+	bool IsAABBInFrustum(const AABB& aabb, const Vector4 planes[6]);
 }
\ No newline at end of file
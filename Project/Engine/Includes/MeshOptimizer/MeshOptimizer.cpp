@@ -0,0 +1,123 @@
+#include "MeshOptimizer.h"
+
+// C++
+#include <cassert>
+#include <algorithm>
+#include <numeric>
+
+// DirectXMesh
+#include <DirectXMesh/DirectXMesh.h>
+
+using namespace MAGIMath;
+
+void MeshOptimizer::OptimizeFaces(std::vector<uint32_t>& indices, const std::vector<VertexData3D>& vertices) {
+	const size_t faceCount = indices.size() / 3;
+	if (faceCount == 0) {
+		return;
+	}
+
+	// 頂点キャッシュのヒット率が上がるように三角形を並べ替え
+	std::vector<uint32_t> faceRemap(faceCount);
+	HRESULT hr = DirectX::OptimizeFacesLRU(indices.data(), faceCount, faceRemap.data());
+	if (FAILED(hr)) {
+		return;
+	}
+
+	// 新しい順番でインデックスを詰め直す(縮退した三角形は除かれる)
+	std::vector<uint32_t> optimizedIndices;
+	optimizedIndices.reserve(indices.size());
+	for (size_t newFace = 0; newFace < faceCount; newFace++) {
+		const uint32_t oldFace = faceRemap[newFace];
+		if (oldFace == DirectX::UNUSED32) {
+			continue;
+		}
+		optimizedIndices.push_back(indices[oldFace * 3 + 0]);
+		optimizedIndices.push_back(indices[oldFace * 3 + 1]);
+		optimizedIndices.push_back(indices[oldFace * 3 + 2]);
+	}
+	indices = std::move(optimizedIndices);
+
+	// オーバードローを減らすようにクラスタ単位で並べ替え
+	SortClustersForOverdraw(indices, vertices);
+}
+
+std::vector<uint32_t> MeshOptimizer::OptimizeVertexFetch(std::vector<uint32_t>& indices, std::vector<VertexData3D>& vertices) {
+	const size_t faceCount = indices.size() / 3;
+	const size_t vertexCount = vertices.size();
+
+	// 新しい頂点番号から古い頂点番号への対応
+	std::vector<uint32_t> vertexRemap(vertexCount);
+	size_t trailingUnused = 0;
+	HRESULT hr = DirectX::OptimizeVertices(indices.data(), faceCount, vertexCount, vertexRemap.data(), &trailingUnused);
+	if (FAILED(hr)) {
+		// 並べ替えなかったので恒等写像を返す
+		std::iota(vertexRemap.begin(), vertexRemap.end(), 0);
+		return vertexRemap;
+	}
+
+	// 古い頂点番号から新しい頂点番号への対応を作る
+	const size_t usedVertexCount = vertexCount - trailingUnused;
+	std::vector<uint32_t> oldToNew(vertexCount, UINT32_MAX);
+	std::vector<VertexData3D> optimizedVertices(usedVertexCount);
+	for (size_t newIndex = 0; newIndex < usedVertexCount; newIndex++) {
+		const uint32_t oldIndex = vertexRemap[newIndex];
+		assert(oldIndex != DirectX::UNUSED32);
+		oldToNew[oldIndex] = static_cast<uint32_t>(newIndex);
+		optimizedVertices[newIndex] = vertices[oldIndex];
+	}
+
+	for (auto& index : indices) {
+		index = oldToNew[index];
+	}
+	vertices = std::move(optimizedVertices);
+
+	return oldToNew;
+}
+
+void MeshOptimizer::SortClustersForOverdraw(std::vector<uint32_t>& indices, const std::vector<VertexData3D>& vertices) {
+	const uint32_t faceCount = static_cast<uint32_t>(indices.size() / 3);
+	const uint32_t clusterCount = (faceCount + kOverdrawClusterSize - 1) / kOverdrawClusterSize;
+	if (clusterCount <= 1) {
+		return;
+	}
+
+	// メッシュ全体の中心
+	Vector3 meshCenter = { 0.0f,0.0f,0.0f };
+	for (const auto& vertex : vertices) {
+		meshCenter = meshCenter + Vector3{ vertex.position.x,vertex.position.y,vertex.position.z };
+	}
+	meshCenter = meshCenter * (1.0f / static_cast<float>(vertices.size()));
+
+	// クラスタの中心が外側にあり、外を向いているほど先に描く
+	std::vector<float> sortKeys(clusterCount);
+	for (uint32_t cluster = 0; cluster < clusterCount; cluster++) {
+		const uint32_t beginIndex = cluster * kOverdrawClusterSize * 3;
+		const uint32_t endIndex = (std::min)(beginIndex + kOverdrawClusterSize * 3, static_cast<uint32_t>(indices.size()));
+
+		Vector3 center = { 0.0f,0.0f,0.0f };
+		Vector3 normal = { 0.0f,0.0f,0.0f };
+		for (uint32_t i = beginIndex; i < endIndex; i++) {
+			const VertexData3D& vertex = vertices[indices[i]];
+			center = center + Vector3{ vertex.position.x,vertex.position.y,vertex.position.z };
+			normal = normal + vertex.normal;
+		}
+		center = center * (1.0f / static_cast<float>(endIndex - beginIndex));
+
+		sortKeys[cluster] = (LengthSquared(normal) > 0.0f) ? Dot(center - meshCenter, Normalize(normal)) : 0.0f;
+	}
+
+	std::vector<uint32_t> clusterOrder(clusterCount);
+	std::iota(clusterOrder.begin(), clusterOrder.end(), 0);
+	std::stable_sort(clusterOrder.begin(), clusterOrder.end(), [&](uint32_t a, uint32_t b) {
+		return sortKeys[a] > sortKeys[b];
+		});
+
+	std::vector<uint32_t> sortedIndices;
+	sortedIndices.reserve(indices.size());
+	for (uint32_t cluster : clusterOrder) {
+		const uint32_t beginIndex = cluster * kOverdrawClusterSize * 3;
+		const uint32_t endIndex = (std::min)(beginIndex + kOverdrawClusterSize * 3, static_cast<uint32_t>(indices.size()));
+		sortedIndices.insert(sortedIndices.end(), indices.begin() + beginIndex, indices.begin() + endIndex);
+	}
+	indices = std::move(sortedIndices);
+}
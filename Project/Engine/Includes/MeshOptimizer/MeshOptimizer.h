@@ -0,0 +1,27 @@
+#pragma once
+
+// C++
+#include <cstdint>
+#include <vector>
+
+// MyHedder
+#include "Structs/ModelStruct.h"
+
+/// <summary>
+/// メシュレット化する前のインデックスと頂点の並べ替え
+/// </summary>
+class MeshOptimizer {
+public:
+	// 頂点キャッシュとオーバードローを考慮して三角形を並べ替える
+	static void OptimizeFaces(std::vector<uint32_t>& indices, const std::vector<VertexData3D>& vertices);
+	// 参照順に頂点を並べ替え、古い頂点番号から新しい頂点番号への対応を返す(未使用はUINT32_MAX)
+	static std::vector<uint32_t> OptimizeVertexFetch(std::vector<uint32_t>& indices, std::vector<VertexData3D>& vertices);
+
+private:
+	// 外側を向いたクラスタから先に描かれるように並べ替える
+	static void SortClustersForOverdraw(std::vector<uint32_t>& indices, const std::vector<VertexData3D>& vertices);
+
+private:
+	// オーバードロー用に並べ替えるクラスタの三角形数
+	static const uint32_t kOverdrawClusterSize = 64;
+};
@@ -0,0 +1,259 @@
+#include "MeshSimplifier.h"
+
+// C++
+#include <algorithm>
+#include <cmath>
+#include <queue>
+#include <unordered_map>
+
+namespace {
+	/// <summary>
+	/// 対称4x4行列を10要素で持つ二次誤差
+	/// </summary>
+	struct Quadric {
+		double a[10]{};
+
+		void AddPlane(double nx, double ny, double nz, double d) {
+			a[0] += nx * nx; a[1] += nx * ny; a[2] += nx * nz; a[3] += nx * d;
+			a[4] += ny * ny; a[5] += ny * nz; a[6] += ny * d;
+			a[7] += nz * nz; a[8] += nz * d;
+			a[9] += d * d;
+		}
+
+		void Add(const Quadric& q) {
+			for (uint32_t i = 0; i < 10; i++) {
+				a[i] += q.a[i];
+			}
+		}
+
+		// 点と各平面との二乗距離の合計(平均にしないので、平方根はどの平面からの距離よりも大きい)
+		double Evaluate(const Vector3& p) const {
+			const double x = p.x, y = p.y, z = p.z;
+			const double result =
+				a[0] * x * x + 2.0 * a[1] * x * y + 2.0 * a[2] * x * z + 2.0 * a[3] * x +
+				a[4] * y * y + 2.0 * a[5] * y * z + 2.0 * a[6] * y +
+				a[7] * z * z + 2.0 * a[8] * z +
+				a[9];
+			return (std::max)(result, 0.0);
+		}
+	};
+
+	/// <summary>
+	/// 辺縮約の候補(from を to へ寄せる)
+	/// </summary>
+	struct Collapse {
+		double cost;
+		uint32_t from;
+		uint32_t to;
+		uint32_t fromVersion;
+		uint32_t toVersion;
+
+		bool operator>(const Collapse& other) const {
+			return cost > other.cost;
+		}
+	};
+
+	// 三角形の面法線(正規化なし)
+	Vector3 TriangleNormal(const Vector3& p0, const Vector3& p1, const Vector3& p2) {
+		const Vector3 e0 = { p1.x - p0.x, p1.y - p0.y, p1.z - p0.z };
+		const Vector3 e1 = { p2.x - p0.x, p2.y - p0.y, p2.z - p0.z };
+		return {
+			e0.y * e1.z - e0.z * e1.y,
+			e0.z * e1.x - e0.x * e1.z,
+			e0.x * e1.y - e0.y * e1.x,
+		};
+	}
+
+	uint64_t EdgeKey(uint32_t a, uint32_t b) {
+		if (a > b) std::swap(a, b);
+		return (static_cast<uint64_t>(a) << 32) | b;
+	}
+}
+
+float MeshSimplifier::Simplify(const std::vector<Vector3>& positions, const std::vector<uint32_t>& indices, size_t targetIndexCount, float targetError, std::vector<uint32_t>& outIndices) {
+	const uint32_t vertexCount = static_cast<uint32_t>(positions.size());
+	const uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3);
+
+	// 三角形ごとの頂点(縮約で書き換わる)
+	std::vector<uint32_t> triangles(indices.begin(), indices.begin() + triangleCount * 3);
+	std::vector<bool> isTriangleAlive(triangleCount, true);
+	uint32_t aliveTriangleCount = triangleCount;
+
+	// 頂点ごとの二次誤差と隣接三角形
+	std::vector<Quadric> quadrics(vertexCount);
+	std::vector<std::vector<uint32_t>> vertexTriangles(vertexCount);
+	// 辺を共有する三角形の数
+	std::unordered_map<uint64_t, uint32_t> edgeTriangleCounts;
+	edgeTriangleCounts.reserve(triangleCount * 3);
+
+	for (uint32_t t = 0; t < triangleCount; t++) {
+		const uint32_t i0 = triangles[t * 3 + 0];
+		const uint32_t i1 = triangles[t * 3 + 1];
+		const uint32_t i2 = triangles[t * 3 + 2];
+
+		const Vector3 n = TriangleNormal(positions[i0], positions[i1], positions[i2]);
+		const double length = std::sqrt(static_cast<double>(n.x) * n.x + static_cast<double>(n.y) * n.y + static_cast<double>(n.z) * n.z);
+		if (length > 0.0) {
+			const double nx = n.x / length, ny = n.y / length, nz = n.z / length;
+			const double d = -(nx * positions[i0].x + ny * positions[i0].y + nz * positions[i0].z);
+			quadrics[i0].AddPlane(nx, ny, nz, d);
+			quadrics[i1].AddPlane(nx, ny, nz, d);
+			quadrics[i2].AddPlane(nx, ny, nz, d);
+		}
+
+		vertexTriangles[i0].push_back(t);
+		vertexTriangles[i1].push_back(t);
+		vertexTriangles[i2].push_back(t);
+
+		edgeTriangleCounts[EdgeKey(i0, i1)]++;
+		edgeTriangleCounts[EdgeKey(i1, i2)]++;
+		edgeTriangleCounts[EdgeKey(i2, i0)]++;
+	}
+
+	// 境界辺と非多様体辺の頂点は固定する(UVシームやメッシュ間の継ぎ目に穴を開けないため)
+	std::vector<bool> isLocked(vertexCount, false);
+	for (const auto& [key, count] : edgeTriangleCounts) {
+		if (count != 2) {
+			isLocked[static_cast<uint32_t>(key >> 32)] = true;
+			isLocked[static_cast<uint32_t>(key & 0xFFFFFFFF)] = true;
+		}
+	}
+
+	std::vector<bool> isVertexAlive(vertexCount, true);
+	std::vector<uint32_t> versions(vertexCount, 0);
+
+	std::priority_queue<Collapse, std::vector<Collapse>, std::greater<Collapse>> collapses;
+
+	// 縮約候補を積む
+	auto pushCollapse = [&](uint32_t from, uint32_t to) {
+		if (isLocked[from]) return;
+		Quadric q = quadrics[from];
+		q.Add(quadrics[to]);
+		collapses.push({ q.Evaluate(positions[to]), from, to, versions[from], versions[to] });
+	};
+
+	// 頂点の隣接三角形から隣接頂点を集める
+	auto gatherNeighbors = [&](uint32_t v, std::vector<uint32_t>& out) {
+		out.clear();
+		for (uint32_t t : vertexTriangles[v]) {
+			if (!isTriangleAlive[t]) continue;
+			for (uint32_t k = 0; k < 3; k++) {
+				const uint32_t n = triangles[t * 3 + k];
+				if (n != v) out.push_back(n);
+			}
+		}
+		std::sort(out.begin(), out.end());
+		out.erase(std::unique(out.begin(), out.end()), out.end());
+	};
+
+	for (const auto& [key, count] : edgeTriangleCounts) {
+		const uint32_t a = static_cast<uint32_t>(key >> 32);
+		const uint32_t b = static_cast<uint32_t>(key & 0xFFFFFFFF);
+		pushCollapse(a, b);
+		pushCollapse(b, a);
+	}
+
+	const double maxCost = static_cast<double>(targetError) * static_cast<double>(targetError);
+	double resultCost = 0.0;
+
+	std::vector<uint32_t> fromNeighbors;
+	std::vector<uint32_t> toNeighbors;
+
+	while (!collapses.empty() && static_cast<size_t>(aliveTriangleCount) * 3 > targetIndexCount) {
+		const Collapse c = collapses.top();
+		collapses.pop();
+
+		if (c.cost > maxCost) break;
+		if (!isVertexAlive[c.from] || !isVertexAlive[c.to]) continue;
+		if (versions[c.from] != c.fromVersion || versions[c.to] != c.toVersion) continue;
+
+		// 辺がまだ残っているか、共有する三角形の数を調べる
+		uint32_t sharedTriangleCount = 0;
+		for (uint32_t t : vertexTriangles[c.from]) {
+			if (!isTriangleAlive[t]) continue;
+			if (triangles[t * 3 + 0] == c.to || triangles[t * 3 + 1] == c.to || triangles[t * 3 + 2] == c.to) {
+				sharedTriangleCount++;
+			}
+		}
+		if (sharedTriangleCount == 0) continue;
+
+		// リンク条件: 共通の隣接頂点が共有三角形より多いと非多様体になる
+		gatherNeighbors(c.from, fromNeighbors);
+		gatherNeighbors(c.to, toNeighbors);
+		uint32_t commonCount = 0;
+		for (uint32_t n : fromNeighbors) {
+			if (std::binary_search(toNeighbors.begin(), toNeighbors.end(), n)) commonCount++;
+		}
+		if (commonCount > sharedTriangleCount) continue;
+
+		// 縮約で面が裏返らないか確認
+		bool isFlipped = false;
+		for (uint32_t t : vertexTriangles[c.from]) {
+			if (!isTriangleAlive[t]) continue;
+			const uint32_t* tri = &triangles[t * 3];
+			if (tri[0] == c.to || tri[1] == c.to || tri[2] == c.to) continue;
+
+			Vector3 p[3];
+			for (uint32_t k = 0; k < 3; k++) {
+				p[k] = positions[tri[k]];
+			}
+			const Vector3 before = TriangleNormal(p[0], p[1], p[2]);
+			for (uint32_t k = 0; k < 3; k++) {
+				if (tri[k] == c.from) p[k] = positions[c.to];
+			}
+			const Vector3 after = TriangleNormal(p[0], p[1], p[2]);
+
+			const float dot = before.x * after.x + before.y * after.y + before.z * after.z;
+			const float afterLengthSq = after.x * after.x + after.y * after.y + after.z * after.z;
+			if (dot <= 0.0f || afterLengthSq == 0.0f) {
+				isFlipped = true;
+				break;
+			}
+		}
+		if (isFlipped) continue;
+
+		// 縮約を実行
+		isVertexAlive[c.from] = false;
+		quadrics[c.to].Add(quadrics[c.from]);
+		versions[c.to]++;
+		resultCost = (std::max)(resultCost, c.cost);
+
+		for (uint32_t t : vertexTriangles[c.from]) {
+			if (!isTriangleAlive[t]) continue;
+			uint32_t* tri = &triangles[t * 3];
+			if (tri[0] == c.to || tri[1] == c.to || tri[2] == c.to) {
+				// 縮約する辺を含む三角形は潰れる
+				isTriangleAlive[t] = false;
+				aliveTriangleCount--;
+				continue;
+			}
+			for (uint32_t k = 0; k < 3; k++) {
+				if (tri[k] == c.from) tri[k] = c.to;
+			}
+			vertexTriangles[c.to].push_back(t);
+		}
+		vertexTriangles[c.from].clear();
+
+		// 死んだ三角形を取り除く
+		std::erase_if(vertexTriangles[c.to], [&](uint32_t t) { return !isTriangleAlive[t]; });
+
+		// 縮約先の周囲の候補を積み直す
+		gatherNeighbors(c.to, toNeighbors);
+		for (uint32_t n : toNeighbors) {
+			pushCollapse(n, c.to);
+			pushCollapse(c.to, n);
+		}
+	}
+
+	// 生き残った三角形を元の順序で出力
+	outIndices.clear();
+	outIndices.reserve(static_cast<size_t>(aliveTriangleCount) * 3);
+	for (uint32_t t = 0; t < triangleCount; t++) {
+		if (!isTriangleAlive[t]) continue;
+		outIndices.push_back(triangles[t * 3 + 0]);
+		outIndices.push_back(triangles[t * 3 + 1]);
+		outIndices.push_back(triangles[t * 3 + 2]);
+	}
+
+	return static_cast<float>(std::sqrt(resultCost));
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+// C++
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// MyHedder
+#include "Math/Utility/MathUtility.h"
+
+/// <summary>
+/// 二次誤差メトリクス(QEM)によるメッシュ簡略化
+/// 頂点バッファは共有したままインデックスのみを作り直す
+/// </summary>
+class MeshSimplifier {
+public:
+	// 三角形数が目標インデックス数以下、または誤差が上限に達するまで辺を縮約する
+	// 戻り値は縮約で生じた最大の二次誤差の平方根(オブジェクト空間での元の面からの距離の上限)
+	static float Simplify(
+		const std::vector<Vector3>& positions,
+		const std::vector<uint32_t>& indices,
+		size_t targetIndexCount,
+		float targetError,
+		std::vector<uint32_t>& outIndices
+	);
+};
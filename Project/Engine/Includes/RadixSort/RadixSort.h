@@ -0,0 +1,104 @@
+#pragma once
+
+// C++
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/// <summary>
+/// 基数ソート(下位の桁から8bitずつ並べる安定ソート)
+/// 全要素で同じ値の桁は並べ替えないので、使っていない上位ビットの分は手間がかからない
+/// </summary>
+namespace RadixSort {
+
+	// keyFunctionが返す符号なし整数の昇順に並べる(scratchは要素数以上の作業領域)
+	template<typename T, typename KeyFunction>
+	void Sort(std::span<T> values, std::span<T> scratch, KeyFunction keyFunction) {
+		using Key = std::invoke_result_t<KeyFunction, const T&>;
+		static_assert(std::is_unsigned_v<Key>, "RadixSort key must be an unsigned integer");
+		constexpr uint32_t kDigitBits = 8;
+		constexpr uint32_t kDigitCount = sizeof(Key);
+		constexpr uint32_t kBucketCount = 1u << kDigitBits;
+
+		const size_t count = values.size();
+		if (count <= 1) {
+			return;
+		}
+		assert(scratch.size() >= count);
+		assert(count <= (std::numeric_limits<uint32_t>::max)());
+
+		// 全桁のヒストグラムを一度の走査で作る
+		std::array<std::array<uint32_t, kBucketCount>, kDigitCount> histograms{};
+		for (const T& value : values) {
+			const Key key = keyFunction(value);
+			for (uint32_t digit = 0; digit < kDigitCount; ++digit) {
+				histograms[digit][(key >> (digit * kDigitBits)) & (kBucketCount - 1)]++;
+			}
+		}
+
+		T* source = values.data();
+		T* destination = scratch.data();
+		for (uint32_t digit = 0; digit < kDigitCount; ++digit) {
+			const uint32_t shift = digit * kDigitBits;
+			std::array<uint32_t, kBucketCount>& histogram = histograms[digit];
+
+			// 全要素が同じ桁なら並びは変わらない
+			if (histogram[(keyFunction(source[0]) >> shift) & (kBucketCount - 1)] == count) {
+				continue;
+			}
+
+			// 書き込み位置に変換
+			uint32_t offset = 0;
+			for (uint32_t& bucket : histogram) {
+				const uint32_t bucketCount = bucket;
+				bucket = offset;
+				offset += bucketCount;
+			}
+
+			for (size_t i = 0; i < count; ++i) {
+				const uint32_t bucket = static_cast<uint32_t>((keyFunction(source[i]) >> shift) & (kBucketCount - 1));
+				destination[histogram[bucket]++] = std::move(source[i]);
+			}
+			std::swap(source, destination);
+		}
+
+		// 作業領域に残っていれば戻す
+		if (source != values.data()) {
+			for (size_t i = 0; i < count; ++i) {
+				values[i] = std::move(source[i]);
+			}
+		}
+	}
+
+	// floatを大小関係を保ったまま符号なし整数にする
+	inline uint32_t FloatToKey(float value) {
+		const uint32_t bits = std::bit_cast<uint32_t>(value);
+		// 負の数は全ビットを、正の数は符号ビットだけを反転する
+		return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+	}
+
+	// 深度で並べ替えるときの要素(8byteだけ動かして、元のデータは並べ替えない)
+	struct DepthEntry {
+		uint32_t key = 0;
+		uint32_t index = 0;
+	};
+
+	// 深度の大きい順(奥から手前)に並べた元の位置をentriesに求める(同じ深度は積んだ順)
+	inline void SortBackToFront(std::span<const float> depths, std::vector<DepthEntry>& entries, std::vector<DepthEntry>& scratch) {
+		entries.resize(depths.size());
+		scratch.resize(depths.size());
+		for (size_t i = 0; i < depths.size(); ++i) {
+			entries[i] = DepthEntry{ .key = ~FloatToKey(depths[i]), .index = static_cast<uint32_t>(i) };
+		}
+		Sort(std::span<DepthEntry>(entries), std::span<DepthEntry>(scratch), [](const DepthEntry& entry) {
+			return entry.key;
+			});
+	}
+
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+// C++
+#include <cstdint>
+
+// DirectX
+#include <d3d12.h>
+
+// MyHedder
+#include "BufferSuballocator/BufferSuballocator.h"
+
+// 共有バッファから切り出した領域
+struct BufferRegion {
+	// 切り出し元のバッファ
+	ID3D12Resource* resource = nullptr;
+	// 切り出し元での位置
+	BufferSuballocator::Allocation allocation{};
+	// 書き込み先(アップロードヒープのときのみ)
+	uint8_t* mappedData = nullptr;
+	// 先頭のGPUアドレス
+	D3D12_GPU_VIRTUAL_ADDRESS gpuAddress = 0;
+};
+
+// シンプル形状の頂点とインデックスのバッファ
+struct PrimitiveShapeBuffer {
+	// 頂点
+	BufferRegion vertexBuffer{};
+	D3D12_VERTEX_BUFFER_VIEW vertexBufferView{};
+	// インデックス
+	BufferRegion indexBuffer{};
+	D3D12_INDEX_BUFFER_VIEW indexBufferView{};
+};
@@ -20,6 +20,24 @@ struct VertexData3D {
 	Vector3 tangent;
 };
 
+/// <summary>
+/// 量子化した3D頂点データ(VertexData3Dの48byteを20byteに圧縮)
+/// </summary>
+struct QuantizedVertexData3D {
+	uint16_t position[4];	// メッシュの境界で正規化した座標(wは未使用)
+	uint16_t texcoord[2];	// 半精度浮動小数
+	int16_t normal[2];		// 八面体エンコードしたsnorm16
+	int16_t tangent[2];		// 八面体エンコードしたsnorm16
+};
+
+/// <summary>
+/// 量子化した座標の復元パラメータ
+/// </summary>
+struct VertexQuantization {
+	Vector3 positionMin;
+	Vector3 positionScale;
+};
+
 /// <summary>
 /// マテリアルデータ
 /// </summary>
@@ -40,13 +58,28 @@ struct Node {
 	std::vector<Node> children;
 };
 
+/// <summary>
+/// メッシュの簡略化LOD(頂点は元メッシュと共有)
+/// </summary>
+struct MeshLODData {
+	std::vector<uint32_t> indices;
+	// 元メッシュからのオブジェクト空間での誤差
+	float error = 0.0f;
+};
+
 /// <summary>
 /// メッシュデータ
 /// </summary>
 struct MeshData {
+	// フル精度の頂点(スキニングするモデルのみ、それ以外は空)
 	std::vector<VertexData3D> vertices;
 	std::vector<uint32_t> indices;
 	MaterialData material;
+	// LOD1以降のインデックス
+	std::vector<MeshLODData> lods;
+	// 描画に使う量子化した頂点
+	std::vector<QuantizedVertexData3D> quantizedVertices;
+	VertexQuantization quantization{};
 };
 
 /// <summary>
@@ -68,6 +101,10 @@ struct ModelData {
 	std::vector<MeshData> meshes;
 	Node rootNode;
 	std::map<std::string, JointWeightData> skinClusterData;
+	// モデル空間の境界ボックス
+	AABB localAABB{};
+	// LODごとの誤差(全メッシュの最大値、LOD0は0)
+	std::vector<float> lodErrors;
 };
 
 /// <summary>
@@ -112,4 +149,10 @@ struct ModelMaterialDataForGPU {
 struct MeshInfo {
 	uint32_t indexSize;
 	uint32_t meshletCount;
+	uint32_t baseInstance;
+	uint32_t padding0;
+	Vector3 positionMin;
+	float padding1;
+	Vector3 positionScale;
+	float padding2;
 };
\ No newline at end of file
@@ -13,4 +13,19 @@ struct PostEffectCommand {
 	PostEffectType postEffectType;
 	PostEffectParamater param;
 	uint32_t index;
+};
+
+/// <summary>
+/// 続けてかけられるコマンドをまとめたパス
+/// </summary>
+struct PostEffectPass {
+	PostEffectPassType passType;
+	// Colorのときに有効にする処理
+	PostEffectColorOp colorOps;
+	// パスにまとめたパラメータ
+	PostEffectParamater param;
+	// 半分の解像度に描画するか
+	bool isHalfResolution;
+	// まとめたコマンドの数
+	uint32_t commandCount;
 };
\ No newline at end of file
@@ -173,7 +173,7 @@ struct MaterialData3D {
 	Vector2 uvScale = { 1.0f,1.0f };
 	float uvRotate = 0.0f;
 	BlendMode blendMode = BlendMode::None;
-	bool isMakeShadow;
+	bool isMakeShadow = true;
 };
 
 /// <summary>
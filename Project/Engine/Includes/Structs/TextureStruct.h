@@ -19,4 +19,6 @@ struct Texture {
 	DirectX::TexMetadata metaData;
 	// srvIndex
 	uint32_t srvIndex;
+	// 常駐管理のハンドル(描画に使われるまでは未登録)
+	uint32_t residencyHandle = 0xFFFFFFFF;
 };
\ No newline at end of file
@@ -0,0 +1,172 @@
+#include "VertexQuantizer.h"
+
+// C++
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+using namespace MAGIMath;
+
+VertexQuantization VertexQuantizer::CalculateQuantization(const std::vector<VertexData3D>& vertices) {
+	if (vertices.empty()) {
+		return VertexQuantization{ .positionMin = { 0.0f,0.0f,0.0f }, .positionScale = { 0.0f,0.0f,0.0f } };
+	}
+
+	Vector3 min = { vertices[0].position.x,vertices[0].position.y,vertices[0].position.z };
+	Vector3 max = min;
+	for (const auto& vertex : vertices) {
+		min.x = (std::min)(min.x, vertex.position.x);
+		min.y = (std::min)(min.y, vertex.position.y);
+		min.z = (std::min)(min.z, vertex.position.z);
+		max.x = (std::max)(max.x, vertex.position.x);
+		max.y = (std::max)(max.y, vertex.position.y);
+		max.z = (std::max)(max.z, vertex.position.z);
+	}
+
+	return VertexQuantization{
+		.positionMin = min,
+		.positionScale = max - min,
+	};
+}
+
+QuantizedVertexData3D VertexQuantizer::Encode(const VertexData3D& vertex, const VertexQuantization& quantization) {
+	// 境界内を0～65535に正規化
+	auto quantize = [](float value, float min, float scale) {
+		const float t = (scale > 0.0f) ? (value - min) / scale : 0.0f;
+		return static_cast<uint16_t>(std::lround(std::clamp(t, 0.0f, 1.0f) * 65535.0f));
+	};
+
+	QuantizedVertexData3D result{};
+	result.position[0] = quantize(vertex.position.x, quantization.positionMin.x, quantization.positionScale.x);
+	result.position[1] = quantize(vertex.position.y, quantization.positionMin.y, quantization.positionScale.y);
+	result.position[2] = quantize(vertex.position.z, quantization.positionMin.z, quantization.positionScale.z);
+	result.position[3] = 0;
+	result.texcoord[0] = FloatToHalf(vertex.texcoord.x);
+	result.texcoord[1] = FloatToHalf(vertex.texcoord.y);
+	EncodeOctahedral(vertex.normal, result.normal);
+	EncodeOctahedral(vertex.tangent, result.tangent);
+	return result;
+}
+
+VertexData3D VertexQuantizer::Decode(const QuantizedVertexData3D& vertex, const VertexQuantization& quantization) {
+	VertexData3D result{};
+	const Vector3 position = DecodePosition(vertex, quantization);
+	result.position = { position.x,position.y,position.z,1.0f };
+	result.texcoord = { HalfToFloat(vertex.texcoord[0]),HalfToFloat(vertex.texcoord[1]) };
+	result.normal = DecodeOctahedral(vertex.normal);
+	result.tangent = DecodeOctahedral(vertex.tangent);
+	return result;
+}
+
+Vector3 VertexQuantizer::DecodePosition(const QuantizedVertexData3D& vertex, const VertexQuantization& quantization) {
+	return {
+		quantization.positionMin.x + static_cast<float>(vertex.position[0]) / 65535.0f * quantization.positionScale.x,
+		quantization.positionMin.y + static_cast<float>(vertex.position[1]) / 65535.0f * quantization.positionScale.y,
+		quantization.positionMin.z + static_cast<float>(vertex.position[2]) / 65535.0f * quantization.positionScale.z
+	};
+}
+
+uint16_t VertexQuantizer::FloatToHalf(float value) {
+	uint32_t bits = 0;
+	std::memcpy(&bits, &value, sizeof(bits));
+
+	const uint32_t sign = (bits >> 16) & 0x8000;
+	const int32_t exponent = static_cast<int32_t>((bits >> 23) & 0xFF) - 127 + 15;
+	uint32_t mantissa = bits & 0x007FFFFF;
+
+	// NaN / Inf
+	if (((bits >> 23) & 0xFF) == 0xFF) {
+		return static_cast<uint16_t>(sign | 0x7C00 | (mantissa ? 0x200 : 0));
+	}
+	// 半精度で表せない大きさは無限大
+	if (exponent >= 31) {
+		return static_cast<uint16_t>(sign | 0x7C00);
+	}
+	// 非正規化数
+	if (exponent <= 0) {
+		if (exponent < -10) {
+			return static_cast<uint16_t>(sign);
+		}
+		mantissa |= 0x00800000;
+		const uint32_t shift = static_cast<uint32_t>(14 - exponent);
+		uint32_t halfMantissa = mantissa >> shift;
+		// 最近接偶数丸め
+		const uint32_t remainder = mantissa & ((1u << shift) - 1);
+		const uint32_t halfway = 1u << (shift - 1);
+		if (remainder > halfway || (remainder == halfway && (halfMantissa & 1))) {
+			halfMantissa++;
+		}
+		return static_cast<uint16_t>(sign | halfMantissa);
+	}
+
+	uint32_t half = sign | (static_cast<uint32_t>(exponent) << 10) | (mantissa >> 13);
+	// 最近接偶数丸め(繰り上がりで指数も正しく進む)
+	const uint32_t remainder = mantissa & 0x1FFF;
+	if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1))) {
+		half++;
+	}
+	return static_cast<uint16_t>(half);
+}
+
+float VertexQuantizer::HalfToFloat(uint16_t value) {
+	const uint32_t sign = static_cast<uint32_t>(value & 0x8000) << 16;
+	uint32_t exponent = (value >> 10) & 0x1F;
+	uint32_t mantissa = value & 0x3FF;
+
+	uint32_t bits = 0;
+	if (exponent == 0x1F) {
+		bits = sign | 0x7F800000 | (mantissa << 13);
+	} else if (exponent == 0) {
+		if (mantissa == 0) {
+			bits = sign;
+		} else {
+			// 非正規化数を正規化
+			exponent = 127 - 15 + 1;
+			while ((mantissa & 0x400) == 0) {
+				mantissa <<= 1;
+				exponent--;
+			}
+			mantissa &= 0x3FF;
+			bits = sign | (exponent << 23) | (mantissa << 13);
+		}
+	} else {
+		bits = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+	}
+
+	float result = 0.0f;
+	std::memcpy(&result, &bits, sizeof(result));
+	return result;
+}
+
+void VertexQuantizer::EncodeOctahedral(const Vector3& v, int16_t out[2]) {
+	const float sum = std::fabs(v.x) + std::fabs(v.y) + std::fabs(v.z);
+	if (sum == 0.0f) {
+		out[0] = 0;
+		out[1] = 0;
+		return;
+	}
+
+	float x = v.x / sum;
+	float y = v.y / sum;
+	// 下半球は外側に折り返す
+	if (v.z < 0.0f) {
+		const float foldX = (1.0f - std::fabs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+		const float foldY = (1.0f - std::fabs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+		x = foldX;
+		y = foldY;
+	}
+
+	out[0] = static_cast<int16_t>(std::lround(std::clamp(x, -1.0f, 1.0f) * 32767.0f));
+	out[1] = static_cast<int16_t>(std::lround(std::clamp(y, -1.0f, 1.0f) * 32767.0f));
+}
+
+Vector3 VertexQuantizer::DecodeOctahedral(const int16_t in[2]) {
+	const float x = (std::max)(static_cast<float>(in[0]) / 32767.0f, -1.0f);
+	const float y = (std::max)(static_cast<float>(in[1]) / 32767.0f, -1.0f);
+
+	Vector3 n = { x, y, 1.0f - std::fabs(x) - std::fabs(y) };
+	const float t = std::clamp(-n.z, 0.0f, 1.0f);
+	n.x += (n.x >= 0.0f) ? -t : t;
+	n.y += (n.y >= 0.0f) ? -t : t;
+	return Normalize(n);
+}
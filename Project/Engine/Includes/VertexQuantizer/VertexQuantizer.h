@@ -0,0 +1,33 @@
+#pragma once
+
+// C++
+#include <cstdint>
+#include <vector>
+
+// MyHedder
+#include "Structs/ModelStruct.h"
+
+/// <summary>
+/// 頂点データの量子化と復元
+/// </summary>
+class VertexQuantizer {
+public:
+	// 頂点の境界から量子化パラメータを求める
+	static VertexQuantization CalculateQuantization(const std::vector<VertexData3D>& vertices);
+	// 頂点を量子化
+	static QuantizedVertexData3D Encode(const VertexData3D& vertex, const VertexQuantization& quantization);
+	// 量子化した頂点を復元
+	static VertexData3D Decode(const QuantizedVertexData3D& vertex, const VertexQuantization& quantization);
+	// 量子化した頂点の座標だけを復元
+	static Vector3 DecodePosition(const QuantizedVertexData3D& vertex, const VertexQuantization& quantization);
+
+private:
+	// 単精度を半精度に変換
+	static uint16_t FloatToHalf(float value);
+	// 半精度を単精度に変換
+	static float HalfToFloat(uint16_t value);
+	// 単位ベクトルを八面体エンコード
+	static void EncodeOctahedral(const Vector3& v, int16_t out[2]);
+	// 八面体エンコードしたベクトルを復元
+	static Vector3 DecodeOctahedral(const int16_t in[2]);
+};
@@ -26,37 +26,42 @@ void Camera3DManager::Update() {
 #if defined(DEBUG)|| defined(DEVELOP)
 	if (isDebugCamera_) {
 		debugCamera_->UpdateData();
-		currentCamera_->DrawFrustum();
 	}
 #endif
 }
 
-void Camera3DManager::TransferCurrentCamera(uint32_t rootParameterIndex) {
+void Camera3DManager::WriteFrameData() {
+	// 描画スレッドが使うカメラをこのフレームのものに確定する
+	renderCamera_ = GetCurrentCamera();
+	renderFrustumCamera_ = currentCamera_;
+
+	if (currentCamera_) {
+		currentCamera_->WriteFrameData();
+	}
 #if defined(DEBUG)|| defined(DEVELOP)
-	// デバッグカメラフラグがオンの場合デバッグカメラを転送
 	if (isDebugCamera_) {
-		debugCamera_->TransferCamera(rootParameterIndex);
-		return;
+		debugCamera_->WriteFrameData();
+		currentCamera_->DrawFrustum();
 	}
 #endif
-	// 現在選択中のカメラを見つけて転送
-	currentCamera_->TransferCamera(rootParameterIndex);
+}
+
+void Camera3DManager::TransferCurrentCamera(uint32_t rootParameterIndex) {
+	// 確定したカメラ(デバッグカメラフラグがオンの場合デバッグカメラ)を転送
+	assert(renderCamera_);
+	renderCamera_->TransferCamera(rootParameterIndex);
 }
 
 void Camera3DManager::TransferCurrentCameraInverse(uint32_t rootParameterIndex) {
-#if defined(DEBUG)|| defined(DEVELOP)
-	// デバッグカメラフラグがオンの場合デバッグカメラを転送
-	if (isDebugCamera_) {
-		debugCamera_->TransferCameraInv(rootParameterIndex);
-		return;
-	}
-#endif // _DEBUG
-	// 現在選択中のカメラを見つけて転送
-	currentCamera_->TransferCameraInv(rootParameterIndex);
+	// 確定したカメラ(デバッグカメラフラグがオンの場合デバッグカメラ)を転送
+	assert(renderCamera_);
+	renderCamera_->TransferCameraInv(rootParameterIndex);
 }
 
 void Camera3DManager::TransferCurrentCameraFrustum(uint32_t rootParameterIndex) {
-	currentCamera_->TransferCameraFrustum(rootParameterIndex);
+	// カリングはデバッグカメラ中も選択中のカメラで行う
+	assert(renderFrustumCamera_);
+	renderFrustumCamera_->TransferCameraFrustum(rootParameterIndex);
 }
 
 void Camera3DManager::DrawCurrentCameraFrustum() {
@@ -77,6 +82,17 @@ Camera3D* Camera3DManager::Add(const std::string& name, std::unique_ptr<Camera3D
 void Camera3DManager::Remove(const std::string& cameraName) {
 	// 指定した名前のカメラを検索
 	if (cameras3D_.contains(cameraName)) {
+		// 確定済みのカメラなら外す
+		Camera3D* camera = cameras3D_[cameraName].get();
+		if (renderCamera_ == camera) {
+			renderCamera_ = nullptr;
+		}
+		if (renderFrustumCamera_ == camera) {
+			renderFrustumCamera_ = nullptr;
+		}
+		if (currentCamera_ == camera) {
+			currentCamera_ = nullptr;
+		}
 		// 見つかったら消す
 		cameras3D_.erase(cameraName);
 	} else {
@@ -112,10 +128,21 @@ Camera3D* Camera3DManager::GetCurrentCamera() {
 	return currentCamera_;
 }
 
+float Camera3DManager::GetViewDepth(const Vector3& worldPosition) {
+	Camera3D* camera = GetCurrentCamera();
+	if (!camera) {
+		return 0.0f;
+	}
+	return camera->GetViewDepth(worldPosition);
+}
+
 bool& Camera3DManager::GetIsDebugCamera() {
 	return isDebugCamera_;
 }
 
 void Camera3DManager::Clear() {
 	cameras3D_.clear();
+	currentCamera_ = nullptr;
+	renderCamera_ = nullptr;
+	renderFrustumCamera_ = nullptr;
 }
@@ -18,6 +18,8 @@ public:
 
 	void Initialize();
 	void Update();
+	// 今のフレームのカメラのデータを書き込み、描画スレッドが使うカメラを確定する
+	void WriteFrameData();
 	void TransferCurrentCamera(uint32_t rootParameterIndex);
 	void TransferCurrentCameraInverse(uint32_t rootParameterIndex);
 	void TransferCurrentCameraFrustum(uint32_t rootParameterIndex);
@@ -35,6 +37,9 @@ public:
 	// 使用中のカメラを取得
 	Camera3D* GetCurrentCamera();
 
+	// 使用中のカメラから見た深度を取得(カメラがなければ0)
+	float GetViewDepth(const Vector3& worldPosition);
+
 	// デバッグカメラフラグの参照
 	bool& GetIsDebugCamera();
 
@@ -49,4 +54,8 @@ private:
 	std::unique_ptr<DebugCamera3D> debugCamera_;
 	// 現在使用中のカメラ
 	Camera3D* currentCamera_ = nullptr;
+	// 描画スレッドが転送するカメラ(WriteFrameDataで確定する)
+	Camera3D* renderCamera_ = nullptr;
+	// 描画スレッドがカリングに使うカメラ
+	Camera3D* renderFrustumCamera_ = nullptr;
 };
\ No newline at end of file
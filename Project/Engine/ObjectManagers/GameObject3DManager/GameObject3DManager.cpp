@@ -51,6 +51,9 @@ std::weak_ptr<GameObject3D> GameObject3DManager::Find(const std::string& objectN
 void GameObject3DManager::DeleteGarbage() {
 	for (auto& gameobject : gameObjects_) {
 		if (gameobject && !gameobject->GetIsAlive()) {
+			// 空間インデックスから外す
+			spatialIndex_.Remove(gameobject->GetSpatialProxyId());
+			gameobject->SetSpatialProxyId(LooseOctree::kInvalidProxyId);
 			gameobject->Finalize();
 		}
 	}
@@ -68,5 +71,47 @@ void GameObject3DManager::DeleteGarbage() {
 }
 
 void GameObject3DManager::Clear() {
+	spatialIndex_.Clear();
 	gameObjects_.clear();
+}
+
+void GameObject3DManager::UpdateSpatialIndex() {
+	for (auto& gameObject : gameObjects_) {
+		if (!gameObject || !gameObject->GetIsAlive()) {
+			continue;
+		}
+
+		// 生成後に読み込みが終わったモデルは境界ボックスを取り直して入れ直す
+		const bool isBoundsUpdated = gameObject->UpdateModelBounds();
+
+		const uint32_t proxyId = gameObject->GetSpatialProxyId();
+		if (proxyId == LooseOctree::kInvalidProxyId) {
+			// 描画物を持つオブジェクトだけ登録
+			if (gameObject->HasModelRenderer()) {
+				gameObject->SetSpatialProxyId(spatialIndex_.Insert(gameObject->GetWorldAABB(), gameObject.get()));
+			}
+		} else if (isBoundsUpdated || gameObject->GetIsWorldAABBChanged()) {
+			spatialIndex_.Update(proxyId, gameObject->GetWorldAABB());
+		}
+	}
+}
+
+void GameObject3DManager::RebuildSpatialIndex(const AABB& worldBounds) {
+	spatialIndex_.Rebuild(worldBounds);
+}
+
+const AABB& GameObject3DManager::GetSpatialIndexBounds() const {
+	return spatialIndex_.GetWorldBounds();
+}
+
+void GameObject3DManager::QueryAABB(const AABB& bounds, std::vector<GameObject3D*>& result) const {
+	spatialIndex_.QueryAABB(bounds, result);
+}
+
+void GameObject3DManager::QuerySphere(const Vector3& center, float radius, std::vector<GameObject3D*>& result) const {
+	spatialIndex_.QuerySphere(center, radius, result);
+}
+
+void GameObject3DManager::QueryFrustum(const Vector4 planes[6], std::vector<GameObject3D*>& result) const {
+	spatialIndex_.QueryFrustum(planes, result);
 }
\ No newline at end of file
@@ -7,6 +7,7 @@
 
 // MyHedder
 #include "GameObject3D/GameObject3D.h"
+#include "LooseOctree/LooseOctree.h"
 
 /// <summary>
 /// 3Dゲームオブジェクトマネージャー
@@ -21,7 +22,23 @@ public:
 	void DeleteGarbage();
 	void Clear();
 
+	// 空間インデックスの更新(未登録オブジェクトの登録と移動したオブジェクトの再配置)
+	void UpdateSpatialIndex();
+	// ワールド範囲を指定して空間インデックスを作り直す
+	void RebuildSpatialIndex(const AABB& worldBounds);
+	// 空間インデックスのワールド範囲を取得
+	const AABB& GetSpatialIndexBounds() const;
+
+	// AABBと交差するオブジェクトを取得
+	void QueryAABB(const AABB& bounds, std::vector<GameObject3D*>& result) const;
+	// 球と交差するオブジェクトを取得
+	void QuerySphere(const Vector3& center, float radius, std::vector<GameObject3D*>& result) const;
+	// フラスタムにかかるオブジェクトを取得
+	void QueryFrustum(const Vector4 planes[6], std::vector<GameObject3D*>& result) const;
+
 private:
 	std::vector<std::shared_ptr<GameObject3D>> gameObjects_;
 	std::unordered_map<std::string, std::weak_ptr<GameObject3D>> gameObjectList_;
+	// 空間インデックス
+	LooseOctree spatialIndex_;
 };
\ No newline at end of file
@@ -38,11 +38,6 @@ LightManager::~LightManager() {
 }
 
 void LightManager::Update() {
-	// ライト情報の更新
-	directionalLightData_->direction = directionalLight_.direction;
-	directionalLightData_->intensity = directionalLight_.intensity;
-	directionalLightData_->color = directionalLight_.color;
-
 	// ----------------------------------------------
 	// シャドウマップ用ライトカメラ行列の構築
 	// ----------------------------------------------
@@ -59,9 +54,6 @@ void LightManager::Update() {
 	// ビュー行列（ライト空間ビュー）
 	lightView_ = MakeLookAtMatrix(position, target_, up);
 
-	// VP 行列を GPU 定数バッファへ書き込み
-	directionalLightCameraData_->viewProjection = lightView_ * lightProj_;
-
 	const Matrix4x4 vp = lightView_ * lightProj_;
 	auto row = [&](int r, int c) { return vp.m[r][c]; };
 
@@ -91,11 +83,30 @@ void LightManager::Update() {
 										 row(3,3) - row(3,2) }); // Far
 
 	for (int i = 0; i < 6; ++i) {
-		directionalLightFrustumData_->planes[i] = frustumPlanes_[i];
+		shadowCasterPlanes_[i] = frustumPlanes_[i];
 	}
+	// ニア面はどの位置でも内側になる平面に置き換える
+	shadowCasterPlanes_[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
 
 }
 
+void LightManager::WriteFrameData() {
+	// 今のフレームのリソースへ書き込む
+	const uint32_t frameIndex = directXCommand_->GetFrameIndex();
+
+	// ライト情報の更新
+	directionalLightData_[frameIndex]->direction = directionalLight_.direction;
+	directionalLightData_[frameIndex]->intensity = directionalLight_.intensity;
+	directionalLightData_[frameIndex]->color = directionalLight_.color;
+
+	// VP 行列を GPU 定数バッファへ書き込み
+	directionalLightCameraData_[frameIndex]->viewProjection = lightView_ * lightProj_;
+
+	for (int i = 0; i < 6; ++i) {
+		directionalLightFrustumData_[frameIndex]->planes[i] = frustumPlanes_[i];
+	}
+}
+
 void LightManager::SetDirectionalLight(const DirectionalLight& directionalLight) {
 	directionalLight_.direction = Normalize(directionalLight.direction);
 	directionalLight_.intensity = directionalLight.intensity;
@@ -110,54 +121,70 @@ void LightManager::TransferDirectionalLight(uint32_t paramIndex) {
 	// コマンドリストを取得
 	ID3D12GraphicsCommandList* commandList = directXCommand_->GetList();
 	// ライト情報を送る
-	commandList->SetGraphicsRootConstantBufferView(paramIndex, directionalLightResource_->GetGPUVirtualAddress());
+	commandList->SetGraphicsRootConstantBufferView(paramIndex, directionalLightResource_[directXCommand_->GetFrameIndex()]->GetGPUVirtualAddress());
 }
 
 void LightManager::TransferDirectionalLightCamera(uint32_t paramIndex) {
 	// コマンドリストを取得
 	ID3D12GraphicsCommandList* commandList = directXCommand_->GetList();
 	// ライト情報を送る
-	commandList->SetGraphicsRootConstantBufferView(paramIndex, directionalLightCameraResource_->GetGPUVirtualAddress());
+	commandList->SetGraphicsRootConstantBufferView(paramIndex, directionalLightCameraResource_[directXCommand_->GetFrameIndex()]->GetGPUVirtualAddress());
 }
 
 void LightManager::TransferDirectionalLightFrustum(uint32_t paramIndex) {
 	// コマンドリストを取得
 	ID3D12GraphicsCommandList* commandList = directXCommand_->GetList();
 	// ライト情報を送る
-	commandList->SetGraphicsRootConstantBufferView(paramIndex, directionalLightFrustumResource_->GetGPUVirtualAddress());
+	commandList->SetGraphicsRootConstantBufferView(paramIndex, directionalLightFrustumResource_[directXCommand_->GetFrameIndex()]->GetGPUVirtualAddress());
+}
+
+bool LightManager::IsInDirectionalLightShadowVolume(const AABB& worldAABB) const {
+	return MAGIMath::IsAABBInFrustum(worldAABB, shadowCasterPlanes_);
 }
 
 void LightManager::CreateDirectionalLightResource() {
-	directionalLightResource_ = dxgi_->CreateBufferResource(sizeof(DirectionalLightForGPU));
+	for (uint32_t frame = 0; frame < FrameConst::FrameCount; ++frame) {
+		directionalLightResource_[frame] = dxgi_->CreateBufferResource(sizeof(DirectionalLightForGPU));
+	}
 }
 
 void LightManager::MapDirectionalLightData() {
-	directionalLightData_ = nullptr;
-	directionalLightResource_->Map(0, nullptr, reinterpret_cast<void**>(&directionalLightData_));
-	directionalLightData_->direction = { 0.0f,-1.0f,0.0f };
-	directionalLightData_->intensity = 1.0f;
-	directionalLightData_->color = { 1.0f,1.0f,1.0f };
+	for (uint32_t frame = 0; frame < FrameConst::FrameCount; ++frame) {
+		directionalLightData_[frame] = nullptr;
+		directionalLightResource_[frame]->Map(0, nullptr, reinterpret_cast<void**>(&directionalLightData_[frame]));
+		directionalLightData_[frame]->direction = { 0.0f,-1.0f,0.0f };
+		directionalLightData_[frame]->intensity = 1.0f;
+		directionalLightData_[frame]->color = { 1.0f,1.0f,1.0f };
+	}
 }
 
 void LightManager::CreateDirectionalLightCameraResource() {
-	directionalLightCameraResource_ = dxgi_->CreateBufferResource(sizeof(DirectionalLightCameraForGPU));
+	for (uint32_t frame = 0; frame < FrameConst::FrameCount; ++frame) {
+		directionalLightCameraResource_[frame] = dxgi_->CreateBufferResource(sizeof(DirectionalLightCameraForGPU));
+	}
 }
 
 void LightManager::MapDirectionalLightCameraData() {
-	directionalLightCameraData_ = nullptr;
-	directionalLightCameraResource_->Map(0, nullptr, reinterpret_cast<void**>(&directionalLightCameraData_));
-	directionalLightCameraData_->viewProjection = MakeIdentityMatrix4x4();
+	for (uint32_t frame = 0; frame < FrameConst::FrameCount; ++frame) {
+		directionalLightCameraData_[frame] = nullptr;
+		directionalLightCameraResource_[frame]->Map(0, nullptr, reinterpret_cast<void**>(&directionalLightCameraData_[frame]));
+		directionalLightCameraData_[frame]->viewProjection = MakeIdentityMatrix4x4();
+	}
 }
 
 void LightManager::CreateDirectionalLightFrustumResource() {
-	directionalLightFrustumResource_ = dxgi_->CreateBufferResource(sizeof(DirectionalLightFrustumForGPU));
+	for (uint32_t frame = 0; frame < FrameConst::FrameCount; ++frame) {
+		directionalLightFrustumResource_[frame] = dxgi_->CreateBufferResource(sizeof(DirectionalLightFrustumForGPU));
+	}
 }
 
 void LightManager::MapDirectionalLightFrustumData() {
-	directionalLightFrustumData_ = nullptr;
-	directionalLightFrustumResource_->Map(0, nullptr, reinterpret_cast<void**>(&directionalLightFrustumData_));
-	for (uint32_t i = 0; i < 6; i++) {
-		directionalLightFrustumData_->planes[i] = { 0.0f,0.0f,0.0f };
+	for (uint32_t frame = 0; frame < FrameConst::FrameCount; ++frame) {
+		directionalLightFrustumData_[frame] = nullptr;
+		directionalLightFrustumResource_[frame]->Map(0, nullptr, reinterpret_cast<void**>(&directionalLightFrustumData_[frame]));
+		for (uint32_t i = 0; i < 6; i++) {
+			directionalLightFrustumData_[frame]->planes[i] = { 0.0f,0.0f,0.0f };
+		}
 	}
 }
 
@@ -10,6 +10,7 @@
 #include "DirectX/ComPtr/ComPtr.h"
 #include "Structs/LightStruct.h"
 #include "Math/Utility/MathUtility.h"
+#include "Const/FrameConst.h"
 
 class DXGI;
 class DirectXCommand;
@@ -23,7 +24,10 @@ public:
 	LightManager(DXGI* dxgi, DirectXCommand* directXCommand);
 	~LightManager();
 
+	// ライトカメラの行列と平面を計算する
 	void Update();
+	// 今のフレームのリソースへライトのデータを書き込む(描画スレッドが止まっている間に呼ぶ)
+	void WriteFrameData();
 
 	void SetDirectionalLight(const DirectionalLight& directionalLight);
 	void SetDirectionalLightCameraTarget(const Vector3& target);
@@ -31,6 +35,9 @@ public:
 	void TransferDirectionalLight(uint32_t paramIndex);
 	void TransferDirectionalLightCamera(uint32_t paramIndex);
 	void TransferDirectionalLightFrustum(uint32_t paramIndex);
+
+	// 平行光源の影に映りうる範囲にかかっているか(ニア面より手前の遮蔽物も影を落とすのでニア面は判定しない)
+	[[nodiscard]] bool IsInDirectionalLightShadowVolume(const AABB& worldAABB) const;
 private:
 	void CreateDirectionalLightResource();
 	void MapDirectionalLightData();
@@ -53,14 +60,15 @@ private:
 	// DirectionalLight
 	//========================
 	DirectionalLight directionalLight_{};
-	ComPtr<ID3D12Resource> directionalLightResource_ = nullptr;
-	DirectionalLightForGPU* directionalLightData_ = nullptr;
+	// GPUが読んでいる間に書き換えないようにフレームごとに持つ
+	ComPtr<ID3D12Resource> directionalLightResource_[FrameConst::FrameCount];
+	DirectionalLightForGPU* directionalLightData_[FrameConst::FrameCount]{};
 
 	//========================
 	// DirectionalLightCamera
 	//========================
-	ComPtr<ID3D12Resource> directionalLightCameraResource_;
-	DirectionalLightCameraForGPU* directionalLightCameraData_ = nullptr;
+	ComPtr<ID3D12Resource> directionalLightCameraResource_[FrameConst::FrameCount];
+	DirectionalLightCameraForGPU* directionalLightCameraData_[FrameConst::FrameCount]{};
 	// ニアクリップ距離
 	const float nearClipRange_ = 1.0f;
 	// ファークリップ距離
@@ -73,9 +81,11 @@ private:
 	//========================
 	// DirectionalLightFrustum
 	//========================
-	ComPtr<ID3D12Resource> directionalLightFrustumResource_;
-	DirectionalLightFrustumForGPU* directionalLightFrustumData_{};
+	ComPtr<ID3D12Resource> directionalLightFrustumResource_[FrameConst::FrameCount];
+	DirectionalLightFrustumForGPU* directionalLightFrustumData_[FrameConst::FrameCount]{};
 	Vector4 frustumPlanes_[6]{};
+	// 影を落とすオブジェクトの判定用平面(ニア面は常に通す)
+	Vector4 shadowCasterPlanes_[6]{};
 
 private:
 	DXGI* dxgi_ = nullptr;
@@ -4,7 +4,8 @@
 
 #include "Logger/Logger.h"
 
-ParticleGroup3DManager::ParticleGroup3DManager() {
+ParticleGroup3DManager::ParticleGroup3DManager(RenderQueue* renderQueue) {
+	SetRenderQueue(renderQueue);
 	Logger::Log("ParticleGroup3DManager Initialize\n");
 }
 
@@ -20,10 +21,11 @@ void ParticleGroup3DManager::Update() {
 	}
 }
 
-void ParticleGroup3DManager::Draw() {
+void ParticleGroup3DManager::WriteFrameData() {
 	for (auto& particleGroup3D : particleGroups3D_) {
 		if (particleGroup3D) {
-			particleGroup3D->Draw();
+			particleGroup3D->WriteFrameData();
+			particleGroup3D->SubmitRenderItem(renderQueue_);
 		}
 	}
 }
@@ -111,3 +113,8 @@ BaseParticleGroup3D* ParticleGroup3DManager::Find(const std::string& name) {
 const std::vector<std::unique_ptr<BaseParticleGroup3D>>& ParticleGroup3DManager::GetParticleGroups() {
 	return particleGroups3D_;
 }
+
+void ParticleGroup3DManager::SetRenderQueue(RenderQueue* renderQueue) {
+	assert(renderQueue);
+	renderQueue_ = renderQueue;
+}
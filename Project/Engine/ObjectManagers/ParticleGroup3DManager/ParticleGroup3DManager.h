@@ -15,11 +15,12 @@
 /// </summary>
 class ParticleGroup3DManager {
 public:
-	ParticleGroup3DManager();
+	ParticleGroup3DManager(RenderQueue* renderQueue);
 	~ParticleGroup3DManager();
 
 	void Update();
-	void Draw();
+	// 今のフレームのリソースへ書き込んで描画キューに積む(描画スレッドが止まっている間に呼ぶ)
+	void WriteFrameData();
 
 	std::string CreatePrimitiveParticleGroup(const std::string& particleGroupName, const Primitive3DType& primitiveType, const std::string& textureName);
 
@@ -31,8 +32,13 @@ public:
 
 	const std::vector<std::unique_ptr<BaseParticleGroup3D>>& GetParticleGroups();
 
+private:
+	void SetRenderQueue(RenderQueue* renderQueue);
+
 private:
 	// パーティクルグループコンテナ
 	std::vector<std::unique_ptr<BaseParticleGroup3D>> particleGroups3D_;
+
+	RenderQueue* renderQueue_ = nullptr;
 };
 
@@ -5,6 +5,7 @@
 #include "Logger/Logger.h"
 #include "DirectX/DXGI/DXGI.h"
 #include "DirectX/ShaderCompiler/ShaderCompiler.h"
+#include "Structs/ModelStruct.h"
 
 Model3DGraphicsPipeline::Model3DGraphicsPipeline(DXGI* dxgi, ShaderCompiler* shaderCompiler)
 	: BaseGraphicsPipeline(dxgi, shaderCompiler) {
@@ -108,7 +109,7 @@ void Model3DGraphicsPipeline::CreateRootSignature() {
 	// b2 MeshInfo
 	rootParams[9].ParameterType = D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS;
 	rootParams[9].ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
-	rootParams[9].Constants.Num32BitValues = 4;
+	rootParams[9].Constants.Num32BitValues = sizeof(MeshInfo) / sizeof(uint32_t);
 	rootParams[9].Constants.ShaderRegister = 2;
 
 	// b3 Frustum
@@ -54,6 +54,11 @@ void PostEffectPipelineManager::Initialize(DXGI* dxgi, ShaderCompiler* shaderCom
 	SetRootSignature(PostEffectType::RadialBlur);
 	SetPipelineState(PostEffectType::RadialBlur);
 
+	// 色をまとめてかけるパイプラインを組み合わせごとに生成、初期化
+	for (uint32_t i = 0; i < kPostEffectColorPermutationNum; i++) {
+		fusedColorPostEffectPipelines_[i] = std::make_unique<FusedColorPostEffectPipeline>(dxgi, shaderCompiler, static_cast<PostEffectColorOp>(i));
+		fusedColorPostEffectPipelines_[i]->Initialize();
+	}
 }
 
 ID3D12RootSignature* PostEffectPipelineManager::GetRootSignature(PostEffectType pipelineState) {
@@ -64,6 +69,16 @@ ID3D12PipelineState* PostEffectPipelineManager::GetPipelineState(PostEffectType
 	return postEffectPipelineStates_[static_cast<uint32_t>(pipelineState)][static_cast<uint32_t>(blendMode)].Get();
 }
 
+ID3D12RootSignature* PostEffectPipelineManager::GetFusedColorRootSignature(PostEffectColorOp colorOps) {
+	assert(static_cast<uint32_t>(colorOps) < kPostEffectColorPermutationNum);
+	return fusedColorPostEffectPipelines_[static_cast<uint32_t>(colorOps)]->GetRootSignature();
+}
+
+ID3D12PipelineState* PostEffectPipelineManager::GetFusedColorPipelineState(PostEffectColorOp colorOps, BlendMode blendMode) {
+	assert(static_cast<uint32_t>(colorOps) < kPostEffectColorPermutationNum);
+	return fusedColorPostEffectPipelines_[static_cast<uint32_t>(colorOps)]->GetPipelineState(blendMode);
+}
+
 void PostEffectPipelineManager::SetRootSignature(PostEffectType pipelineState) {
 	// パイプラインごとに対応するルートシグネイチャを設定
 	switch (pipelineState) {
@@ -21,6 +21,7 @@ class ShaderCompiler;
 #include "PostEffectPipelines/GaussianBlurXPostEffectPipeline/GaussianBlurXPostEffectPipeline.h"
 #include "PostEffectPipelines/GaussianBlurYPostEffectPipeline/GaussianBlurYPostEffectPipeline.h"
 #include "PostEffectPipelines/RadialBlurPostEffectPipeline/RadialBlurPostEffectPipeline.h"
+#include "PostEffectPipelines/FusedColorPostEffectPipeline/FusedColorPostEffectPipeline.h"
 
 /// <summary>
 /// ポストエフェクトパイプラインマネージャ
@@ -38,6 +39,12 @@ public:
 	// パイプラインステイトのゲッター
 	ID3D12PipelineState* GetPipelineState(PostEffectType pipelineState, BlendMode blendMode);
 
+	// 色をまとめてかけるパスのルートシグネイチャのゲッター
+	ID3D12RootSignature* GetFusedColorRootSignature(PostEffectColorOp colorOps);
+
+	// 色をまとめてかけるパスのパイプラインステイトのゲッター
+	ID3D12PipelineState* GetFusedColorPipelineState(PostEffectColorOp colorOps, BlendMode blendMode);
+
 	// ルートシグネイチャをセット
 	void SetRootSignature(PostEffectType pipelineState);
 
@@ -62,4 +69,6 @@ private:
 	std::unique_ptr<GaussianBlurYPostEffectPipeline> gaussianBlurYPostEffectPipeline_ = nullptr;
 	// RadialBlurPostEffectPipeline
 	std::unique_ptr<RadialBlurPostEffectPipeline> radialBlurPostEffectPipeline_ = nullptr;
+	// FusedColorPostEffectPipeline(有効にする処理の組み合わせごと)
+	std::unique_ptr<FusedColorPostEffectPipeline> fusedColorPostEffectPipelines_[kPostEffectColorPermutationNum];
 };
\ No newline at end of file
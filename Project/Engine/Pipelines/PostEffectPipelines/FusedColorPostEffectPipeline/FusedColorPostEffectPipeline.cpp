@@ -0,0 +1,36 @@
+#include "FusedColorPostEffectPipeline.h"
+
+#include <cassert>
+
+#include "Logger/Logger.h"
+#include "DirectX/DXGI/DXGI.h"
+#include "DirectX/ShaderCompiler/ShaderCompiler.h"
+
+FusedColorPostEffectPipeline::FusedColorPostEffectPipeline(DXGI* dxgi, ShaderCompiler* shaderCompiler, PostEffectColorOp colorOps)
+	:BaseWithParamaterPostEffectPipeline(dxgi, shaderCompiler) {
+	colorOps_ = colorOps;
+}
+
+FusedColorPostEffectPipeline::~FusedColorPostEffectPipeline() {}
+
+void FusedColorPostEffectPipeline::CompileShaders() {
+	vertexShaderBlob_ = nullptr;
+	vertexShaderBlob_ = shaderCompiler_->CompileShader(L"EngineAssets/Shaders/PostEffect/FusedColor/FusedColor.VS.hlsl", L"vs_6_0");
+	assert(vertexShaderBlob_ != nullptr);
+
+	// 有効にする処理をdefineで渡す
+	std::vector<std::wstring> defines;
+	if ((colorOps_ & PostEffectColorOp::RadialBlur) != PostEffectColorOp::None) {
+		defines.push_back(L"ENABLE_RADIAL_BLUR");
+	}
+	if ((colorOps_ & PostEffectColorOp::Grayscale) != PostEffectColorOp::None) {
+		defines.push_back(L"ENABLE_GRAYSCALE");
+	}
+	if ((colorOps_ & PostEffectColorOp::Vignette) != PostEffectColorOp::None) {
+		defines.push_back(L"ENABLE_VIGNETTE");
+	}
+
+	pixelShaderBlob_ = nullptr;
+	pixelShaderBlob_ = shaderCompiler_->CompileShader(L"EngineAssets/Shaders/PostEffect/FusedColor/FusedColor.PS.hlsl", L"ps_6_0", defines);
+	assert(pixelShaderBlob_ != nullptr);
+}
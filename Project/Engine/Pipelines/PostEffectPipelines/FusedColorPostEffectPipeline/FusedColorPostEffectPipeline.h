@@ -0,0 +1,22 @@
+#pragma once
+
+#include "PostEffectPipelines/BaseWithParamaterPostEffectPipeline/BaseWithParamaterPostEffectPipeline.h"
+#include "Enums/PostEffectPipelineEnum.h"
+
+/// <summary>
+/// 色をまとめてかけるポストエフェクト(有効にする処理の組み合わせごとに作る)
+/// </summary>
+class FusedColorPostEffectPipeline :public BaseWithParamaterPostEffectPipeline {
+public:
+	FusedColorPostEffectPipeline(DXGI* dxgi, ShaderCompiler* shaderCompiler, PostEffectColorOp colorOps);
+	~FusedColorPostEffectPipeline()override;
+
+
+private:
+	// シェーダーをコンパイルする
+	void CompileShaders()override;
+
+private:
+	// 有効にする処理
+	PostEffectColorOp colorOps_ = PostEffectColorOp::None;
+};
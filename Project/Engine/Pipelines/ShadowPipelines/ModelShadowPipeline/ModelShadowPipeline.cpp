@@ -5,6 +5,7 @@
 #include "Logger/Logger.h"
 #include "DirectX/DXGI/DXGI.h"
 #include "DirectX/ShaderCompiler/ShaderCompiler.h"
+#include "Structs/ModelStruct.h"
 
 ModelShadowPipeline::ModelShadowPipeline(DXGI* dxgi, ShaderCompiler* shaderCompiler)
 	:BaseShadowPipeline(dxgi, shaderCompiler) {}
@@ -89,7 +90,7 @@ void ModelShadowPipeline::CreateRootSignature() {
 	// b2 MeshInfo
 	rootParams[7].ParameterType = D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS;
 	rootParams[7].ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
-	rootParams[7].Constants.Num32BitValues = 4;
+	rootParams[7].Constants.Num32BitValues = sizeof(MeshInfo) / sizeof(uint32_t);
 	rootParams[7].Constants.ShaderRegister = 2;
 
 	// b3 Frustum
@@ -2,6 +2,9 @@
 
 #include <memory>
 #include <string>
+#include <vector>
+
+#include "AssetLoadQueue/AssetLoadQueue.h"
 
 // 前方宣言
 template <typename Data>
@@ -16,6 +19,9 @@ public:
 
 	virtual ~BaseScene() = default;
 
+	// 先読み(ワーカースレッドで呼ばれる。非同期ロードなどスレッドセーフな処理だけを行う)
+	// 積んだハンドルがすべてReadyになったらシーンが切り替わる
+	virtual void Preload([[maybe_unused]] std::vector<AssetLoadHandle>& handles) {}
 	virtual void Initialize() {}
 	virtual void Update() {}
 	virtual void Draw() {}
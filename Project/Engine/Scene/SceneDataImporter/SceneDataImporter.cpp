@@ -1,23 +1,38 @@
 #include "SceneDataImporter.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 #include "Logger/Logger.h"
 
 #include "SceneDataContainer/SceneDataContainer.h"
 #include "GameObject3DManager/GameObject3DManager.h"
 #include "Renderer3DManager/Renderer3DManager.h"
 #include "TransformManager/TransformManager.h"
+#include "ModelDataContainer/ModelDataContainer.h"
+#include "ModelDrawerManager/ModelDrawerManager.h"
+#include "Camera3DManager/Camera3DManager.h"
+#include "Math/Utility/MathUtility.h"
+#include "Const/SceneImportConst.h"
+#include "Const/WorldPartitionConst.h"
 
-SceneDataImporter::SceneDataImporter(SceneDataContainer* sceneDataContainer, GameObject3DManager* gameObject3DManager, Renderer3DManager* renderer3DManager, TransformManager* transformManager) {
+SceneDataImporter::SceneDataImporter(SceneDataContainer* sceneDataContainer, GameObject3DManager* gameObject3DManager, Renderer3DManager* renderer3DManager, TransformManager* transformManager, ModelDataContainer* modelDataContainer, ModelDrawerManager* modelDrawerManager, Camera3DManager* camera3DManager) {
 	assert(sceneDataContainer);
 	assert(gameObject3DManager);
 	assert(renderer3DManager);
 	assert(transformManager);
+	assert(modelDataContainer);
+	assert(modelDrawerManager);
+	assert(camera3DManager);
 
 	sceneDataContainer_ = sceneDataContainer;
 	gameObject3DManager_ = gameObject3DManager;
 	renderer3DManager_ = renderer3DManager;
 	transformManager_ = transformManager;
+	modelDataContainer_ = modelDataContainer;
+	modelDrawerManager_ = modelDrawerManager;
+	camera3DManager_ = camera3DManager;
+	SetStreamingDistance(WorldPartitionConst::LoadDistance, WorldPartitionConst::UnloadDistance);
 	Logger::Log("SceneDataImporter Initialize\n");
 }
 
@@ -26,24 +41,278 @@ SceneDataImporter::~SceneDataImporter() {
 }
 
 void SceneDataImporter::Import(const std::string& scaneDataName, bool isSceneClear) {
-	Logger::Log("Begin import sceneData: " + scaneDataName + "\n");
+	ImportJob job = CreateJob(scaneDataName, sceneDataContainer_->GetData(scaneDataName), isSceneClear);
+	ProcessJob(job, true, {});
+}
+
+SceneImportHandle SceneDataImporter::ImportAsync(const std::string& scaneDataName, bool isSceneClear) {
+	jobs_.push_back(CreateJob(scaneDataName, sceneDataContainer_->GetData(scaneDataName), isSceneClear));
+	return SceneImportHandle(jobs_.back().progress);
+}
+
+void SceneDataImporter::Update() {
+	// カメラの位置で読み込むセルを決める
+	if (isStreaming_) {
+		UpdateStreaming();
+	}
+
+	if (jobs_.empty()) {
+		return;
+	}
+
+	// このフレームでインポートに使える時間
+	const auto deadline = std::chrono::steady_clock::now() +
+		std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double, std::milli>(SceneImportConst::FrameBudgetMilliseconds));
+
+	while (!jobs_.empty() && std::chrono::steady_clock::now() < deadline) {
+		if (!ProcessJob(jobs_.front(), false, deadline)) {
+			break;
+		}
+		jobs_.pop_front();
+	}
+}
+
+void SceneDataImporter::BeginStreaming(const std::string& scaneDataName, bool isSceneClear) {
+	const SceneData& sceneData = sceneDataContainer_->GetData(scaneDataName);
+
+	// 分割されていないシーンはまとめてインポートする
+	if (sceneData.cellSize <= 0.0f || sceneData.cells.empty()) {
+		Logger::Log("SceneData is not partitioned. Importing whole scene: " + scaneDataName + "\n");
+		ImportAsync(scaneDataName, isSceneClear);
+		return;
+	}
 
+	if (isStreaming_) {
+		EndStreaming();
+	}
 	if (isSceneClear) {
-		gameObject3DManager_->Clear();
-		renderer3DManager_->Clear();
-		transformManager_->Clear();
+		ClearScene();
+	}
+
+	streamingSceneData_ = sceneData;
+	streamingCells_.clear();
+	streamingCells_.reserve(sceneData.cells.size());
+
+	// セルの格子とオブジェクトの高さから空間インデックスの範囲を決める
+	const float cellSize = sceneData.cellSize;
+	AABB worldBounds{};
+	bool isFirstBounds = true;
+	for (const SceneCellData& cellData : sceneData.cells) {
+		for (uint32_t i = cellData.firstObject; i < cellData.firstObject + cellData.objectCount; i++) {
+			const float y = sceneData.objects[i].translate.y;
+			const AABB cellBounds{
+				.min = { static_cast<float>(cellData.x) * cellSize, y - cellSize, static_cast<float>(cellData.z) * cellSize },
+				.max = { static_cast<float>(cellData.x + 1) * cellSize, y + cellSize, static_cast<float>(cellData.z + 1) * cellSize },
+			};
+			worldBounds = isFirstBounds ? cellBounds : MAGIMath::MergeAABB(worldBounds, cellBounds);
+			isFirstBounds = false;
+		}
+		streamingCells_.push_back(StreamingCell{ .data = cellData });
+	}
+	if (!isFirstBounds) {
+		if (!isSceneClear) {
+			worldBounds = MAGIMath::MergeAABB(worldBounds, gameObject3DManager_->GetSpatialIndexBounds());
+		}
+		gameObject3DManager_->RebuildSpatialIndex(worldBounds);
+	}
+
+	isStreaming_ = true;
+	Logger::Log("Begin streaming sceneData: " + scaneDataName + "\n");
+}
+
+void SceneDataImporter::EndStreaming() {
+	isStreaming_ = false;
+	streamingCells_.clear();
+	streamingSceneData_ = {};
+}
+
+void SceneDataImporter::SetStreamingDistance(float loadDistance, float unloadDistance) {
+	assert(loadDistance < unloadDistance && "Unload distance must be farther than load distance");
+	loadDistance_ = loadDistance;
+	unloadDistance_ = unloadDistance;
+}
+
+bool SceneDataImporter::IsStreaming() const {
+	return isStreaming_;
+}
+
+SceneDataImporter::ImportJob SceneDataImporter::CreateJob(const std::string& scaneDataName, const SceneData& sceneData, bool isSceneClear) {
+	ImportJob job{};
+	job.sceneDataName = scaneDataName;
+	job.sceneData = sceneData;
+	job.isSceneClear = isSceneClear;
+	job.progress = std::make_shared<SceneImportProgress>();
+
+	// 使うモデルの読み込みをワーカースレッドで開始(読み込み済みのものはすぐReadyになる)
+	for (const auto& object3d : job.sceneData.objects) {
+		if (!job.pendingModels.contains(object3d.modelName)) {
+			job.pendingModels.emplace(object3d.modelName, modelDataContainer_->LoadAsync(object3d.modelName));
+		}
+	}
+
+	job.progress->totalCount = static_cast<uint32_t>(job.pendingModels.size() + job.sceneData.objects.size());
+	return job;
+}
+
+bool SceneDataImporter::ProcessJob(ImportJob& job, bool isWait, std::chrono::steady_clock::time_point deadline) {
+	auto isOverBudget = [&]() {
+		return !isWait && std::chrono::steady_clock::now() >= deadline;
+		};
+
+	if (!job.isStarted) {
+		job.isStarted = true;
+		Logger::Log("Begin import sceneData: " + job.sceneDataName + "\n");
+
+		if (job.isSceneClear) {
+			// 消したシーンのセルは追わない
+			EndStreaming();
+			ClearScene();
+		}
+	}
+
+	// 待つ場合はこのシーンのモデルだけ確定させる(ほかの読み込みは待たない)
+	if (isWait) {
+		for (const auto& [modelName, handle] : job.pendingModels) {
+			modelDataContainer_->WaitLoad(modelName);
+		}
+	}
+
+	// 読み込みが終わったモデルの描画クラスを作る
+	for (auto it = job.pendingModels.begin(); it != job.pendingModels.end();) {
+		if (!it->second.IsReady()) {
+			++it;
+			continue;
+		}
+		if (!modelDrawerManager_->HasModelDrawer(it->first)) {
+			modelDrawerManager_->CreateModelDrawer(it->first, modelDataContainer_->FindModelData(it->first));
+		}
+		job.progress->completedCount++;
+		it = job.pendingModels.erase(it);
+
+		if (isOverBudget()) {
+			return false;
+		}
+	}
+
+	// モデルが揃ったオブジェクトから順に配置する
+	while (job.nextObjectIndex < job.sceneData.objects.size()) {
+		const SceneObjectData& object3d = job.sceneData.objects[job.nextObjectIndex];
+		if (job.pendingModels.contains(object3d.modelName)) {
+			break;
+		}
+		InstantiateObject(job, object3d);
+		job.nextObjectIndex++;
+		job.progress->completedCount++;
+
+		if (isOverBudget()) {
+			break;
+		}
 	}
 
-	SceneData sceneData = sceneDataContainer_->GetData(scaneDataName);
+	if (job.nextObjectIndex < job.sceneData.objects.size() || !job.pendingModels.empty()) {
+		return false;
+	}
+
+	CompleteJob(job);
+	return true;
+}
 
-	for (const auto& object3d : sceneData.objects) {
-		std::shared_ptr<ModelRenderer> newModelRenderer = std::make_shared<ModelRenderer>(object3d.modelName, object3d.modelName);
+void SceneDataImporter::InstantiateObject(ImportJob& job, const SceneObjectData& object3d) {
+	std::shared_ptr<ModelRenderer> newModelRenderer = std::make_shared<ModelRenderer>(object3d.modelName, object3d.modelName);
+	newModelRenderer->SetIsOccluder(object3d.isOccluder);
 
-		std::shared_ptr<GameObject3D> newGameObject = std::make_shared<GameObject3D>(object3d.objectName, object3d.scale, object3d.rotate, object3d.translate);
-		newGameObject->AddModelRenderer(std::move(newModelRenderer));
+	const Matrix4x4 worldMatrix = MAGIMath::MakeAffineMatrix(object3d.scale, object3d.rotate, object3d.translate);
+	const AABB worldAABB = MAGIMath::TransformAABB(newModelRenderer->GetLocalAABB(), worldMatrix);
+	job.sceneBounds = job.isFirstBounds ? worldAABB : MAGIMath::MergeAABB(job.sceneBounds, worldAABB);
+	job.isFirstBounds = false;
 
-		gameObject3DManager_->Add(std::move(newGameObject), true);
+	std::shared_ptr<GameObject3D> newGameObject = std::make_shared<GameObject3D>(object3d.objectName, object3d.scale, object3d.rotate, object3d.translate);
+	newGameObject->AddModelRenderer(std::move(newModelRenderer));
+
+	std::weak_ptr<GameObject3D> gameObject = gameObject3DManager_->Add(std::move(newGameObject), true);
+	if (job.spawnedObjects) {
+		job.spawnedObjects->push_back(std::move(gameObject));
 	}
+}
+
+void SceneDataImporter::CompleteJob(ImportJob& job) {
+	// シーンの範囲に合わせて空間インデックスを作り直す(登録は次の更新で行われる)
+	if (job.isRebuildSpatialIndex && !job.isFirstBounds) {
+		if (!job.isSceneClear) {
+			job.sceneBounds = MAGIMath::MergeAABB(job.sceneBounds, gameObject3DManager_->GetSpatialIndexBounds());
+		}
+		gameObject3DManager_->RebuildSpatialIndex(job.sceneBounds);
+	}
+
+	job.progress->isCompleted = true;
+	Logger::Log("Complete import sceneData: " + job.sceneDataName + "\n");
+}
+
+void SceneDataImporter::ClearScene() {
+	gameObject3DManager_->Clear();
+	renderer3DManager_->Clear();
+	transformManager_->Clear();
+}
+
+void SceneDataImporter::UpdateStreaming() {
+	Camera3D* camera = camera3DManager_->GetCurrentCamera();
+	if (!camera) {
+		return;
+	}
+	const Vector3 eye = camera->GetEye();
+
+	// 読み込む距離と破棄する距離の間では今の状態を保つ
+	for (StreamingCell& cell : streamingCells_) {
+		const float distance = CalculateCellDistance(cell.data, eye);
+		if (!cell.isLoaded && distance <= loadDistance_) {
+			LoadCell(cell);
+		} else if (cell.isLoaded && distance > unloadDistance_) {
+			UnloadCell(cell);
+		}
+	}
+}
+
+void SceneDataImporter::LoadCell(StreamingCell& cell) {
+	SceneData cellData{};
+	cellData.name = streamingSceneData_.name;
+	cellData.objects.assign(
+		streamingSceneData_.objects.begin() + cell.data.firstObject,
+		streamingSceneData_.objects.begin() + cell.data.firstObject + cell.data.objectCount);
+
+	// 空間インデックスは開始時に作ってあるので作り直さない
+	ImportJob job = CreateJob(streamingSceneData_.name, cellData, false);
+	job.isRebuildSpatialIndex = false;
+	job.spawnedObjects = std::make_shared<std::vector<std::weak_ptr<GameObject3D>>>();
+
+	cell.isLoaded = true;
+	cell.handle = SceneImportHandle(job.progress);
+	cell.objects = job.spawnedObjects;
+	jobs_.push_back(std::move(job));
+}
+
+void SceneDataImporter::UnloadCell(StreamingCell& cell) {
+	// 配置の途中なら終わってから破棄する
+	if (!cell.handle.IsCompleted()) {
+		return;
+	}
+
+	// 次のDeleteGarbageで消える(使われなくなったモデルとテクスチャは常駐予算に応じて追い出される)
+	for (const std::weak_ptr<GameObject3D>& object : *cell.objects) {
+		if (auto gameObject = object.lock()) {
+			gameObject->SetIsAlive(false);
+		}
+	}
+
+	cell.isLoaded = false;
+	cell.handle = {};
+	cell.objects.reset();
+}
 
-	Logger::Log("Complete import sceneData: " + scaneDataName + "\n");
+float SceneDataImporter::CalculateCellDistance(const SceneCellData& cell, const Vector3& position) const {
+	const float cellSize = streamingSceneData_.cellSize;
+	const float minX = static_cast<float>(cell.x) * cellSize;
+	const float minZ = static_cast<float>(cell.z) * cellSize;
+	const float dx = (std::max)({ minX - position.x, 0.0f, position.x - (minX + cellSize) });
+	const float dz = (std::max)({ minZ - position.z, 0.0f, position.z - (minZ + cellSize) });
+	return std::sqrt(dx * dx + dz * dz);
 }
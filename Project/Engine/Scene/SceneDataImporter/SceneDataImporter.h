@@ -1,28 +1,169 @@
 #pragma once
 
 // C++
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
 #include <string>
+#include <unordered_map>
+
+// MyHedder
+#include "SceneDataContainer/SceneDataContainer.h"
+#include "AssetLoadQueue/AssetLoadQueue.h"
+#include "Math/Utility/MathUtility.h"
 
 // 前方宣言
-class SceneDataContainer;
+class GameObject3D;
 class GameObject3DManager;
 class Renderer3DManager;
 class TransformManager;
+class ModelDataContainer;
+class ModelDrawerManager;
+class Camera3DManager;
+
+/// <summary>
+/// シーンインポートの進捗
+/// </summary>
+struct SceneImportProgress {
+	// 読み込むモデルと配置するオブジェクトの合計
+	uint32_t totalCount = 0;
+	// 終わった数
+	uint32_t completedCount = 0;
+	bool isCompleted = false;
+};
+
+/// <summary>
+/// シーンの非同期インポートのハンドル
+/// </summary>
+class SceneImportHandle {
+public:
+	SceneImportHandle() = default;
+	explicit SceneImportHandle(std::shared_ptr<const SceneImportProgress> progress)
+		:progress_(std::move(progress)) {
+	}
+
+	// 進捗(0~1)
+	float GetProgress()const {
+		if (!progress_ || progress_->totalCount == 0) {
+			return IsCompleted() ? 1.0f : 0.0f;
+		}
+		return static_cast<float>(progress_->completedCount) / static_cast<float>(progress_->totalCount);
+	}
+	// インポートが終わったか
+	bool IsCompleted()const {
+		return progress_ && progress_->isCompleted;
+	}
+	// 有効なハンドルか
+	bool IsValid()const {
+		return progress_ != nullptr;
+	}
+
+private:
+	std::shared_ptr<const SceneImportProgress> progress_;
+};
 
 /// <summary>
 /// シーンデータをインポートする
 /// </summary>
 class SceneDataImporter {
 public:
-	SceneDataImporter(SceneDataContainer* sceneDataContainer, GameObject3DManager* gameObject3DManager, Renderer3DManager* renderer3DManager, TransformManager* transformManager);
+	SceneDataImporter(SceneDataContainer* sceneDataContainer, GameObject3DManager* gameObject3DManager, Renderer3DManager* renderer3DManager, TransformManager* transformManager, ModelDataContainer* modelDataContainer, ModelDrawerManager* modelDrawerManager, Camera3DManager* camera3DManager);
 	~SceneDataImporter();
 
-	// シーンデータインポート
+	// シーンデータインポート(終わるまで待つ)
 	void Import(const std::string& scaneDataName, bool isSceneClear);
+	// シーンデータの非同期インポート(モデルはワーカースレッドで読み、配置は数フレームに分けて行う)
+	SceneImportHandle ImportAsync(const std::string& scaneDataName, bool isSceneClear);
+	// 1フレーム分の時間だけインポートを進める
+	void Update();
+
+	// ワールド分割されたシーンのストリーミングを開始(カメラからの距離でセルを読み込み・破棄する)
+	void BeginStreaming(const std::string& scaneDataName, bool isSceneClear);
+	// ストリーミングを終了(読み込んだセルはそのまま残す)
+	void EndStreaming();
+	// セルを読み込む距離と破棄する距離を設定
+	void SetStreamingDistance(float loadDistance, float unloadDistance);
+	// ストリーミング中か
+	bool IsStreaming()const;
+
+private:
+	/// <summary>
+	/// 進行中のインポート
+	/// </summary>
+	struct ImportJob {
+		std::string sceneDataName;
+		SceneData sceneData;
+		bool isSceneClear = false;
+		bool isStarted = false;
+
+		// 読み込み中のモデル(描画クラスを作ったものから消す)
+		std::unordered_map<std::string, AssetLoadHandle> pendingModels;
+		// 次に配置するオブジェクト
+		size_t nextObjectIndex = 0;
+
+		// シーン全体の範囲(空間インデックスのルートに使う)
+		AABB sceneBounds{};
+		bool isFirstBounds = true;
+		// 終わったときに空間インデックスを作り直すか(セルの読み込みでは作り直さない)
+		bool isRebuildSpatialIndex = true;
+
+		// 配置したオブジェクト(セルの破棄に使う。不要ならnull)
+		std::shared_ptr<std::vector<std::weak_ptr<GameObject3D>>> spawnedObjects;
+
+		std::shared_ptr<SceneImportProgress> progress;
+	};
+
+	/// <summary>
+	/// ストリーミングするセル
+	/// </summary>
+	struct StreamingCell {
+		SceneCellData data;
+		// 読み込みを開始したか
+		bool isLoaded = false;
+		// 読み込みの進捗
+		SceneImportHandle handle;
+		// 配置したオブジェクト
+		std::shared_ptr<std::vector<std::weak_ptr<GameObject3D>>> objects;
+	};
+
+	// インポートを作ってモデルの読み込みを開始する
+	ImportJob CreateJob(const std::string& scaneDataName, const SceneData& sceneData, bool isSceneClear);
+	// 期限までインポートを進める(isWaitなら終わるまで進める。終わったらtrue)
+	bool ProcessJob(ImportJob& job, bool isWait, std::chrono::steady_clock::time_point deadline);
+	// オブジェクトを1つ配置する
+	void InstantiateObject(ImportJob& job, const SceneObjectData& object3d);
+	// 配置が終わったシーンの後処理
+	void CompleteJob(ImportJob& job);
+	// シーンを空にする
+	void ClearScene();
+
+	// カメラからの距離でセルを読み込み・破棄する
+	void UpdateStreaming();
+	// セルのオブジェクトのインポートを積む
+	void LoadCell(StreamingCell& cell);
+	// セルのオブジェクトを破棄する
+	void UnloadCell(StreamingCell& cell);
+	// セルとカメラのXZ平面上の距離
+	float CalculateCellDistance(const SceneCellData& cell, const Vector3& position)const;
 
 private:
 	SceneDataContainer* sceneDataContainer_ = nullptr;
 	GameObject3DManager* gameObject3DManager_ = nullptr;
 	Renderer3DManager* renderer3DManager_ = nullptr;
 	TransformManager* transformManager_ = nullptr;
-};
\ No newline at end of file
+	ModelDataContainer* modelDataContainer_ = nullptr;
+	ModelDrawerManager* modelDrawerManager_ = nullptr;
+	Camera3DManager* camera3DManager_ = nullptr;
+
+	// 非同期インポートの待ち行列(先頭から順に進める)
+	std::deque<ImportJob> jobs_;
+
+	// ストリーミング中のシーン
+	bool isStreaming_ = false;
+	SceneData streamingSceneData_;
+	std::vector<StreamingCell> streamingCells_;
+	// セルを読み込む距離と破棄する距離
+	float loadDistance_ = 0.0f;
+	float unloadDistance_ = 0.0f;
+};
@@ -4,10 +4,13 @@
 #include <string>
 #include <unordered_map>
 #include <functional>
+#include <future>
 #include <cassert>
 #include <type_traits>
+#include <vector>
 
 #include "BaseScene/BaseScene.h"
+#include "SceneDataImporter/SceneDataImporter.h"
 #include "GameData/GameData.h"
 
 template <typename Data>
@@ -27,12 +30,27 @@ public:
 
 	// シーン変更
 	void ChangeScene(const std::string& sceneName);
+	// 裏で次のシーンを作ってアセットを読み、揃ったフレームで切り替える
+	void PreloadScene(const std::string& sceneName);
+	// 先読み中か
+	bool IsPreloading()const;
+	// 先読みの進捗(0~1)
+	float GetPreloadProgress()const;
 
 	// 共有データへの参照を取得
 	Data& GetData()const;
+
+	// シーンの非同期インポートを進捗の監視対象にする
+	void TrackImport(const SceneImportHandle& handle);
+	// 監視中のインポートの進捗(0~1)
+	float GetImportProgress()const;
+	// 監視中のインポートが進行中か
+	bool IsImporting()const;
 private:
 	// シーン変更処理
 	void SwitchScene();
+	// 先読みが終わっていれば次のシーンにする
+	void UpdatePreload();
 private:
 	// シーンファクトリ関数
 	using SceneFactoryFunc = std::function<std::unique_ptr<BaseScene<Data>>()>;
@@ -42,8 +60,22 @@ private:
 	std::unique_ptr<BaseScene<Data>> currentScene_;
 	// 次のシーン
 	std::unique_ptr<BaseScene<Data>> nextScene_;
+
+	/// <summary>
+	/// 先読みしたシーン
+	/// </summary>
+	struct PreloadedScene {
+		std::unique_ptr<BaseScene<Data>> scene;
+		std::vector<AssetLoadHandle> handles;
+	};
+	// 先読み中のシーン(作成とPreloadはワーカースレッド)
+	std::future<PreloadedScene> preloadFuture_;
+	// 作成済みでアセットの確定を待っているシーン
+	std::unique_ptr<PreloadedScene> preloadedScene_;
 	// 共有データ
 	std::shared_ptr<Data> data_;
+	// 監視中のシーンインポート
+	SceneImportHandle importHandle_;
 
 };
 
@@ -11,6 +11,10 @@ SceneManager<Data>::SceneManager()
 
 template <typename Data>
 SceneManager<Data>::~SceneManager() {
+	// 先読み中のワーカースレッドを待つ
+	if (preloadFuture_.valid()) {
+		preloadFuture_.wait();
+	}
 	if (currentScene_) {
 		currentScene_->Finalize();
 		currentScene_.reset();
@@ -20,6 +24,7 @@ SceneManager<Data>::~SceneManager() {
 
 template <typename Data>
 void SceneManager<Data>::Update() {
+	UpdatePreload();
 	SwitchScene();
 	if (currentScene_) {
 		currentScene_->Update();
@@ -54,14 +59,94 @@ void SceneManager<Data>::ChangeScene(const std::string& sceneName) {
 	auto it = factory_.find(sceneName);
 	assert(it != factory_.end() && "No scene found with the given name");
 
+	// 先読み中のものは捨てる
+	if (preloadFuture_.valid()) {
+		preloadFuture_.wait();
+		preloadFuture_ = {};
+	}
+	preloadedScene_.reset();
+
 	nextScene_ = it->second();
 }
 
+template <typename Data>
+void SceneManager<Data>::PreloadScene(const std::string& sceneName) {
+	auto it = factory_.find(sceneName);
+	assert(it != factory_.end() && "No scene found with the given name");
+	assert(!IsPreloading() && "Scene is already preloading");
+
+	// シーンの作成とアセットの読み込み開始はワーカースレッドで行う
+	preloadFuture_ = std::async(std::launch::async, [factory = it->second]() {
+		PreloadedScene preloaded;
+		preloaded.scene = factory();
+		preloaded.scene->Preload(preloaded.handles);
+		return preloaded;
+		});
+}
+
+template <typename Data>
+bool SceneManager<Data>::IsPreloading() const {
+	return preloadFuture_.valid() || preloadedScene_ != nullptr;
+}
+
+template <typename Data>
+float SceneManager<Data>::GetPreloadProgress() const {
+	if (!IsPreloading()) {
+		return 1.0f;
+	}
+	// シーンの作成が終わるまでは0
+	if (!preloadedScene_ || preloadedScene_->handles.empty()) {
+		return 0.0f;
+	}
+	size_t readyCount = 0;
+	for (const AssetLoadHandle& handle : preloadedScene_->handles) {
+		if (handle.IsReady()) {
+			readyCount++;
+		}
+	}
+	return static_cast<float>(readyCount) / static_cast<float>(preloadedScene_->handles.size());
+}
+
 template<typename Data>
 inline Data& SceneManager<Data>::GetData() const {
 	return *data_;
 }
 
+template<typename Data>
+inline void SceneManager<Data>::TrackImport(const SceneImportHandle& handle) {
+	importHandle_ = handle;
+}
+
+template<typename Data>
+inline float SceneManager<Data>::GetImportProgress() const {
+	return importHandle_.IsValid() ? importHandle_.GetProgress() : 1.0f;
+}
+
+template<typename Data>
+inline bool SceneManager<Data>::IsImporting() const {
+	return importHandle_.IsValid() && !importHandle_.IsCompleted();
+}
+
+template <typename Data>
+void SceneManager<Data>::UpdatePreload() {
+	// シーンの作成とPreloadが終わったら受け取る
+	if (preloadFuture_.valid() && preloadFuture_.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+		preloadedScene_ = std::make_unique<PreloadedScene>(preloadFuture_.get());
+	}
+	if (!preloadedScene_) {
+		return;
+	}
+
+	// アセットがすべて確定していれば、このフレームで切り替える
+	for (const AssetLoadHandle& handle : preloadedScene_->handles) {
+		if (!handle.IsReady()) {
+			return;
+		}
+	}
+	nextScene_ = std::move(preloadedScene_->scene);
+	preloadedScene_.reset();
+}
+
 template <typename Data>
 void SceneManager<Data>::SwitchScene() {
 	if (nextScene_) {
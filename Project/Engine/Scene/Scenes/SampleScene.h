@@ -17,6 +17,7 @@ public:
 	using BaseScene<Data>::BaseScene; // 親クラスのコンストラクタをそのまま継承
 	~SampleScene()override = default;
 
+	void Preload(std::vector<AssetLoadHandle>& handles) override;
 	void Initialize() override;
 	void Update() override;
 	void Draw() override;
@@ -52,6 +53,17 @@ private:
 	std::weak_ptr<GameObject3D> teapot_;
 };
 
+template<typename Data>
+inline void SampleScene<Data>::Preload(std::vector<AssetLoadHandle>& handles) {
+	// テクスチャ
+	handles.push_back(MAGISYSTEM::LoadTextureAsync("pronama_chan.png"));
+	handles.push_back(MAGISYSTEM::LoadTextureAsync("gradationLine.png"));
+	handles.push_back(MAGISYSTEM::LoadTextureAsync("kloppenheim_06_puresky_2k.dds"));
+
+	// モデル
+	handles.push_back(MAGISYSTEM::LoadModelAsync("teapot"));
+}
+
 template<typename Data>
 inline void SampleScene<Data>::Initialize() {
 
@@ -121,8 +133,11 @@ inline void SampleScene<Data>::Update() {
 
 	ImGui::Begin("SceneImport");
 	if (ImGui::Button("Import")) {
-		MAGISYSTEM::LoadSceneDataFromJson("SceneData");
-		MAGISYSTEM::ImportSceneData("SceneData");
+		MAGISYSTEM::LoadSceneData("SceneData");
+		this->sceneManager_->TrackImport(MAGISYSTEM::ImportSceneDataAsync("SceneData"));
+	}
+	if (this->sceneManager_->IsImporting()) {
+		ImGui::ProgressBar(this->sceneManager_->GetImportProgress());
 	}
 	ImGui::End();
 
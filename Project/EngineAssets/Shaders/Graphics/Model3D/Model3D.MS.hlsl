@@ -4,7 +4,7 @@
 ConstantBuffer<Camera> gCamera : register(b0);
 ConstantBuffer<MeshInfo> gMeshInfo : register(b2);
 StructuredBuffer<ModelDataForGPU> gInstanceData : register(t0);
-StructuredBuffer<VertexData3D> gVertexBuffer : register(t1);
+StructuredBuffer<QuantizedVertexData3D> gVertexBuffer : register(t1);
 StructuredBuffer<Meshlet> gMeshlets : register(t2);
 ByteAddressBuffer gUniqueVertexIndices : register(t3);
 ByteAddressBuffer gPrimitiveIndices : register(t4);
@@ -38,7 +38,7 @@ uint3 GetPrimitive(in Meshlet m, uint localPrim)
 
 MeshOutput GetVertexAttributes(uint vertexIndex, uint instID)
 {
-    VertexData3D v = gVertexBuffer[vertexIndex];
+    VertexData3D v = DecodeVertex(gVertexBuffer[vertexIndex], gMeshInfo);
     ModelDataForGPU instData = gInstanceData[instID];
     
     MeshOutput vout;
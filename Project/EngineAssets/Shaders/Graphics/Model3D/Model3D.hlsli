@@ -33,6 +33,16 @@ struct VertexData3D
     float3 tangent;
 };
 
+// 量子化した頂点データ
+struct QuantizedVertexData3D
+{
+    uint positionXY; // メッシュの境界で正規化した16bit座標
+    uint positionZW;
+    uint uv; // half x2
+    uint normal; // 八面体エンコードしたsnorm16 x2
+    uint tangent; // 八面体エンコードしたsnorm16 x2
+};
+
 // インスタンスデータ
 struct ModelDataForGPU
 {
@@ -83,8 +93,43 @@ struct MeshInfo
 {
     uint IndexSize;
     uint MeshletCount;
+    uint BaseInstance; // LODごとのインスタンス開始位置
+    uint _pad0;
+    float3 PositionMin; // 量子化した座標の復元用
+    float _pad1;
+    float3 PositionScale;
+    float _pad2;
 };
 
+// ────────── 量子化頂点の復元 ──────────
+
+float2 UnpackSnorm16x2(uint packed)
+{
+    int2 s = int2(packed << 16, packed) >> 16;
+    return max(float2(s) / 32767.0f, -1.0f);
+}
+
+float3 DecodeOctahedral(float2 f)
+{
+    float3 n = float3(f.x, f.y, 1.0f - abs(f.x) - abs(f.y));
+    float t = saturate(-n.z);
+    n.x += n.x >= 0.0f ? -t : t;
+    n.y += n.y >= 0.0f ? -t : t;
+    return normalize(n);
+}
+
+VertexData3D DecodeVertex(QuantizedVertexData3D q, MeshInfo info)
+{
+    float3 position = float3(q.positionXY & 0xFFFF, q.positionXY >> 16, q.positionZW & 0xFFFF) / 65535.0f;
+
+    VertexData3D v;
+    v.position = float4(info.PositionMin + position * info.PositionScale, 1.0f);
+    v.uv = float2(f16tof32(q.uv & 0xFFFF), f16tof32(q.uv >> 16));
+    v.normal = DecodeOctahedral(UnpackSnorm16x2(q.normal));
+    v.tangent = DecodeOctahedral(UnpackSnorm16x2(q.tangent));
+    return v;
+}
+
 struct Meshlet
 {
     uint VertCount;
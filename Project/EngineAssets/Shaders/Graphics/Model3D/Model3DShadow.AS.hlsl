@@ -12,7 +12,7 @@ StructuredBuffer<CullData> gCullData : register(t5);
 void main(uint3 dtid : SV_DispatchThreadID, uint3 gid : SV_GroupID)
 {
     uint meshletID = gid.x * AS_GROUP_SIZE + dtid.x;
-    uint instanceID = dtid.y;
+    uint instanceID = gMeshInfo.BaseInstance + dtid.y;
     
     bool visible = false;
    
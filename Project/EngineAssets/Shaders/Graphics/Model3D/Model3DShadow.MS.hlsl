@@ -3,7 +3,7 @@
 // oChobt@
 ConstantBuffer<DirectionalLightCamera> gCamera : register(b0);
 StructuredBuffer<ModelDataForGPU> gInstanceData : register(t0);
-StructuredBuffer<VertexData3D> gVertexBuffer : register(t1);
+StructuredBuffer<QuantizedVertexData3D> gVertexBuffer : register(t1);
 StructuredBuffer<Meshlet> gMeshlets : register(t2);
 ByteAddressBuffer gUniqueVertexIndices : register(t3);
 ByteAddressBuffer gPrimitiveIndices : register(t4);
@@ -39,7 +39,7 @@ uint3 GetPrimitive(in Meshlet m, uint localPrim)
 // _f[^[hϊr[vWFNVKp
 ShadowMeshOutput GetVertexAttributes(uint vertexIndex, uint instID)
 {
-    VertexData3D v = gVertexBuffer[vertexIndex];
+    VertexData3D v = DecodeVertex(gVertexBuffer[vertexIndex], gMeshInfo);
     ModelDataForGPU instData = gInstanceData[instID];
 
     ShadowMeshOutput vout;
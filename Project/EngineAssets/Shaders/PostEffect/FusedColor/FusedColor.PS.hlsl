@@ -0,0 +1,44 @@
+#include "FusedColor.hlsli"
+
+// ENABLE_RADIAL_BLUR, ENABLE_GRAYSCALE, ENABLE_VIGNETTE の組み合わせでコンパイルする
+
+Texture2D<float4> gTexture : register(t0);
+SamplerState gSampler : register(s0);
+ConstantBuffer<FusedColorData> gdata : register(b0);
+
+PixelShaderOutput main(VertexShaderOutput input)
+{
+    PixelShaderOutput output;
+
+#ifdef ENABLE_RADIAL_BLUR
+    const float2 center = gdata.param0.xy;
+    const float blurWidth = gdata.param0.z;
+    const uint numSamples = 10;
+
+    float3 blurColor = float3(0.0f, 0.0f, 0.0f);
+    float2 direction = input.texcoord - center;
+    for (uint sampleIndex = 0; sampleIndex < numSamples; ++sampleIndex)
+    {
+        float2 texcoord = input.texcoord + direction * blurWidth * float(sampleIndex);
+        blurColor += gTexture.Sample(gSampler, texcoord).rgb;
+    }
+    output.color.rgb = blurColor * rcp(float(numSamples));
+    output.color.a = 1.0f;
+#else
+    output.color = gTexture.Sample(gSampler, input.texcoord);
+#endif
+
+#ifdef ENABLE_GRAYSCALE
+    float value = dot(output.color.rgb, float3(0.2125f, 0.7154f, 0.0721f));
+    output.color.rgb = float3(value, value, value);
+#endif
+
+#ifdef ENABLE_VIGNETTE
+    float2 correct = input.texcoord * (1.0f - input.texcoord.yx);
+    float vignette = correct.x * correct.y * gdata.param1.x;
+    vignette = saturate(pow(vignette, gdata.param1.y));
+    output.color.rgb *= vignette;
+#endif
+
+    return output;
+}
\ No newline at end of file
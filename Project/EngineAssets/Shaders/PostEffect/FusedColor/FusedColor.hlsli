@@ -0,0 +1,18 @@
+struct VertexShaderOutput
+{
+    float4 position : SV_POSITION;
+    float2 texcoord : TEXCOORD0;
+};
+
+struct PixelShaderOutput
+{
+    float4 color : SV_TARGET0;
+};
+
+struct FusedColorData
+{
+    float4 param0; // xy {RadialBlurCenter.x,RadialBlurCenter.y} z {RadialBlurWidth}
+    float4 param1; // xy {VignetteScale,VignetteFalloff}
+    float4 param2;
+    float4 param3;
+};
\ No newline at end of file
@@ -0,0 +1,4 @@
+@echo off
+cd /d %~dp0
+python pack_assets.py ..\.. ..\..\Assets.pack
+pause
@@ -0,0 +1,108 @@
+# アセットパック(Assets.pack)の書き出しツール
+# エンジンの AssetPack クラスが読むレイアウトで、Assets/ と EngineAssets/ を1ファイルにまとめる
+#
+# レイアウト(リトルエンディアン)
+#   Header  : magic[8] "MAGIPACK", version u32, tableSize u32, tableOffset u64, stringOffset u64
+#   Data    : 各ファイルの中身(パス順に並べ、ALIGNMENT境界に揃える)
+#   Table   : Entry * tableSize (パスハッシュをキーにした線形探査のハッシュテーブル)
+#             Entry = hash u64, dataOffset u64, dataSize u64, nameOffset u32, nameLength u32
+#   Strings : パス文字列(区切り文字は'/')
+
+import os
+import struct
+import sys
+
+MAGIC = b"MAGIPACK"
+VERSION = 1
+# ファイルの先頭はページ境界に揃える
+ALIGNMENT = 4096
+
+HEADER = struct.Struct("<8sIIQQ")
+ENTRY = struct.Struct("<QQQII")
+
+# パックに含めるディレクトリ(プロジェクトのルートからの相対パス)
+SOURCE_DIRECTORIES = ["Assets", "EngineAssets"]
+
+
+def normalize_path(path):
+    return path.replace("\\", "/")
+
+
+def hash_path(path):
+    # エンジン側のAssetPack::HashPathと同じ(区切り文字と英大文字を正規化したFNV-1a 64bit)
+    h = 14695981039346656037
+    for c in normalize_path(path).encode("utf-8"):
+        if 65 <= c <= 90:
+            c += 32
+        h ^= c
+        h = (h * 1099511628211) & 0xFFFFFFFFFFFFFFFF
+    return h
+
+
+def align(value, alignment):
+    return (value + alignment - 1) & ~(alignment - 1)
+
+
+def collect_files(root):
+    files = []
+    for directory in SOURCE_DIRECTORIES:
+        for current, _, names in os.walk(os.path.join(root, directory)):
+            for name in names:
+                full_path = os.path.join(current, name)
+                files.append(normalize_path(os.path.relpath(full_path, root)))
+    # 同じディレクトリのファイルが隣り合うようにパス順に並べる
+    files.sort()
+    return files
+
+
+def write_pack(root, output_path):
+    files = collect_files(root)
+
+    # 目次は読み込み率50%以下になるよう2のべき乗で確保
+    table_size = 1
+    while table_size < max(len(files) * 2, 1):
+        table_size *= 2
+    mask = table_size - 1
+    table = [None] * table_size
+
+    strings = bytearray()
+
+    with open(output_path, "wb") as out:
+        out.write(b"\0" * HEADER.size)
+
+        for path in files:
+            offset = align(out.tell(), ALIGNMENT)
+            out.write(b"\0" * (offset - out.tell()))
+            with open(os.path.join(root, path), "rb") as f:
+                data = f.read()
+            out.write(data)
+
+            name = path.encode("utf-8")
+            h = hash_path(path)
+            slot = h & mask
+            while table[slot] is not None:
+                if table[slot][0] == h:
+                    sys.exit("hash collision: " + path)
+                slot = (slot + 1) & mask
+            table[slot] = (h, offset, len(data), len(strings), len(name))
+            strings += name
+
+        table_offset = align(out.tell(), 8)
+        out.write(b"\0" * (table_offset - out.tell()))
+        for entry in table:
+            out.write(ENTRY.pack(*(entry if entry else (0, 0, 0, 0, 0))))
+
+        string_offset = out.tell()
+        out.write(strings)
+
+        out.seek(0)
+        out.write(HEADER.pack(MAGIC, VERSION, table_size, table_offset, string_offset))
+
+    print("packed {} files into {}".format(len(files), output_path))
+
+
+if __name__ == "__main__":
+    # 引数: プロジェクトのルート(Assets/ がある場所) 出力ファイル
+    project_root = sys.argv[1] if len(sys.argv) > 1 else os.path.join(os.path.dirname(__file__), "..", "..")
+    output = sys.argv[2] if len(sys.argv) > 2 else os.path.join(project_root, "Assets.pack")
+    write_pack(project_root, output)
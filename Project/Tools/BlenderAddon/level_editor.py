@@ -6,6 +6,7 @@ import gpu_extras.batch
 import copy
 import mathutils
 import json
+import struct
 
 # ブレンダーに登録するアドオン情報
 bl_info = {
@@ -80,6 +81,10 @@ class TOPBAR_MT_my_menu(bpy.types.Menu):
         self.layout.operator(MYADDON_OT_export_scene.bl_idname,
             text = MYADDON_OT_export_scene.bl_label)
 
+        #シーン出力(バイナリ)
+        self.layout.operator(MYADDON_OT_export_scene_binary.bl_idname,
+            text = MYADDON_OT_export_scene_binary.bl_label)
+
 
 
 
@@ -118,6 +123,21 @@ class MYADDON_OT_create_ico_sphere(bpy.types.Operator):
 
         return {'FINISHED'}
     
+#オブジェクトのローカルトランスフォームをエンジンの座標系に変換
+def convert_transform(object):
+    #平行移動、回転、スケールを抽出
+    trans, rot_q, scale = object.matrix_local.decompose()
+    rot_q_xyzw = (-rot_q.x,-rot_q.z,-rot_q.y,rot_q.w)   # ← Blender は wxyz なので並べ替え
+
+    translate = (trans.x, trans.z, trans.y) # 座標系ここで変換
+    return translate, rot_q_xyzw, (scale.x, scale.z, scale.y)
+
+#ワールド分割のセル(エンジン座標のXZ平面を格子に区切る)
+def compute_cell(translate, cell_size):
+    if cell_size <= 0.0:
+        return (0, 0)
+    return (math.floor(translate[0] / cell_size), math.floor(translate[2] / cell_size))
+
 #オペレータ　シーン出力
 class MYADDON_OT_export_scene(bpy.types.Operator,bpy_extras.io_utils.ExportHelper):
     bl_idname = "myaddon.myaddon_ot_export_scene"
@@ -126,6 +146,9 @@ class MYADDON_OT_export_scene(bpy.types.Operator,bpy_extras.io_utils.ExportHelpe
     #出力するファイルの拡張子
     filename_ext = ".json"
 
+    #ワールド分割のセルの一辺の長さ(0なら分割しない)
+    cell_size: bpy.props.FloatProperty(name = "セルサイズ", default = 64.0, min = 0.0)
+
     def write_and_print(self,file,str):
         print(str)
 
@@ -173,6 +196,9 @@ class MYADDON_OT_export_scene(bpy.types.Operator,bpy_extras.io_utils.ExportHelpe
 
         #ノード名
         json_object_root["name"] = "scene"
+        #ワールド分割のセルの大きさ
+        if self.cell_size > 0.0:
+            json_object_root["cell_size"] = self.cell_size
         #オブジェクトリストを作成
         json_object_root["objects"] = list()
 
@@ -211,22 +237,29 @@ class MYADDON_OT_export_scene(bpy.types.Operator,bpy_extras.io_utils.ExportHelpe
         #その他情報をパック
         #オブジェクトのローカルトランスフォームから
         #平行移動、回転、スケールを抽出
-        trans, rot_q, scale = object.matrix_local.decompose()
-        rot_q_xyzw = (-rot_q.x,-rot_q.z,-rot_q.y,rot_q.w)   # ← Blender は wxyz なので並べ替え
+        translate, rotate, scale = convert_transform(object)
 
         transform = {
-            "translate": (trans.x, trans.z, trans.y), # 座標系ここで変換
-            "rotate": rot_q_xyzw,                
-            "scale": (scale.x, scale.z,scale.y)
+            "translate": translate,
+            "rotate": rotate,
+            "scale": scale
         }   
 
         #まとめて1個分のjsonオブジェクトに登録
         json_object["transform"] = transform
 
+        #シーン直下のオブジェクトが属するセル
+        if level == 0 and self.cell_size > 0.0:
+            json_object["cell"] = compute_cell(translate, self.cell_size)
+
         #カスタムプロパティ'file name'
         if "model_name" in object:
             json_object["model_name"] = object["model_name"]
 
+        #カスタムプロパティ'occluder'(オクルージョンカリングの遮蔽物)
+        if "occluder" in object:
+            json_object["occluder"] = bool(object["occluder"])
+
         #カスタムプロパティ'collider'
         if "collider" in object:
             collider = dict()
@@ -248,6 +281,112 @@ class MYADDON_OT_export_scene(bpy.types.Operator,bpy_extras.io_utils.ExportHelpe
                 self.parse_scene_recursive_json(json_object["children"],child,level +1)
 
 
+#オペレータ　シーン出力(バイナリ)
+#レイアウトはエンジンのSceneDataContainer::BinaryHeaderと一致させる
+class MYADDON_OT_export_scene_binary(bpy.types.Operator,bpy_extras.io_utils.ExportHelper):
+    bl_idname = "myaddon.myaddon_ot_export_scene_binary"
+    bl_label = "シーン出力(バイナリ)"
+    bl_description = "シーン情報をバイナリ形式でExportします"
+    #出力するファイルの拡張子
+    filename_ext = ".scene"
+
+    #ワールド分割のセルの一辺の長さ(0なら分割しない)
+    cell_size: bpy.props.FloatProperty(name = "セルサイズ", default = 64.0, min = 0.0)
+
+    #識別子とバージョン
+    MAGIC = b"MAGISCNE"
+    VERSION = 2
+    #オブジェクトのフラグ
+    FLAG_OCCLUDER = 1 << 0
+
+    def execute(self,context):
+
+        print("シーン情報をバイナリでExportします")
+        #ファイルに出力
+        self.export_binary()
+
+        print("シーン情報をExportしました")
+        self.report({'INFO'},"シーン情報をExportしました")
+
+        return {'FINISHED'}
+
+    def export_binary(self):
+        """バイナリ形式でファイルに出力"""
+
+        #エンジンが読むのはシーン直下のモデル付きメッシュのみ
+        objects = [object for object in bpy.context.scene.objects
+                   if not object.parent and object.type == "MESH" and "model_name" in object]
+
+        #セル順に並べて、セルごとに連続した範囲にする
+        object_cells = {object.name: compute_cell(convert_transform(object)[0], self.cell_size) for object in objects}
+        objects.sort(key = lambda object: object_cells[object.name])
+        cells = list()
+        for index, object in enumerate(objects):
+            cell = object_cells[object.name]
+            if not cells or cells[-1][0] != cell:
+                cells.append([cell, index, 0])
+            cells[-1][2] += 1
+        #分割しない場合はセルを書かない
+        if self.cell_size <= 0.0:
+            cells = list()
+
+        #文字列テーブル(同じ文字列は1度だけ書く)
+        string_table = bytearray()
+        string_refs = dict()
+        def add_string(text):
+            if text not in string_refs:
+                encoded = text.encode("utf-8")
+                string_refs[text] = (len(string_table), len(encoded))
+                string_table.extend(encoded)
+            return string_refs[text]
+
+        #モデル名は番号で参照する
+        model_names = list()
+        model_indices = dict()
+
+        translates = bytearray()
+        rotates = bytearray()
+        scales = bytearray()
+        model_index_array = bytearray()
+        flags = bytearray()
+        object_names = bytearray()
+
+        for object in objects:
+            translate, rotate, scale = convert_transform(object)
+            translates += struct.pack("<3f", *translate)
+            rotates += struct.pack("<4f", *rotate)
+            scales += struct.pack("<3f", *scale)
+
+            model_name = object["model_name"]
+            if model_name not in model_indices:
+                model_indices[model_name] = len(model_names)
+                model_names.append(model_name)
+            model_index_array += struct.pack("<I", model_indices[model_name])
+
+            flag = 0
+            if "occluder" in object and bool(object["occluder"]):
+                flag |= self.FLAG_OCCLUDER
+            flags += struct.pack("<I", flag)
+
+            object_names += struct.pack("<2I", *add_string(object.name))
+
+        model_name_refs = bytearray()
+        for model_name in model_names:
+            model_name_refs += struct.pack("<2I", *add_string(model_name))
+
+        cell_array = bytearray()
+        for (cell_x, cell_z), first, count in cells:
+            cell_array += struct.pack("<2i2I", cell_x, cell_z, first, count)
+
+        header = struct.pack("<8s5If", self.MAGIC, self.VERSION, len(objects), len(model_names), len(string_table), len(cells), self.cell_size)
+
+        #ファイルをバイナリ形式で書き出し用にオープン
+        with open(self.filepath, "wb") as file:
+            for section in (header, translates, rotates, scales, model_index_array, flags, object_names, model_name_refs, cell_array, string_table):
+                file.write(section)
+
+        print("オブジェクト数: %d, モデル数: %d, セル数: %d" % (len(objects), len(model_names), len(cells)))
+
 #パネル　ファイル名
 class OBJECT_PT_model_name(bpy.types.Panel):
     """オブジェクトのモデルネームパネル"""
@@ -282,6 +421,40 @@ class MYADDON_OT_add_modelname(bpy.types.Operator):
 
         return {"FINISHED"}
 
+#パネル　遮蔽物
+class OBJECT_PT_occluder(bpy.types.Panel):
+    """オクルージョンカリングの遮蔽物パネル"""
+    bl_idname = "OBJECT_PT_occluder"
+    bl_label = "Occluder"
+    bl_space_type = "PROPERTIES"
+    bl_region_type = "WINDOW"
+    bl_context = "object"
+
+    #サブメニューの描画
+    def draw(self,context):
+
+        #パネルに項目を追加
+        if "occluder" in context.object:
+            #既にプロパティがあれば、プロパティを表示
+            self.layout.prop(context.object,'["occluder"]', text = self.bl_label)
+        else:
+            #プロパティがなければ、プロパティ追加ボタンを表示
+            self.layout.operator(MYADDON_OT_add_occluder.bl_idname)
+
+#オペレータ　カスタムプロパティ
+class MYADDON_OT_add_occluder(bpy.types.Operator):
+    bl_idname = "myaddon.myaddon_ot_add_occluder"
+    bl_label = "occluder 追加"
+    bl_description = "['occluder']カスタムプロパティを追加します"
+    bl_options = {"REGISTER", "UNDO"}
+
+    def execute(self,context):
+
+        #['occluder']カスタムプロパティを追加
+        context.object["occluder"] = True
+
+        return {"FINISHED"}
+
 #コライダー描画
 class DrawCollider:
 
@@ -414,11 +587,14 @@ class OBJECT_PT_collider(bpy.types.Panel):
 #Blenderに登録するクラスリスト
 classes =(
     MYADDON_OT_export_scene,
+    MYADDON_OT_export_scene_binary,
     MYADDON_OT_create_ico_sphere,
     MYADDON_OT_stretch_vertex, 
     TOPBAR_MT_my_menu,
     MYADDON_OT_add_modelname,
     OBJECT_PT_model_name,
+    MYADDON_OT_add_occluder,
+    OBJECT_PT_occluder,
     MYADDON_OT_add_collider,
     OBJECT_PT_collider
 )
\ No newline at end of file